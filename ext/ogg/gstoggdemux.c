@@ -32,6 +32,10 @@
  * ]|
  *  Decodes a vorbis audio stream stored inside an ogg container and plays it.
  *
+ * In pull mode, the position of every page read while playing or seeking is
+ * remembered, so that seeking back into an area that was played already does
+ * not need to bisect the file again.
+ *
  */
 
 
@@ -60,6 +64,9 @@
 
 #define SEEK_GIVE_UP_THRESHOLD (3*GST_SECOND)
 
+/* upper bound on the number of pages remembered per chain for seeking */
+#define MAX_SEEK_INDEX_ENTRIES (64 * 1024)
+
 #define GST_CHAIN_LOCK(ogg)     g_mutex_lock(&(ogg)->chain_lock)
 #define GST_CHAIN_UNLOCK(ogg)   g_mutex_unlock(&(ogg)->chain_lock)
 
@@ -802,7 +809,22 @@ gst_ogg_demux_chain_peer (GstOggPad * pad, ogg_packet * packet,
   if (!pad->added)
     goto not_added;
 
-  buf = gst_buffer_new_and_alloc (packet->bytes - offset - trim);
+  if (pad->page_buffer && packet->bytes - offset - trim > 0
+      && packet->packet >= pad->page_body
+      && packet->packet + packet->bytes <= pad->page_body + pad->page_body_len) {
+    /* packet does not span pages, share the input memory */
+    buf = gst_buffer_copy_region (pad->page_buffer, GST_BUFFER_COPY_MEMORY,
+        pad->page_buffer_offset + (packet->packet - pad->page_body) + offset,
+        packet->bytes - offset - trim);
+  } else {
+    buf = gst_buffer_new_and_alloc (packet->bytes - offset - trim);
+
+    if (packet->packet != NULL) {
+      /* copy packet in buffer */
+      gst_buffer_fill (buf, 0, packet->packet + offset,
+          packet->bytes - offset - trim);
+    }
+  }
 
   if (pad->map.audio_clipping && (clip_start || clip_end)) {
     GST_DEBUG_OBJECT (pad,
@@ -821,12 +843,6 @@ gst_ogg_demux_chain_peer (GstOggPad * pad, ogg_packet * packet,
   if (is_header)
     GST_BUFFER_FLAG_SET (buf, GST_BUFFER_FLAG_HEADER);
 
-  if (packet->packet != NULL) {
-    /* copy packet in buffer */
-    gst_buffer_fill (buf, 0, packet->packet + offset,
-        packet->bytes - offset - trim);
-  }
-
   GST_BUFFER_TIMESTAMP (buf) = out_timestamp;
   GST_BUFFER_DURATION (buf) = out_duration;
   GST_BUFFER_OFFSET (buf) = out_offset;
@@ -2015,6 +2031,7 @@ gst_ogg_pad_submit_page (GstOggPad * pad, ogg_page * page)
   GstFlowReturn result = GST_FLOW_OK;
   GstOggDemux *ogg;
   gboolean continued = FALSE;
+  glong leftover;
 
   ogg = pad->ogg;
 
@@ -2058,14 +2075,31 @@ gst_ogg_pad_submit_page (GstOggPad * pad, ogg_page * page)
   if (page->header_len + page->body_len > ogg->max_page_size)
     ogg->max_page_size = page->header_len + page->body_len;
 
+  leftover = pad->map.stream.body_fill - pad->map.stream.body_returned;
+
   if (ogg_stream_pagein (&pad->map.stream, page) != 0)
     goto choked;
   if (pad->current_granule == -1)
     gst_ogg_demux_setup_first_granule (ogg, pad, page);
 
+  /* if the page came in one piece from the last input buffer and the stream
+   * layer appended its body as is, packets that don't span pages can be
+   * output as sub-buffers of the input */
+  if (ogg->sync_input && ogg->segment.rate > 0.0
+      && pad->map.stream.body_fill == leftover + page->body_len
+      && page->body >= ogg->sync_input_data
+      && page->body + page->body_len <=
+      ogg->sync_input_data + gst_buffer_get_size (ogg->sync_input)) {
+    pad->page_buffer = ogg->sync_input;
+    pad->page_buffer_offset = page->body - ogg->sync_input_data;
+    pad->page_body = pad->map.stream.body_data + leftover;
+    pad->page_body_len = page->body_len;
+  }
+
   /* flush all packets in the stream layer, this might not give a packet if
    * the page had no packets finishing on the page (npackets == 0). */
   result = gst_ogg_pad_stream_out (pad, 0);
+  pad->page_buffer = NULL;
 
   if (pad->continued) {
     ogg_packet packet;
@@ -2132,6 +2166,7 @@ gst_ogg_chain_new (GstOggDemux * ogg)
   chain->segment_start = GST_CLOCK_TIME_NONE;
   chain->segment_stop = GST_CLOCK_TIME_NONE;
   chain->total_time = GST_CLOCK_TIME_NONE;
+  chain->seek_index = g_array_new (FALSE, FALSE, sizeof (GstOggSeekEntry));
 
   return chain;
 }
@@ -2147,6 +2182,7 @@ gst_ogg_chain_free (GstOggChain * chain)
     gst_object_unref (pad);
   }
   g_array_free (chain->streams, TRUE);
+  g_array_free (chain->seek_index, TRUE);
   g_slice_free (GstOggChain, chain);
 }
 
@@ -2245,6 +2281,145 @@ gst_ogg_chain_has_stream (GstOggChain * chain, guint32 serialno)
   return gst_ogg_chain_get_stream (chain, serialno) != NULL;
 }
 
+/* returns the position of the first entry that is not before @time and
+ * @offset */
+static guint
+gst_ogg_chain_seek_index_find (GstOggChain * chain, GstClockTime time,
+    gint64 offset)
+{
+  GArray *index = chain->seek_index;
+  guint lo = 0, hi = index->len;
+
+  while (lo < hi) {
+    guint mid = lo + (hi - lo) / 2;
+    GstOggSeekEntry *entry = &g_array_index (index, GstOggSeekEntry, mid);
+
+    if (entry->time < time || (entry->time == time && entry->offset < offset))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+/* remember where the page at @offset is so that later seeks can skip
+ * (most of) the bisection */
+static void
+gst_ogg_chain_index_page (GstOggChain * chain, ogg_page * page, gint64 offset,
+    gint64 next_offset)
+{
+  GstOggSeekEntry entry, *found;
+  GstClockTime granuletime;
+  gint64 granulepos;
+  GstOggPad *pad;
+  guint pos;
+
+  if (chain->seek_index->len >= MAX_SEEK_INDEX_ENTRIES)
+    return;
+  if (!GST_CLOCK_TIME_IS_VALID (chain->begin_time))
+    return;
+
+  granulepos = ogg_page_granulepos (page);
+  if (granulepos == -1)
+    return;
+
+  pad = gst_ogg_chain_get_stream (chain, ogg_page_serialno (page));
+  if (pad == NULL || pad->map.is_skeleton)
+    return;
+  if (!GST_CLOCK_TIME_IS_VALID (pad->start_time))
+    return;
+
+  granuletime = gst_ogg_stream_get_end_time_for_granulepos (&pad->map,
+      granulepos);
+  if (!GST_CLOCK_TIME_IS_VALID (granuletime) || granuletime < pad->start_time)
+    return;
+
+  /* same time base as do_binary_search() */
+  entry.time = granuletime - pad->start_time + chain->begin_time;
+  entry.offset = offset;
+  entry.next_offset = next_offset;
+  entry.serialno = pad->map.serialno;
+
+  pos = gst_ogg_chain_seek_index_find (chain, entry.time, entry.offset);
+  if (pos < chain->seek_index->len) {
+    found = &g_array_index (chain->seek_index, GstOggSeekEntry, pos);
+    if (found->time == entry.time && found->offset == entry.offset)
+      return;
+  }
+
+  GST_LOG_OBJECT (chain->ogg, "indexing page at %" G_GINT64_FORMAT
+      " with time %" GST_TIME_FORMAT, offset, GST_TIME_ARGS (entry.time));
+  g_array_insert_val (chain->seek_index, pos, entry);
+}
+
+/* use the pages we have seen already to narrow down the range that
+ * do_binary_search() has to bisect. When the pages around @target are
+ * known, begin ends up at end and no data has to be read at all.
+ *
+ * The index is sorted by the end time of the pages, which is not the order
+ * in the file when streams are interleaved: a long page of one stream is
+ * written before the short pages of another stream that end earlier. The
+ * range is only narrowed when the pages around @target are in file order
+ * as well, otherwise the bisection has to work it out. */
+static void
+gst_ogg_chain_search_seek_index (GstOggChain * chain, gint64 target,
+    gboolean only_serial_no, gint serialno, gint64 * begin, gint64 * end,
+    gint64 * begintime, gint64 * endtime, gint64 * best)
+{
+  GArray *index = chain->seek_index;
+  GstOggSeekEntry *before = NULL, *after = NULL;
+  guint pos, i;
+
+  if (index->len == 0 || target < 0)
+    return;
+
+  pos = gst_ogg_chain_seek_index_find (chain, target, 0);
+
+  /* last page before the target */
+  for (i = pos; i > 0; i--) {
+    GstOggSeekEntry *entry = &g_array_index (index, GstOggSeekEntry, i - 1);
+
+    if (only_serial_no && entry->serialno != serialno)
+      continue;
+
+    if (entry->offset >= *begin && entry->next_offset <= *end)
+      before = entry;
+    break;
+  }
+
+  /* first page at or after the target */
+  for (i = pos; i < index->len; i++) {
+    GstOggSeekEntry *entry = &g_array_index (index, GstOggSeekEntry, i);
+
+    if (only_serial_no && entry->serialno != serialno)
+      continue;
+
+    if (entry->offset >= *begin && entry->offset < *end)
+      after = entry;
+    break;
+  }
+
+  if (before && after && before->next_offset > after->offset) {
+    GST_DEBUG_OBJECT (chain->ogg, "pages around the target are not in file "
+        "order (%" G_GINT64_FORMAT " > %" G_GINT64_FORMAT "), not using index",
+        before->next_offset, after->offset);
+    return;
+  }
+
+  if (before) {
+    *best = before->offset;
+    *begin = before->next_offset;
+    *begintime = before->time;
+  }
+  if (after) {
+    *end = after->offset;
+    *endtime = after->time;
+  }
+
+  GST_DEBUG_OBJECT (chain->ogg, "index narrowed search to %" G_GINT64_FORMAT
+      " - %" G_GINT64_FORMAT, *begin, *end);
+}
+
 /* signals and args */
 enum
 {
@@ -2548,6 +2723,9 @@ gst_ogg_demux_submit_buffer (GstOggDemux * ogg, GstBuffer * buffer)
   if (G_UNLIKELY (size == 0))
     goto done;
 
+  /* the sync layer might move its data around now */
+  gst_buffer_replace (&ogg->sync_input, NULL);
+
   oggbuffer = ogg_sync_buffer (&ogg->sync, size);
   if (G_UNLIKELY (oggbuffer == NULL))
     goto no_buffer;
@@ -2557,6 +2735,9 @@ gst_ogg_demux_submit_buffer (GstOggDemux * ogg, GstBuffer * buffer)
   if (G_UNLIKELY (ogg_sync_wrote (&ogg->sync, size) < 0))
     goto write_failed;
 
+  gst_buffer_replace (&ogg->sync_input, buffer);
+  ogg->sync_input_data = (const guint8 *) oggbuffer;
+
   if (!ogg->pullmode) {
     GST_PUSH_LOCK (ogg);
     ogg->push_byte_offset += size;
@@ -2620,6 +2801,8 @@ gst_ogg_demux_get_data (GstOggDemux * ogg, gint64 end_offset)
   if (ogg->read_offset == ogg->length)
     goto eos;
 
+  gst_buffer_replace (&ogg->sync_input, NULL);
+
   oggbuffer = ogg_sync_buffer (&ogg->sync, ogg->chunk_size);
   if (G_UNLIKELY (oggbuffer == NULL))
     goto no_buffer;
@@ -3101,6 +3284,9 @@ do_binary_search (GstOggDemux * ogg, GstOggChain * chain, gint64 begin,
 
   best = begin;
 
+  gst_ogg_chain_search_seek_index (chain, target, only_serial_no, serialno,
+      &begin, &end, &begintime, &endtime, &best);
+
   GST_DEBUG_OBJECT (ogg,
       "chain offset %" G_GINT64_FORMAT ", end offset %" G_GINT64_FORMAT,
       begin, end);
@@ -3162,6 +3348,7 @@ do_binary_search (GstOggDemux * ogg, GstOggChain * chain, gint64 begin,
         /* get the granulepos */
         GST_LOG_OBJECT (ogg, "found next ogg page at %" G_GINT64_FORMAT,
             result);
+        gst_ogg_chain_index_page (chain, &og, result, ogg->offset);
         granulepos = ogg_page_granulepos (&og);
         if (granulepos == -1) {
           GST_LOG_OBJECT (ogg, "granulepos of next page is -1");
@@ -3373,6 +3560,8 @@ gst_ogg_demux_do_seek (GstOggDemux * ogg, GstSegment * segment,
     } else if (ret != GST_FLOW_OK)
       goto seek_error;
 
+    gst_ogg_chain_index_page (chain, &og, result, ogg->offset);
+
     /* get the stream */
     pad = gst_ogg_chain_get_stream (chain, ogg_page_serialno (&og));
     if (pad == NULL)
@@ -4704,12 +4893,23 @@ gst_ogg_demux_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
       /* discontinuity in the pages */
       GST_DEBUG_OBJECT (ogg, "discont in page found, continuing");
     } else {
+      if (ogg->pullmode && ogg->current_chain) {
+        /* everything up to ogg->offset went into the sync layer, what it
+         * did not return yet follows this page */
+        gint64 next_offset =
+            ogg->offset - (ogg->sync.fill - ogg->sync.returned);
+
+        gst_ogg_chain_index_page (ogg->current_chain, &page,
+            next_offset - page.header_len - page.body_len, next_offset);
+      }
       result = gst_ogg_demux_handle_page (ogg, &page, FALSE);
       if (result < 0) {
         GST_DEBUG_OBJECT (ogg, "gst_ogg_demux_handle_page returned %d", result);
       }
     }
   }
+  gst_buffer_replace (&ogg->sync_input, NULL);
+
   if (ret == 0 || result == GST_FLOW_OK) {
     gst_ogg_demux_sync_streams (ogg);
   }
@@ -4829,6 +5029,10 @@ gst_ogg_demux_loop_reverse (GstOggDemux * ogg)
 
   ogg->offset = offset;
 
+  if (ogg->current_chain)
+    gst_ogg_chain_index_page (ogg->current_chain, &page, offset,
+        offset + page.header_len + page.body_len);
+
   if (G_UNLIKELY (ogg->newsegment)) {
     gst_ogg_demux_send_event (ogg, ogg->newsegment);
     ogg->newsegment = NULL;
@@ -51,6 +51,17 @@ GType gst_ogg_demux_get_type (void);
 typedef struct _GstOggDemux GstOggDemux;
 typedef struct _GstOggDemuxClass GstOggDemuxClass;
 typedef struct _GstOggChain GstOggChain;
+typedef struct _GstOggSeekEntry GstOggSeekEntry;
+
+/* a page with a valid granulepos seen while playing or seeking, used to
+ * narrow down or avoid the bisection on later seeks */
+struct _GstOggSeekEntry
+{
+  GstClockTime time;            /* end time of the page in the stream */
+  gint64 offset;                /* offset of the page */
+  gint64 next_offset;           /* offset right after the page */
+  guint32 serialno;
+};
 
 /* all information needed for one ogg chain (relevant for chained bitstreams) */
 struct _GstOggChain
@@ -73,6 +84,8 @@ struct _GstOggChain
                                    the start times of all streams. */
   GstClockTime segment_stop;    /* the timestamp of the last page, this is the MAX of the
                                    streams. */
+
+  GArray *seek_index;           /* GstOggSeekEntry sorted by time and offset */
 };
 
 /* all information needed for one ogg stream */
@@ -102,6 +115,13 @@ struct _GstOggPad
 
   GList *continued;
 
+  /* input memory of the page being submitted and where its body ended up in
+   * the stream layer, packets inside it are output without copying */
+  GstBuffer *page_buffer;
+  gsize page_buffer_offset;
+  const guint8 *page_body;
+  glong page_body_len;
+
   gboolean discont;
   GstFlowReturn last_ret;       /* last return of _pad_push() */
   gboolean is_eos;
@@ -203,6 +223,11 @@ struct _GstOggDemux
   ogg_sync_state sync;
   long chunk_size;
 
+  /* the buffer last written into the sync layer and its data in there,
+   * only set while its pages are handled */
+  GstBuffer *sync_input;
+  const guint8 *sync_input_data;
+
   /* Seek events set up by the streaming thread */
   GstEvent *seek_event;
   GThread *seek_event_thread;
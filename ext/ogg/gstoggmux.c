@@ -70,6 +70,7 @@ GST_DEBUG_CATEGORY_STATIC (gst_ogg_mux_debug);
 #define DEFAULT_MAX_PAGE_DELAY  G_GINT64_CONSTANT(500000000)
 #define DEFAULT_MAX_TOLERANCE   G_GINT64_CONSTANT(40000000)
 #define DEFAULT_SKELETON        FALSE
+#define DEFAULT_MAX_QUEUE_TIME  G_GUINT64_CONSTANT(0)
 
 enum
 {
@@ -77,7 +78,8 @@ enum
   ARG_MAX_DELAY,
   ARG_MAX_PAGE_DELAY,
   ARG_MAX_TOLERANCE,
-  ARG_SKELETON
+  ARG_SKELETON,
+  ARG_MAX_QUEUE_TIME
 };
 
 static GstStaticPadTemplate src_factory = GST_STATIC_PAD_TEMPLATE ("src",
@@ -188,6 +190,23 @@ gst_ogg_mux_class_init (GstOggMuxClass * klass)
           DEFAULT_SKELETON,
           (GParamFlags) G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstOggMux:max-queue-time:
+   *
+   * Maximum time span of the pages queued for interleaving. Pages are only
+   * output in time order once every stream has a page queued, so a stream
+   * that produces pages rarely makes the queues of all other streams grow.
+   * When the queued pages span more than this, the oldest page is output
+   * anyway. 0 means no limit.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, ARG_MAX_QUEUE_TIME,
+      g_param_spec_uint64 ("max-queue-time", "Max queue time",
+          "Maximum time span of queued pages before the oldest is output "
+          "(0 = unlimited)", 0, G_MAXUINT64, DEFAULT_MAX_QUEUE_TIME,
+          (GParamFlags) G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state = gst_ogg_mux_change_state;
 
 }
@@ -229,6 +248,7 @@ gst_ogg_mux_init (GstOggMux * ogg_mux)
   ogg_mux->max_delay = DEFAULT_MAX_DELAY;
   ogg_mux->max_page_delay = DEFAULT_MAX_PAGE_DELAY;
   ogg_mux->max_tolerance = DEFAULT_MAX_TOLERANCE;
+  ogg_mux->max_queue_time = DEFAULT_MAX_QUEUE_TIME;
 
   gst_ogg_mux_clear (ogg_mux);
 }
@@ -592,9 +612,117 @@ gst_ogg_mux_push_buffer (GstOggMux * mux, GstBuffer * buffer,
   GST_LOG_OBJECT (mux->srcpad, "pushing %p, last_ts=%" GST_TIME_FORMAT,
       buffer, GST_TIME_ARGS (mux->last_ts));
 
+  if (mux->pending_pages) {
+    gst_buffer_list_add (mux->pending_pages, buffer);
+    return GST_FLOW_OK;
+  }
+
   return gst_pad_push (mux->srcpad, buffer);
 }
 
+/* push the pages collected by gst_ogg_mux_push_buffer() in one go */
+static GstFlowReturn
+gst_ogg_mux_push_pending_pages (GstOggMux * mux)
+{
+  GstBufferList *list = mux->pending_pages;
+  GstBuffer *buffer;
+
+  mux->pending_pages = NULL;
+
+  switch (gst_buffer_list_length (list)) {
+    case 0:
+      gst_buffer_list_unref (list);
+      return GST_FLOW_OK;
+    case 1:
+      buffer = gst_buffer_ref (gst_buffer_list_get (list, 0));
+      gst_buffer_list_unref (list);
+      return gst_pad_push (mux->srcpad, buffer);
+    default:
+      GST_LOG_OBJECT (mux->srcpad, "pushing list of %u pages",
+          gst_buffer_list_length (list));
+      return gst_pad_push_list (mux->srcpad, list);
+  }
+}
+
+/* time of the first page with a granulepos queued on @pad */
+static GstClockTime
+gst_ogg_mux_queue_head_time (GstOggPadData * pad)
+{
+  GList *l;
+
+  for (l = pad->pagebuffers->head; l != NULL; l = l->next) {
+    GstBuffer *buf = l->data;
+
+    if (GST_BUFFER_OFFSET_END_IS_VALID (buf))
+      return GST_BUFFER_OFFSET (buf);
+  }
+  return GST_CLOCK_TIME_NONE;
+}
+
+/* time of the last page with a granulepos queued on @pad */
+static GstClockTime
+gst_ogg_mux_queue_tail_time (GstOggPadData * pad)
+{
+  GList *l;
+
+  for (l = pad->pagebuffers->tail; l != NULL; l = l->prev) {
+    GstBuffer *buf = l->data;
+
+    if (GST_BUFFER_OFFSET_END_IS_VALID (buf))
+      return GST_BUFFER_OFFSET (buf);
+  }
+  return GST_CLOCK_TIME_NONE;
+}
+
+/* some queue has no page to decide on the interleaving yet. If the pages
+ * queued on the other pads span more than max-queue-time, push the oldest
+ * one (and the pages without granulepos in front of it) anyway */
+static gboolean
+gst_ogg_mux_dequeue_overflow_page (GstOggMux * mux, GstFlowReturn * flowret)
+{
+  GSList *walk;
+  GstOggPadData *opad = NULL;
+  GstClockTime oldest = GST_CLOCK_TIME_NONE;
+  GstClockTime newest = GST_CLOCK_TIME_NONE;
+  GstBuffer *buf;
+  gboolean last;
+
+  if (mux->max_queue_time == 0)
+    return FALSE;
+
+  for (walk = mux->collect->data; walk; walk = g_slist_next (walk)) {
+    GstOggPadData *pad = (GstOggPadData *) walk->data;
+    GstClockTime head, tail;
+
+    head = gst_ogg_mux_queue_head_time (pad);
+    if (head == GST_CLOCK_TIME_NONE)
+      continue;
+    tail = gst_ogg_mux_queue_tail_time (pad);
+
+    if (oldest == GST_CLOCK_TIME_NONE || head < oldest) {
+      oldest = head;
+      opad = pad;
+    }
+    if (newest == GST_CLOCK_TIME_NONE || tail > newest)
+      newest = tail;
+  }
+
+  if (opad == NULL || newest - oldest <= mux->max_queue_time)
+    return FALSE;
+
+  GST_DEBUG_OBJECT (opad->collect.pad, "queued pages span %" GST_TIME_FORMAT
+      ", pushing page with gp time %" GST_TIME_FORMAT,
+      GST_TIME_ARGS (newest - oldest), GST_TIME_ARGS (oldest));
+
+  do {
+    buf = g_queue_pop_head (opad->pagebuffers);
+    last = GST_BUFFER_OFFSET_END_IS_VALID (buf);
+    *flowret = gst_ogg_mux_push_buffer (mux, buf, opad);
+  } while (!last && *flowret == GST_FLOW_OK);
+
+  return TRUE;
+}
+
 /* if all queues have at least one page, dequeue the page with the lowest
  * timestamp */
 static gboolean
@@ -623,7 +751,7 @@ gst_ogg_mux_dequeue_page (GstOggMux * mux, GstFlowReturn * flowret)
       } else {
         GST_LOG_OBJECT (pad->collect.pad,
             "no pages in this queue, can't dequeue");
-        return FALSE;
+        return gst_ogg_mux_dequeue_overflow_page (mux, flowret);
       }
     } else {
       /* We then need to check for a non-negative granulepos */
@@ -642,7 +770,7 @@ gst_ogg_mux_dequeue_page (GstOggMux * mux, GstFlowReturn * flowret)
       if (!valid) {
         GST_LOG_OBJECT (pad->collect.pad,
             "No page timestamps in queue, can't dequeue");
-        return FALSE;
+        return gst_ogg_mux_dequeue_overflow_page (mux, flowret);
       }
     }
 
@@ -717,7 +845,7 @@ static GstFlowReturn
 gst_ogg_mux_pad_queue_page (GstOggMux * mux, GstOggPadData * pad,
     ogg_page * page, gboolean delta)
 {
-  GstFlowReturn ret;
+  GstFlowReturn ret, flush_ret;
   GstBuffer *buffer = gst_ogg_mux_buffer_from_page (mux, page, delta);
 
   /* take the timestamp of the first packet on this page */
@@ -738,10 +866,15 @@ gst_ogg_mux_pad_queue_page (GstOggMux * mux, GstOggPadData * pad,
       GST_TIME_ARGS (GST_BUFFER_TIMESTAMP (buffer)),
       g_queue_get_length (pad->pagebuffers));
 
+  /* collect everything that can go out now and push it as one list */
+  mux->pending_pages = gst_buffer_list_new ();
   while (gst_ogg_mux_dequeue_page (mux, &ret)) {
     if (ret != GST_FLOW_OK)
       break;
   }
+  flush_ret = gst_ogg_mux_push_pending_pages (mux);
+  if (ret == GST_FLOW_OK)
+    ret = flush_ret;
 
   return ret;
 }
@@ -2117,6 +2250,9 @@ gst_ogg_mux_get_property (GObject * object,
     case ARG_SKELETON:
       g_value_set_boolean (value, ogg_mux->use_skeleton);
       break;
+    case ARG_MAX_QUEUE_TIME:
+      g_value_set_uint64 (value, ogg_mux->max_queue_time);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -2144,6 +2280,9 @@ gst_ogg_mux_set_property (GObject * object,
     case ARG_SKELETON:
       ogg_mux->use_skeleton = g_value_get_boolean (value);
       break;
+    case ARG_MAX_QUEUE_TIME:
+      ogg_mux->max_queue_time = g_value_get_uint64 (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -123,6 +123,10 @@ struct _GstOggMux
   guint64 max_delay;
   guint64 max_page_delay;
   guint64 max_tolerance;
+  guint64 max_queue_time;
+
+  /* pages dequeued in one go, pushed as a list */
+  GstBufferList *pending_pages;
 
   GstOggPadData *delta_pad;     /* when a delta frame is detected on a stream, we mark
                                    pages as delta frames up to the page that has the
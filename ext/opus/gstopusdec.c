@@ -168,6 +168,7 @@ gst_opus_dec_reset (GstOpusDec * dec)
     opus_multistream_decoder_destroy (dec->state);
     dec->state = NULL;
   }
+  dec->decoder_reorders = FALSE;
 
   gst_buffer_replace (&dec->streamheader, NULL);
   gst_buffer_replace (&dec->vorbiscomment, NULL);
@@ -458,6 +459,35 @@ packet_duration_opus (const unsigned char *data, size_t bytes)
   return duration / 48.f * 1000000;
 }
 
+/* Permutes the channel mapping table so that the decoder writes the
+ * channels in the order of the output format, which saves reordering
+ * every decoded buffer */
+static gboolean
+gst_opus_dec_get_reordered_mapping (GstOpusDec * dec, guint8 * mapping)
+{
+  gint reorder_map[64];
+  gint i;
+
+  if (dec->opus_pos[0] == GST_AUDIO_CHANNEL_POSITION_INVALID)
+    return FALSE;
+
+  if (dec->n_channels > G_N_ELEMENTS (reorder_map))
+    return FALSE;
+
+  if (memcmp (dec->opus_pos, dec->info.position,
+          sizeof (dec->opus_pos[0]) * dec->n_channels) == 0)
+    return FALSE;
+
+  if (!gst_audio_get_channel_reorder_map (dec->n_channels, dec->opus_pos,
+          dec->info.position, reorder_map))
+    return FALSE;
+
+  for (i = 0; i < dec->n_channels; i++)
+    mapping[reorder_map[i]] = dec->channel_mapping[i];
+
+  return TRUE;
+}
+
 static GstFlowReturn
 opus_dec_chain_parse_data (GstOpusDec * dec, GstBuffer * buffer)
 {
@@ -474,6 +504,9 @@ opus_dec_chain_parse_data (GstOpusDec * dec, GstBuffer * buffer)
   GstAudioClippingMeta *cmeta = NULL;
 
   if (dec->state == NULL) {
+    guint8 reordered_mapping[256];
+    const guint8 *mapping = dec->channel_mapping;
+
     /* If we did not get any headers, default to 2 channels */
     if (dec->n_channels == 0) {
       GST_INFO_OBJECT (dec, "No header, assuming single stream");
@@ -506,9 +539,21 @@ opus_dec_chain_parse_data (GstOpusDec * dec, GstBuffer * buffer)
 
     GST_DEBUG_OBJECT (dec, "%d streams, %d stereo", dec->n_streams,
         dec->n_stereo_streams);
+
+    dec->decoder_reorders =
+        gst_opus_dec_get_reordered_mapping (dec, reordered_mapping);
+    if (dec->decoder_reorders) {
+#ifndef GST_DISABLE_GST_DEBUG
+      gst_opus_common_log_channel_mapping_table (GST_ELEMENT (dec),
+          opusdec_debug, "Reordered mapping table", dec->n_channels,
+          reordered_mapping);
+#endif
+      mapping = reordered_mapping;
+    }
+
     dec->state =
         opus_multistream_decoder_create (dec->sample_rate, dec->n_channels,
-        dec->n_streams, dec->n_stereo_streams, dec->channel_mapping, &err);
+        dec->n_streams, dec->n_stereo_streams, mapping, &err);
     if (!dec->state || err != OPUS_OK)
       goto creation_failed;
 
@@ -733,7 +778,8 @@ opus_dec_chain_parse_data (GstOpusDec * dec, GstBuffer * buffer)
   if (gst_buffer_get_size (outbuf) == 0) {
     gst_buffer_unref (outbuf);
     outbuf = NULL;
-  } else if (dec->opus_pos[0] != GST_AUDIO_CHANNEL_POSITION_INVALID) {
+  } else if (!dec->decoder_reorders
+      && dec->opus_pos[0] != GST_AUDIO_CHANNEL_POSITION_INVALID) {
     gst_audio_buffer_reorder_channels (outbuf, GST_AUDIO_FORMAT_S16,
         dec->n_channels, dec->opus_pos, dec->info.position);
   }
@@ -59,6 +59,8 @@ struct _GstOpusDec {
 
   GstAudioChannelPosition opus_pos[64];
   GstAudioInfo info;
+  /* channel mapping of the decoder state puts out GStreamer order */
+  gboolean decoder_reorders;
 
   guint8 n_streams;
   guint8 n_stereo_streams;
@@ -308,6 +308,8 @@ static gboolean gst_base_text_overlay_can_handle_caps (GstCaps * incaps);
 
 static void
 gst_base_text_overlay_update_render_size (GstBaseTextOverlay * overlay);
+static void
+gst_base_text_overlay_clear_rendered_text (GstBaseTextOverlay * overlay);
 
 GType
 gst_base_text_overlay_get_type (void)
@@ -649,6 +651,8 @@ gst_base_text_overlay_finalize (GObject * object)
     overlay->text_image = NULL;
   }
 
+  gst_base_text_overlay_clear_rendered_text (overlay);
+
   if (overlay->layout) {
     g_object_unref (overlay->layout);
     overlay->layout = NULL;
@@ -1145,6 +1149,9 @@ gst_base_text_overlay_set_property (GObject * object, guint prop_id,
       break;
   }
 
+  /* colors, fonts etc. might have changed, draw everything again */
+  if (prop_id != PROP_TEXT)
+    gst_base_text_overlay_clear_rendered_text (overlay);
   overlay->need_render = TRUE;
   GST_BASE_TEXT_OVERLAY_UNLOCK (overlay);
 }
@@ -1655,9 +1662,10 @@ gst_base_text_overlay_set_composition (GstBaseTextOverlay * overlay)
         overlay->text_width, overlay->text_height, render_width,
         render_height, xpos, ypos);
 
-    gst_buffer_add_video_meta (overlay->text_image, GST_VIDEO_FRAME_FLAG_NONE,
-        GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB,
-        overlay->text_width, overlay->text_height);
+    if (!gst_buffer_get_video_meta (overlay->text_image))
+      gst_buffer_add_video_meta (overlay->text_image,
+          GST_VIDEO_FRAME_FLAG_NONE, GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB,
+          overlay->text_width, overlay->text_height);
 
     rectangle = gst_video_overlay_rectangle_new_raw (overlay->text_image,
         xpos, ypos, render_width, render_height,
@@ -1693,6 +1701,114 @@ gst_text_overlay_filter_foreground_attr (PangoAttribute * attr, gpointer data)
   }
 }
 
+static void
+gst_base_text_overlay_clear_rendered_text (GstBaseTextOverlay * overlay)
+{
+  g_free (overlay->rendered_text);
+  overlay->rendered_text = NULL;
+  g_free (overlay->rendered_pos);
+  overlay->rendered_pos = NULL;
+}
+
+/* Only short plain ASCII text on a single line is tracked, so that byte
+ * offsets are character offsets and the layout is left to right */
+#define MAX_TRACKED_TEXT_LEN 128
+
+static gboolean
+gst_base_text_overlay_is_trackable (GstBaseTextOverlay * overlay,
+    const gchar * string, gint textlen)
+{
+  gint i;
+
+  if (textlen == 0 || textlen > MAX_TRACKED_TEXT_LEN)
+    return FALSE;
+  if (overlay->use_vertical_render)
+    return FALSE;
+  if (pango_layout_get_line_count (overlay->layout) != 1)
+    return FALSE;
+
+  for (i = 0; i < textlen; i++) {
+    if (string[i] & 0x80 || string[i] == '<' || string[i] == '&')
+      return FALSE;
+  }
+  return TRUE;
+}
+
+/* remember what was drawn into text_image */
+static void
+gst_base_text_overlay_store_rendered_text (GstBaseTextOverlay * overlay,
+    const gchar * string, gint textlen, const cairo_matrix_t * matrix)
+{
+  PangoRectangle pos;
+  gint i;
+
+  gst_base_text_overlay_clear_rendered_text (overlay);
+
+  if (!gst_base_text_overlay_is_trackable (overlay, string, textlen))
+    return;
+
+  overlay->rendered_text = g_strndup (string, textlen);
+  overlay->rendered_pos = g_new (gint, textlen + 1);
+  for (i = 0; i < textlen; i++) {
+    pango_layout_index_to_pos (overlay->layout, i, &pos);
+    overlay->rendered_pos[i] = pos.x;
+  }
+  overlay->rendered_pos[textlen] = pos.x + pos.width;
+  overlay->rendered_matrix = *matrix;
+}
+
+/* Check if @string can be drawn by only redrawing the area of the characters
+ * that differ from the previously rendered text. That is the case when the
+ * image has the same size and placement and the unchanged characters did not
+ * move. On success, @x0 and @x1 are set to the horizontal range of the
+ * changed characters in layout pixels, which is empty if nothing changed. */
+static gboolean
+gst_base_text_overlay_get_damage (GstBaseTextOverlay * overlay,
+    const gchar * string, gint textlen, const cairo_matrix_t * matrix,
+    gint width, gint height, gdouble * x0, gdouble * x1)
+{
+  const cairo_matrix_t *prev_matrix = &overlay->rendered_matrix;
+  PangoRectangle first_pos, last_pos;
+  gint i, first = -1, last = -1;
+
+  if (overlay->text_image == NULL || overlay->rendered_text == NULL)
+    return FALSE;
+  if (width != (gint) overlay->text_width
+      || height != (gint) overlay->text_height)
+    return FALSE;
+  if (matrix->xx != prev_matrix->xx || matrix->yx != prev_matrix->yx ||
+      matrix->xy != prev_matrix->xy || matrix->yy != prev_matrix->yy ||
+      matrix->x0 != prev_matrix->x0 || matrix->y0 != prev_matrix->y0)
+    return FALSE;
+  if (strlen (overlay->rendered_text) != (gsize) textlen ||
+      !gst_base_text_overlay_is_trackable (overlay, string, textlen))
+    return FALSE;
+
+  for (i = 0; i < textlen; i++) {
+    if (string[i] != overlay->rendered_text[i]) {
+      if (first < 0)
+        first = i;
+      last = i;
+    }
+  }
+
+  if (first < 0) {
+    *x0 = *x1 = 0;
+    return TRUE;
+  }
+
+  pango_layout_index_to_pos (overlay->layout, first, &first_pos);
+  pango_layout_index_to_pos (overlay->layout, last, &last_pos);
+  if (first_pos.x != overlay->rendered_pos[first] ||
+      last_pos.x + last_pos.width != overlay->rendered_pos[last + 1])
+    return FALSE;
+
+  *x0 = (gdouble) first_pos.x / PANGO_SCALE;
+  *x1 = (gdouble) (last_pos.x + last_pos.width) / PANGO_SCALE;
+
+  return TRUE;
+}
+
 static void
 gst_base_text_overlay_render_pangocairo (GstBaseTextOverlay * overlay,
     const gchar * string, gint textlen)
@@ -1711,6 +1827,8 @@ gst_base_text_overlay_render_pangocairo (GstBaseTextOverlay * overlay,
   gint xpad = 0, ypad = 0;
   GstBuffer *buffer;
   GstMapInfo map;
+  gboolean partial;
+  gdouble damage_x0 = 0, damage_x1 = 0;
 
   if (overlay->auto_adjust_size) {
     /* 640 pixel is default */
@@ -1920,25 +2038,62 @@ gst_base_text_overlay_render_pangocairo (GstBaseTextOverlay * overlay,
       ceil (outline_offset / 2.0l) - ink_rect.x,
       ceil (outline_offset / 2.0l) - ink_rect.y);
 
-  /* reallocate overlay buffer */
+  partial = gst_base_text_overlay_get_damage (overlay, string, textlen,
+      &cairo_matrix, width, height, &damage_x0, &damage_x1);
+
+  if (partial && damage_x0 == damage_x1) {
+    GST_DEBUG_OBJECT (overlay, "Text unchanged, reusing previous image");
+    gst_base_text_overlay_set_composition (overlay);
+    return;
+  }
+
+  /* reallocate overlay buffer, the previous one might still be in use
+   * downstream */
   buffer = gst_buffer_new_and_alloc (4 * width * height);
+  gst_buffer_map (buffer, &map, GST_MAP_READWRITE);
+  if (partial)
+    gst_buffer_extract (overlay->text_image, 0, map.data, map.size);
   gst_buffer_replace (&overlay->text_image, buffer);
   gst_buffer_unref (buffer);
 
-  gst_buffer_map (buffer, &map, GST_MAP_READWRITE);
   surface = cairo_image_surface_create_for_data (map.data,
       CAIRO_FORMAT_ARGB32, width, height, width * 4);
   cr = cairo_create (surface);
 
+  /* apply transformations */
+  cairo_set_matrix (cr, &cairo_matrix);
+
+  if (partial) {
+    gdouble margin, y0, y1;
+
+    /* changed glyphs might overhang their logical extents, and shadow and
+     * outline go beyond the glyphs */
+    margin = logical_rect.height / 2.0 + outline_offset;
+    damage_x0 -= margin;
+    damage_x1 += margin + shadow_offset;
+    y0 = ink_rect.y - outline_offset;
+    y1 = ink_rect.y + unscaled_height + outline_offset;
+
+    GST_DEBUG_OBJECT (overlay, "Redrawing text between %f and %f", damage_x0,
+        damage_x1);
+
+    /* clip on whole pixels, so that the pixels around the damaged area
+     * stay untouched */
+    cairo_user_to_device (cr, &damage_x0, &y0);
+    cairo_user_to_device (cr, &damage_x1, &y1);
+    cairo_identity_matrix (cr);
+    cairo_rectangle (cr, floor (damage_x0), floor (y0),
+        ceil (damage_x1) - floor (damage_x0), ceil (y1) - floor (y0));
+    cairo_clip (cr);
+    cairo_set_matrix (cr, &cairo_matrix);
+  }
+
   /* clear surface */
   cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
   cairo_paint (cr);
 
   cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
 
-  /* apply transformations */
-  cairo_set_matrix (cr, &cairo_matrix);
-
   /* FIXME: We use show_layout everywhere except for the surface
    * because it's really faster and internally does all kinds of
    * caching. Unfortunately we have to paint to a cairo path for
@@ -2011,6 +2166,9 @@ gst_base_text_overlay_render_pangocairo (GstBaseTextOverlay * overlay,
   if (height != 0)
     overlay->text_height = height;
 
+  gst_base_text_overlay_store_rendered_text (overlay, string, textlen,
+      &cairo_matrix);
+
   gst_base_text_overlay_set_composition (overlay);
 }
 
@@ -200,6 +200,13 @@ struct _GstBaseTextOverlay {
     gboolean                 need_render;
     GstBuffer               *text_image;
 
+    /* plain text in text_image with the pango x position of each character
+     * and of its end, and the matrix it was drawn with. Used to only redraw
+     * the characters that changed */
+    gchar                   *rendered_text;
+    gint                    *rendered_pos;
+    cairo_matrix_t           rendered_matrix;
+
     /* dimension relative to witch the render is done, this is the stream size
      * or a portion of the window_size (adapted to aspect ratio) */
     gint                     render_width;
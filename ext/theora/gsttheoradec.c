@@ -111,6 +111,8 @@ static gboolean theora_dec_decide_allocation (GstVideoDecoder * decoder,
 
 static GstFlowReturn theora_dec_decode_buffer (GstTheoraDec * dec,
     GstBuffer * buf, GstVideoCodecFrame * frame);
+static void theora_dec_stripe_decoded (void *ctx, th_ycbcr_buffer buf,
+    int yfrag0, int yfrag_end);
 
 static gboolean
 gst_theora_dec_ctl_is_supported (int req)
@@ -488,6 +490,19 @@ theora_handle_type_packet (GstTheoraDec * dec)
     GST_WARNING_OBJECT (dec, "Could not enable BITS mode visualisation");
   }
 
+  /* telemetry is only drawn by th_decode_ycbcr_out(), otherwise have the
+   * image copied stripe by stripe while it is being decoded */
+  dec->use_stripes = FALSE;
+  if (!dec->telemetry_mv && !dec->telemetry_mbmode && !dec->telemetry_qi &&
+      !dec->telemetry_bits) {
+    th_stripe_callback cb;
+
+    cb.ctx = dec;
+    cb.stripe_decoded = theora_dec_stripe_decoded;
+    dec->use_stripes = th_decode_ctl (dec->decoder, TH_DECCTL_SET_STRIPE_CB,
+        &cb, sizeof (cb)) == 0;
+  }
+
   /* Create the output state */
   dec->output_state = state =
       gst_video_decoder_set_output_state (GST_VIDEO_DECODER (dec), fmt,
@@ -641,19 +656,12 @@ null_buffer:
   }
 }
 
-/* Allocate buffer and copy image data into Y444 format */
+/* Allocate output buffer and map it for copying the image data into */
 static GstFlowReturn
-theora_handle_image (GstTheoraDec * dec, th_ycbcr_buffer buf,
-    GstVideoCodecFrame * frame)
+theora_dec_begin_image (GstTheoraDec * dec, GstVideoCodecFrame * frame)
 {
   GstVideoDecoder *decoder = GST_VIDEO_DECODER (dec);
-  gint width, height, stride;
   GstFlowReturn result;
-  gint i, comp;
-  guint8 *dest, *src;
-  GstVideoFrame vframe;
-  gint pic_width, pic_height;
-  gint offset_x, offset_y;
 
   result = gst_video_decoder_allocate_output_frame (decoder, frame);
 
@@ -665,23 +673,23 @@ theora_handle_image (GstTheoraDec * dec, th_ycbcr_buffer buf,
 
   if (!dec->can_crop) {
     /* we need to crop the hard way */
-    offset_x = dec->info.pic_x;
-    offset_y = dec->info.pic_y;
-    pic_width = dec->info.pic_width;
-    pic_height = dec->info.pic_height;
+    dec->out_x = dec->info.pic_x;
+    dec->out_y = dec->info.pic_y;
+    dec->out_width = dec->info.pic_width;
+    dec->out_height = dec->info.pic_height;
     /* Ensure correct offsets in chroma for formats that need it
      * by rounding the offset. libtheora will add proper pixels,
      * so no need to handle them ourselves. */
-    if (offset_x & 1 && dec->info.pixel_fmt != TH_PF_444)
-      offset_x--;
-    if (offset_y & 1 && dec->info.pixel_fmt == TH_PF_420)
-      offset_y--;
+    if (dec->out_x & 1 && dec->info.pixel_fmt != TH_PF_444)
+      dec->out_x--;
+    if (dec->out_y & 1 && dec->info.pixel_fmt == TH_PF_420)
+      dec->out_y--;
   } else {
     /* copy the whole frame */
-    offset_x = 0;
-    offset_y = 0;
-    pic_width = dec->info.frame_width;
-    pic_height = dec->info.frame_height;
+    dec->out_x = 0;
+    dec->out_y = 0;
+    dec->out_width = dec->info.frame_width;
+    dec->out_height = dec->info.frame_height;
 
     if (dec->info.pic_width != dec->info.frame_width ||
         dec->info.pic_height != dec->info.frame_height ||
@@ -716,43 +724,96 @@ theora_handle_image (GstTheoraDec * dec, th_ycbcr_buffer buf,
     }
   }
 
-  /* if only libtheora would allow us to give it a destination frame */
-  GST_CAT_TRACE_OBJECT (CAT_PERFORMANCE, dec,
-      "doing unavoidable video frame copy");
-
-  if (G_UNLIKELY (!gst_video_frame_map (&vframe, &dec->uncropped_info,
+  if (G_UNLIKELY (!gst_video_frame_map (&dec->vframe, &dec->uncropped_info,
               frame->output_buffer, GST_MAP_WRITE)))
     goto invalid_frame;
 
+  dec->vframe_mapped = TRUE;
+  dec->stripes_done = FALSE;
+
+  return GST_FLOW_OK;
+
+invalid_frame:
+  {
+    GST_DEBUG_OBJECT (dec, "could not map video frame");
+    return GST_FLOW_ERROR;
+  }
+}
+
+static void
+theora_dec_end_image (GstTheoraDec * dec)
+{
+  if (dec->vframe_mapped) {
+    gst_video_frame_unmap (&dec->vframe);
+    dec->vframe_mapped = FALSE;
+  }
+}
+
+/* Copy the luma rows [y0, y1) of the decoded frame, and the chroma rows
+ * belonging to them, into the mapped output frame */
+static void
+theora_dec_copy_rows (GstTheoraDec * dec, th_ycbcr_buffer buf, gint y0,
+    gint y1)
+{
+  GstVideoFrame *vframe = &dec->vframe;
+  gint width, height, stride;
+  gint i, comp, first, last;
+  guint8 *dest, *src;
+
   for (comp = 0; comp < 3; comp++) {
+    gint x_shift, y_shift;
+
     width =
-        GST_VIDEO_FORMAT_INFO_SCALE_WIDTH (vframe.info.finfo, comp, pic_width);
+        GST_VIDEO_FORMAT_INFO_SCALE_WIDTH (vframe->info.finfo, comp,
+        dec->out_width);
     height =
-        GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT (vframe.info.finfo, comp,
-        pic_height);
-    stride = GST_VIDEO_FRAME_COMP_STRIDE (&vframe, comp);
-    dest = GST_VIDEO_FRAME_COMP_DATA (&vframe, comp);
+        GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT (vframe->info.finfo, comp,
+        dec->out_height);
+    x_shift = (width == dec->out_width) ? 0 : 1;
+    y_shift = (height == dec->out_height) ? 0 : 1;
+
+    /* rows of this component in output frame coordinates */
+    first = MAX ((y0 >> y_shift) - (dec->out_y >> y_shift), 0);
+    last = MIN ((y1 >> y_shift) - (dec->out_y >> y_shift), height);
+    if (first >= last)
+      continue;
+
+    stride = GST_VIDEO_FRAME_COMP_STRIDE (vframe, comp);
+    dest = GST_VIDEO_FRAME_COMP_DATA (vframe, comp);
+    dest += first * stride;
 
     src = buf[comp].data;
-    src += ((height == pic_height) ? offset_y : offset_y / 2)
-        * buf[comp].stride;
-    src += (width == pic_width) ? offset_x : offset_x / 2;
+    src += ((dec->out_y >> y_shift) + first) * buf[comp].stride;
+    src += dec->out_x >> x_shift;
 
-    for (i = 0; i < height; i++) {
+    for (i = first; i < last; i++) {
       memcpy (dest, src, width);
 
       dest += stride;
       src += buf[comp].stride;
     }
   }
-  gst_video_frame_unmap (&vframe);
+}
 
-  return GST_FLOW_OK;
-invalid_frame:
-  {
-    GST_DEBUG_OBJECT (dec, "could not map video frame");
-    return GST_FLOW_ERROR;
-  }
+/* Called by libtheora from th_decode_packetin() for every completed (and
+ * post-processed) stripe of fragment rows, bottom to top, so the data is
+ * copied while it is still in the cache */
+static void
+theora_dec_stripe_decoded (void *ctx, th_ycbcr_buffer buf, int yfrag0,
+    int yfrag_end)
+{
+  GstTheoraDec *dec = ctx;
+
+  if (!dec->vframe_mapped)
+    return;
+
+  GST_CAT_TRACE_OBJECT (CAT_PERFORMANCE, dec,
+      "copying decoded fragment rows %d to %d", yfrag0, yfrag_end);
+
+  theora_dec_copy_rows (dec, buf, yfrag0 * 8, yfrag_end * 8);
+
+  if (yfrag0 == 0)
+    dec->stripes_done = TRUE;
 }
 
 static GstFlowReturn
@@ -764,6 +825,7 @@ theora_handle_data_packet (GstTheoraDec * dec, ogg_packet * packet,
   gboolean keyframe;
   GstFlowReturn result;
   ogg_int64_t gp;
+  gboolean late;
 
   if (G_UNLIKELY (!dec->have_header)) {
     result = theoradec_handle_header_caps (dec);
@@ -783,15 +845,34 @@ theora_handle_data_packet (GstTheoraDec * dec, ogg_packet * packet,
 
   GST_DEBUG_OBJECT (dec, "parsing data packet");
 
-  /* this does the decoding */
+  late = frame &&
+      (gst_video_decoder_get_max_decode_time (GST_VIDEO_DECODER (dec),
+          frame) < 0);
+
+  /* have the output frame ready, so that the stripe callback can fill it
+   * while decoding */
+  result = GST_FLOW_OK;
+  if (dec->use_stripes && frame && !late)
+    result = theora_dec_begin_image (dec, frame);
+
+  /* this does the decoding, which has to happen in any case to keep the
+   * reference frames intact */
   if (G_UNLIKELY (th_decode_packetin (dec->decoder, packet, &gp) < 0))
     goto decode_error;
 
-  if (frame &&
-      (gst_video_decoder_get_max_decode_time (GST_VIDEO_DECODER (dec),
-              frame) < 0))
+  if (G_UNLIKELY (result != GST_FLOW_OK))
+    return result;
+
+  if (late)
     goto dropping_qos;
 
+  /* all done already, unless the frame was a duplicate of the previous one
+   * for which libtheora does not invoke the stripe callback */
+  if (dec->vframe_mapped && dec->stripes_done) {
+    theora_dec_end_image (dec);
+    return GST_FLOW_OK;
+  }
+
   /* this does postprocessing and set up the decoded frame
    * pointers in our yuv variable */
   if (G_UNLIKELY (th_decode_ycbcr_out (dec->decoder, buf) < 0))
@@ -801,9 +882,18 @@ theora_handle_data_packet (GstTheoraDec * dec, ogg_packet * packet,
           || (buf[0].height != dec->info.frame_height)))
     goto wrong_dimensions;
 
-  result = theora_handle_image (dec, buf, frame);
+  if (!dec->vframe_mapped) {
+    result = theora_dec_begin_image (dec, frame);
+    if (G_UNLIKELY (result != GST_FLOW_OK))
+      return result;
+  }
 
-  return result;
+  GST_CAT_TRACE_OBJECT (CAT_PERFORMANCE, dec, "copying whole video frame");
+
+  theora_dec_copy_rows (dec, buf, 0, dec->info.frame_height);
+  theora_dec_end_image (dec);
+
+  return GST_FLOW_OK;
 
   /* ERRORS */
 not_initialized:
@@ -824,18 +914,21 @@ dropping_qos:
   }
 decode_error:
   {
+    theora_dec_end_image (dec);
     GST_ELEMENT_ERROR (GST_ELEMENT (dec), STREAM, DECODE,
         (NULL), ("theora decoder did not decode data packet"));
     return GST_FLOW_ERROR;
   }
 no_yuv:
   {
+    theora_dec_end_image (dec);
     GST_ELEMENT_ERROR (GST_ELEMENT (dec), STREAM, DECODE,
         (NULL), ("couldn't read out YUV image"));
     return GST_FLOW_ERROR;
   }
 wrong_dimensions:
   {
+    theora_dec_end_image (dec);
     GST_ELEMENT_ERROR (GST_ELEMENT (dec), STREAM, FORMAT,
         (NULL), ("dimensions of image do not match header"));
     return GST_FLOW_ERROR;
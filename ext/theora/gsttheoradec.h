@@ -78,6 +78,13 @@ struct _GstTheoraDec
 
   gboolean can_crop;
   GstVideoInfo uncropped_info;
+
+  /* output frame filled by the stripe callback while decoding */
+  gboolean use_stripes;
+  GstVideoFrame vframe;
+  gboolean vframe_mapped;
+  gboolean stripes_done;
+  gint out_x, out_y, out_width, out_height;
 };
 
 struct _GstTheoraDecClass
@@ -96,7 +96,9 @@
  * small(er) buffers being pushed and processed downstream. Note that this
  * feature is only available if the buffer layout is interleaved. For planar
  * buffers, the decoder implementation is fully responsible for the output
- * buffer size.
+ * buffer size. The same aggregation is used for the frames decoded from an
+ * upstream #GstBufferList, which are pushed downstream as one buffer once the
+ * whole list has been handled, also in live pipelines.
  *
  * On the other hand, it should be noted that baseclass only provides limited
  * seeking support (upon explicit subclass request), as full-fledged support
@@ -182,6 +184,10 @@ typedef struct _GstAudioDecoderContext
 
   GstAllocator *allocator;
   GstAllocationParams params;
+
+  /* output buffer pool, sized to the largest requested output buffer */
+  GstBufferPool *pool;
+  gsize pool_size;
 } GstAudioDecoderContext;
 
 struct _GstAudioDecoderPrivate
@@ -245,6 +251,11 @@ struct _GstAudioDecoderPrivate
 
   /* whether circumstances allow output aggregation */
   gint agg;
+  /* TRUE while handling the buffers of an input buffer list */
+  gboolean batch;
+
+  /* empty input buffer handed to the subclass for concealment */
+  GstBuffer *plc_buffer;
 
   /* reverse playback queues */
   /* collect input */
@@ -295,6 +306,8 @@ static gboolean gst_audio_decoder_sink_setcaps (GstAudioDecoder * dec,
     GstCaps * caps);
 static GstFlowReturn gst_audio_decoder_chain (GstPad * pad, GstObject * parent,
     GstBuffer * buf);
+static GstFlowReturn gst_audio_decoder_chain_list (GstPad * pad,
+    GstObject * parent, GstBufferList * list);
 static gboolean gst_audio_decoder_src_query (GstPad * pad, GstObject * parent,
     GstQuery * query);
 static gboolean gst_audio_decoder_sink_query (GstPad * pad, GstObject * parent,
@@ -445,6 +458,8 @@ gst_audio_decoder_init (GstAudioDecoder * dec, GstAudioDecoderClass * klass)
       GST_DEBUG_FUNCPTR (gst_audio_decoder_sink_event));
   gst_pad_set_chain_function (dec->sinkpad,
       GST_DEBUG_FUNCPTR (gst_audio_decoder_chain));
+  gst_pad_set_chain_list_function (dec->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_audio_decoder_chain_list));
   gst_pad_set_query_function (dec->sinkpad,
       GST_DEBUG_FUNCPTR (gst_audio_decoder_sink_query));
   gst_element_add_pad (GST_ELEMENT (dec), dec->sinkpad);
@@ -483,6 +498,19 @@ gst_audio_decoder_init (GstAudioDecoder * dec, GstAudioDecoderClass * klass)
   GST_DEBUG_OBJECT (dec, "init ok");
 }
 
+static void
+gst_audio_decoder_clear_pool (GstAudioDecoder * dec)
+{
+  GstAudioDecoderContext *ctx = &dec->priv->ctx;
+
+  if (ctx->pool) {
+    gst_buffer_pool_set_active (ctx->pool, FALSE);
+    gst_object_unref (ctx->pool);
+    ctx->pool = NULL;
+  }
+  ctx->pool_size = 0;
+}
+
 static void
 gst_audio_decoder_reset (GstAudioDecoder * dec, gboolean full)
 {
@@ -521,6 +549,8 @@ gst_audio_decoder_reset (GstAudioDecoder * dec, gboolean full)
 
     if (dec->priv->ctx.allocator)
       gst_object_unref (dec->priv->ctx.allocator);
+    gst_audio_decoder_clear_pool (dec);
+    gst_buffer_replace (&dec->priv->plc_buffer, NULL);
 
     GST_OBJECT_LOCK (dec);
     dec->priv->decode_flags_override = FALSE;
@@ -568,6 +598,8 @@ gst_audio_decoder_finalize (GObject * object)
   if (dec->priv->adapter_out) {
     g_object_unref (dec->priv->adapter_out);
   }
+  gst_audio_decoder_clear_pool (dec);
+  gst_buffer_replace (&dec->priv->plc_buffer, NULL);
 
   g_rec_mutex_clear (&dec->stream_lock);
 
@@ -707,6 +739,9 @@ gst_audio_decoder_negotiate_default (GstAudioDecoder * dec)
   dec->priv->ctx.allocator = allocator;
   dec->priv->ctx.params = params;
 
+  /* recreated with the new allocator on the next allocation */
+  gst_audio_decoder_clear_pool (dec);
+
 done:
 
   if (query)
@@ -1021,7 +1056,7 @@ exit:
 }
 
 /* mini aggregator combining output buffers into fewer larger ones,
- * if so allowed/configured */
+ * if so allowed/configured, or for the duration of an input buffer list */
 static GstFlowReturn
 gst_audio_decoder_output (GstAudioDecoder * dec, GstBuffer * buf)
 {
@@ -1044,7 +1079,7 @@ gst_audio_decoder_output (GstAudioDecoder * dec, GstBuffer * buf)
 
 again:
   inbuf = NULL;
-  if (priv->agg && dec->priv->latency > 0 &&
+  if (((priv->agg && dec->priv->latency > 0) || priv->batch) &&
       priv->ctx.info.layout == GST_AUDIO_LAYOUT_INTERLEAVED) {
     gint av;
     gboolean assemble = FALSE;
@@ -1076,7 +1111,9 @@ again:
       av += gst_buffer_get_size (buf);
       buf = NULL;
     }
-    if (priv->out_dur > dec->priv->latency)
+    /* a batch is only assembled once the whole list was handled */
+    if (priv->out_dur > dec->priv->latency && (!priv->batch ||
+            (priv->agg && dec->priv->latency > 0)))
       assemble = TRUE;
     if (av && assemble) {
       GST_LOG_OBJECT (dec, "assembling fragment");
@@ -1342,6 +1379,16 @@ gst_audio_decoder_finish_frame_or_subframe (GstAudioDecoder * dec,
   GST_AUDIO_DECODER_STREAM_LOCK (dec);
 
   if (buf != NULL && priv->subframe_samples == 0) {
+    /* collected output must go out in the format it was decoded in */
+    if (G_UNLIKELY (ctx->output_format_changed &&
+            gst_adapter_available (priv->adapter_out))) {
+      ret = gst_audio_decoder_output (dec, NULL);
+      if (ret != GST_FLOW_OK) {
+        gst_buffer_unref (buf);
+        goto exit;
+      }
+    }
+
     ret = check_pending_reconfigure (dec);
     if (ret == GST_FLOW_FLUSHING || ret == GST_FLOW_NOT_NEGOTIATED) {
       gst_buffer_unref (buf);
@@ -2093,6 +2140,66 @@ not_negotiated:
   }
 }
 
+typedef struct
+{
+  GstAudioDecoder *dec;
+  GstFlowReturn ret;
+} ChainListData;
+
+static gboolean
+chain_list_buffer (GstBuffer ** buffer, guint idx, gpointer user_data)
+{
+  ChainListData *data = user_data;
+  GstBuffer *buf = *buffer;
+
+  /* take the buffer out of the list so it stays writable */
+  *buffer = NULL;
+  data->ret = gst_audio_decoder_chain (data->dec->sinkpad,
+      GST_OBJECT_CAST (data->dec), buf);
+
+  return data->ret == GST_FLOW_OK;
+}
+
+/* all packets of a list are decoded in one go and their output is
+ * collected into as few buffers as possible */
+static GstFlowReturn
+gst_audio_decoder_chain_list (GstPad * pad, GstObject * parent,
+    GstBufferList * list)
+{
+  GstAudioDecoder *dec;
+  ChainListData data;
+  GstFlowReturn ret;
+
+  dec = GST_AUDIO_DECODER (parent);
+
+  GST_LOG_OBJECT (dec, "received buffer list of length %u",
+      gst_buffer_list_length (list));
+
+  data.dec = dec;
+  data.ret = GST_FLOW_OK;
+
+  list = gst_buffer_list_make_writable (list);
+
+  GST_AUDIO_DECODER_STREAM_LOCK (dec);
+  dec->priv->batch = TRUE;
+  gst_buffer_list_foreach (list, chain_list_buffer, &data);
+  /* push out whatever was collected, even if a later packet failed, unless
+   * the regular aggregation keeps collecting anyway */
+  if (dec->priv->agg > 0 && dec->priv->latency > 0)
+    ret = GST_FLOW_OK;
+  else
+    ret = gst_audio_decoder_output (dec, NULL);
+  dec->priv->batch = FALSE;
+  GST_AUDIO_DECODER_STREAM_UNLOCK (dec);
+
+  gst_buffer_list_unref (list);
+
+  if (data.ret != GST_FLOW_OK)
+    ret = data.ret;
+
+  return ret;
+}
+
 /* perform upstream byte <-> time conversion (duration, seeking)
  * if subclass allows and if enough data for moderately decent conversion */
 static inline gboolean
@@ -2259,10 +2366,18 @@ gst_audio_decoder_handle_gap (GstAudioDecoder * dec, GstEvent * event)
     GstAudioDecoderClass *klass = GST_AUDIO_DECODER_GET_CLASS (dec);
     GstBuffer *buf;
 
-    /* hand subclass empty frame with duration that needs covering */
-    buf = gst_buffer_new ();
+    /* hand subclass empty frame with duration that needs covering, reusing
+     * the previous one if nobody holds on to it anymore */
+    if (!dec->priv->plc_buffer ||
+        !gst_buffer_is_writable (dec->priv->plc_buffer)) {
+      gst_buffer_replace (&dec->priv->plc_buffer, NULL);
+      dec->priv->plc_buffer = gst_buffer_new ();
+    }
+    buf = dec->priv->plc_buffer;
+    GST_BUFFER_FLAGS (buf) = 0;
     GST_BUFFER_TIMESTAMP (buf) = timestamp;
     GST_BUFFER_DURATION (buf) = duration;
+    gst_buffer_ref (buf);
     /* best effort, not much error handling */
     gst_audio_decoder_handle_frame (dec, klass, buf);
     ret = TRUE;
@@ -3702,6 +3817,50 @@ gst_audio_decoder_merge_tags (GstAudioDecoder * dec,
   GST_AUDIO_DECODER_STREAM_UNLOCK (dec);
 }
 
+/* with STREAM_LOCK */
+static GstBuffer *
+gst_audio_decoder_acquire_pool_buffer (GstAudioDecoder * dec, gsize size)
+{
+  GstAudioDecoderContext *ctx = &dec->priv->ctx;
+  GstBuffer *buffer = NULL;
+
+  /* pool buffers can only shrink, start over with the larger size */
+  if (ctx->pool && size > ctx->pool_size)
+    gst_audio_decoder_clear_pool (dec);
+
+  if (!ctx->pool) {
+    GstBufferPool *pool;
+    GstStructure *config;
+
+    pool = gst_buffer_pool_new ();
+    config = gst_buffer_pool_get_config (pool);
+    gst_buffer_pool_config_set_params (config, NULL, size, 0, 0);
+    gst_buffer_pool_config_set_allocator (config, ctx->allocator,
+        &ctx->params);
+
+    if (!gst_buffer_pool_set_config (pool, config) ||
+        !gst_buffer_pool_set_active (pool, TRUE)) {
+      GST_INFO_OBJECT (dec, "failed to set up output buffer pool");
+      gst_object_unref (pool);
+      return NULL;
+    }
+
+    GST_DEBUG_OBJECT (dec, "new output buffer pool for %" G_GSIZE_FORMAT
+        " bytes", size);
+    ctx->pool = pool;
+    ctx->pool_size = size;
+  }
+
+  if (gst_buffer_pool_acquire_buffer (ctx->pool, &buffer,
+          NULL) != GST_FLOW_OK)
+    return NULL;
+
+  if (size < ctx->pool_size)
+    gst_buffer_resize (buffer, 0, size);
+
+  return buffer;
+}
+
 /**
  * gst_audio_decoder_allocate_output_buffer:
  * @dec: a #GstAudioDecoder
@@ -3710,6 +3869,10 @@ gst_audio_decoder_merge_tags (GstAudioDecoder * dec,
  * Helper function that allocates a buffer to hold an audio frame
  * for @dec's current output format.
  *
+ * Since 1.18 the buffer is taken from a buffer pool that is kept by @dec
+ * and that is sized to the largest @size requested so far, so decoders
+ * producing many small frames do not allocate memory for each of them.
+ *
  * Returns: (transfer full): allocated buffer
  */
 GstBuffer *
@@ -3735,9 +3898,11 @@ gst_audio_decoder_allocate_output_buffer (GstAudioDecoder * dec, gsize size)
     }
   }
 
-  buffer =
-      gst_buffer_new_allocate (dec->priv->ctx.allocator, size,
-      &dec->priv->ctx.params);
+  buffer = gst_audio_decoder_acquire_pool_buffer (dec, size);
+  if (!buffer)
+    buffer =
+        gst_buffer_new_allocate (dec->priv->ctx.allocator, size,
+        &dec->priv->ctx.params);
   if (!buffer) {
     GST_INFO_OBJECT (dec, "couldn't allocate output buffer");
     goto fallback;
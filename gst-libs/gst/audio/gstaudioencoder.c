@@ -54,6 +54,8 @@
  *
  *     * Base class gathers input sample data (as directed by the context's
  *       frame_samples and frame_max) and provides this to subclass' @handle_frame.
+ *       Data that lies within a single input buffer is provided without
+ *       copying.
  *     * If codec processing results in encoded data, subclass should call
  *       gst_audio_encoder_finish_frame() to have encoded data pushed
  *       downstream. Alternatively, it might also call
@@ -61,6 +63,10 @@
  *       dropped samples) to indicate dropped (non-encoded) samples.
  *     * Just prior to actually pushing a buffer downstream,
  *       it is passed to @pre_push.
+ *     * Encoded data that is finished while the base class hands input to
+ *       @handle_frame is collected and pushed downstream as one
+ *       #GstBufferList afterwards, e.g. when a subclass encodes several frames
+ *       per @handle_frame call as allowed by gst_audio_encoder_set_frame_max().
  *     * During the parsing process GstAudioEncoderClass will handle both
  *       srcpad and sinkpad events. Sink events will be passed to subclass
  *       if @event callback has been provided.
@@ -210,6 +216,9 @@ struct _GstAudioEncoderPrivate
   gboolean force;
   /* need to handle changed input caps */
   gboolean do_caps;
+  /* output collected while handing input to subclass, pushed as one list */
+  gboolean batch;
+  GstBufferList *pending_output;
 
   /* output bps estimatation */
   /* global in samples seen */
@@ -502,6 +511,10 @@ gst_audio_encoder_reset (GstAudioEncoder * enc, gboolean full)
   gst_segment_init (&enc->output_segment, GST_FORMAT_TIME);
 
   gst_adapter_clear (enc->priv->adapter);
+  if (enc->priv->pending_output) {
+    gst_buffer_list_unref (enc->priv->pending_output);
+    enc->priv->pending_output = NULL;
+  }
   enc->priv->got_data = FALSE;
   enc->priv->drained = TRUE;
   enc->priv->offset = 0;
@@ -714,6 +727,30 @@ foreach_metadata (GstBuffer * inbuf, GstMeta ** meta, gpointer user_data)
   return TRUE;
 }
 
+/* with STREAM_LOCK */
+static GstFlowReturn
+gst_audio_encoder_push_pending_output (GstAudioEncoder * enc)
+{
+  GstBufferList *list = enc->priv->pending_output;
+  GstBuffer *buf;
+
+  if (!list)
+    return GST_FLOW_OK;
+
+  enc->priv->pending_output = NULL;
+
+  if (gst_buffer_list_length (list) > 1) {
+    GST_LOG_OBJECT (enc, "pushing list of %u buffers",
+        gst_buffer_list_length (list));
+    return gst_pad_push_list (enc->srcpad, list);
+  }
+
+  buf = gst_buffer_ref (gst_buffer_list_get (list, 0));
+  gst_buffer_list_unref (list);
+
+  return gst_pad_push (enc->srcpad, buf);
+}
+
 /**
  * gst_audio_encoder_finish_frame:
  * @enc: a #GstAudioEncoder
@@ -763,6 +800,19 @@ gst_audio_encoder_finish_frame (GstAudioEncoder * enc, GstBuffer * buf,
       buf ? gst_buffer_get_size (buf) : -1, samples);
 
   needs_reconfigure = gst_pad_check_reconfigure (enc->srcpad);
+
+  /* anything but encoded data needs collected output pushed out first */
+  if (G_UNLIKELY (priv->pending_output && (ctx->output_caps_changed ||
+              needs_reconfigure || priv->pending_events ||
+              priv->tags_changed || ctx->new_headers))) {
+    ret = gst_audio_encoder_push_pending_output (enc);
+    if (ret != GST_FLOW_OK) {
+      if (buf)
+        gst_buffer_unref (buf);
+      goto exit;
+    }
+  }
+
   if (G_UNLIKELY (ctx->output_caps_changed || needs_reconfigure)) {
     if (!gst_audio_encoder_negotiate_unlocked (enc)) {
       gst_pad_mark_reconfigure (enc->srcpad);
@@ -996,8 +1046,15 @@ gst_audio_encoder_finish_frame (GstAudioEncoder * enc, GstBuffer * buf,
         GST_TIME_ARGS (GST_BUFFER_TIMESTAMP (buf)),
         GST_TIME_ARGS (GST_BUFFER_DURATION (buf)));
 
-    ret = gst_pad_push (enc->srcpad, buf);
-    GST_LOG_OBJECT (enc, "buffer pushed: %s", gst_flow_get_name (ret));
+    if (priv->batch) {
+      if (!priv->pending_output)
+        priv->pending_output = gst_buffer_list_new ();
+      gst_buffer_list_add (priv->pending_output, buf);
+      GST_LOG_OBJECT (enc, "buffer collected");
+    } else {
+      ret = gst_pad_push (enc->srcpad, buf);
+      GST_LOG_OBJECT (enc, "buffer pushed: %s", gst_flow_get_name (ret));
+    }
   } else {
     /* merely advance samples, most work for that already done above */
     priv->samples += samples;
@@ -1046,7 +1103,8 @@ gst_audio_encoder_push_buffers (GstAudioEncoder * enc, gboolean force)
   GstAudioEncoderContext *ctx;
   gint av, need;
   GstBuffer *buf;
-  GstFlowReturn ret = GST_FLOW_OK;
+  gboolean mapped;
+  GstFlowReturn ret = GST_FLOW_OK, push_ret;
 
   klass = GST_AUDIO_ENCODER_GET_CLASS (enc);
 
@@ -1055,9 +1113,13 @@ gst_audio_encoder_push_buffers (GstAudioEncoder * enc, gboolean force)
   priv = enc->priv;
   ctx = &enc->priv->ctx;
 
+  /* all output of this round goes downstream in one go */
+  priv->batch = TRUE;
+
   while (ret == GST_FLOW_OK) {
 
     buf = NULL;
+    mapped = FALSE;
     av = gst_adapter_available (priv->adapter);
 
     g_assert (priv->offset <= av);
@@ -1097,12 +1159,21 @@ gst_audio_encoder_push_buffers (GstAudioEncoder * enc, gboolean force)
 
     priv->got_data = FALSE;
     if (G_LIKELY (need)) {
-      const guint8 *data;
-
-      data = gst_adapter_map (priv->adapter, priv->offset + need);
-      buf =
-          gst_buffer_new_wrapped_full (GST_MEMORY_FLAG_READONLY,
-          (gpointer) data, priv->offset + need, priv->offset, need, NULL, NULL);
+      if (priv->offset == 0 &&
+          gst_adapter_available_fast (priv->adapter) >= need) {
+        /* frame within a single input buffer, hand out (part of) that one
+         * rather than mapping and wrapping the adapter data */
+        buf = gst_adapter_get_buffer (priv->adapter, need);
+      } else {
+        const guint8 *data;
+
+        data = gst_adapter_map (priv->adapter, priv->offset + need);
+        buf =
+            gst_buffer_new_wrapped_full (GST_MEMORY_FLAG_READONLY,
+            (gpointer) data, priv->offset + need, priv->offset, need, NULL,
+            NULL);
+        mapped = TRUE;
+      }
     } else if (!priv->drainable) {
       GST_DEBUG_OBJECT (enc, "non-drainable and no more data");
       goto finish;
@@ -1129,7 +1200,8 @@ gst_audio_encoder_push_buffers (GstAudioEncoder * enc, gboolean force)
 
     if (G_LIKELY (buf)) {
       gst_buffer_unref (buf);
-      gst_adapter_unmap (priv->adapter);
+      if (mapped)
+        gst_adapter_unmap (priv->adapter);
     }
 
   finish:
@@ -1141,6 +1213,11 @@ gst_audio_encoder_push_buffers (GstAudioEncoder * enc, gboolean force)
     }
   }
 
+  priv->batch = FALSE;
+  push_ret = gst_audio_encoder_push_pending_output (enc);
+  if (ret == GST_FLOW_OK)
+    ret = push_ret;
+
   return ret;
 }
 
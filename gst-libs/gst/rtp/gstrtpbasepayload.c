@@ -60,6 +60,10 @@ struct _GstRTPBasePayloadPrivate
 
   gboolean onvif_no_rate_control;
 
+  gboolean subframe_input;
+  /* the input buffer being handled ends a frame */
+  gboolean input_marker;
+
   gboolean negotiated;
 
   gboolean delay_segment;
@@ -96,6 +100,7 @@ enum
 #define DEFAULT_ONVIF_NO_RATE_CONTROL   FALSE
 #define DEFAULT_TWCC_EXT_ID             0
 #define DEFAULT_SCALE_RTPTIME           TRUE
+#define DEFAULT_SUBFRAME_INPUT          FALSE
 
 enum
 {
@@ -116,6 +121,7 @@ enum
   PROP_ONVIF_NO_RATE_CONTROL,
   PROP_TWCC_EXT_ID,
   PROP_SCALE_RTPTIME,
+  PROP_SUBFRAME_INPUT,
   PROP_LAST
 };
 
@@ -383,6 +389,29 @@ gst_rtp_base_payload_class_init (GstRTPBasePayloadClass * klass)
           "Whether the RTP timestamp should be scaled with the rate (speed)",
           DEFAULT_SCALE_RTPTIME, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstRTPBasePayload:subframe-input:
+   *
+   * Input buffers may contain only a part of a frame, such as the slices
+   * pushed with gst_video_encoder_finish_subframe(). Only the buffer that
+   * completes a frame has the %GST_BUFFER_FLAG_MARKER flag.
+   *
+   * When enabled, the RTP marker bit is only kept on pushed packets that
+   * have the %GST_BUFFER_FLAG_MARKER flag.
+   * gst_rtp_base_payload_allocate_output_buffer() sets that flag on buffers
+   * allocated while handling an input buffer that ends a frame. Payloaders
+   * that collect data of several input buffers into one packet set or unset
+   * the flag themselves, or push their data at the end of every input
+   * buffer when gst_rtp_base_payload_needs_subframe_flush() returns %TRUE.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_SUBFRAME_INPUT,
+      g_param_spec_boolean ("subframe-input", "Sub-frame input",
+          "Input buffers may be parts of a frame, the last one is flagged "
+          "with MARKER", DEFAULT_SUBFRAME_INPUT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state = gst_rtp_base_payload_change_state;
 
   klass->get_caps = gst_rtp_base_payload_getcaps_default;
@@ -445,6 +474,8 @@ gst_rtp_base_payload_init (GstRTPBasePayload * rtpbasepayload, gpointer g_class)
   rtpbasepayload->priv->base_rtime_hz = GST_BUFFER_OFFSET_NONE;
   rtpbasepayload->priv->onvif_no_rate_control = DEFAULT_ONVIF_NO_RATE_CONTROL;
   rtpbasepayload->priv->scale_rtptime = DEFAULT_SCALE_RTPTIME;
+  rtpbasepayload->priv->subframe_input = DEFAULT_SUBFRAME_INPUT;
+  rtpbasepayload->priv->input_marker = TRUE;
 
   rtpbasepayload->media = NULL;
   rtpbasepayload->encoding_name = NULL;
@@ -740,9 +771,14 @@ gst_rtp_base_payload_chain (GstPad * pad, GstObject * parent,
     }
   }
 
+  rtpbasepayload->priv->input_marker =
+      GST_BUFFER_FLAG_IS_SET (buffer, GST_BUFFER_FLAG_MARKER);
+
   ret = rtpbasepayload_class->handle_buffer (rtpbasepayload, buffer);
 
   gst_buffer_replace (&rtpbasepayload->priv->input_meta_buffer, NULL);
+  /* data drained later, e.g. on EOS, ends a frame */
+  rtpbasepayload->priv->input_marker = TRUE;
 
   return ret;
 
@@ -1220,6 +1256,7 @@ typedef struct
   guint64 offset;
   guint32 rtptime;
   guint8 twcc_ext_id;
+  gboolean subframe_input;
 } HeaderData;
 
 static gboolean
@@ -1261,6 +1298,10 @@ set_headers (GstBuffer ** buffer, guint idx, gpointer user_data)
   gst_rtp_buffer_set_payload_type (&rtp, data->pt);
   gst_rtp_buffer_set_seq (&rtp, data->seqnum);
   gst_rtp_buffer_set_timestamp (&rtp, data->rtptime);
+  /* the frame continues in a later packet */
+  if (data->subframe_input
+      && !GST_BUFFER_FLAG_IS_SET (*buffer, GST_BUFFER_FLAG_MARKER))
+    gst_rtp_buffer_set_marker (&rtp, FALSE);
   _set_twcc_seq (&rtp, data->seqnum, data->twcc_ext_id);
   gst_rtp_buffer_unmap (&rtp);
 
@@ -1319,6 +1360,7 @@ gst_rtp_base_payload_prepare_push (GstRTPBasePayload * payload,
   data.ssrc = payload->current_ssrc;
   data.pt = payload->pt;
   data.twcc_ext_id = priv->twcc_ext_id;
+  data.subframe_input = priv->subframe_input;
 
   /* find the first buffer with a timestamp */
   if (is_list) {
@@ -1513,7 +1555,10 @@ gst_rtp_base_payload_push (GstRTPBasePayload * payload, GstBuffer * buffer)
  * Allocate a new #GstBuffer with enough data to hold an RTP packet with
  * minimum @csrc_count CSRCs, a payload length of @payload_len and padding of
  * @pad_len. If @payload has #GstRTPBasePayload:source-info %TRUE additional
- * CSRCs may be allocated and filled with RTP source information.
+ * CSRCs may be allocated and filled with RTP source information. If
+ * @payload has #GstRTPBasePayload:subframe-input %TRUE, the buffer gets the
+ * %GST_BUFFER_FLAG_MARKER flag when the input buffer being handled ends a
+ * frame.
  *
  * Returns: A newly allocated buffer that can hold an RTP packet with given
  * parameters.
@@ -1556,9 +1601,35 @@ gst_rtp_base_payload_allocate_output_buffer (GstRTPBasePayload * payload,
   if (buffer == NULL)
     buffer = gst_rtp_buffer_new_allocate (payload_len, pad_len, csrc_count);
 
+  if (payload->priv->subframe_input && payload->priv->input_marker)
+    GST_BUFFER_FLAG_SET (buffer, GST_BUFFER_FLAG_MARKER);
+
   return buffer;
 }
 
+/**
+ * gst_rtp_base_payload_needs_subframe_flush:
+ * @payload: a #GstRTPBasePayload
+ *
+ * Check if @payload gets parts of frames as input, see
+ * #GstRTPBasePayload:subframe-input. Payloaders that collect data until
+ * gst_rtp_base_payload_is_filled() returns %TRUE should then push what they
+ * collected at the end of every input buffer, so that each part is sent
+ * without waiting for the rest of the frame.
+ *
+ * Returns: %TRUE if collected data should be pushed at the end of every
+ * input buffer.
+ *
+ * Since: 1.18
+ */
+gboolean
+gst_rtp_base_payload_needs_subframe_flush (GstRTPBasePayload * payload)
+{
+  g_return_val_if_fail (GST_IS_RTP_BASE_PAYLOAD (payload), FALSE);
+
+  return payload->priv->subframe_input;
+}
+
 static GstStructure *
 gst_rtp_base_payload_create_stats (GstRTPBasePayload * rtpbasepayload)
 {
@@ -1642,6 +1713,9 @@ gst_rtp_base_payload_set_property (GObject * object, guint prop_id,
     case PROP_SCALE_RTPTIME:
       priv->scale_rtptime = g_value_get_boolean (value);
       break;
+    case PROP_SUBFRAME_INPUT:
+      priv->subframe_input = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1718,6 +1792,9 @@ gst_rtp_base_payload_get_property (GObject * object, guint prop_id,
     case PROP_SCALE_RTPTIME:
       g_value_set_boolean (value, priv->scale_rtptime);
       break;
+    case PROP_SUBFRAME_INPUT:
+      g_value_set_boolean (value, priv->subframe_input);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -164,6 +164,9 @@ GST_RTP_API
 gboolean        gst_rtp_base_payload_is_filled          (GstRTPBasePayload *payload,
                                                          guint size, GstClockTime duration);
 
+GST_RTP_API
+gboolean        gst_rtp_base_payload_needs_subframe_flush (GstRTPBasePayload *payload);
+
 GST_RTP_API
 GstFlowReturn   gst_rtp_base_payload_push               (GstRTPBasePayload *payload,
                                                          GstBuffer *buffer);
@@ -281,6 +281,277 @@ link_failed:
   }
 }
 
+/* Converter kept around between calls to convert_sample_raw(), so that
+ * repeated conversions between the same formats and sizes don't need to
+ * set up a new converter every time */
+static GMutex convert_cache_lock;
+static GstVideoConverter *convert_cache;
+static GstVideoInfo convert_cache_in_info;
+static GstVideoInfo convert_cache_out_info;
+static GstStructure *convert_cache_config;
+
+static gboolean
+caps_are_raw_system_memory (const GstCaps * caps)
+{
+  GstCapsFeatures *features;
+
+  if (gst_caps_get_size (caps) != 1 || !caps_are_raw (caps))
+    return FALSE;
+
+  features = gst_caps_get_features (caps, 0);
+  return features == NULL
+      || gst_caps_features_is_equal (features,
+      GST_CAPS_FEATURES_MEMORY_SYSTEM_MEMORY);
+}
+
+/* Place the converted image like videoscale does with add-borders=true:
+ * as large as possible in the output while keeping the display aspect
+ * ratio of the input */
+static void
+convert_sample_raw_get_dest_rect (const GstVideoInfo * out_info, gint src_w,
+    gint src_h, gint src_par_n, gint src_par_d, gint * dest_x, gint * dest_y,
+    gint * dest_w, gint * dest_h)
+{
+  gint out_w = GST_VIDEO_INFO_WIDTH (out_info);
+  gint out_h = GST_VIDEO_INFO_HEIGHT (out_info);
+  gint out_par_n = GST_VIDEO_INFO_PAR_N (out_info);
+  gint out_par_d = GST_VIDEO_INFO_PAR_D (out_info);
+  gint dar_n, dar_d, w, h;
+
+  *dest_x = 0;
+  *dest_y = 0;
+  *dest_w = out_w;
+  *dest_h = out_h;
+
+  if (!gst_util_fraction_multiply (src_w, src_h, src_par_n, src_par_d, &dar_n,
+          &dar_d))
+    return;
+
+  /* height needed at full output width to keep the input DAR */
+  h = gst_util_uint64_scale (out_w, (guint64) out_par_n * dar_d,
+      (guint64) out_par_d * dar_n);
+  if (h <= out_h) {
+    w = out_w;
+  } else {
+    h = out_h;
+    w = gst_util_uint64_scale (out_h, (guint64) out_par_d * dar_n,
+        (guint64) out_par_n * dar_d);
+  }
+
+  if (w <= 0 || h <= 0)
+    return;
+
+  *dest_x = (out_w - w) / 2;
+  *dest_y = (out_h - h) / 2;
+  *dest_w = w;
+  *dest_h = h;
+}
+
+/* A conversion of raw video done directly with a #GstVideoConverter */
+typedef struct
+{
+  GstVideoInfo in_info;
+  GstVideoInfo out_info;
+  GstStructure *config;
+} RawConvert;
+
+/* Checks if @sample can be converted to @to_caps directly with a
+ * #GstVideoConverter instead of going through a pipeline, and sets up @rc
+ * for convert_sample_raw_run() if so. This doesn't touch the pixels. */
+static gboolean
+convert_sample_raw_prepare (GstSample * sample, const GstCaps * to_caps,
+    RawConvert * rc)
+{
+  GstBuffer *buf;
+  GstCaps *from_caps;
+  GstVideoInfo in_info, out_info;
+  GstVideoCropMeta *cmeta;
+  GstStructure *to_s;
+  gint src_x, src_y, src_w, src_h;
+  gint dest_x, dest_y, dest_w, dest_h;
+
+  from_caps = gst_sample_get_caps (sample);
+  buf = gst_sample_get_buffer (sample);
+
+  if (!caps_are_raw_system_memory (from_caps) ||
+      !caps_are_raw_system_memory (to_caps) || !gst_caps_is_fixed (to_caps))
+    return FALSE;
+
+  /* the output size must be given, otherwise the pipeline has to
+   * negotiate it */
+  to_s = gst_caps_get_structure (to_caps, 0);
+  if (!gst_structure_has_field (to_s, "width") ||
+      !gst_structure_has_field (to_s, "height"))
+    return FALSE;
+
+  if (!gst_video_info_from_caps (&in_info, from_caps) ||
+      !gst_video_info_from_caps (&out_info, to_caps))
+    return FALSE;
+
+  /* the converter doesn't deinterlace */
+  if (GST_VIDEO_INFO_INTERLACE_MODE (&in_info) !=
+      GST_VIDEO_INFO_INTERLACE_MODE (&out_info))
+    return FALSE;
+
+  /* the pipeline takes the framerate from the input */
+  GST_VIDEO_INFO_FPS_N (&out_info) = GST_VIDEO_INFO_FPS_N (&in_info);
+  GST_VIDEO_INFO_FPS_D (&out_info) = GST_VIDEO_INFO_FPS_D (&in_info);
+
+  src_x = src_y = 0;
+  src_w = GST_VIDEO_INFO_WIDTH (&in_info);
+  src_h = GST_VIDEO_INFO_HEIGHT (&in_info);
+
+  cmeta = gst_buffer_get_video_crop_meta (buf);
+  if (cmeta) {
+    if (cmeta->x + cmeta->width > src_w || cmeta->y + cmeta->height > src_h)
+      return FALSE;
+
+    src_x = cmeta->x;
+    src_y = cmeta->y;
+    src_w = cmeta->width;
+    src_h = cmeta->height;
+  }
+
+  if (gst_structure_has_field (to_s, "pixel-aspect-ratio")) {
+    convert_sample_raw_get_dest_rect (&out_info, src_w, src_h,
+        GST_VIDEO_INFO_PAR_N (&in_info), GST_VIDEO_INFO_PAR_D (&in_info),
+        &dest_x, &dest_y, &dest_w, &dest_h);
+  } else {
+    gint par_n, par_d;
+
+    /* like videoscale, fixate the output pixel-aspect-ratio so that the
+     * input display aspect ratio is kept at the requested size, and scale
+     * to the whole output without borders */
+    if (!gst_util_fraction_multiply (src_w * GST_VIDEO_INFO_PAR_N (&in_info),
+            src_h * GST_VIDEO_INFO_PAR_D (&in_info),
+            GST_VIDEO_INFO_HEIGHT (&out_info), GST_VIDEO_INFO_WIDTH (&out_info),
+            &par_n, &par_d))
+      return FALSE;
+
+    GST_VIDEO_INFO_PAR_N (&out_info) = par_n;
+    GST_VIDEO_INFO_PAR_D (&out_info) = par_d;
+
+    dest_x = dest_y = 0;
+    dest_w = GST_VIDEO_INFO_WIDTH (&out_info);
+    dest_h = GST_VIDEO_INFO_HEIGHT (&out_info);
+  }
+
+  rc->in_info = in_info;
+  rc->out_info = out_info;
+  rc->config = gst_structure_new ("GstVideoConvertConfig",
+      GST_VIDEO_CONVERTER_OPT_SRC_X, G_TYPE_INT, src_x,
+      GST_VIDEO_CONVERTER_OPT_SRC_Y, G_TYPE_INT, src_y,
+      GST_VIDEO_CONVERTER_OPT_SRC_WIDTH, G_TYPE_INT, src_w,
+      GST_VIDEO_CONVERTER_OPT_SRC_HEIGHT, G_TYPE_INT, src_h,
+      GST_VIDEO_CONVERTER_OPT_DEST_X, G_TYPE_INT, dest_x,
+      GST_VIDEO_CONVERTER_OPT_DEST_Y, G_TYPE_INT, dest_y,
+      GST_VIDEO_CONVERTER_OPT_DEST_WIDTH, G_TYPE_INT, dest_w,
+      GST_VIDEO_CONVERTER_OPT_DEST_HEIGHT, G_TYPE_INT, dest_h, NULL);
+
+  return TRUE;
+}
+
+/* Converts @sample as set up by convert_sample_raw_prepare(), with the
+ * cached converter when possible. Takes ownership of the config in @rc. */
+static GstSample *
+convert_sample_raw_run (GstSample * sample, RawConvert * rc)
+{
+  GstBuffer *buf, *outbuf;
+  GstCaps *out_caps;
+  GstVideoInfo *in_info = &rc->in_info, *out_info = &rc->out_info;
+  GstVideoFrame in_frame, out_frame;
+  GstVideoConverter *convert;
+  GstStructure *config = rc->config;
+  gboolean cached;
+
+  rc->config = NULL;
+  buf = gst_sample_get_buffer (sample);
+
+  if (!gst_video_frame_map (&in_frame, in_info, buf, GST_MAP_READ)) {
+    gst_structure_free (config);
+    return NULL;
+  }
+
+  outbuf = gst_buffer_new_and_alloc (GST_VIDEO_INFO_SIZE (out_info));
+  if (!gst_video_frame_map (&out_frame, out_info, outbuf, GST_MAP_WRITE)) {
+    gst_video_frame_unmap (&in_frame);
+    gst_buffer_unref (outbuf);
+    gst_structure_free (config);
+    return NULL;
+  }
+
+  GST_DEBUG ("converting %" GST_PTR_FORMAT " with %" GST_PTR_FORMAT,
+      gst_sample_get_caps (sample), config);
+
+  /* when another thread is using the cached converter, use a temporary
+   * one instead of waiting */
+  cached = g_mutex_trylock (&convert_cache_lock);
+  if (cached && convert_cache &&
+      gst_video_info_is_equal (&convert_cache_in_info, in_info) &&
+      gst_video_info_is_equal (&convert_cache_out_info, out_info) &&
+      gst_structure_is_equal (convert_cache_config, config)) {
+    GST_DEBUG ("reusing cached converter %p", convert_cache);
+    convert = convert_cache;
+    gst_structure_free (config);
+  } else {
+    GstStructure *config_copy = cached ? gst_structure_copy (config) : NULL;
+
+    convert = gst_video_converter_new (in_info, out_info, config);
+    if (cached && convert) {
+      if (convert_cache) {
+        gst_video_converter_free (convert_cache);
+        gst_structure_free (convert_cache_config);
+      }
+      convert_cache = convert;
+      convert_cache_in_info = *in_info;
+      convert_cache_out_info = *out_info;
+      convert_cache_config = config_copy;
+    } else if (config_copy) {
+      gst_structure_free (config_copy);
+    }
+  }
+
+  if (convert) {
+    gst_video_converter_frame (convert, &in_frame, &out_frame);
+    if (convert != convert_cache)
+      gst_video_converter_free (convert);
+  }
+
+  if (cached)
+    g_mutex_unlock (&convert_cache_lock);
+
+  gst_video_frame_unmap (&out_frame);
+  gst_video_frame_unmap (&in_frame);
+
+  if (!convert) {
+    gst_buffer_unref (outbuf);
+    return NULL;
+  }
+
+  gst_buffer_copy_into (outbuf, buf, GST_BUFFER_COPY_TIMESTAMPS, 0, -1);
+
+  out_caps = gst_video_info_to_caps (out_info);
+  sample = gst_sample_new (outbuf, out_caps, NULL, NULL);
+  gst_caps_unref (out_caps);
+  gst_buffer_unref (outbuf);
+
+  return sample;
+}
+
+/* Convert raw video directly with a (cached) #GstVideoConverter instead of
+ * going through a pipeline. Returns %NULL when the conversion can't be done
+ * that way, in which case the caller should use the pipeline. */
+static GstSample *
+convert_sample_raw (GstSample * sample, const GstCaps * to_caps)
+{
+  RawConvert rc;
+
+  if (!convert_sample_raw_prepare (sample, to_caps, &rc))
+    return NULL;
+
+  return convert_sample_raw_run (sample, &rc);
+}
+
 /**
  * gst_video_convert_sample:
  * @sample: a #GstSample
@@ -294,6 +565,10 @@ link_failed:
  *
  * The width, height and pixel-aspect-ratio can also be specified in the output caps.
  *
+ * When @to_caps are fixed raw video caps, the conversion is done directly
+ * with a #GstVideoConverter that is reused between calls, without setting
+ * up a pipeline.
+ *
  * Returns: The converted #GstSample, or %NULL if an error happened (in which case @err
  * will point to the #GError).
  */
@@ -330,6 +605,13 @@ gst_video_convert_sample (GstSample * sample, const GstCaps * to_caps,
     gst_caps_append_structure (to_caps_copy, s);
   }
 
+  /* fully specified raw to raw conversions don't need a pipeline */
+  result = convert_sample_raw (sample, to_caps_copy);
+  if (result) {
+    gst_caps_unref (to_caps_copy);
+    return result;
+  }
+
   pipeline =
       build_convert_frame_pipeline (&src, &sink, from_caps,
       gst_buffer_get_video_crop_meta (buf), to_caps_copy, &err);
@@ -656,6 +938,58 @@ done:
   return GST_FLOW_OK;
 }
 
+/* Direct conversions for gst_video_convert_sample_async() run in a shared
+ * pool of worker threads so that the calling thread is never blocked */
+typedef struct
+{
+  GstVideoConvertSampleContext *ctx;
+  RawConvert rc;
+} RawConvertJob;
+
+static void
+convert_frame_raw_job_func (RawConvertJob * job, gpointer unused)
+{
+  GstVideoConvertSampleContext *ctx = job->ctx;
+  GstSample *converted;
+  GError *error = NULL;
+
+  converted = convert_sample_raw_run (ctx->sample, &job->rc);
+  if (!converted) {
+    GST_ERROR ("Could not convert video frame");
+    error = g_error_new (GST_CORE_ERROR, GST_CORE_ERROR_FAILED,
+        "Could not convert video frame");
+  }
+
+  g_mutex_lock (&ctx->mutex);
+  if (!ctx->finished) {
+    convert_frame_finish (ctx, converted, error);
+  } else {
+    /* timed out already */
+    if (converted)
+      gst_sample_unref (converted);
+    g_clear_error (&error);
+  }
+  g_mutex_unlock (&ctx->mutex);
+
+  gst_video_convert_frame_context_unref (ctx);
+  g_slice_free (RawConvertJob, job);
+}
+
+static GThreadPool *
+convert_frame_get_raw_pool (void)
+{
+  static gsize pool = 0;
+
+  if (g_once_init_enter (&pool)) {
+    GThreadPool *p =
+        g_thread_pool_new ((GFunc) convert_frame_raw_job_func, NULL,
+        g_get_num_processors (), FALSE, NULL);
+    g_once_init_leave (&pool, (gsize) p);
+  }
+
+  return (GThreadPool *) pool;
+}
+
 /**
  * gst_video_convert_sample_async:
  * @sample: a #GstSample
@@ -676,6 +1010,9 @@ done:
  * %GMainContext, see g_main_context_get_thread_default(). If GLib before 2.22 is used,
  * this will always be the global default main context.
  *
+ * Conversions between fully specified raw video caps are done directly by
+ * a #GstVideoConverter on a worker thread instead of a pipeline.
+ *
  * @destroy_notify will be called after the callback was called and @user_data is not needed
  * anymore.
  */
@@ -693,6 +1030,7 @@ gst_video_convert_sample_async (GstSample * sample,
   GstElement *pipeline, *src, *sink;
   guint i, n;
   GSource *source;
+  RawConvertJob *job;
   GstVideoConvertSampleContext *ctx;
 
   g_return_if_fail (sample != NULL);
@@ -733,15 +1071,6 @@ gst_video_convert_sample_async (GstSample * sample,
   ctx->context = g_main_context_ref (context);
   ctx->finished = FALSE;
 
-  pipeline =
-      build_convert_frame_pipeline (&src, &sink, from_caps,
-      gst_buffer_get_video_crop_meta (buf), to_caps_copy, &error);
-  if (!pipeline)
-    goto no_pipeline;
-  ctx->pipeline = pipeline;
-
-  bus = gst_element_get_bus (pipeline);
-
   if (timeout != GST_CLOCK_TIME_NONE) {
     ctx->timeout_source = g_timeout_source_new (timeout / GST_MSECOND);
     g_source_set_callback (ctx->timeout_source,
@@ -751,6 +1080,29 @@ gst_video_convert_sample_async (GstSample * sample,
     g_source_attach (ctx->timeout_source, context);
   }
 
+  /* fully specified raw to raw conversions don't need a pipeline. They are
+   * done by a worker thread and the result is dispatched from @context */
+  job = g_slice_new0 (RawConvertJob);
+  if (convert_sample_raw_prepare (sample, to_caps_copy, &job->rc)) {
+    gst_caps_unref (to_caps_copy);
+
+    /* the job takes over our reference to the context */
+    job->ctx = ctx;
+    g_thread_pool_push (convert_frame_get_raw_pool (), job, NULL);
+
+    return;
+  }
+  g_slice_free (RawConvertJob, job);
+
+  pipeline =
+      build_convert_frame_pipeline (&src, &sink, from_caps,
+      gst_buffer_get_video_crop_meta (buf), to_caps_copy, &error);
+  if (!pipeline)
+    goto no_pipeline;
+  ctx->pipeline = pipeline;
+
+  bus = gst_element_get_bus (pipeline);
+
   g_signal_connect_data (src, "need-data",
       G_CALLBACK (convert_frame_need_data_callback),
       gst_video_convert_frame_context_ref (ctx),
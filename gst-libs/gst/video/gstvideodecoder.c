@@ -66,6 +66,12 @@
  *     and offset tracking, and possibly to requeue the frame for a later
  *     attempt in the case of reverse playback.
  *
+ *   * Subclasses that can decode several frames at once can implement
+ *     @handle_frame_threaded and enable it with
+ *     @gst_video_decoder_set_frame_threads. Sync point frames are then
+ *     decoded by a pool of worker threads and the base class finishes
+ *     them in decoding order.
+ *
  * ## Shutdown phase
  *
  *   * The GstVideoDecoder class calls @stop to inform the subclass that data
@@ -289,13 +295,115 @@ GST_DEBUG_CATEGORY (videodecoder_debug);
 
 /* properties */
 #define DEFAULT_QOS                 TRUE
+#define DEFAULT_OUTPUT_QUEUE_SIZE   0
+#define DEFAULT_MAX_POOL_SIZE       0
+#define DEFAULT_DROP_DROPPABLE      FALSE
+
+/* number of acquired output buffers after which the pool is shrunk again
+ * if decoding never had to wait for a free buffer. The pool is only grown
+ * when decoding had to wait at least POOL_ADAPT_MIN_WAITS times within
+ * one such window, a single stall is not worth more memory */
+#define POOL_ADAPT_WINDOW           300
+#define POOL_ADAPT_MIN_WAITS        2
 
 enum
 {
   PROP_0,
   PROP_QOS,
+  PROP_OUTPUT_QUEUE_SIZE,
+  PROP_MAX_POOL_SIZE,
+  PROP_DROP_DROPPABLE,
 };
 
+/* Counts the output buffers that are out of the pool. The dispose function
+ * of every acquired buffer is chained with pool_track_dispose(), which runs
+ * when the last reference is dropped and the buffer goes back to its pool.
+ * The state is kept in qdata, so it is invisible to downstream elements and
+ * never ends up on copies of the buffer */
+typedef struct
+{
+  gint refcount;
+  gint outstanding;
+} PoolTracker;
+
+typedef struct
+{
+  PoolTracker *tracker;
+  GstMiniObjectDisposeFunction dispose;
+  gint acquired;
+} PoolTrackData;
+
+static PoolTracker *
+pool_tracker_ref (PoolTracker * tracker)
+{
+  g_atomic_int_inc (&tracker->refcount);
+  return tracker;
+}
+
+static void
+pool_tracker_unref (PoolTracker * tracker)
+{
+  if (g_atomic_int_dec_and_test (&tracker->refcount))
+    g_slice_free (PoolTracker, tracker);
+}
+
+static GQuark
+pool_track_quark (void)
+{
+  static GQuark quark = 0;
+
+  if (G_UNLIKELY (quark == 0))
+    quark = g_quark_from_static_string ("GstVideoDecoderPoolTrack");
+
+  return quark;
+}
+
+static void
+pool_track_data_free (PoolTrackData * data)
+{
+  pool_tracker_unref (data->tracker);
+  g_slice_free (PoolTrackData, data);
+}
+
+static gboolean
+pool_track_dispose (GstMiniObject * obj)
+{
+  PoolTrackData *data = gst_mini_object_get_qdata (obj, pool_track_quark ());
+
+  /* also called when the pool finally frees the buffer, only count the
+   * return after an acquisition */
+  if (g_atomic_int_compare_and_exchange (&data->acquired, TRUE, FALSE))
+    g_atomic_int_add (&data->tracker->outstanding, -1);
+
+  return data->dispose ? data->dispose (obj) : TRUE;
+}
+
+/* Marks @buffer, just acquired from the pool, as out of the pool */
+static guint
+pool_tracker_track (PoolTracker * tracker, GstBuffer * buffer)
+{
+  GstMiniObject *obj = GST_MINI_OBJECT_CAST (buffer);
+  PoolTrackData *data;
+
+  data = gst_mini_object_get_qdata (obj, pool_track_quark ());
+  if (data == NULL) {
+    data = g_slice_new0 (PoolTrackData);
+    data->tracker = pool_tracker_ref (tracker);
+    data->dispose = obj->dispose;
+    obj->dispose = pool_track_dispose;
+    gst_mini_object_set_qdata (obj, pool_track_quark (), data,
+        (GDestroyNotify) pool_track_data_free);
+  } else if (data->tracker != tracker) {
+    /* the pool is shared with another decoder */
+    pool_tracker_unref (data->tracker);
+    data->tracker = pool_tracker_ref (tracker);
+  }
+
+  g_atomic_int_set (&data->acquired, TRUE);
+
+  return g_atomic_int_add (&tracker->outstanding, 1) + 1;
+}
+
 struct _GstVideoDecoderPrivate
 {
   /* FIXME introduce a context ? */
@@ -304,6 +412,22 @@ struct _GstVideoDecoderPrivate
   GstAllocator *allocator;
   GstAllocationParams params;
 
+  /* output pool statistics, OBJECT_LOCK */
+  PoolTracker *pool_tracker;
+  guint pool_min, pool_max;
+  guint max_pool_outstanding;
+  guint64 pool_acquired;
+  guint64 pool_waits;
+  GstClockTime pool_wait_time;
+  GstClockTime max_pool_wait_time;
+
+  /* adaptive pool sizing, see the max-pool-size property */
+  guint max_pool_size;
+  guint pool_extra;
+  guint pool_window_acquired;
+  guint pool_window_waits;
+  guint pool_window_outstanding;
+
   /* parse tracking */
   /* input data */
   GstAdapter *input_adapter;
@@ -377,13 +501,14 @@ struct _GstVideoDecoderPrivate
   guint32 system_frame_number;
   guint32 decode_frame_number;
 
-  GList *frames;                /* Protected with OBJECT_LOCK */
+  GstVideoCodecFrameTable frames;       /* Protected with STREAM_LOCK */
   GstVideoCodecState *input_state;
   GstVideoCodecState *output_state;     /* OBJECT_LOCK and STREAM_LOCK */
   gboolean output_state_changed;
 
   /* QoS properties */
   gboolean do_qos;
+  gboolean drop_droppable;      /* OBJECT_LOCK */
   gdouble proportion;           /* OBJECT_LOCK */
   GstClockTime earliest_time;   /* OBJECT_LOCK */
   GstClockTime qos_frame_duration;      /* OBJECT_LOCK */
@@ -411,6 +536,24 @@ struct _GstVideoDecoderPrivate
   /* flags */
   gboolean use_default_pad_acceptcaps;
 
+  /* frame threading, see gst_video_decoder_set_frame_threads() */
+  guint frame_threads;          /* written with STREAM_LOCK and frame_jobs_lock */
+  GThreadPool *frame_pool;
+  GMutex frame_jobs_lock;
+  GCond frame_jobs_cond;
+  GQueue frame_jobs;            /* FrameJob, in decoding order */
+  guint max_queued_frames;      /* frame_jobs_lock */
+  guint64 threaded_frames;      /* frame_jobs_lock */
+  GstClockTime threaded_latency;        /* frame_jobs_lock */
+
+  /* output thread, see the output-queue-size property */
+  guint output_queue_size;     /* OBJECT_LOCK */
+  GMutex output_lock;
+  GCond output_cond;
+  GQueue output_queue;          /* GstBuffer, output_lock */
+  gboolean output_pushing;      /* output_lock */
+  GstFlowReturn output_flow;    /* output_lock */
+
 #ifndef GST_DISABLE_DEBUG
   /* Diagnostic time for reporting the time
    * from flush to first output */
@@ -443,6 +586,12 @@ static gboolean gst_video_decoder_sink_query (GstPad * pad, GstObject * parent,
     GstQuery * query);
 static GstStateChangeReturn gst_video_decoder_change_state (GstElement *
     element, GstStateChange transition);
+static gboolean gst_video_decoder_src_activate_mode (GstPad * pad,
+    GstObject * parent, GstPadMode mode, gboolean active);
+static GstFlowReturn gst_video_decoder_drain_output_queue (GstVideoDecoder *
+    decoder);
+static void gst_video_decoder_flush_output_queue (GstVideoDecoder * decoder,
+    GstFlowReturn flow);
 static gboolean gst_video_decoder_src_query (GstPad * pad, GstObject * parent,
     GstQuery * query);
 static void gst_video_decoder_reset (GstVideoDecoder * decoder, gboolean full,
@@ -463,6 +612,8 @@ static GstFlowReturn gst_video_decoder_flush_parse (GstVideoDecoder * dec,
     gboolean at_eos);
 
 static void gst_video_decoder_clear_queues (GstVideoDecoder * dec);
+static GstFlowReturn gst_video_decoder_finish_frame_jobs (GstVideoDecoder *
+    decoder, guint max_pending, gboolean discard);
 
 static gboolean gst_video_decoder_sink_event_default (GstVideoDecoder * decoder,
     GstEvent * event);
@@ -570,6 +721,56 @@ gst_video_decoder_class_init (GstVideoDecoderClass * klass)
       g_param_spec_boolean ("qos", "Quality of Service",
           "Handle Quality-of-Service events from downstream",
           DEFAULT_QOS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstVideoDecoder:output-queue-size:
+   *
+   * Maximum number of decoded buffers queued for a separate output thread
+   * that pushes them downstream, so that a slow downstream does not block
+   * decoding. 0 disables the output thread and pushes buffers from the
+   * decoding thread.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_OUTPUT_QUEUE_SIZE,
+      g_param_spec_uint ("output-queue-size", "Output queue size",
+          "Maximum number of buffers queued for the output thread "
+          "(0 = push from the decoding thread)", 0, G_MAXUINT,
+          DEFAULT_OUTPUT_QUEUE_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstVideoDecoder:max-pool-size:
+   *
+   * Upper bound for the number of buffers in a bounded output buffer pool.
+   * When decoding repeatedly has to wait for a free output buffer, the
+   * allocation query is redone for a pool with more buffers, up to this
+   * size. The caps are not renegotiated for that. The pool is shrunk back
+   * towards the size requested by downstream when the extra buffers are
+   * not used. 0 disables adaptive pool sizing.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_POOL_SIZE,
+      g_param_spec_uint ("max-pool-size", "Maximum pool size",
+          "Maximum number of buffers the output buffer pool is grown to "
+          "(0 = keep the size negotiated with downstream)", 0, G_MAXUINT,
+          DEFAULT_MAX_POOL_SIZE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstVideoDecoder:drop-droppable:
+   *
+   * If set to %TRUE and #GstVideoDecoder:qos is enabled, frames that are not
+   * sync points and carry the %GST_BUFFER_FLAG_DROPPABLE flag are dropped
+   * before decoding when they are already too late. Only enable this when
+   * upstream sets the flag on frames that no other frame references.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_DROP_DROPPABLE,
+      g_param_spec_boolean ("drop-droppable", "Drop droppable",
+          "Drop late frames flagged as droppable before decoding them",
+          DEFAULT_DROP_DROPPABLE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -581,6 +782,20 @@ gst_video_decoder_init (GstVideoDecoder * decoder, GstVideoDecoderClass * klass)
   GST_DEBUG_OBJECT (decoder, "gst_video_decoder_init");
 
   decoder->priv = gst_video_decoder_get_instance_private (decoder);
+  __gst_video_codec_frame_table_init (&decoder->priv->frames);
+  decoder->priv->frame_threads = 1;
+  g_mutex_init (&decoder->priv->frame_jobs_lock);
+  g_cond_init (&decoder->priv->frame_jobs_cond);
+  g_queue_init (&decoder->priv->frame_jobs);
+  decoder->priv->output_queue_size = DEFAULT_OUTPUT_QUEUE_SIZE;
+  g_mutex_init (&decoder->priv->output_lock);
+  g_cond_init (&decoder->priv->output_cond);
+  g_queue_init (&decoder->priv->output_queue);
+  decoder->priv->output_flow = GST_FLOW_FLUSHING;
+  decoder->priv->max_pool_size = DEFAULT_MAX_POOL_SIZE;
+  decoder->priv->drop_droppable = DEFAULT_DROP_DROPPABLE;
+  decoder->priv->pool_tracker = g_slice_new0 (PoolTracker);
+  decoder->priv->pool_tracker->refcount = 1;
 
   pad_template =
       gst_element_class_get_pad_template (GST_ELEMENT_CLASS (klass), "sink");
@@ -605,6 +820,8 @@ gst_video_decoder_init (GstVideoDecoder * decoder, GstVideoDecoderClass * klass)
       GST_DEBUG_FUNCPTR (gst_video_decoder_src_event));
   gst_pad_set_query_function (pad,
       GST_DEBUG_FUNCPTR (gst_video_decoder_src_query));
+  gst_pad_set_activatemode_function (pad,
+      GST_DEBUG_FUNCPTR (gst_video_decoder_src_activate_mode));
   gst_element_add_pad (GST_ELEMENT (decoder), decoder->srcpad);
 
   gst_segment_init (&decoder->input_segment, GST_FORMAT_TIME);
@@ -792,8 +1009,24 @@ gst_video_decoder_finalize (GObject * object)
 
   GST_DEBUG_OBJECT (object, "finalize");
 
+  if (decoder->priv->frame_pool) {
+    gst_video_decoder_finish_frame_jobs (decoder, 0, TRUE);
+    g_thread_pool_free (decoder->priv->frame_pool, FALSE, TRUE);
+    decoder->priv->frame_pool = NULL;
+  }
+  g_mutex_clear (&decoder->priv->frame_jobs_lock);
+  g_cond_clear (&decoder->priv->frame_jobs_cond);
+
+  g_queue_foreach (&decoder->priv->output_queue, (GFunc) gst_buffer_unref,
+      NULL);
+  g_queue_clear (&decoder->priv->output_queue);
+  g_mutex_clear (&decoder->priv->output_lock);
+  g_cond_clear (&decoder->priv->output_cond);
+
   g_rec_mutex_clear (&decoder->stream_lock);
 
+  __gst_video_codec_frame_table_free (&decoder->priv->frames);
+
   if (decoder->priv->input_adapter) {
     g_object_unref (decoder->priv->input_adapter);
     decoder->priv->input_adapter = NULL;
@@ -812,6 +1045,8 @@ gst_video_decoder_finalize (GObject * object)
     gst_object_unref (decoder->priv->pool);
     decoder->priv->pool = NULL;
   }
+  /* buffers still out of the pool keep the tracker alive */
+  pool_tracker_unref (decoder->priv->pool_tracker);
 
   if (decoder->priv->allocator) {
     gst_object_unref (decoder->priv->allocator);
@@ -831,6 +1066,21 @@ gst_video_decoder_get_property (GObject * object, guint property_id,
     case PROP_QOS:
       g_value_set_boolean (value, priv->do_qos);
       break;
+    case PROP_OUTPUT_QUEUE_SIZE:
+      GST_OBJECT_LOCK (object);
+      g_value_set_uint (value, priv->output_queue_size);
+      GST_OBJECT_UNLOCK (object);
+      break;
+    case PROP_DROP_DROPPABLE:
+      GST_OBJECT_LOCK (object);
+      g_value_set_boolean (value, priv->drop_droppable);
+      GST_OBJECT_UNLOCK (object);
+      break;
+    case PROP_MAX_POOL_SIZE:
+      GST_OBJECT_LOCK (object);
+      g_value_set_uint (value, priv->max_pool_size);
+      GST_OBJECT_UNLOCK (object);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -847,6 +1097,21 @@ gst_video_decoder_set_property (GObject * object, guint property_id,
     case PROP_QOS:
       priv->do_qos = g_value_get_boolean (value);
       break;
+    case PROP_OUTPUT_QUEUE_SIZE:
+      GST_OBJECT_LOCK (object);
+      priv->output_queue_size = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (object);
+      break;
+    case PROP_DROP_DROPPABLE:
+      GST_OBJECT_LOCK (object);
+      priv->drop_droppable = g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (object);
+      break;
+    case PROP_MAX_POOL_SIZE:
+      GST_OBJECT_LOCK (object);
+      priv->max_pool_size = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (object);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -862,6 +1127,9 @@ gst_video_decoder_flush (GstVideoDecoder * dec, gboolean hard)
 
   GST_LOG_OBJECT (dec, "flush hard %d", hard);
 
+  /* the subclass must not be decoding anything while it is flushed */
+  ret = gst_video_decoder_finish_frame_jobs (dec, 0, hard);
+
   /* Inform subclass */
   if (klass->reset) {
     GST_FIXME_OBJECT (dec, "GstVideoDecoder::reset() is deprecated");
@@ -933,6 +1201,13 @@ gst_video_decoder_push_event (GstVideoDecoder * decoder, GstEvent * event)
       break;
   }
 
+  if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_START) {
+    gst_video_decoder_flush_output_queue (decoder, GST_FLOW_FLUSHING);
+  } else if (GST_EVENT_IS_SERIALIZED (event)) {
+    /* keep the order with the buffers of the output thread */
+    gst_video_decoder_drain_output_queue (decoder);
+  }
+
   GST_DEBUG_OBJECT (decoder, "pushing event %s",
       gst_event_type_get_name (GST_EVENT_TYPE (event)));
 
@@ -1003,6 +1278,13 @@ gst_video_decoder_drain_out (GstVideoDecoder * dec, gboolean at_eos)
       ret = gst_video_decoder_parse_available (dec, TRUE, FALSE);
     }
 
+    /* output everything still being decoded in worker threads before
+     * the subclass drains, or discard it after an error */
+    if (ret == GST_FLOW_OK)
+      ret = gst_video_decoder_finish_frame_jobs (dec, 0, FALSE);
+    else
+      gst_video_decoder_finish_frame_jobs (dec, 0, TRUE);
+
     if (at_eos) {
       if (decoder_class->finish)
         ret = decoder_class->finish (dec);
@@ -1376,7 +1658,12 @@ gst_video_decoder_sink_event_default (GstVideoDecoder * decoder,
       GList *l;
 
       GST_VIDEO_DECODER_STREAM_LOCK (decoder);
-      for (l = priv->frames; l; l = l->next) {
+      /* wait for the output thread to stop and accept buffers again */
+      gst_pad_pause_task (decoder->srcpad);
+      gst_video_decoder_flush_output_queue (decoder, GST_FLOW_OK);
+
+      for (l = __gst_video_codec_frame_table_head (&priv->frames); l;
+          l = l->next) {
         GstVideoCodecFrame *frame = l->data;
 
         frame->events = _flush_events (decoder->srcpad, frame->events);
@@ -2067,8 +2354,7 @@ gst_video_decoder_clear_queues (GstVideoDecoder * dec)
   g_list_free_full (priv->parse_gather,
       (GDestroyNotify) gst_video_codec_frame_unref);
   priv->parse_gather = NULL;
-  g_list_free_full (priv->frames, (GDestroyNotify) gst_video_codec_frame_unref);
-  priv->frames = NULL;
+  __gst_video_codec_frame_table_clear (&priv->frames);
 }
 
 static void
@@ -2147,6 +2433,16 @@ gst_video_decoder_reset (GstVideoDecoder * decoder, gboolean full,
       priv->pool = NULL;
     }
 
+    GST_OBJECT_LOCK (decoder);
+    priv->pool_min = priv->pool_max = 0;
+    priv->max_pool_outstanding = 0;
+    priv->pool_acquired = priv->pool_waits = 0;
+    priv->pool_wait_time = priv->max_pool_wait_time = 0;
+    priv->pool_extra = 0;
+    priv->pool_window_acquired = priv->pool_window_waits = 0;
+    priv->pool_window_outstanding = 0;
+    GST_OBJECT_UNLOCK (decoder);
+
     if (priv->allocator) {
       gst_object_unref (priv->allocator);
       priv->allocator = NULL;
@@ -2276,6 +2572,12 @@ gst_video_decoder_flush_decode (GstVideoDecoder * dec)
     walk = next;
   }
 
+  /* all frames need to be in the output queue before it is reversed */
+  if (res == GST_FLOW_OK)
+    res = gst_video_decoder_finish_frame_jobs (dec, 0, FALSE);
+  else
+    gst_video_decoder_finish_frame_jobs (dec, 0, TRUE);
+
   return res;
 }
 
@@ -2587,6 +2889,10 @@ gst_video_decoder_change_state (GstElement * element, GstStateChange transition)
     case GST_STATE_CHANGE_PAUSED_TO_READY:{
       gboolean stopped = TRUE;
 
+      GST_VIDEO_DECODER_STREAM_LOCK (decoder);
+      gst_video_decoder_finish_frame_jobs (decoder, 0, TRUE);
+      GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
+
       if (decoder_class->stop)
         stopped = decoder_class->stop (decoder);
 
@@ -2693,7 +2999,7 @@ gst_video_decoder_prepare_finish_frame (GstVideoDecoder *
 
 #ifndef GST_DISABLE_GST_DEBUG
   GST_LOG_OBJECT (decoder, "n %d in %" G_GSIZE_FORMAT " out %" G_GSIZE_FORMAT,
-      g_list_length (priv->frames),
+      __gst_video_codec_frame_table_length (&priv->frames),
       gst_adapter_available (priv->input_adapter),
       gst_adapter_available (priv->output_adapter));
 #endif
@@ -2707,7 +3013,8 @@ gst_video_decoder_prepare_finish_frame (GstVideoDecoder *
       sync, GST_TIME_ARGS (frame->pts), GST_TIME_ARGS (frame->dts));
 
   /* Push all pending events that arrived before this frame */
-  for (l = priv->frames; l; l = l->next) {
+  for (l = __gst_video_codec_frame_table_head (&priv->frames); l;
+      l = l->next) {
     GstVideoCodecFrame *tmp = l->data;
 
     if (tmp->events) {
@@ -2767,7 +3074,8 @@ gst_video_decoder_prepare_finish_frame (GstVideoDecoder *
     gboolean seen_none = FALSE;
 
     /* some maintenance regardless */
-    for (l = priv->frames; l; l = l->next) {
+    for (l = __gst_video_codec_frame_table_head (&priv->frames); l;
+        l = l->next) {
       GstVideoCodecFrame *tmp = l->data;
 
       if (!GST_CLOCK_TIME_IS_VALID (tmp->abidata.ABI.ts)) {
@@ -2801,7 +3109,8 @@ gst_video_decoder_prepare_finish_frame (GstVideoDecoder *
     /* some more maintenance, ts2 holds PTS */
     min_ts = GST_CLOCK_TIME_NONE;
     seen_none = FALSE;
-    for (l = priv->frames; l; l = l->next) {
+    for (l = __gst_video_codec_frame_table_head (&priv->frames); l;
+        l = l->next) {
       GstVideoCodecFrame *tmp = l->data;
 
       if (!GST_CLOCK_TIME_IS_VALID (tmp->abidata.ABI.ts2)) {
@@ -2893,15 +3202,9 @@ void
 gst_video_decoder_release_frame (GstVideoDecoder * dec,
     GstVideoCodecFrame * frame)
 {
-  GList *link;
-
   /* unref once from the list */
   GST_VIDEO_DECODER_STREAM_LOCK (dec);
-  link = g_list_find (dec->priv->frames, frame);
-  if (link) {
-    gst_video_codec_frame_unref (frame);
-    dec->priv->frames = g_list_delete_link (dec->priv->frames, link);
-  }
+  __gst_video_codec_frame_table_remove (&dec->priv->frames, frame);
   if (frame->events) {
     dec->priv->pending_events =
         g_list_concat (frame->events, dec->priv->pending_events);
@@ -3155,6 +3458,144 @@ done:
   return ret;
 }
 
+static void
+gst_video_decoder_output_loop (GstVideoDecoder * decoder)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  GstFlowReturn ret;
+  GstBuffer *buf;
+
+  g_mutex_lock (&priv->output_lock);
+  while (g_queue_is_empty (&priv->output_queue)
+      && priv->output_flow == GST_FLOW_OK)
+    g_cond_wait (&priv->output_cond, &priv->output_lock);
+
+  if (priv->output_flow != GST_FLOW_OK)
+    goto pause;
+
+  buf = g_queue_pop_head (&priv->output_queue);
+  priv->output_pushing = TRUE;
+  g_cond_broadcast (&priv->output_cond);
+  g_mutex_unlock (&priv->output_lock);
+
+  ret = gst_pad_push (decoder->srcpad, buf);
+
+  g_mutex_lock (&priv->output_lock);
+  priv->output_pushing = FALSE;
+  if (ret != GST_FLOW_OK && priv->output_flow == GST_FLOW_OK)
+    priv->output_flow = ret;
+  g_cond_broadcast (&priv->output_cond);
+
+  if (priv->output_flow != GST_FLOW_OK)
+    goto pause;
+  g_mutex_unlock (&priv->output_lock);
+
+  return;
+
+pause:
+  {
+    GST_DEBUG_OBJECT (decoder, "pausing output thread, reason %s",
+        gst_flow_get_name (priv->output_flow));
+    /* the decoding thread gets the flow return for the next buffer */
+    g_queue_foreach (&priv->output_queue, (GFunc) gst_buffer_unref, NULL);
+    g_queue_clear (&priv->output_queue);
+    g_cond_broadcast (&priv->output_cond);
+    g_mutex_unlock (&priv->output_lock);
+    gst_pad_pause_task (decoder->srcpad);
+  }
+}
+
+/* With STREAM_LOCK, takes the buffer reference */
+static GstFlowReturn
+gst_video_decoder_queue_output (GstVideoDecoder * decoder, GstBuffer * buf,
+    guint queue_size)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  GstFlowReturn ret;
+
+  g_mutex_lock (&priv->output_lock);
+  ret = priv->output_flow;
+  g_mutex_unlock (&priv->output_lock);
+
+  if (ret == GST_FLOW_OK)
+    gst_pad_start_task (decoder->srcpad,
+        (GstTaskFunction) gst_video_decoder_output_loop, decoder, NULL);
+
+  /* release STREAM_LOCK not to block upstream
+   * while waiting for the output thread */
+  GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
+  g_mutex_lock (&priv->output_lock);
+  while (priv->output_flow == GST_FLOW_OK
+      && priv->output_queue.length >= queue_size)
+    g_cond_wait (&priv->output_cond, &priv->output_lock);
+
+  ret = priv->output_flow;
+  if (ret == GST_FLOW_OK) {
+    g_queue_push_tail (&priv->output_queue, buf);
+    g_cond_broadcast (&priv->output_cond);
+    buf = NULL;
+  }
+  g_mutex_unlock (&priv->output_lock);
+  GST_VIDEO_DECODER_STREAM_LOCK (decoder);
+
+  if (buf)
+    gst_buffer_unref (buf);
+
+  return ret;
+}
+
+/* Waits until the output thread pushed all queued buffers */
+static GstFlowReturn
+gst_video_decoder_drain_output_queue (GstVideoDecoder * decoder)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  GstFlowReturn ret;
+
+  g_mutex_lock (&priv->output_lock);
+  while (priv->output_flow == GST_FLOW_OK
+      && (!g_queue_is_empty (&priv->output_queue) || priv->output_pushing))
+    g_cond_wait (&priv->output_cond, &priv->output_lock);
+  ret = priv->output_flow;
+  g_mutex_unlock (&priv->output_lock);
+
+  return ret;
+}
+
+/* Drops all queued buffers, a @flow other than GST_FLOW_OK makes the output
+ * thread pause and is returned for new buffers */
+static void
+gst_video_decoder_flush_output_queue (GstVideoDecoder * decoder,
+    GstFlowReturn flow)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+
+  g_mutex_lock (&priv->output_lock);
+  g_queue_foreach (&priv->output_queue, (GFunc) gst_buffer_unref, NULL);
+  g_queue_clear (&priv->output_queue);
+  priv->output_flow = flow;
+  g_cond_broadcast (&priv->output_cond);
+  g_mutex_unlock (&priv->output_lock);
+}
+
+static gboolean
+gst_video_decoder_src_activate_mode (GstPad * pad, GstObject * parent,
+    GstPadMode mode, gboolean active)
+{
+  GstVideoDecoder *decoder = GST_VIDEO_DECODER (parent);
+
+  if (mode != GST_PAD_MODE_PUSH)
+    return FALSE;
+
+  if (active) {
+    gst_video_decoder_flush_output_queue (decoder, GST_FLOW_OK);
+  } else {
+    gst_video_decoder_flush_output_queue (decoder, GST_FLOW_FLUSHING);
+    gst_pad_stop_task (pad);
+  }
+
+  return TRUE;
+}
+
 /* With stream lock, takes the frame reference */
 static GstFlowReturn
 gst_video_decoder_clip_and_push_buf (GstVideoDecoder * decoder, GstBuffer * buf)
@@ -3165,6 +3606,7 @@ gst_video_decoder_clip_and_push_buf (GstVideoDecoder * decoder, GstBuffer * buf)
   guint64 cstart, cstop;
   GstSegment *segment;
   GstClockTime duration;
+  guint output_queue_size;
 
   /* Check for clipping */
   start = GST_BUFFER_PTS (buf);
@@ -3267,6 +3709,7 @@ gst_video_decoder_clip_and_push_buf (GstVideoDecoder * decoder, GstBuffer * buf)
     /* better none than nothing valid */
     priv->time = GST_CLOCK_TIME_NONE;
   }
+  output_queue_size = priv->output_queue_size;
   GST_OBJECT_UNLOCK (decoder);
 
   GST_DEBUG_OBJECT (decoder, "pushing buffer %p of size %" G_GSIZE_FORMAT ", "
@@ -3291,6 +3734,19 @@ gst_video_decoder_clip_and_push_buf (GstVideoDecoder * decoder, GstBuffer * buf)
   }
 #endif
 
+  if (output_queue_size > 0) {
+    ret = gst_video_decoder_queue_output (decoder, buf, output_queue_size);
+    goto done;
+  }
+
+  /* buffers that are still queued go first if the output thread was
+   * disabled in the meantime */
+  ret = gst_video_decoder_drain_output_queue (decoder);
+  if (ret != GST_FLOW_OK && ret != GST_FLOW_FLUSHING) {
+    gst_buffer_unref (buf);
+    goto done;
+  }
+
   /* release STREAM_LOCK not to block upstream 
    * while pushing buffer downstream */
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
@@ -3447,6 +3903,180 @@ gst_video_decoder_have_frame (GstVideoDecoder * decoder)
   return ret;
 }
 
+typedef struct _FrameJob FrameJob;
+
+struct _FrameJob
+{
+  GstVideoCodecFrame *frame;
+  GstFlowReturn ret;
+  gboolean done;
+  GstClockTime queued;
+};
+
+static void
+gst_video_decoder_frame_thread_func (gpointer data, gpointer user_data)
+{
+  FrameJob *job = data;
+  GstVideoDecoder *decoder = user_data;
+  GstVideoDecoderClass *decoder_class = GST_VIDEO_DECODER_GET_CLASS (decoder);
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  GstFlowReturn ret;
+
+  ret = decoder_class->handle_frame_threaded (decoder, job->frame);
+
+  g_mutex_lock (&priv->frame_jobs_lock);
+  job->ret = ret;
+  job->done = TRUE;
+  g_cond_broadcast (&priv->frame_jobs_cond);
+  g_mutex_unlock (&priv->frame_jobs_lock);
+}
+
+/* Finishes the decoded frames at the head of the job queue in decoding
+ * order, waiting for running jobs until at most @max_pending are left.
+ * With @discard, the frames are released instead of pushed.
+ * Must be called with the STREAM_LOCK */
+static GstFlowReturn
+gst_video_decoder_finish_frame_jobs (GstVideoDecoder * decoder,
+    guint max_pending, gboolean discard)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  GstFlowReturn ret = GST_FLOW_OK;
+  FrameJob *job;
+
+  g_mutex_lock (&priv->frame_jobs_lock);
+  while ((job = g_queue_peek_head (&priv->frame_jobs))) {
+    if (!job->done) {
+      if (priv->frame_jobs.length <= max_pending)
+        break;
+      g_cond_wait (&priv->frame_jobs_cond, &priv->frame_jobs_lock);
+      continue;
+    }
+
+    g_queue_pop_head (&priv->frame_jobs);
+    priv->threaded_frames++;
+    priv->threaded_latency += gst_util_get_timestamp () - job->queued;
+    g_mutex_unlock (&priv->frame_jobs_lock);
+
+    if (discard || ret != GST_FLOW_OK || job->ret != GST_FLOW_OK) {
+      if (!discard && ret == GST_FLOW_OK) {
+        GST_DEBUG_OBJECT (decoder, "threaded decoding of frame %d failed: %s",
+            job->frame->system_frame_number, gst_flow_get_name (job->ret));
+        ret = job->ret;
+      }
+      gst_video_decoder_release_frame (decoder, job->frame);
+    } else {
+      ret = gst_video_decoder_finish_frame (decoder, job->frame);
+    }
+    g_slice_free (FrameJob, job);
+
+    g_mutex_lock (&priv->frame_jobs_lock);
+  }
+  g_mutex_unlock (&priv->frame_jobs_lock);
+
+  return ret;
+}
+
+/* Hands @frame to a worker thread. Sync points don't depend on earlier
+ * frames and are decoded in parallel, other frames are decoded right here
+ * once everything before them is done. */
+static GstFlowReturn
+gst_video_decoder_decode_frame_threaded (GstVideoDecoder * decoder,
+    GstVideoCodecFrame * frame)
+{
+  GstVideoDecoderClass *decoder_class = GST_VIDEO_DECODER_GET_CLASS (decoder);
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  GstFlowReturn ret;
+  FrameJob *job;
+
+  if (G_UNLIKELY (priv->frame_pool == NULL)) {
+    GError *err = NULL;
+
+    priv->frame_pool = g_thread_pool_new (gst_video_decoder_frame_thread_func,
+        decoder, priv->frame_threads, FALSE, &err);
+    if (priv->frame_pool == NULL) {
+      GST_WARNING_OBJECT (decoder, "failed to create thread pool: %s",
+          err->message);
+      g_clear_error (&err);
+      priv->frame_threads = 1;
+      return decoder_class->handle_frame (decoder, frame);
+    }
+  }
+
+  /* make room for this frame first, every running job holds an output
+   * buffer and only this thread gives them back */
+  if (GST_VIDEO_CODEC_FRAME_IS_SYNC_POINT (frame))
+    ret = gst_video_decoder_finish_frame_jobs (decoder,
+        priv->frame_threads - 1, FALSE);
+  else
+    ret = gst_video_decoder_finish_frame_jobs (decoder, 0, FALSE);
+
+  if (ret == GST_FLOW_OK)
+    ret = gst_video_decoder_allocate_output_frame (decoder, frame);
+  if (ret != GST_FLOW_OK) {
+    gst_video_decoder_release_frame (decoder, frame);
+    return ret;
+  }
+
+  if (!GST_VIDEO_CODEC_FRAME_IS_SYNC_POINT (frame)) {
+    ret = decoder_class->handle_frame_threaded (decoder, frame);
+    if (ret == GST_FLOW_OK)
+      ret = gst_video_decoder_finish_frame (decoder, frame);
+    else
+      gst_video_decoder_release_frame (decoder, frame);
+
+    return ret;
+  }
+
+  job = g_slice_new0 (FrameJob);
+  job->frame = frame;
+  job->queued = gst_util_get_timestamp ();
+
+  g_mutex_lock (&priv->frame_jobs_lock);
+  g_queue_push_tail (&priv->frame_jobs, job);
+  priv->max_queued_frames =
+      MAX (priv->max_queued_frames, priv->frame_jobs.length);
+  g_mutex_unlock (&priv->frame_jobs_lock);
+
+  g_thread_pool_push (priv->frame_pool, job, NULL);
+
+  /* push what is already done without waiting */
+  return gst_video_decoder_finish_frame_jobs (decoder, G_MAXUINT, FALSE);
+}
+
+/* With drop-droppable, frames that are not sync points and flagged
+ * DROPPABLE by upstream are considered not referenced by other frames and
+ * can be dropped before decoding */
+static gboolean
+gst_video_decoder_can_skip_frame (GstVideoDecoder * decoder,
+    GstVideoCodecFrame * frame)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  GstClockTime earliest_time;
+  gboolean drop_droppable;
+
+  GST_OBJECT_LOCK (decoder);
+  drop_droppable = priv->drop_droppable;
+  GST_OBJECT_UNLOCK (decoder);
+
+  if (!drop_droppable || !priv->do_qos || decoder->input_segment.rate < 0.0)
+    return FALSE;
+
+  if (GST_VIDEO_CODEC_FRAME_IS_SYNC_POINT (frame)
+      || !GST_BUFFER_FLAG_IS_SET (frame->input_buffer,
+          GST_BUFFER_FLAG_DROPPABLE))
+    return FALSE;
+
+  if (!GST_CLOCK_TIME_IS_VALID (frame->deadline))
+    return FALSE;
+
+  GST_OBJECT_LOCK (decoder);
+  earliest_time = priv->earliest_time;
+  GST_OBJECT_UNLOCK (decoder);
+
+  return GST_CLOCK_TIME_IS_VALID (earliest_time)
+      && frame->deadline < earliest_time;
+}
+
 /* Pass the frame in priv->current_frame through the
  * handle_frame() callback for decoding and passing to gvd_finish_frame(),
  * or dropping by passing to gvd_drop_frame() */
@@ -3492,20 +4122,44 @@ gst_video_decoder_decode_frame (GstVideoDecoder * decoder,
       ", dist %d", GST_TIME_ARGS (frame->pts), GST_TIME_ARGS (frame->dts),
       frame->distance_from_sync);
 
-  gst_video_codec_frame_ref (frame);
-  priv->frames = g_list_append (priv->frames, frame);
+  __gst_video_codec_frame_table_push (&priv->frames, frame);
 
-  if (g_list_length (priv->frames) > 10) {
+  if (__gst_video_codec_frame_table_length (&priv->frames) > 10) {
     GST_DEBUG_OBJECT (decoder, "decoder frame list getting long: %d frames,"
-        "possible internal leaking?", g_list_length (priv->frames));
+        "possible internal leaking?",
+        __gst_video_codec_frame_table_length (&priv->frames));
   }
 
   frame->deadline =
       gst_segment_to_running_time (&decoder->input_segment, GST_FORMAT_TIME,
       frame->pts);
 
+  /* no need to decode a frame that nothing depends on if it is going to be
+   * dropped for being late anyway */
+  if (gst_video_decoder_can_skip_frame (decoder, frame)) {
+    GST_DEBUG_OBJECT (decoder, "skipping decoding of late frame %d, deadline %"
+        GST_TIME_FORMAT, frame->system_frame_number,
+        GST_TIME_ARGS (frame->deadline));
+    ret = gst_video_decoder_finish_frame_jobs (decoder, 0, FALSE);
+    if (ret == GST_FLOW_OK)
+      ret = gst_video_decoder_drop_frame (decoder, frame);
+    else
+      gst_video_decoder_release_frame (decoder, frame);
+    return ret;
+  }
+
   /* do something with frame */
-  ret = decoder_class->handle_frame (decoder, frame);
+  if (priv->frame_threads > 1 && decoder_class->handle_frame_threaded
+      && priv->output_state) {
+    ret = gst_video_decoder_decode_frame_threaded (decoder, frame);
+  } else {
+    /* frames still decoded by worker threads go first */
+    ret = gst_video_decoder_finish_frame_jobs (decoder, 0, FALSE);
+    if (ret == GST_FLOW_OK)
+      ret = decoder_class->handle_frame (decoder, frame);
+    else
+      gst_video_decoder_release_frame (decoder, frame);
+  }
   if (ret != GST_FLOW_OK)
     GST_DEBUG_OBJECT (decoder, "flow error %s", gst_flow_get_name (ret));
 
@@ -3640,8 +4294,9 @@ gst_video_decoder_get_oldest_frame (GstVideoDecoder * decoder)
   GstVideoCodecFrame *frame = NULL;
 
   GST_VIDEO_DECODER_STREAM_LOCK (decoder);
-  if (decoder->priv->frames)
-    frame = gst_video_codec_frame_ref (decoder->priv->frames->data);
+  frame = __gst_video_codec_frame_table_oldest (&decoder->priv->frames);
+  if (frame)
+    gst_video_codec_frame_ref (frame);
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
 
   return (GstVideoCodecFrame *) frame;
@@ -3659,20 +4314,15 @@ gst_video_decoder_get_oldest_frame (GstVideoDecoder * decoder)
 GstVideoCodecFrame *
 gst_video_decoder_get_frame (GstVideoDecoder * decoder, int frame_number)
 {
-  GList *g;
-  GstVideoCodecFrame *frame = NULL;
+  GstVideoCodecFrame *frame;
 
   GST_DEBUG_OBJECT (decoder, "frame_number : %d", frame_number);
 
   GST_VIDEO_DECODER_STREAM_LOCK (decoder);
-  for (g = decoder->priv->frames; g; g = g->next) {
-    GstVideoCodecFrame *tmp = g->data;
-
-    if (tmp->system_frame_number == frame_number) {
-      frame = gst_video_codec_frame_ref (tmp);
-      break;
-    }
-  }
+  frame = __gst_video_codec_frame_table_lookup (&decoder->priv->frames,
+      frame_number);
+  if (frame)
+    gst_video_codec_frame_ref (frame);
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
 
   return frame;
@@ -3692,8 +4342,7 @@ gst_video_decoder_get_frames (GstVideoDecoder * decoder)
   GList *frames;
 
   GST_VIDEO_DECODER_STREAM_LOCK (decoder);
-  frames = g_list_copy (decoder->priv->frames);
-  g_list_foreach (frames, (GFunc) gst_video_codec_frame_ref, NULL);
+  frames = __gst_video_codec_frame_table_copy (&decoder->priv->frames);
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
 
   return frames;
@@ -3741,6 +4390,17 @@ gst_video_decoder_decide_allocation_default (GstVideoDecoder * decoder,
     update_pool = FALSE;
   }
 
+  /* every frame thread holds an output buffer while decoding */
+  if (decoder->priv->frame_threads > 1 && max != 0)
+    max = MAX (max, min + decoder->priv->frame_threads);
+
+  /* buffers added at runtime because decoding had to wait for free ones */
+  GST_OBJECT_LOCK (decoder);
+  if (decoder->priv->pool_extra > 0 && max != 0
+      && decoder->priv->max_pool_size > max)
+    max = MIN (max + decoder->priv->pool_extra, decoder->priv->max_pool_size);
+  GST_OBJECT_UNLOCK (decoder);
+
   if (pool == NULL) {
     /* no pool, we can make our own */
     GST_DEBUG_OBJECT (decoder, "no pool, making new pool");
@@ -3816,6 +4476,7 @@ gst_video_decoder_negotiate_pool (GstVideoDecoder * decoder, GstCaps * caps)
   GstBufferPool *pool = NULL;
   GstAllocator *allocator;
   GstAllocationParams params;
+  guint min = 0, max = 0;
   gboolean ret = TRUE;
 
   klass = GST_VIDEO_DECODER_GET_CLASS (decoder);
@@ -3847,7 +4508,7 @@ gst_video_decoder_negotiate_pool (GstVideoDecoder * decoder, GstCaps * caps)
   }
 
   if (gst_query_get_n_allocation_pools (query) > 0)
-    gst_query_parse_nth_allocation_pool (query, 0, &pool, NULL, NULL, NULL);
+    gst_query_parse_nth_allocation_pool (query, 0, &pool, NULL, &min, &max);
   if (!pool) {
     if (allocator)
       gst_object_unref (allocator);
@@ -3873,6 +4534,13 @@ gst_video_decoder_negotiate_pool (GstVideoDecoder * decoder, GstCaps * caps)
   }
   decoder->priv->pool = pool;
 
+  GST_OBJECT_LOCK (decoder);
+  decoder->priv->pool_min = min;
+  decoder->priv->pool_max = max;
+  decoder->priv->pool_window_acquired = decoder->priv->pool_window_waits = 0;
+  decoder->priv->pool_window_outstanding = 0;
+  GST_OBJECT_UNLOCK (decoder);
+
   /* and activate */
   GST_DEBUG_OBJECT (decoder, "activate pool %" GST_PTR_FORMAT, pool);
   gst_buffer_pool_set_active (pool, TRUE);
@@ -3959,7 +4627,7 @@ gst_video_decoder_negotiate_default (GstVideoDecoder * decoder)
 
   /* Push all pending pre-caps events of the oldest frame before
    * setting caps */
-  frame = decoder->priv->frames ? decoder->priv->frames->data : NULL;
+  frame = __gst_video_codec_frame_table_oldest (&decoder->priv->frames);
   if (frame || decoder->priv->current_frame_events) {
     GList **events, *l;
 
@@ -3989,6 +4657,8 @@ gst_video_decoder_negotiate_default (GstVideoDecoder * decoder)
     if (!prevcaps) {
       GST_DEBUG_OBJECT (decoder, "decoder src pad has currently NULL caps");
     }
+    /* buffers with the previous caps go first */
+    gst_video_decoder_drain_output_queue (decoder);
     ret = gst_pad_set_caps (decoder->srcpad, state->caps);
   } else {
     ret = TRUE;
@@ -4052,6 +4722,109 @@ gst_video_decoder_negotiate (GstVideoDecoder * decoder)
   return ret;
 }
 
+/* With STREAM_LOCK. Only redoes the allocation query to get a pool of the
+ * new size, the caps stay the same. The buffers out of the old pool go back
+ * to it and are freed with it */
+static void
+gst_video_decoder_resize_pool (GstVideoDecoder * decoder)
+{
+  GstVideoCodecState *state = decoder->priv->output_state;
+  GstCaps *caps = NULL;
+
+  if (state && state->allocation_caps)
+    caps = gst_caps_ref (state->allocation_caps);
+  if (caps == NULL || !gst_video_decoder_negotiate_pool (decoder, caps)) {
+    GST_DEBUG_OBJECT (decoder, "failed to resize the pool, renegotiating");
+    gst_pad_mark_reconfigure (decoder->srcpad);
+  }
+
+  if (caps)
+    gst_caps_unref (caps);
+}
+
+/* With STREAM_LOCK. Acquires a buffer from the output pool, keeping track of
+ * the time spent waiting for a free buffer and of the buffers out of the
+ * pool, and adapts the pool size to that */
+static GstFlowReturn
+gst_video_decoder_acquire_buffer (GstVideoDecoder * decoder,
+    GstBuffer ** buffer, GstBufferPoolAcquireParams * params)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  GstBufferPoolAcquireParams try_params = { 0, };
+  GstClockTime wait_time = GST_CLOCK_TIME_NONE;
+  gboolean resize = FALSE;
+  GstFlowReturn flow;
+  guint outstanding, pool_max, pool_extra;
+
+  if (params)
+    try_params = *params;
+  try_params.flags |= GST_BUFFER_POOL_ACQUIRE_FLAG_DONTWAIT;
+
+  flow = gst_buffer_pool_acquire_buffer (priv->pool, buffer, &try_params);
+  if (flow == GST_FLOW_EAGAIN
+      && !(params && (params->flags & GST_BUFFER_POOL_ACQUIRE_FLAG_DONTWAIT))) {
+    GstClockTime start = gst_util_get_timestamp ();
+
+    flow = gst_buffer_pool_acquire_buffer (priv->pool, buffer, params);
+    wait_time = gst_util_get_timestamp () - start;
+    GST_DEBUG_OBJECT (decoder, "waited %" GST_TIME_FORMAT " for a buffer",
+        GST_TIME_ARGS (wait_time));
+  }
+
+  if (flow != GST_FLOW_OK)
+    return flow;
+
+  outstanding = pool_tracker_track (priv->pool_tracker, *buffer);
+
+  GST_OBJECT_LOCK (decoder);
+  priv->pool_acquired++;
+  priv->max_pool_outstanding = MAX (priv->max_pool_outstanding, outstanding);
+  if (GST_CLOCK_TIME_IS_VALID (wait_time)) {
+    priv->pool_waits++;
+    priv->pool_wait_time += wait_time;
+    priv->max_pool_wait_time = MAX (priv->max_pool_wait_time, wait_time);
+  }
+
+  if (priv->max_pool_size > 0 && priv->pool_max > 0) {
+    priv->pool_window_acquired++;
+    priv->pool_window_outstanding =
+        MAX (priv->pool_window_outstanding, outstanding);
+    if (GST_CLOCK_TIME_IS_VALID (wait_time))
+      priv->pool_window_waits++;
+
+    if (GST_CLOCK_TIME_IS_VALID (wait_time)
+        && priv->pool_window_waits >= POOL_ADAPT_MIN_WAITS
+        && priv->pool_max < priv->max_pool_size) {
+      /* grow by a quarter */
+      priv->pool_extra += MAX (priv->pool_max / 4, 1);
+      priv->pool_window_acquired = priv->pool_window_waits = 0;
+      priv->pool_window_outstanding = 0;
+      resize = TRUE;
+    } else if (priv->pool_window_acquired >= POOL_ADAPT_WINDOW) {
+      /* shrink to what was used, plus one buffer of headroom */
+      if (priv->pool_window_waits == 0 && priv->pool_extra > 0
+          && priv->pool_window_outstanding + 1 < priv->pool_max) {
+        priv->pool_extra -= MIN (priv->pool_extra,
+            priv->pool_max - priv->pool_window_outstanding - 1);
+        resize = TRUE;
+      }
+      priv->pool_window_acquired = priv->pool_window_waits = 0;
+      priv->pool_window_outstanding = 0;
+    }
+  }
+  pool_max = priv->pool_max;
+  pool_extra = priv->pool_extra;
+  GST_OBJECT_UNLOCK (decoder);
+
+  if (resize) {
+    GST_DEBUG_OBJECT (decoder, "resizing output pool of %u buffers, %u extra",
+        pool_max, pool_extra);
+    gst_video_decoder_resize_pool (decoder);
+  }
+
+  return flow;
+}
+
 /**
  * gst_video_decoder_allocate_output_buffer:
  * @decoder: a #GstVideoDecoder
@@ -4090,7 +4863,7 @@ gst_video_decoder_allocate_output_buffer (GstVideoDecoder * decoder)
     }
   }
 
-  flow = gst_buffer_pool_acquire_buffer (decoder->priv->pool, &buffer, NULL);
+  flow = gst_video_decoder_acquire_buffer (decoder, &buffer, NULL);
 
   if (flow != GST_FLOW_OK) {
     GST_INFO_OBJECT (decoder, "couldn't allocate output buffer, flow %s",
@@ -4188,7 +4961,7 @@ gst_video_decoder_allocate_output_frame_with_params (GstVideoDecoder *
 
   GST_LOG_OBJECT (decoder, "alloc buffer size %d", num_bytes);
 
-  flow_ret = gst_buffer_pool_acquire_buffer (decoder->priv->pool,
+  flow_ret = gst_video_decoder_acquire_buffer (decoder,
       &frame->output_buffer, params);
 
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
@@ -4576,3 +5349,132 @@ gst_video_decoder_set_use_default_pad_acceptcaps (GstVideoDecoder * decoder,
 {
   decoder->priv->use_default_pad_acceptcaps = use;
 }
+
+/**
+ * gst_video_decoder_set_frame_threads:
+ * @decoder: a #GstVideoDecoder
+ * @n_threads: maximum number of threads to decode frames with, 0 for the
+ *     number of cores
+ *
+ * Enables frame threaded decoding for subclasses that implement
+ * @handle_frame_threaded. Frames that are sync points are then decoded by up
+ * to @n_threads worker threads in parallel, all other frames wait for the
+ * frames before them and are decoded one by one. Output is pushed in
+ * decoding order, exactly like without threads: the base class does not
+ * reorder frames by PTS, subclasses for codecs with B-frames still have to
+ * take care of that themselves.
+ *
+ * Frames are only handed to worker threads once an output state is set,
+ * before that and when @n_threads is 1 (the default) @handle_frame is used.
+ *
+ * Since: 1.18
+ */
+void
+gst_video_decoder_set_frame_threads (GstVideoDecoder * decoder,
+    guint n_threads)
+{
+  GstVideoDecoderPrivate *priv;
+
+  g_return_if_fail (GST_IS_VIDEO_DECODER (decoder));
+
+  priv = decoder->priv;
+
+  if (n_threads == 0)
+    n_threads = g_get_num_processors ();
+
+  GST_DEBUG_OBJECT (decoder, "using %u frame threads", n_threads);
+
+  GST_VIDEO_DECODER_STREAM_LOCK (decoder);
+  g_mutex_lock (&priv->frame_jobs_lock);
+  priv->frame_threads = n_threads;
+  g_mutex_unlock (&priv->frame_jobs_lock);
+  if (priv->frame_pool && n_threads > 1)
+    g_thread_pool_set_max_threads (priv->frame_pool, n_threads, NULL);
+  GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
+}
+
+/**
+ * gst_video_decoder_get_frame_threads:
+ * @decoder: a #GstVideoDecoder
+ *
+ * Returns: the number of threads used to decode frames, 1 when frame
+ * threading is disabled.
+ *
+ * Since: 1.18
+ */
+guint
+gst_video_decoder_get_frame_threads (GstVideoDecoder * decoder)
+{
+  guint n_threads;
+
+  g_return_val_if_fail (GST_IS_VIDEO_DECODER (decoder), 1);
+
+  g_mutex_lock (&decoder->priv->frame_jobs_lock);
+  n_threads = decoder->priv->frame_threads;
+  g_mutex_unlock (&decoder->priv->frame_jobs_lock);
+
+  return n_threads;
+}
+
+/**
+ * gst_video_decoder_get_stats:
+ * @decoder: a #GstVideoDecoder
+ *
+ * Returns statistics about the decoder, with the following fields:
+ *
+ *  * "frame-threads" G_TYPE_UINT: the number of frame threads
+ *  * "queued-frames" G_TYPE_UINT: frames currently handed to worker threads
+ *     and not pushed yet
+ *  * "max-queued-frames" G_TYPE_UINT: the maximum of "queued-frames"
+ *  * "threaded-frames" G_TYPE_UINT64: frames decoded by worker threads
+ *  * "average-latency" G_TYPE_UINT64: average time in nanoseconds between
+ *     handing a frame to a worker thread and pushing it
+ *  * "pool-min-buffers" G_TYPE_UINT, "pool-max-buffers" G_TYPE_UINT: the
+ *     currently configured size of the output buffer pool
+ *  * "pool-acquired" G_TYPE_UINT64: buffers acquired from the pool
+ *  * "pool-outstanding" G_TYPE_UINT: buffers currently out of the pool
+ *  * "max-pool-outstanding" G_TYPE_UINT: the maximum of "pool-outstanding"
+ *  * "pool-waits" G_TYPE_UINT64: acquisitions that had to wait for a buffer
+ *     to be released to the pool
+ *  * "pool-wait-time" G_TYPE_UINT64: total time in nanoseconds spent waiting
+ *  * "max-pool-wait-time" G_TYPE_UINT64: longest single wait in nanoseconds
+ *
+ * Returns: (transfer full): a #GstStructure with the statistics
+ *
+ * Since: 1.18
+ */
+GstStructure *
+gst_video_decoder_get_stats (GstVideoDecoder * decoder)
+{
+  GstVideoDecoderPrivate *priv;
+  GstStructure *s;
+
+  g_return_val_if_fail (GST_IS_VIDEO_DECODER (decoder), NULL);
+
+  priv = decoder->priv;
+
+  g_mutex_lock (&priv->frame_jobs_lock);
+  s = gst_structure_new ("GstVideoDecoderStats",
+      "frame-threads", G_TYPE_UINT, priv->frame_threads,
+      "queued-frames", G_TYPE_UINT, priv->frame_jobs.length,
+      "max-queued-frames", G_TYPE_UINT, priv->max_queued_frames,
+      "threaded-frames", G_TYPE_UINT64, priv->threaded_frames,
+      "average-latency", G_TYPE_UINT64, priv->threaded_frames ?
+      priv->threaded_latency / priv->threaded_frames : (guint64) 0, NULL);
+  g_mutex_unlock (&priv->frame_jobs_lock);
+
+  GST_OBJECT_LOCK (decoder);
+  gst_structure_set (s,
+      "pool-min-buffers", G_TYPE_UINT, priv->pool_min,
+      "pool-max-buffers", G_TYPE_UINT, priv->pool_max,
+      "pool-acquired", G_TYPE_UINT64, priv->pool_acquired,
+      "pool-outstanding", G_TYPE_UINT,
+      (guint) MAX (g_atomic_int_get (&priv->pool_tracker->outstanding), 0),
+      "max-pool-outstanding", G_TYPE_UINT, priv->max_pool_outstanding,
+      "pool-waits", G_TYPE_UINT64, priv->pool_waits,
+      "pool-wait-time", G_TYPE_UINT64, priv->pool_wait_time,
+      "max-pool-wait-time", G_TYPE_UINT64, priv->max_pool_wait_time, NULL);
+  GST_OBJECT_UNLOCK (decoder);
+
+  return s;
+}
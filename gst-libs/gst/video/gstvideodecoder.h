@@ -272,6 +272,14 @@ struct _GstVideoDecoder
  *                  tags and meta with only the "video" tag. subclasses can
  *                  implement this method and return %TRUE if the metadata is to be
  *                  copied. Since: 1.6
+ * @handle_frame_threaded: Optional.
+ *                  Decodes @frame into its already allocated output buffer
+ *                  when frame threading is enabled with
+ *                  gst_video_decoder_set_frame_threads(). Can be called from
+ *                  several worker threads at once and must not call any
+ *                  #GstVideoDecoder method. The base class finishes the frame
+ *                  when %GST_FLOW_OK is returned and releases it otherwise.
+ *                  Since: 1.18
  *
  * Subclasses can override any of the available virtual methods or not, as
  * needed. At minimum @handle_frame needs to be overridden, and @set_format
@@ -337,8 +345,11 @@ struct _GstVideoDecoderClass
                                    GstVideoCodecFrame *frame,
                                    GstMeta * meta);
 
+  GstFlowReturn (*handle_frame_threaded) (GstVideoDecoder *decoder,
+                                          GstVideoCodecFrame *frame);
+
   /*< private >*/
-  gpointer padding[GST_PADDING_LARGE-6];
+  gpointer padding[GST_PADDING_LARGE-7];
 };
 
 GST_VIDEO_API
@@ -477,6 +488,16 @@ GST_VIDEO_API
 void             gst_video_decoder_set_use_default_pad_acceptcaps (GstVideoDecoder * decoder,
                                                                    gboolean use);
 
+GST_VIDEO_API
+void             gst_video_decoder_set_frame_threads (GstVideoDecoder * decoder,
+                                                      guint n_threads);
+
+GST_VIDEO_API
+guint            gst_video_decoder_get_frame_threads (GstVideoDecoder * decoder);
+
+GST_VIDEO_API
+GstStructure *   gst_video_decoder_get_stats (GstVideoDecoder * decoder);
+
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GstVideoDecoder, gst_object_unref)
 
 G_END_DECLS
@@ -53,6 +53,11 @@
  *       @gst_video_encoder_finish_frame to have encoded data pushed
  *       downstream.
  *
+ *     * Subclasses for intra-only codecs that can encode several frames at
+ *       once can implement @handle_frame_threaded and enable it with
+ *       @gst_video_encoder_set_frame_threads. Frames are then encoded by a
+ *       pool of worker threads and the base class finishes them in order.
+ *
  *     * If implemented, baseclass calls subclass @pre_push just prior to
  *       pushing to allow subclasses to modify some metadata on the buffer.
  *       If it returns GST_FLOW_OK, the buffer is pushed downstream.
@@ -141,7 +146,7 @@ struct _GstVideoEncoderPrivate
 
   guint32 system_frame_number;
 
-  GList *frames;                /* Protected with OBJECT_LOCK */
+  GstVideoCodecFrameTable frames;       /* Protected with STREAM_LOCK */
   GstVideoCodecState *input_state;
   GstVideoCodecState *output_state;
   gboolean output_state_changed;
@@ -174,6 +179,23 @@ struct _GstVideoEncoderPrivate
   /* qos messages: frames dropped/processed */
   guint dropped;
   guint processed;
+
+  /* allocation statistics, OBJECT_LOCK */
+  guint max_pending_frames;
+  guint64 output_buffers;
+  guint64 output_bytes;
+
+  /* frame threading, see gst_video_encoder_set_frame_threads() */
+  guint frame_threads;          /* STREAM_LOCK */
+  GThreadPool *frame_pool;
+  GMutex frame_jobs_lock;
+  GCond frame_jobs_cond;
+  GQueue frame_jobs;            /* FrameJob, in input order */
+  guint max_queued_frames;      /* frame_jobs_lock */
+  guint64 threaded_frames;      /* frame_jobs_lock */
+  GstClockTime threaded_latency;        /* frame_jobs_lock */
+  /* output delay caused by frame threading, OBJECT_LOCK */
+  GstClockTime frame_threads_latency;
 };
 
 typedef struct _ForcedKeyUnitEvent ForcedKeyUnitEvent;
@@ -245,6 +267,12 @@ static gboolean gst_video_encoder_propose_allocation_default (GstVideoEncoder *
 static gboolean gst_video_encoder_negotiate_default (GstVideoEncoder * encoder);
 static gboolean gst_video_encoder_negotiate_unlocked (GstVideoEncoder *
     encoder);
+static GstFlowReturn gst_video_encoder_finish_frame_jobs (GstVideoEncoder *
+    encoder, guint max_pending, gboolean discard);
+static void gst_video_encoder_update_frame_threads_latency (GstVideoEncoder *
+    encoder);
+static void gst_video_encoder_release_frame (GstVideoEncoder * enc,
+    GstVideoCodecFrame * frame);
 
 static gboolean gst_video_encoder_sink_query_default (GstVideoEncoder * encoder,
     GstQuery * query);
@@ -390,6 +418,7 @@ static gboolean
 gst_video_encoder_reset (GstVideoEncoder * encoder, gboolean hard)
 {
   GstVideoEncoderPrivate *priv = encoder->priv;
+  GstAllocator *allocator;
   gboolean ret = TRUE;
 
   GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
@@ -437,10 +466,12 @@ gst_video_encoder_reset (GstVideoEncoder * encoder, gboolean hard)
     priv->headers = NULL;
     priv->new_headers = FALSE;
 
-    if (priv->allocator) {
-      gst_object_unref (priv->allocator);
-      priv->allocator = NULL;
-    }
+    GST_OBJECT_LOCK (encoder);
+    allocator = priv->allocator;
+    priv->allocator = NULL;
+    GST_OBJECT_UNLOCK (encoder);
+    if (allocator)
+      gst_object_unref (allocator);
 
     g_list_foreach (priv->current_frame_events, (GFunc) gst_event_unref, NULL);
     g_list_free (priv->current_frame_events);
@@ -454,10 +485,18 @@ gst_video_encoder_reset (GstVideoEncoder * encoder, gboolean hard)
 
     priv->dropped = 0;
     priv->processed = 0;
+
+    GST_OBJECT_LOCK (encoder);
+    priv->max_pending_frames = 0;
+    priv->output_buffers = 0;
+    priv->output_bytes = 0;
+    priv->frame_threads_latency = 0;
+    GST_OBJECT_UNLOCK (encoder);
   } else {
     GList *l;
 
-    for (l = priv->frames; l; l = l->next) {
+    for (l = __gst_video_codec_frame_table_head (&priv->frames); l;
+        l = l->next) {
       GstVideoCodecFrame *frame = l->data;
 
       frame->events = _flush_events (encoder->srcpad, frame->events);
@@ -466,9 +505,7 @@ gst_video_encoder_reset (GstVideoEncoder * encoder, gboolean hard)
         encoder->priv->current_frame_events);
   }
 
-  g_list_foreach (priv->frames, (GFunc) gst_video_codec_frame_unref, NULL);
-  g_list_free (priv->frames);
-  priv->frames = NULL;
+  __gst_video_codec_frame_table_clear (&priv->frames);
 
   GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
 
@@ -498,6 +535,11 @@ gst_video_encoder_init (GstVideoEncoder * encoder, GstVideoEncoderClass * klass)
   GST_DEBUG_OBJECT (encoder, "gst_video_encoder_init");
 
   priv = encoder->priv = gst_video_encoder_get_instance_private (encoder);
+  __gst_video_codec_frame_table_init (&priv->frames);
+  priv->frame_threads = 1;
+  g_mutex_init (&priv->frame_jobs_lock);
+  g_cond_init (&priv->frame_jobs_cond);
+  g_queue_init (&priv->frame_jobs);
 
   pad_template =
       gst_element_class_get_pad_template (GST_ELEMENT_CLASS (klass), "sink");
@@ -660,6 +702,9 @@ gst_video_encoder_setcaps (GstVideoEncoder * encoder, GstCaps * caps)
     goto caps_not_changed;
   }
 
+  /* frames of the previous format are done before reconfiguring */
+  gst_video_encoder_finish_frame_jobs (encoder, 0, FALSE);
+
   if (encoder_class->reset) {
     GST_FIXME_OBJECT (encoder, "GstVideoEncoder::reset() is deprecated");
     encoder_class->reset (encoder, TRUE);
@@ -673,6 +718,7 @@ gst_video_encoder_setcaps (GstVideoEncoder * encoder, GstCaps * caps)
     if (encoder->priv->input_state)
       gst_video_codec_state_unref (encoder->priv->input_state);
     encoder->priv->input_state = state;
+    gst_video_encoder_update_frame_threads_latency (encoder);
   } else {
     gst_video_codec_state_unref (state);
   }
@@ -776,7 +822,7 @@ gst_video_encoder_propose_allocation_default (GstVideoEncoder * encoder,
   GstCaps *caps;
   GstVideoInfo info;
   GstBufferPool *pool;
-  guint size;
+  guint size, min;
 
   gst_query_parse_allocation (query, &caps, NULL);
 
@@ -788,6 +834,16 @@ gst_video_encoder_propose_allocation_default (GstVideoEncoder * encoder,
 
   size = GST_VIDEO_INFO_SIZE (&info);
 
+  /* input buffers stay with us until their frame is encoded, so let upstream
+   * preallocate as many as were pending at most so far. Before the first
+   * frame that is only known for frame threading, where every worker thread
+   * holds one; otherwise leave the minimum to upstream. */
+  GST_OBJECT_LOCK (encoder);
+  min = encoder->priv->max_pending_frames;
+  GST_OBJECT_UNLOCK (encoder);
+  if (min == 0 && encoder->priv->frame_threads > 1)
+    min = encoder->priv->frame_threads;
+
   if (gst_query_get_n_allocation_pools (query) == 0) {
     GstStructure *structure;
     GstAllocator *allocator = NULL;
@@ -801,7 +857,7 @@ gst_video_encoder_propose_allocation_default (GstVideoEncoder * encoder,
     pool = gst_video_buffer_pool_new ();
 
     structure = gst_buffer_pool_get_config (pool);
-    gst_buffer_pool_config_set_params (structure, caps, size, 0, 0);
+    gst_buffer_pool_config_set_params (structure, caps, size, min, 0);
     gst_buffer_pool_config_set_allocator (structure, allocator, &params);
 
     if (allocator)
@@ -810,7 +866,7 @@ gst_video_encoder_propose_allocation_default (GstVideoEncoder * encoder,
     if (!gst_buffer_pool_set_config (pool, structure))
       goto config_failed;
 
-    gst_query_add_allocation_pool (query, pool, size, 0, 0);
+    gst_query_add_allocation_pool (query, pool, size, min, 0);
     gst_object_unref (pool);
     gst_query_add_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL);
   }
@@ -912,8 +968,19 @@ gst_video_encoder_finalize (GObject * object)
   GST_DEBUG_OBJECT (object, "finalize");
 
   encoder = GST_VIDEO_ENCODER (object);
+
+  if (encoder->priv->frame_pool) {
+    gst_video_encoder_finish_frame_jobs (encoder, 0, TRUE);
+    g_thread_pool_free (encoder->priv->frame_pool, FALSE, TRUE);
+    encoder->priv->frame_pool = NULL;
+  }
+  g_mutex_clear (&encoder->priv->frame_jobs_lock);
+  g_cond_clear (&encoder->priv->frame_jobs_cond);
+
   g_rec_mutex_clear (&encoder->stream_lock);
 
+  __gst_video_codec_frame_table_free (&encoder->priv->frames);
+
   if (encoder->priv->allocator) {
     gst_object_unref (encoder->priv->allocator);
     encoder->priv->allocator = NULL;
@@ -1035,10 +1102,15 @@ gst_video_encoder_sink_event_default (GstVideoEncoder * encoder,
 
       GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
 
+      /* output everything still being encoded in worker threads before
+       * the subclass drains */
+      flow_ret = gst_video_encoder_finish_frame_jobs (encoder, 0, FALSE);
+
       if (encoder_class->finish) {
-        flow_ret = encoder_class->finish (encoder);
-      } else {
-        flow_ret = GST_FLOW_OK;
+        if (flow_ret == GST_FLOW_OK)
+          flow_ret = encoder_class->finish (encoder);
+        else
+          encoder_class->finish (encoder);
       }
 
       if (encoder->priv->current_frame_events) {
@@ -1161,6 +1233,7 @@ gst_video_encoder_sink_event_default (GstVideoEncoder * encoder,
     }
     case GST_EVENT_FLUSH_STOP:{
       GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
+      gst_video_encoder_finish_frame_jobs (encoder, 0, TRUE);
       gst_video_encoder_flush (encoder);
       gst_segment_init (&encoder->input_segment, GST_FORMAT_TIME);
       gst_segment_init (&encoder->output_segment, GST_FORMAT_TIME);
@@ -1359,12 +1432,12 @@ gst_video_encoder_src_query_default (GstVideoEncoder * enc, GstQuery * query)
             GST_TIME_ARGS (min_latency), GST_TIME_ARGS (max_latency));
 
         GST_OBJECT_LOCK (enc);
-        min_latency += priv->min_latency;
+        min_latency += priv->min_latency + priv->frame_threads_latency;
         if (max_latency == GST_CLOCK_TIME_NONE
             || enc->priv->max_latency == GST_CLOCK_TIME_NONE)
           max_latency = GST_CLOCK_TIME_NONE;
         else
-          max_latency += enc->priv->max_latency;
+          max_latency += enc->priv->max_latency + priv->frame_threads_latency;
         GST_OBJECT_UNLOCK (enc);
 
         gst_query_set_latency (query, live, min_latency, max_latency);
@@ -1431,6 +1504,162 @@ gst_video_encoder_new_frame (GstVideoEncoder * encoder, GstBuffer * buf,
 }
 
 
+typedef struct _FrameJob FrameJob;
+
+struct _FrameJob
+{
+  GstVideoCodecFrame *frame;
+  GstFlowReturn ret;
+  gboolean done;
+  GstClockTime queued;
+};
+
+static void
+gst_video_encoder_frame_thread_func (gpointer data, gpointer user_data)
+{
+  FrameJob *job = data;
+  GstVideoEncoder *encoder = user_data;
+  GstVideoEncoderClass *encoder_class = GST_VIDEO_ENCODER_GET_CLASS (encoder);
+  GstVideoEncoderPrivate *priv = encoder->priv;
+  GstFlowReturn ret;
+
+  ret = encoder_class->handle_frame_threaded (encoder, job->frame);
+
+  g_mutex_lock (&priv->frame_jobs_lock);
+  job->ret = ret;
+  job->done = TRUE;
+  g_cond_broadcast (&priv->frame_jobs_cond);
+  g_mutex_unlock (&priv->frame_jobs_lock);
+}
+
+/* Finishes the encoded frames at the head of the job queue in input order,
+ * waiting for running jobs until at most @max_pending are left.
+ * With @discard, the frames are released instead of pushed.
+ * Must be called with the STREAM_LOCK */
+static GstFlowReturn
+gst_video_encoder_finish_frame_jobs (GstVideoEncoder * encoder,
+    guint max_pending, gboolean discard)
+{
+  GstVideoEncoderPrivate *priv = encoder->priv;
+  GstFlowReturn ret = GST_FLOW_OK;
+  FrameJob *job;
+
+  g_mutex_lock (&priv->frame_jobs_lock);
+  while ((job = g_queue_peek_head (&priv->frame_jobs))) {
+    if (!job->done) {
+      if (priv->frame_jobs.length <= max_pending)
+        break;
+      g_cond_wait (&priv->frame_jobs_cond, &priv->frame_jobs_lock);
+      continue;
+    }
+
+    g_queue_pop_head (&priv->frame_jobs);
+    priv->threaded_frames++;
+    priv->threaded_latency += gst_util_get_timestamp () - job->queued;
+    g_mutex_unlock (&priv->frame_jobs_lock);
+
+    if (discard || ret != GST_FLOW_OK || job->ret != GST_FLOW_OK) {
+      if (!discard && ret == GST_FLOW_OK) {
+        GST_DEBUG_OBJECT (encoder, "threaded encoding of frame %d failed: %s",
+            job->frame->system_frame_number, gst_flow_get_name (job->ret));
+        ret = job->ret;
+      }
+      gst_video_encoder_release_frame (encoder, job->frame);
+    } else {
+      /* the subclass declared all frames to be independent */
+      GST_VIDEO_CODEC_FRAME_SET_SYNC_POINT (job->frame);
+      ret = gst_video_encoder_finish_frame (encoder, job->frame);
+    }
+    g_slice_free (FrameJob, job);
+
+    g_mutex_lock (&priv->frame_jobs_lock);
+  }
+  g_mutex_unlock (&priv->frame_jobs_lock);
+
+  return ret;
+}
+
+/* With STREAM_LOCK. With frame threading a frame is pushed up to
+ * frame_threads - 1 frames later than without, which is added to the
+ * latency reported upstream */
+static void
+gst_video_encoder_update_frame_threads_latency (GstVideoEncoder * encoder)
+{
+  GstVideoEncoderClass *klass = GST_VIDEO_ENCODER_GET_CLASS (encoder);
+  GstVideoEncoderPrivate *priv = encoder->priv;
+  GstClockTime latency = 0;
+  gboolean changed;
+
+  if (priv->frame_threads > 1 && klass->handle_frame_threaded
+      && priv->input_state && priv->input_state->info.fps_n > 0
+      && priv->input_state->info.fps_d > 0)
+    latency = gst_util_uint64_scale (priv->frame_threads - 1,
+        GST_SECOND * priv->input_state->info.fps_d,
+        priv->input_state->info.fps_n);
+
+  GST_OBJECT_LOCK (encoder);
+  changed = priv->frame_threads_latency != latency;
+  priv->frame_threads_latency = latency;
+  GST_OBJECT_UNLOCK (encoder);
+
+  if (changed) {
+    GST_DEBUG_OBJECT (encoder, "frame threads latency %" GST_TIME_FORMAT,
+        GST_TIME_ARGS (latency));
+    gst_element_post_message (GST_ELEMENT_CAST (encoder),
+        gst_message_new_latency (GST_OBJECT_CAST (encoder)));
+  }
+}
+
+/* Hands @frame to a worker thread, with at most frame_threads frames
+ * being encoded at the same time */
+static GstFlowReturn
+gst_video_encoder_encode_frame_threaded (GstVideoEncoder * encoder,
+    GstVideoCodecFrame * frame)
+{
+  GstVideoEncoderClass *encoder_class = GST_VIDEO_ENCODER_GET_CLASS (encoder);
+  GstVideoEncoderPrivate *priv = encoder->priv;
+  GstFlowReturn ret;
+  FrameJob *job;
+
+  if (G_UNLIKELY (priv->frame_pool == NULL)) {
+    GError *err = NULL;
+
+    priv->frame_pool = g_thread_pool_new (gst_video_encoder_frame_thread_func,
+        encoder, priv->frame_threads, FALSE, &err);
+    if (priv->frame_pool == NULL) {
+      GST_WARNING_OBJECT (encoder, "failed to create thread pool: %s",
+          err->message);
+      g_clear_error (&err);
+      priv->frame_threads = 1;
+      gst_video_encoder_update_frame_threads_latency (encoder);
+      return encoder_class->handle_frame (encoder, frame);
+    }
+  }
+
+  /* make room for this frame first */
+  ret = gst_video_encoder_finish_frame_jobs (encoder,
+      priv->frame_threads - 1, FALSE);
+  if (ret != GST_FLOW_OK) {
+    gst_video_encoder_release_frame (encoder, frame);
+    return ret;
+  }
+
+  job = g_slice_new0 (FrameJob);
+  job->frame = frame;
+  job->queued = gst_util_get_timestamp ();
+
+  g_mutex_lock (&priv->frame_jobs_lock);
+  g_queue_push_tail (&priv->frame_jobs, job);
+  priv->max_queued_frames =
+      MAX (priv->max_queued_frames, priv->frame_jobs.length);
+  g_mutex_unlock (&priv->frame_jobs_lock);
+
+  g_thread_pool_push (priv->frame_pool, job, NULL);
+
+  /* push what is already done without waiting */
+  return gst_video_encoder_finish_frame_jobs (encoder, G_MAXUINT, FALSE);
+}
+
 static GstFlowReturn
 gst_video_encoder_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 {
@@ -1540,8 +1769,12 @@ gst_video_encoder_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   }
   GST_OBJECT_UNLOCK (encoder);
 
-  gst_video_codec_frame_ref (frame);
-  priv->frames = g_list_append (priv->frames, frame);
+  __gst_video_codec_frame_table_push (&priv->frames, frame);
+
+  GST_OBJECT_LOCK (encoder);
+  priv->max_pending_frames = MAX (priv->max_pending_frames,
+      __gst_video_codec_frame_table_length (&priv->frames));
+  GST_OBJECT_UNLOCK (encoder);
 
   /* new data, more finish needed */
   priv->drained = FALSE;
@@ -1553,7 +1786,16 @@ gst_video_encoder_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
       gst_segment_to_running_time (&encoder->input_segment, GST_FORMAT_TIME,
       frame->pts);
 
-  ret = klass->handle_frame (encoder, frame);
+  if (priv->frame_threads > 1 && klass->handle_frame_threaded) {
+    ret = gst_video_encoder_encode_frame_threaded (encoder, frame);
+  } else {
+    /* frames still encoded by worker threads go first */
+    ret = gst_video_encoder_finish_frame_jobs (encoder, 0, FALSE);
+    if (ret == GST_FLOW_OK)
+      ret = klass->handle_frame (encoder, frame);
+    else
+      gst_video_encoder_release_frame (encoder, frame);
+  }
 
 done:
   GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
@@ -1605,6 +1847,10 @@ gst_video_encoder_change_state (GstElement * element, GstStateChange transition)
     case GST_STATE_CHANGE_PAUSED_TO_READY:{
       gboolean stopped = TRUE;
 
+      GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
+      gst_video_encoder_finish_frame_jobs (encoder, 0, TRUE);
+      GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
+
       if (encoder_class->stop)
         stopped = encoder_class->stop (encoder);
 
@@ -1662,7 +1908,7 @@ static gboolean
 gst_video_encoder_negotiate_default (GstVideoEncoder * encoder)
 {
   GstVideoEncoderClass *klass = GST_VIDEO_ENCODER_GET_CLASS (encoder);
-  GstAllocator *allocator;
+  GstAllocator *allocator, *old_allocator;
   GstAllocationParams params;
   gboolean ret = TRUE;
   GstVideoCodecState *state = encoder->priv->output_state;
@@ -1759,7 +2005,7 @@ gst_video_encoder_negotiate_default (GstVideoEncoder * encoder)
 
   /* Push all pending pre-caps events of the oldest frame before
    * setting caps */
-  frame = encoder->priv->frames ? encoder->priv->frames->data : NULL;
+  frame = __gst_video_codec_frame_table_oldest (&encoder->priv->frames);
   if (frame || encoder->priv->current_frame_events) {
     GList **events, *l;
 
@@ -1818,10 +2064,14 @@ gst_video_encoder_negotiate_default (GstVideoEncoder * encoder)
     gst_allocation_params_init (&params);
   }
 
-  if (encoder->priv->allocator)
-    gst_object_unref (encoder->priv->allocator);
+  /* frame threads may be reading these, see gst_video_encoder_get_allocator */
+  GST_OBJECT_LOCK (encoder);
+  old_allocator = encoder->priv->allocator;
   encoder->priv->allocator = allocator;
   encoder->priv->params = params;
+  GST_OBJECT_UNLOCK (encoder);
+  if (old_allocator)
+    gst_object_unref (old_allocator);
 
 done:
   if (query)
@@ -1882,6 +2132,15 @@ gst_video_encoder_negotiate (GstVideoEncoder * encoder)
   return ret;
 }
 
+static void
+gst_video_encoder_count_output_buffer (GstVideoEncoder * encoder, gsize size)
+{
+  GST_OBJECT_LOCK (encoder);
+  encoder->priv->output_buffers++;
+  encoder->priv->output_bytes += size;
+  GST_OBJECT_UNLOCK (encoder);
+}
+
 /**
  * gst_video_encoder_allocate_output_buffer:
  * @encoder: a #GstVideoEncoder
@@ -1921,12 +2180,15 @@ gst_video_encoder_allocate_output_buffer (GstVideoEncoder * encoder, gsize size)
     goto fallback;
   }
 
+  gst_video_encoder_count_output_buffer (encoder, size);
   GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
 
   return buffer;
 
 fallback:
   buffer = gst_buffer_new_allocate (NULL, size, NULL);
+  if (buffer)
+    gst_video_encoder_count_output_buffer (encoder, size);
 
   GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
 
@@ -1971,6 +2233,8 @@ gst_video_encoder_allocate_output_frame (GstVideoEncoder *
   frame->output_buffer =
       gst_buffer_new_allocate (encoder->priv->allocator, size,
       &encoder->priv->params);
+  if (frame->output_buffer)
+    gst_video_encoder_count_output_buffer (encoder, size);
 
   GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
 
@@ -1981,14 +2245,8 @@ static void
 gst_video_encoder_release_frame (GstVideoEncoder * enc,
     GstVideoCodecFrame * frame)
 {
-  GList *link;
-
   /* unref once from the list */
-  link = g_list_find (enc->priv->frames, frame);
-  if (link) {
-    gst_video_codec_frame_unref (frame);
-    enc->priv->frames = g_list_delete_link (enc->priv->frames, link);
-  }
+  __gst_video_codec_frame_table_remove (&enc->priv->frames, frame);
   /* unref because this function takes ownership */
   gst_video_codec_frame_unref (frame);
 }
@@ -2122,7 +2380,7 @@ gst_video_encoder_push_pending_unlocked (GstVideoEncoder * encoder,
   GList *l;
 
   /* Push all pending events that arrived before this frame */
-  for (l = priv->frames; l; l = l->next) {
+  for (l = __gst_video_codec_frame_table_head (&priv->frames); l; l = l->next) {
     GstVideoCodecFrame *tmp = l->data;
 
     if (tmp->events) {
@@ -2154,7 +2412,7 @@ gst_video_encoder_infer_dts_unlocked (GstVideoEncoder * encoder,
   gboolean seen_none = FALSE;
 
   /* some maintenance regardless */
-  for (l = priv->frames; l; l = l->next) {
+  for (l = __gst_video_codec_frame_table_head (&priv->frames); l; l = l->next) {
     GstVideoCodecFrame *tmp = l->data;
 
     if (!GST_CLOCK_TIME_IS_VALID (tmp->abidata.ABI.ts)) {
@@ -2708,8 +2966,9 @@ gst_video_encoder_get_oldest_frame (GstVideoEncoder * encoder)
   GstVideoCodecFrame *frame = NULL;
 
   GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
-  if (encoder->priv->frames)
-    frame = gst_video_codec_frame_ref (encoder->priv->frames->data);
+  frame = __gst_video_codec_frame_table_oldest (&encoder->priv->frames);
+  if (frame)
+    gst_video_codec_frame_ref (frame);
   GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
 
   return (GstVideoCodecFrame *) frame;
@@ -2727,20 +2986,15 @@ gst_video_encoder_get_oldest_frame (GstVideoEncoder * encoder)
 GstVideoCodecFrame *
 gst_video_encoder_get_frame (GstVideoEncoder * encoder, int frame_number)
 {
-  GList *g;
-  GstVideoCodecFrame *frame = NULL;
+  GstVideoCodecFrame *frame;
 
   GST_DEBUG_OBJECT (encoder, "frame_number : %d", frame_number);
 
   GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
-  for (g = encoder->priv->frames; g; g = g->next) {
-    GstVideoCodecFrame *tmp = g->data;
-
-    if (tmp->system_frame_number == frame_number) {
-      frame = gst_video_codec_frame_ref (tmp);
-      break;
-    }
-  }
+  frame = __gst_video_codec_frame_table_lookup (&encoder->priv->frames,
+      frame_number);
+  if (frame)
+    gst_video_codec_frame_ref (frame);
   GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
 
   return frame;
@@ -2760,8 +3014,7 @@ gst_video_encoder_get_frames (GstVideoEncoder * encoder)
   GList *frames;
 
   GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
-  frames = g_list_copy (encoder->priv->frames);
-  g_list_foreach (frames, (GFunc) gst_video_codec_frame_ref, NULL);
+  frames = __gst_video_codec_frame_table_copy (&encoder->priv->frames);
   GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
 
   return frames;
@@ -2822,6 +3075,9 @@ gst_video_encoder_merge_tags (GstVideoEncoder * encoder,
  * used by the base class and its @params.
  *
  * Unref the @allocator after use it.
+ *
+ * This function is thread-safe and can also be called from
+ * @handle_frame_threaded.
  */
 void
 gst_video_encoder_get_allocator (GstVideoEncoder * encoder,
@@ -2829,12 +3085,14 @@ gst_video_encoder_get_allocator (GstVideoEncoder * encoder,
 {
   g_return_if_fail (GST_IS_VIDEO_ENCODER (encoder));
 
+  GST_OBJECT_LOCK (encoder);
   if (allocator)
     *allocator = encoder->priv->allocator ?
         gst_object_ref (encoder->priv->allocator) : NULL;
 
   if (params)
     *params = encoder->priv->params;
+  GST_OBJECT_UNLOCK (encoder);
 }
 
 /**
@@ -2938,3 +3196,116 @@ gst_video_encoder_is_qos_enabled (GstVideoEncoder * encoder)
 
   return res;
 }
+
+/**
+ * gst_video_encoder_get_stats:
+ * @encoder: a #GstVideoEncoder
+ *
+ * Returns statistics about the encoder, with the following fields:
+ *
+ *  * "max-pending-frames" G_TYPE_UINT: the maximum number of input frames
+ *     waiting to be encoded at the same time, this is also proposed as the
+ *     minimum size of the upstream buffer pool
+ *  * "output-buffers" G_TYPE_UINT64: buffers allocated with
+ *     gst_video_encoder_allocate_output_buffer() and
+ *     gst_video_encoder_allocate_output_frame()
+ *  * "output-bytes" G_TYPE_UINT64: total size of these buffers
+ *  * "frame-threads" G_TYPE_UINT: the number of frame threads
+ *  * "queued-frames" G_TYPE_UINT: frames currently handed to worker threads
+ *     and not pushed yet
+ *  * "max-queued-frames" G_TYPE_UINT: the maximum of "queued-frames"
+ *  * "threaded-frames" G_TYPE_UINT64: frames encoded by worker threads
+ *  * "average-latency" G_TYPE_UINT64: average time in nanoseconds between
+ *     handing a frame to a worker thread and pushing it
+ *
+ * Returns: (transfer full): a #GstStructure with the statistics
+ *
+ * Since: 1.18
+ */
+GstStructure *
+gst_video_encoder_get_stats (GstVideoEncoder * encoder)
+{
+  GstVideoEncoderPrivate *priv;
+  GstStructure *s;
+
+  g_return_val_if_fail (GST_IS_VIDEO_ENCODER (encoder), NULL);
+
+  priv = encoder->priv;
+
+  GST_OBJECT_LOCK (encoder);
+  s = gst_structure_new ("GstVideoEncoderStats",
+      "max-pending-frames", G_TYPE_UINT, priv->max_pending_frames,
+      "output-buffers", G_TYPE_UINT64, priv->output_buffers,
+      "output-bytes", G_TYPE_UINT64, priv->output_bytes, NULL);
+  GST_OBJECT_UNLOCK (encoder);
+
+  g_mutex_lock (&priv->frame_jobs_lock);
+  gst_structure_set (s,
+      "frame-threads", G_TYPE_UINT, priv->frame_threads,
+      "queued-frames", G_TYPE_UINT, priv->frame_jobs.length,
+      "max-queued-frames", G_TYPE_UINT, priv->max_queued_frames,
+      "threaded-frames", G_TYPE_UINT64, priv->threaded_frames,
+      "average-latency", G_TYPE_UINT64, priv->threaded_frames ?
+      priv->threaded_latency / priv->threaded_frames : (guint64) 0, NULL);
+  g_mutex_unlock (&priv->frame_jobs_lock);
+
+  return s;
+}
+
+/**
+ * gst_video_encoder_set_frame_threads:
+ * @encoder: a #GstVideoEncoder
+ * @n_threads: maximum number of threads to encode frames with, 0 for the
+ *     number of cores
+ *
+ * Enables frame threaded encoding for subclasses of intra-only codecs that
+ * implement @handle_frame_threaded. Up to @n_threads frames are then encoded
+ * in parallel and pushed in input order, exactly like without threads. All
+ * of these frames are marked as sync points.
+ *
+ * When @n_threads is 1 (the default) @handle_frame is used.
+ *
+ * As frames are output up to @n_threads - 1 frames later, that many frame
+ * durations are added to the latency of the encoder.
+ *
+ * Since: 1.18
+ */
+void
+gst_video_encoder_set_frame_threads (GstVideoEncoder * encoder,
+    guint n_threads)
+{
+  GstVideoEncoderPrivate *priv;
+
+  g_return_if_fail (GST_IS_VIDEO_ENCODER (encoder));
+
+  priv = encoder->priv;
+
+  if (n_threads == 0)
+    n_threads = g_get_num_processors ();
+
+  GST_DEBUG_OBJECT (encoder, "using %u frame threads", n_threads);
+
+  GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
+  priv->frame_threads = n_threads;
+  if (priv->frame_pool && n_threads > 1)
+    g_thread_pool_set_max_threads (priv->frame_pool, n_threads, NULL);
+  gst_video_encoder_update_frame_threads_latency (encoder);
+  GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
+}
+
+/**
+ * gst_video_encoder_get_frame_threads:
+ * @encoder: a #GstVideoEncoder
+ *
+ * Returns: the number of threads used to encode frames, 1 when frame
+ * threading is disabled.
+ *
+ * Since: 1.18
+ */
+guint
+gst_video_encoder_get_frame_threads (GstVideoEncoder * encoder)
+{
+  g_return_val_if_fail (GST_IS_VIDEO_ENCODER (encoder), 1);
+
+  return encoder->priv->frame_threads;
+}
@@ -234,6 +234,18 @@ struct _GstVideoEncoder
  *                  tags and meta with only the "video" tag. subclasses can
  *                  implement this method and return %TRUE if the metadata is to be
  *                  copied. Since: 1.6
+ * @handle_frame_threaded: Optional.
+ *                  Encodes @frame of an intra-only codec when frame threading
+ *                  is enabled with gst_video_encoder_set_frame_threads(). Can
+ *                  be called from several worker threads at once while the
+ *                  streaming thread holds the stream lock, so the only
+ *                  #GstVideoEncoder method that can be called from it is
+ *                  the thread-safe gst_video_encoder_get_allocator(). The
+ *                  subclass sets frame->output_buffer, which it allocates
+ *                  itself, e.g. with gst_buffer_new_allocate() and that
+ *                  allocator. The base class finishes the frame when
+ *                  %GST_FLOW_OK is returned and releases it otherwise.
+ *                  Since: 1.18
  *
  * Subclasses can override any of the available virtual methods or not, as
  * needed. At minimum @handle_frame needs to be overridden, and @set_format
@@ -295,8 +307,11 @@ struct _GstVideoEncoderClass
                                    GstVideoCodecFrame *frame,
                                    GstMeta * meta);
 
+  GstFlowReturn (*handle_frame_threaded) (GstVideoEncoder *encoder,
+                                          GstVideoCodecFrame *frame);
+
   /*< private >*/
-  gpointer       _gst_reserved[GST_PADDING_LARGE-4];
+  gpointer       _gst_reserved[GST_PADDING_LARGE-5];
 };
 
 GST_VIDEO_API
@@ -381,6 +396,16 @@ gboolean             gst_video_encoder_is_qos_enabled (GstVideoEncoder * encoder
 GST_VIDEO_API
 GstClockTimeDiff     gst_video_encoder_get_max_encode_time (GstVideoEncoder *encoder, GstVideoCodecFrame * frame);
 
+GST_VIDEO_API
+void                 gst_video_encoder_set_frame_threads (GstVideoEncoder * encoder,
+                                                          guint n_threads);
+
+GST_VIDEO_API
+guint                gst_video_encoder_get_frame_threads (GstVideoEncoder * encoder);
+
+GST_VIDEO_API
+GstStructure *       gst_video_encoder_get_stats (GstVideoEncoder * encoder);
+
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GstVideoEncoder, gst_object_unref)
 
 G_END_DECLS
@@ -259,3 +259,320 @@ __gst_video_encoded_video_convert (gint64 bytes, gint64 time,
 exit:
   return res;
 }
+
+/* Pending frames table of the video decoder and encoder.
+ *
+ * Subclasses may reuse a system_frame_number, so the index keeps all links
+ * with a given number, oldest first. It may also change the number of a
+ * pending frame, in which case the index is stale for that frame and the
+ * table falls back to a linear search, like before the index existed */
+
+void
+__gst_video_codec_frame_table_init (GstVideoCodecFrameTable * table)
+{
+  g_queue_init (&table->frames);
+  table->index = g_hash_table_new_full (NULL, NULL, NULL,
+      (GDestroyNotify) g_queue_free);
+}
+
+/* drops all frames, the table stays usable */
+void
+__gst_video_codec_frame_table_clear (GstVideoCodecFrameTable * table)
+{
+  g_hash_table_remove_all (table->index);
+  g_queue_foreach (&table->frames, (GFunc) gst_video_codec_frame_unref, NULL);
+  g_queue_clear (&table->frames);
+}
+
+void
+__gst_video_codec_frame_table_free (GstVideoCodecFrameTable * table)
+{
+  __gst_video_codec_frame_table_clear (table);
+  g_hash_table_unref (table->index);
+  table->index = NULL;
+}
+
+/* takes a ref on @frame */
+void
+__gst_video_codec_frame_table_push (GstVideoCodecFrameTable * table,
+    GstVideoCodecFrame * frame)
+{
+  gpointer key = GINT_TO_POINTER (frame->system_frame_number);
+  GQueue *links;
+
+  g_queue_push_tail (&table->frames, gst_video_codec_frame_ref (frame));
+
+  links = g_hash_table_lookup (table->index, key);
+  if (links == NULL) {
+    links = g_queue_new ();
+    g_hash_table_insert (table->index, key, links);
+  }
+  g_queue_push_tail (links, table->frames.tail);
+}
+
+/* removes @link from the index, @links is where it is expected */
+static gboolean
+frame_table_unindex (GstVideoCodecFrameTable * table, gpointer key,
+    GQueue * links, GList * link)
+{
+  GList *l;
+
+  l = g_queue_find (links, link);
+  if (l == NULL)
+    return FALSE;
+
+  g_queue_delete_link (links, l);
+  if (g_queue_is_empty (links))
+    g_hash_table_remove (table->index, key);
+
+  return TRUE;
+}
+
+/* drops the ref of the table on @frame, returns %FALSE when @frame was not
+ * in the table */
+gboolean
+__gst_video_codec_frame_table_remove (GstVideoCodecFrameTable * table,
+    GstVideoCodecFrame * frame)
+{
+  gpointer key = GINT_TO_POINTER (frame->system_frame_number);
+  GQueue *links;
+  GList *link = NULL, *l;
+
+  links = g_hash_table_lookup (table->index, key);
+  if (links) {
+    for (l = links->head; l; l = l->next) {
+      if (((GList *) l->data)->data == frame) {
+        link = l->data;
+        break;
+      }
+    }
+  }
+
+  if (link) {
+    frame_table_unindex (table, key, links, link);
+  } else {
+    GHashTableIter iter;
+
+    /* the system_frame_number changed after @frame was added */
+    link = g_queue_find (&table->frames, frame);
+    if (link == NULL)
+      return FALSE;
+
+    g_hash_table_iter_init (&iter, table->index);
+    while (g_hash_table_iter_next (&iter, &key, (gpointer *) & links)) {
+      if (frame_table_unindex (table, key, links, link))
+        break;
+    }
+  }
+
+  g_queue_delete_link (&table->frames, link);
+  gst_video_codec_frame_unref (frame);
+
+  return TRUE;
+}
+
+/* returns a borrowed frame, the oldest one if several frames have
+ * @frame_number */
+GstVideoCodecFrame *
+__gst_video_codec_frame_table_lookup (GstVideoCodecFrameTable * table,
+    gint frame_number)
+{
+  GQueue *links;
+  GList *l;
+
+  links = g_hash_table_lookup (table->index, GINT_TO_POINTER (frame_number));
+  if (links) {
+    for (l = links->head; l; l = l->next) {
+      GstVideoCodecFrame *frame = ((GList *) l->data)->data;
+
+      if (frame->system_frame_number == frame_number)
+        return frame;
+    }
+  }
+
+  /* not indexed under this number, it may have been changed */
+  for (l = table->frames.head; l; l = l->next) {
+    GstVideoCodecFrame *frame = l->data;
+
+    if (frame->system_frame_number == frame_number)
+      return frame;
+  }
+
+  return NULL;
+}
+
+/* returns a list with a ref on every frame, oldest first */
+GList *
+__gst_video_codec_frame_table_copy (GstVideoCodecFrameTable * table)
+{
+  GList *frames = NULL, *l;
+
+  for (l = table->frames.tail; l; l = l->prev)
+    frames = g_list_prepend (frames, gst_video_codec_frame_ref (l->data));
+
+  return frames;
+}
+
+/* Parallelized task runner, shared by the converter and frame copy code */
+
+static gpointer
+gst_parallelized_task_thread_func (gpointer data)
+{
+  GstParallelizedTaskThread *self = data;
+
+  g_mutex_lock (&self->runner->lock);
+  self->runner->n_done++;
+  if (self->runner->n_done == self->runner->n_wait)
+    g_cond_signal (&self->runner->cond_done);
+
+  do {
+    gint idx;
+
+    while (self->runner->n_todo == -1 && !self->runner->quit)
+      g_cond_wait (&self->runner->cond_todo, &self->runner->lock);
+
+    if (self->runner->quit)
+      break;
+
+    idx = self->runner->n_todo--;
+    g_assert (self->runner->n_todo >= -1);
+    g_mutex_unlock (&self->runner->lock);
+
+    g_assert (self->runner->func != NULL);
+
+    self->runner->func (self->runner->task_data[idx]);
+
+    g_mutex_lock (&self->runner->lock);
+    self->runner->n_done++;
+    if (self->runner->n_done == self->runner->n_wait)
+      g_cond_signal (&self->runner->cond_done);
+  } while (TRUE);
+
+  g_mutex_unlock (&self->runner->lock);
+
+  return NULL;
+}
+
+void
+gst_parallelized_task_runner_free (GstParallelizedTaskRunner * self)
+{
+  guint i;
+
+  g_mutex_lock (&self->lock);
+  self->quit = TRUE;
+  g_cond_broadcast (&self->cond_todo);
+  g_mutex_unlock (&self->lock);
+
+  for (i = 1; i < self->n_threads; i++) {
+    if (!self->threads[i].thread)
+      continue;
+
+    g_thread_join (self->threads[i].thread);
+  }
+
+  g_mutex_clear (&self->lock);
+  g_cond_clear (&self->cond_todo);
+  g_cond_clear (&self->cond_done);
+  g_free (self->threads);
+  g_free (self);
+}
+
+GstParallelizedTaskRunner *
+gst_parallelized_task_runner_new (guint n_threads)
+{
+  GstParallelizedTaskRunner *self;
+  guint i;
+  GError *err = NULL;
+
+  if (n_threads == 0)
+    n_threads = g_get_num_processors ();
+
+  self = g_new0 (GstParallelizedTaskRunner, 1);
+  self->n_threads = n_threads;
+  self->threads = g_new0 (GstParallelizedTaskThread, n_threads);
+
+  self->quit = FALSE;
+  self->n_todo = -1;
+  self->n_done = 0;
+  self->n_wait = n_threads - 1;
+  g_mutex_init (&self->lock);
+  g_cond_init (&self->cond_todo);
+  g_cond_init (&self->cond_done);
+
+  /* Set when scheduling a job */
+  self->func = NULL;
+  self->task_data = NULL;
+
+  for (i = 0; i < n_threads; i++) {
+    self->threads[i].runner = self;
+    self->threads[i].idx = i;
+
+    /* First thread is the one calling run() */
+    if (i > 0) {
+      self->threads[i].thread =
+          g_thread_try_new ("videoworker", gst_parallelized_task_thread_func,
+          &self->threads[i], &err);
+      if (!self->threads[i].thread)
+        goto error;
+    }
+  }
+
+  g_mutex_lock (&self->lock);
+  while (self->n_done < self->n_threads - 1)
+    g_cond_wait (&self->cond_done, &self->lock);
+  self->n_done = 0;
+  g_mutex_unlock (&self->lock);
+
+  return self;
+
+error:
+  {
+    GST_ERROR ("Failed to start thread %u: %s", i, err->message);
+    g_clear_error (&err);
+
+    gst_parallelized_task_runner_free (self);
+    return NULL;
+  }
+}
+
+void
+gst_parallelized_task_runner_run (GstParallelizedTaskRunner * self,
+    GstParallelizedTaskFunc func, gpointer * task_data)
+{
+  gst_parallelized_task_runner_run_n (self, func, task_data, self->n_threads);
+}
+
+/* Like gst_parallelized_task_runner_run() but only runs the first @n_tasks
+ * entries of @task_data, leaving the other threads of the runner idle.
+ * @n_tasks must be between 1 and the number of threads of the runner. */
+void
+gst_parallelized_task_runner_run_n (GstParallelizedTaskRunner * self,
+    GstParallelizedTaskFunc func, gpointer * task_data, guint n_tasks)
+{
+  g_assert (n_tasks > 0 && n_tasks <= self->n_threads);
+
+  self->func = func;
+  self->task_data = task_data;
+
+  if (n_tasks > 1) {
+    g_mutex_lock (&self->lock);
+    self->n_todo = n_tasks - 2;
+    self->n_done = 0;
+    self->n_wait = n_tasks - 1;
+    g_cond_broadcast (&self->cond_todo);
+    g_mutex_unlock (&self->lock);
+  }
+
+  self->func (self->task_data[n_tasks - 1]);
+
+  if (n_tasks > 1) {
+    g_mutex_lock (&self->lock);
+    while (self->n_done < n_tasks - 1)
+      g_cond_wait (&self->cond_done, &self->lock);
+    self->n_done = 0;
+    g_mutex_unlock (&self->lock);
+  }
+
+  self->func = NULL;
+  self->task_data = NULL;
+}
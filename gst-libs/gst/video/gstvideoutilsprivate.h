@@ -46,6 +46,109 @@ gboolean __gst_video_rawvideo_convert (GstVideoCodecState * state, GstFormat src
                                        gint64 src_value, GstFormat * dest_format,
                                        gint64 * dest_value);
 
+/* Pending codec frames, in the order they were handed to the subclass,
+ * with O(1) lookup and removal by system_frame_number */
+typedef struct _GstVideoCodecFrameTable GstVideoCodecFrameTable;
+
+struct _GstVideoCodecFrameTable
+{
+  GQueue frames;                /* GstVideoCodecFrame, oldest first */
+  GHashTable *index;            /* system_frame_number -> GQueue of links
+                                 * in frames, oldest first */
+};
+
+G_GNUC_INTERNAL
+void __gst_video_codec_frame_table_init (GstVideoCodecFrameTable * table);
+
+G_GNUC_INTERNAL
+void __gst_video_codec_frame_table_clear (GstVideoCodecFrameTable * table);
+
+G_GNUC_INTERNAL
+void __gst_video_codec_frame_table_free (GstVideoCodecFrameTable * table);
+
+G_GNUC_INTERNAL
+void __gst_video_codec_frame_table_push (GstVideoCodecFrameTable * table,
+                                         GstVideoCodecFrame * frame);
+
+G_GNUC_INTERNAL
+gboolean __gst_video_codec_frame_table_remove (GstVideoCodecFrameTable * table,
+                                               GstVideoCodecFrame * frame);
+
+G_GNUC_INTERNAL
+GstVideoCodecFrame *__gst_video_codec_frame_table_lookup (GstVideoCodecFrameTable * table,
+                                                          gint frame_number);
+
+G_GNUC_INTERNAL
+GList *__gst_video_codec_frame_table_copy (GstVideoCodecFrameTable * table);
+
+#define __gst_video_codec_frame_table_head(t) ((t)->frames.head)
+#define __gst_video_codec_frame_table_oldest(t) \
+    ((GstVideoCodecFrame *) g_queue_peek_head (&(t)->frames))
+#define __gst_video_codec_frame_table_length(t) ((t)->frames.length)
+
+/* Overlay blending. The native 4:2:0 path averages chroma differently from
+ * gst_video_blend(), so it is only used by the overlay composition and the
+ * public function keeps its output. */
+typedef struct _GstVideoBlendChroma GstVideoBlendChroma;
+
+G_GNUC_INTERNAL
+gboolean __gst_video_blend_is_native (const GstVideoInfo * dest_info);
+
+G_GNUC_INTERNAL
+gboolean __gst_video_blend_cached (GstVideoFrame * dest, GstVideoFrame * src,
+                                   gint x, gint y, gfloat global_alpha,
+                                   GstVideoBlendChroma ** chroma);
+
+G_GNUC_INTERNAL
+void __gst_video_blend_chroma_free (GstVideoBlendChroma * chroma);
+
+/* Parallelized task runner */
+typedef void (*GstParallelizedTaskFunc) (gpointer user_data);
+
+typedef struct _GstParallelizedTaskRunner GstParallelizedTaskRunner;
+typedef struct _GstParallelizedTaskThread GstParallelizedTaskThread;
+
+struct _GstParallelizedTaskThread
+{
+  GstParallelizedTaskRunner *runner;
+  guint idx;
+  GThread *thread;
+};
+
+struct _GstParallelizedTaskRunner
+{
+  guint n_threads;
+
+  GstParallelizedTaskThread *threads;
+
+  GstParallelizedTaskFunc func;
+  gpointer *task_data;
+
+  GMutex lock;
+  GCond cond_todo, cond_done;
+  gint n_todo, n_done;
+  /* number of worker threads the running job waits for */
+  gint n_wait;
+  gboolean quit;
+};
+
+G_GNUC_INTERNAL
+GstParallelizedTaskRunner *gst_parallelized_task_runner_new (guint n_threads);
+
+G_GNUC_INTERNAL
+void gst_parallelized_task_runner_free (GstParallelizedTaskRunner * self);
+
+G_GNUC_INTERNAL
+void gst_parallelized_task_runner_run (GstParallelizedTaskRunner * self,
+                                       GstParallelizedTaskFunc func,
+                                       gpointer * task_data);
+
+G_GNUC_INTERNAL
+void gst_parallelized_task_runner_run_n (GstParallelizedTaskRunner * self,
+                                         GstParallelizedTaskFunc func,
+                                         gpointer * task_data,
+                                         guint n_tasks);
+
 G_END_DECLS
 
 #endif
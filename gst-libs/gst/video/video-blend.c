@@ -28,6 +28,7 @@
 #endif
 
 #include "video-blend.h"
+#include "gstvideoutilsprivate.h"
 #include "video-orc.h"
 
 #include <string.h>
@@ -276,6 +277,317 @@ G_STMT_START { \
 } G_STMT_END
 
 
+/* Native blending onto 4:2:0 frames
+ *
+ * Instead of unpacking, blending and repacking full destination lines, the
+ * overlay (which must be non-premultiplied AYUV) is blended straight into the
+ * planes of the frame, touching only the pixels it covers. Chroma is blended
+ * with a 2x2 subsampled copy of the overlay, which only depends on the parity
+ * of the overlay position and can therefore be kept around by the caller
+ * between frames. */
+struct _GstVideoBlendChroma
+{
+  /* overlay dimensions and position parity the samples were made for */
+  gint src_width, src_height;
+  gint phase_x, phase_y;
+
+  /* subsampled overlay, 3 bytes (A, U, V) per chroma sample */
+  gint width, height;
+  guint8 *data;
+};
+
+gboolean
+__gst_video_blend_is_native (const GstVideoInfo * dest_info)
+{
+  if (GST_VIDEO_INFO_IS_INTERLACED (dest_info))
+    return FALSE;
+
+  switch (GST_VIDEO_INFO_FORMAT (dest_info)) {
+    case GST_VIDEO_FORMAT_I420:
+    case GST_VIDEO_FORMAT_YV12:
+    case GST_VIDEO_FORMAT_NV12:
+    case GST_VIDEO_FORMAT_NV21:
+    case GST_VIDEO_FORMAT_P010_10LE:
+    case GST_VIDEO_FORMAT_P010_10BE:
+      return TRUE;
+    default:
+      return FALSE;
+  }
+}
+
+static gboolean
+video_blend_can_blend_native (GstVideoFrame * dest, GstVideoFrame * src)
+{
+  return GST_VIDEO_FRAME_FORMAT (src) == GST_VIDEO_FORMAT_AYUV
+      && !(GST_VIDEO_INFO_FLAGS (&src->info) &
+      GST_VIDEO_FLAG_PREMULTIPLIED_ALPHA)
+      && __gst_video_blend_is_native (&dest->info);
+}
+
+static GstVideoBlendChroma *
+video_blend_chroma_new (GstVideoFrame * src, gint phase_x, gint phase_y)
+{
+  GstVideoBlendChroma *chroma;
+  const guint8 *sdata, *s;
+  gint sstride, width, height, i, j, k, l, sx, sy;
+  guint suma, sumu, sumv;
+  guint8 *out;
+
+  width = GST_VIDEO_FRAME_WIDTH (src);
+  height = GST_VIDEO_FRAME_HEIGHT (src);
+  sdata = GST_VIDEO_FRAME_PLANE_DATA (src, 0);
+  sstride = GST_VIDEO_FRAME_PLANE_STRIDE (src, 0);
+
+  chroma = g_slice_new (GstVideoBlendChroma);
+  chroma->src_width = width;
+  chroma->src_height = height;
+  chroma->phase_x = phase_x;
+  chroma->phase_y = phase_y;
+  chroma->width = (width + phase_x + 1) / 2;
+  chroma->height = (height + phase_y + 1) / 2;
+  chroma->data = g_malloc (chroma->width * chroma->height * 3);
+
+  out = chroma->data;
+  for (i = 0; i < chroma->height; i++) {
+    for (j = 0; j < chroma->width; j++, out += 3) {
+      suma = sumu = sumv = 0;
+
+      /* pixels of the block outside of the overlay count as transparent */
+      for (k = 0; k < 2; k++) {
+        sy = 2 * i - phase_y + k;
+        if (sy < 0 || sy >= height)
+          continue;
+        for (l = 0; l < 2; l++) {
+          sx = 2 * j - phase_x + l;
+          if (sx < 0 || sx >= width)
+            continue;
+          s = sdata + sy * sstride + sx * 4;
+          suma += s[0];
+          sumu += s[0] * s[2];
+          sumv += s[0] * s[3];
+        }
+      }
+
+      out[0] = (suma + 2) / 4;
+      if (suma) {
+        out[1] = (sumu + suma / 2) / suma;
+        out[2] = (sumv + suma / 2) / suma;
+      } else {
+        out[1] = out[2] = 128;
+      }
+    }
+  }
+
+  return chroma;
+}
+
+void
+__gst_video_blend_chroma_free (GstVideoBlendChroma * chroma)
+{
+  g_free (chroma->data);
+  g_slice_free (GstVideoBlendChroma, chroma);
+}
+
+static void
+video_blend_luma_u8 (guint8 * d, const guint8 * s, gint width, guint alpha)
+{
+  gint i;
+  guint a;
+
+  for (i = 0; i < width; i++, s += 4) {
+    a = s[0] * alpha / 255;
+    d[i] = (s[1] * a + d[i] * (255 - a)) / 255;
+  }
+}
+
+static void
+video_blend_luma_u16 (guint8 * d, const guint8 * s, gint width, guint alpha,
+    gboolean big_endian)
+{
+  gint i;
+  guint a, c;
+
+  for (i = 0; i < width; i++, s += 4, d += 2) {
+    a = s[0] * alpha / 255;
+    if (a == 0)
+      continue;
+    c = big_endian ? GST_READ_UINT16_BE (d) : GST_READ_UINT16_LE (d);
+    c = ((s[1] << 8) * a + c * (255 - a)) / 255;
+    /* samples are MSB aligned, keep the padding bits clear */
+    c &= 0xffc0;
+    if (big_endian)
+      GST_WRITE_UINT16_BE (d, c);
+    else
+      GST_WRITE_UINT16_LE (d, c);
+  }
+}
+
+static void
+video_blend_chroma_u8 (guint8 * du, guint8 * dv, gint pstride,
+    const guint8 * s, gint width, guint alpha)
+{
+  gint i;
+  guint a;
+
+  for (i = 0; i < width; i++, s += 3, du += pstride, dv += pstride) {
+    a = s[0] * alpha / 255;
+    if (a == 0)
+      continue;
+    *du = (s[1] * a + *du * (255 - a)) / 255;
+    *dv = (s[2] * a + *dv * (255 - a)) / 255;
+  }
+}
+
+static void
+video_blend_chroma_u16 (guint8 * du, guint8 * dv, gint pstride,
+    const guint8 * s, gint width, guint alpha, gboolean big_endian)
+{
+  gint i;
+  guint a, u, v;
+
+  for (i = 0; i < width; i++, s += 3, du += pstride, dv += pstride) {
+    a = s[0] * alpha / 255;
+    if (a == 0)
+      continue;
+    if (big_endian) {
+      u = GST_READ_UINT16_BE (du);
+      v = GST_READ_UINT16_BE (dv);
+    } else {
+      u = GST_READ_UINT16_LE (du);
+      v = GST_READ_UINT16_LE (dv);
+    }
+    u = (((s[1] << 8) * a + u * (255 - a)) / 255) & 0xffc0;
+    v = (((s[2] << 8) * a + v * (255 - a)) / 255) & 0xffc0;
+    if (big_endian) {
+      GST_WRITE_UINT16_BE (du, u);
+      GST_WRITE_UINT16_BE (dv, v);
+    } else {
+      GST_WRITE_UINT16_LE (du, u);
+      GST_WRITE_UINT16_LE (dv, v);
+    }
+  }
+}
+
+static void
+video_blend_native (GstVideoFrame * dest, GstVideoFrame * src, gint x, gint y,
+    guint alpha, GstVideoBlendChroma ** chroma_cache)
+{
+  GstVideoBlendChroma *chroma = NULL;
+  gint src_width, src_height, dest_width, dest_height;
+  gint x0, y0, x1, y1, cx0, cy0, cx1, cy1, cxoff, cyoff, i;
+  gint sstride, dstride, ustride, vstride, pstride;
+  guint8 *sdata, *ddata, *udata, *vdata;
+  gboolean deep, big_endian;
+
+  src_width = GST_VIDEO_FRAME_WIDTH (src);
+  src_height = GST_VIDEO_FRAME_HEIGHT (src);
+  dest_width = GST_VIDEO_FRAME_WIDTH (dest);
+  dest_height = GST_VIDEO_FRAME_HEIGHT (dest);
+
+  /* visible part of the overlay, in frame coordinates */
+  x0 = MAX (x, 0);
+  y0 = MAX (y, 0);
+  x1 = MIN (x + src_width, dest_width);
+  y1 = MIN (y + src_height, dest_height);
+
+  deep = GST_VIDEO_FRAME_COMP_DEPTH (dest, 0) > 8;
+  big_endian = !GST_VIDEO_FORMAT_INFO_IS_LE (dest->info.finfo);
+
+  /* luma */
+  sdata = GST_VIDEO_FRAME_PLANE_DATA (src, 0);
+  sstride = GST_VIDEO_FRAME_PLANE_STRIDE (src, 0);
+  ddata = GST_VIDEO_FRAME_COMP_DATA (dest, 0);
+  dstride = GST_VIDEO_FRAME_COMP_STRIDE (dest, 0);
+  pstride = GST_VIDEO_FRAME_COMP_PSTRIDE (dest, 0);
+
+  for (i = y0; i < y1; i++) {
+    const guint8 *s = sdata + (i - y) * sstride + (x0 - x) * 4;
+    guint8 *d = ddata + i * dstride + x0 * pstride;
+
+    if (deep)
+      video_blend_luma_u16 (d, s, x1 - x0, alpha, big_endian);
+    else
+      video_blend_luma_u8 (d, s, x1 - x0, alpha);
+  }
+
+  /* chroma */
+  if (chroma_cache)
+    chroma = *chroma_cache;
+
+  if (chroma == NULL || chroma->src_width != src_width
+      || chroma->src_height != src_height || chroma->phase_x != (x & 1)
+      || chroma->phase_y != (y & 1)) {
+    chroma = video_blend_chroma_new (src, x & 1, y & 1);
+    if (chroma_cache) {
+      if (*chroma_cache)
+        __gst_video_blend_chroma_free (*chroma_cache);
+      *chroma_cache = chroma;
+    }
+  }
+
+  /* first chroma sample of the overlay in the frame, x - phase is even */
+  cxoff = (x - chroma->phase_x) / 2;
+  cyoff = (y - chroma->phase_y) / 2;
+  cx0 = x0 / 2;
+  cy0 = y0 / 2;
+  cx1 = (x1 - 1) / 2 + 1;
+  cy1 = (y1 - 1) / 2 + 1;
+
+  udata = GST_VIDEO_FRAME_COMP_DATA (dest, 1);
+  ustride = GST_VIDEO_FRAME_COMP_STRIDE (dest, 1);
+  vdata = GST_VIDEO_FRAME_COMP_DATA (dest, 2);
+  vstride = GST_VIDEO_FRAME_COMP_STRIDE (dest, 2);
+  pstride = GST_VIDEO_FRAME_COMP_PSTRIDE (dest, 1);
+
+  for (i = cy0; i < cy1; i++) {
+    const guint8 *s = chroma->data +
+        ((i - cyoff) * chroma->width + cx0 - cxoff) * 3;
+    guint8 *du = udata + i * ustride + cx0 * pstride;
+    guint8 *dv = vdata + i * vstride + cx0 * pstride;
+
+    if (deep)
+      video_blend_chroma_u16 (du, dv, pstride, s, cx1 - cx0, alpha,
+          big_endian);
+    else
+      video_blend_chroma_u8 (du, dv, pstride, s, cx1 - cx0, alpha);
+  }
+
+  if (chroma_cache == NULL)
+    __gst_video_blend_chroma_free (chroma);
+}
+
+gboolean
+__gst_video_blend_cached (GstVideoFrame * dest, GstVideoFrame * src,
+    gint x, gint y, gfloat global_alpha, GstVideoBlendChroma ** chroma)
+{
+  gint src_width, src_height;
+
+  if (!video_blend_can_blend_native (dest, src))
+    return gst_video_blend (dest, src, x, y, global_alpha);
+
+  ensure_debug_category ();
+
+  src_width = GST_VIDEO_FRAME_WIDTH (src);
+  src_height = GST_VIDEO_FRAME_HEIGHT (src);
+
+  GST_LOG ("native blend src %dx%d onto dest %dx%d @ %d,%d", src_width,
+      src_height, GST_VIDEO_FRAME_WIDTH (dest), GST_VIDEO_FRAME_HEIGHT (dest),
+      x, y);
+
+  if (x + src_width <= 0 || y + src_height <= 0
+      || x >= GST_VIDEO_FRAME_WIDTH (dest)
+      || y >= GST_VIDEO_FRAME_HEIGHT (dest)) {
+    GST_LOG ("Overlay completely outside the video surface, hence not "
+        "rendering");
+    return TRUE;
+  }
+
+  video_blend_native (dest, src, x, y, CLAMP (255.0 * global_alpha, 0, 255),
+      chroma);
+
+  return TRUE;
+}
+
 /**
  * gst_video_blend:
  * @dest: The #GstVideoFrame where to blend @src in
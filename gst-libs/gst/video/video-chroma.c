@@ -127,8 +127,24 @@ struct _GstVideoChromaResample
       gint width);
   void (*v_resample) (GstVideoChromaResample * resample, gpointer lines[],
       gint width);
+
+  /* scratch line for the kernels that can't work in place */
+  gpointer tmpline;
+  gsize tmpline_size;
 };
 
+static gpointer
+video_chroma_resample_get_tmpline (GstVideoChromaResample * resample,
+    gsize size)
+{
+  if (resample->tmpline_size < size) {
+    g_free (resample->tmpline);
+    resample->tmpline = g_malloc (size);
+    resample->tmpline_size = size;
+  }
+  return resample->tmpline;
+}
+
 #define PR(i)          (p[2 + 4 * (i)])
 #define PB(i)          (p[3 + 4 * (i)])
 
@@ -191,6 +207,40 @@ video_chroma_up_h2_##name (GstVideoChromaResample *resample,            \
   }                                                                     \
 }
 
+/* The ORC version reads the original chroma of the next pixel pair, so it
+ * writes to a scratch line that is copied back afterwards. On odd widths the
+ * last pair is done in C because the ORC kernel would read past the line. */
+#define MAKE_UPSAMPLE_H2_ORC(name,type)                                 \
+static void                                                             \
+video_chroma_up_h2_##name (GstVideoChromaResample *resample,            \
+    gpointer pixels, gint width)                                        \
+{                                                                       \
+  type *p = pixels;                                                     \
+  type *d;                                                              \
+  gint i, n;                                                            \
+                                                                        \
+  if (width < 3)                                                        \
+    return;                                                             \
+                                                                        \
+  n = (width - 2) / 2;                                                  \
+  d = video_chroma_resample_get_tmpline (resample,                      \
+      n * 8 * sizeof (type));                                           \
+  video_orc_chroma_up_h2_##name (d, p, p + 8, n);                       \
+                                                                        \
+  i = 2 * n + 1;                                                        \
+  if (i < width - 1) {                                                  \
+    type tr0 = PR(i-1), tr1 = PR(i+1);                                  \
+    type tb0 = PB(i-1), tb1 = PB(i+1);                                  \
+                                                                        \
+    PR(i) = FILT_3_1 (tr0, tr1);                                        \
+    PB(i) = FILT_3_1 (tb0, tb1);                                        \
+    PR(i+1) = FILT_1_3 (tr0, tr1);                                      \
+    PB(i+1) = FILT_1_3 (tb0, tb1);                                      \
+  }                                                                     \
+  if (n > 0)                                                            \
+    memcpy (p + 4, d, n * 8 * sizeof (type));                           \
+}
+
 /* 2x vertical upsampling without cositing
  *
  *   O--O--O-  <---- a
@@ -241,13 +291,10 @@ static void                                                             \
 video_chroma_up_vi2_##name (GstVideoChromaResample *resample,           \
     gpointer lines[], gint width)                                       \
 {                                                                       \
-  gint i;                                                               \
   type *l0 = lines[0];                                                  \
   type *l1 = lines[1];                                                  \
   type *l2 = lines[2];                                                  \
   type *l3 = lines[3];                                                  \
-  type tr0, tr1, tr2, tr3;                                              \
-  type tb0, tb1, tb2, tb3;                                              \
                                                                         \
   if (resample->h_resample) {                                           \
     if (l0 != l1) {                                                     \
@@ -260,21 +307,12 @@ video_chroma_up_vi2_##name (GstVideoChromaResample *resample,           \
     }                                                                   \
   }                                                                     \
   if (l0 != l1 && l2 != l3) {                                           \
-    for (i = 0; i < width; i++) {                                       \
-      tr0 = PR0(i), tr2 = PR2(i);                                       \
-      tb0 = PB0(i), tb2 = PB2(i);                                       \
-      tr1 = PR1(i), tr3 = PR3(i);                                       \
-      tb1 = PB1(i), tb3 = PB3(i);                                       \
-                                                                        \
-      PR0(i) = FILT_5_3 (tr0, tr2);                                     \
-      PB0(i) = FILT_5_3 (tb0, tb2);                                     \
-      PR1(i) = FILT_7_1 (tr1, tr3);                                     \
-      PB1(i) = FILT_7_1 (tb1, tb3);                                     \
-      PR2(i) = FILT_1_7 (tr0, tr2);                                     \
-      PB2(i) = FILT_1_7 (tb0, tb2);                                     \
-      PR3(i) = FILT_3_5 (tr1, tr3);                                     \
-      PB3(i) = FILT_3_5 (tb1, tb3);                                     \
-    }                                                                   \
+    type *d0 = l0;                                                      \
+    type *d1 = l1;                                                      \
+    type *d2 = l2;                                                      \
+    type *d3 = l3;                                                      \
+    video_orc_chroma_up_vi2_##name (d0, d1, d2, d3, l0, l1, l2, l3,     \
+        width);                                                         \
   }                                                                     \
 }
 
@@ -361,7 +399,7 @@ video_chroma_down_vi2_##name (GstVideoChromaResample *resample,         \
 }
 
 MAKE_UPSAMPLE_H2 (u16, guint16);
-MAKE_UPSAMPLE_H2 (u8, guint8);
+MAKE_UPSAMPLE_H2_ORC (u8, guint8);
 MAKE_UPSAMPLE_V2 (u16, guint16);
 MAKE_UPSAMPLE_V2 (u8, guint8);
 MAKE_UPSAMPLE_VI2 (u16, guint16);
@@ -568,14 +606,27 @@ MAKE_DOWNSAMPLE_VI4 (u8, guint8);
  * x   x
  * a   b
  */
+/* The ORC version only reads the cosited samples of the next pixel pair,
+ * which it leaves untouched, so it can work in place. */
 #define MAKE_UPSAMPLE_H2_CS_ORC(name,type)                              \
 static void                                                             \
 video_chroma_up_h2_cs_##name (GstVideoChromaResample *resample,         \
     gpointer pixels, gint width)                                        \
 {                                                                       \
   type *p = pixels;                                                     \
-  /* ORC version is slower */                                           \
-  video_orc_chroma_up_h2_cs_##name (p, p, p, width-1);                  \
+  type *d = p;                                                          \
+  gint i, n;                                                            \
+                                                                        \
+  if (width < 3)                                                        \
+    return;                                                             \
+                                                                        \
+  n = (width - 2) / 2;                                                  \
+  video_orc_chroma_up_h2_cs_##name (d, p, p + 8, n);                    \
+                                                                        \
+  for (i = 2 * n + 1; i < width - 1; i += 2) {                          \
+    PR(i) = FILT_1_1 (PR(i-1), PR(i+1));                                \
+    PB(i) = FILT_1_1 (PB(i-1), PB(i+1));                                \
+  }                                                                     \
 }
 
 #define MAKE_UPSAMPLE_H2_CS(name,type)                                  \
@@ -654,6 +705,31 @@ video_chroma_down_h2_cs_##name (GstVideoChromaResample *resample,       \
     PB(i) = FILT_1_3 (PB(i-1), PB(i));                                  \
   }                                                                     \
 }
+
+#define MAKE_DOWNSAMPLE_H2_CS_ORC(name,type)                            \
+static void                                                             \
+video_chroma_down_h2_cs_##name (GstVideoChromaResample *resample,       \
+    gpointer pixels, gint width)                                        \
+{                                                                       \
+  type *p = pixels;                                                     \
+  type *d = p + 8;                                                      \
+  gint i, n;                                                            \
+                                                                        \
+  if (width < 2)                                                        \
+    return;                                                             \
+                                                                        \
+  PR(0) = FILT_3_1 (PR(0), PR(1));                                      \
+  PB(0) = FILT_3_1 (PB(0), PB(1));                                      \
+                                                                        \
+  n = (width - 3) / 2;                                                  \
+  video_orc_chroma_down_h2_cs_##name (d, p + 8, p, n);                  \
+                                                                        \
+  i = 2 * n + 2;                                                        \
+  if (i < width) {                                                      \
+    PR(i) = FILT_1_3 (PR(i-1), PR(i));                                  \
+    PB(i) = FILT_1_3 (PB(i-1), PB(i));                                  \
+  }                                                                     \
+}
 /* 2x vertical downsampling with cositing
  *
  * a x O--O--O-  <---- a
@@ -688,13 +764,13 @@ video_chroma_down_vi2_cs_##name (GstVideoChromaResample *resample,      \
 }
 
 MAKE_UPSAMPLE_H2_CS (u16, guint16);
-MAKE_UPSAMPLE_H2_CS (u8, guint8);
+MAKE_UPSAMPLE_H2_CS_ORC (u8, guint8);
 MAKE_UPSAMPLE_V2_CS (u16, guint16);
 MAKE_UPSAMPLE_V2_CS (u8, guint8);
 MAKE_UPSAMPLE_VI2_CS (u16, guint16);
 MAKE_UPSAMPLE_VI2_CS (u8, guint8);
 MAKE_DOWNSAMPLE_H2_CS (u16, guint16);
-MAKE_DOWNSAMPLE_H2_CS (u8, guint8);
+MAKE_DOWNSAMPLE_H2_CS_ORC (u8, guint8);
 MAKE_DOWNSAMPLE_V2_CS (u16, guint16);
 MAKE_DOWNSAMPLE_V2_CS (u8, guint8);
 MAKE_DOWNSAMPLE_VI2_CS (u16, guint16);
@@ -995,6 +1071,8 @@ gst_video_chroma_resample_new (GstVideoChromaMethod method,
   result->v_resample = v_resamplers[v_index].resample;
   result->n_lines = v_resamplers[v_index].n_lines;
   result->offset = v_resamplers[v_index].offset;
+  result->tmpline = NULL;
+  result->tmpline_size = 0;
 
   GST_DEBUG ("resample %p, bits %d, n_lines %u, offset %d", result, bits,
       result->n_lines, result->offset);
@@ -1034,6 +1112,7 @@ gst_video_chroma_resample_free (GstVideoChromaResample * resample)
 {
   g_return_if_fail (resample != NULL);
 
+  g_free (resample->tmpline);
   g_slice_free (GstVideoChromaResample, resample);
 }
 
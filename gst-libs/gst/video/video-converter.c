@@ -36,6 +36,7 @@
 #include <math.h>
 
 #include "video-orc.h"
+#include "gstvideoutilsprivate.h"
 
 #ifdef HAVE_RGA
 #include <rga/rga.h>
@@ -120,199 +121,6 @@ ensure_debug_category (void)
 #define ensure_debug_category() /* NOOP */
 #endif /* GST_DISABLE_GST_DEBUG */
 
-typedef void (*GstParallelizedTaskFunc) (gpointer user_data);
-
-typedef struct _GstParallelizedTaskRunner GstParallelizedTaskRunner;
-typedef struct _GstParallelizedTaskThread GstParallelizedTaskThread;
-
-struct _GstParallelizedTaskThread
-{
-  GstParallelizedTaskRunner *runner;
-  guint idx;
-  GThread *thread;
-};
-
-struct _GstParallelizedTaskRunner
-{
-  guint n_threads;
-
-  GstParallelizedTaskThread *threads;
-
-  GstParallelizedTaskFunc func;
-  gpointer *task_data;
-
-  GMutex lock;
-  GCond cond_todo, cond_done;
-  gint n_todo, n_done;
-  gboolean quit;
-};
-
-static gpointer
-gst_parallelized_task_thread_func (gpointer data)
-{
-  GstParallelizedTaskThread *self = data;
-
-#if 0
-#ifdef HAVE_PTHREAD
-  {
-    pthread_t thread = pthread_self ();
-    cpu_set_t cpuset;
-    int r;
-
-    CPU_ZERO (&cpuset);
-    CPU_SET (self->idx, &cpuset);
-    if ((r = pthread_setaffinity_np (thread, sizeof (cpuset), &cpuset)) != 0)
-      GST_ERROR ("Failed to set thread affinity for thread %d: %s", self->idx,
-          g_strerror (r));
-  }
-#endif
-#endif
-
-  g_mutex_lock (&self->runner->lock);
-  self->runner->n_done++;
-  if (self->runner->n_done == self->runner->n_threads - 1)
-    g_cond_signal (&self->runner->cond_done);
-
-  do {
-    gint idx;
-
-    while (self->runner->n_todo == -1 && !self->runner->quit)
-      g_cond_wait (&self->runner->cond_todo, &self->runner->lock);
-
-    if (self->runner->quit)
-      break;
-
-    idx = self->runner->n_todo--;
-    g_assert (self->runner->n_todo >= -1);
-    g_mutex_unlock (&self->runner->lock);
-
-    g_assert (self->runner->func != NULL);
-
-    self->runner->func (self->runner->task_data[idx]);
-
-    g_mutex_lock (&self->runner->lock);
-    self->runner->n_done++;
-    if (self->runner->n_done == self->runner->n_threads - 1)
-      g_cond_signal (&self->runner->cond_done);
-  } while (TRUE);
-
-  g_mutex_unlock (&self->runner->lock);
-
-  return NULL;
-}
-
-static void
-gst_parallelized_task_runner_free (GstParallelizedTaskRunner * self)
-{
-  guint i;
-
-  g_mutex_lock (&self->lock);
-  self->quit = TRUE;
-  g_cond_broadcast (&self->cond_todo);
-  g_mutex_unlock (&self->lock);
-
-  for (i = 1; i < self->n_threads; i++) {
-    if (!self->threads[i].thread)
-      continue;
-
-    g_thread_join (self->threads[i].thread);
-  }
-
-  g_mutex_clear (&self->lock);
-  g_cond_clear (&self->cond_todo);
-  g_cond_clear (&self->cond_done);
-  g_free (self->threads);
-  g_free (self);
-}
-
-static GstParallelizedTaskRunner *
-gst_parallelized_task_runner_new (guint n_threads)
-{
-  GstParallelizedTaskRunner *self;
-  guint i;
-  GError *err = NULL;
-
-  if (n_threads == 0)
-    n_threads = g_get_num_processors ();
-
-  self = g_new0 (GstParallelizedTaskRunner, 1);
-  self->n_threads = n_threads;
-  self->threads = g_new0 (GstParallelizedTaskThread, n_threads);
-
-  self->quit = FALSE;
-  self->n_todo = -1;
-  self->n_done = 0;
-  g_mutex_init (&self->lock);
-  g_cond_init (&self->cond_todo);
-  g_cond_init (&self->cond_done);
-
-  /* Set when scheduling a job */
-  self->func = NULL;
-  self->task_data = NULL;
-
-  for (i = 0; i < n_threads; i++) {
-    self->threads[i].runner = self;
-    self->threads[i].idx = i;
-
-    /* First thread is the one calling run() */
-    if (i > 0) {
-      self->threads[i].thread =
-          g_thread_try_new ("videoconvert", gst_parallelized_task_thread_func,
-          &self->threads[i], &err);
-      if (!self->threads[i].thread)
-        goto error;
-    }
-  }
-
-  g_mutex_lock (&self->lock);
-  while (self->n_done < self->n_threads - 1)
-    g_cond_wait (&self->cond_done, &self->lock);
-  self->n_done = 0;
-  g_mutex_unlock (&self->lock);
-
-  return self;
-
-error:
-  {
-    GST_ERROR ("Failed to start thread %u: %s", i, err->message);
-    g_clear_error (&err);
-
-    gst_parallelized_task_runner_free (self);
-    return NULL;
-  }
-}
-
-static void
-gst_parallelized_task_runner_run (GstParallelizedTaskRunner * self,
-    GstParallelizedTaskFunc func, gpointer * task_data)
-{
-  guint n_threads = self->n_threads;
-
-  self->func = func;
-  self->task_data = task_data;
-
-  if (n_threads > 1) {
-    g_mutex_lock (&self->lock);
-    self->n_todo = self->n_threads - 2;
-    self->n_done = 0;
-    g_cond_broadcast (&self->cond_todo);
-    g_mutex_unlock (&self->lock);
-  }
-
-  self->func (self->task_data[self->n_threads - 1]);
-
-  if (n_threads > 1) {
-    g_mutex_lock (&self->lock);
-    while (self->n_done < self->n_threads - 1)
-      g_cond_wait (&self->cond_done, &self->lock);
-    self->n_done = 0;
-    g_mutex_unlock (&self->lock);
-  }
-
-  self->func = NULL;
-  self->task_data = NULL;
-}
-
 typedef struct _GstLineCache GstLineCache;
 
 #define SCALE    (8)
@@ -324,6 +132,7 @@ struct _MatrixData
 {
   gdouble dm[4][4];
   gint im[4][4];
+  gfloat fm[3][4];
   gint width;
   guint64 orc_p1;
   guint64 orc_p2;
@@ -340,7 +149,7 @@ typedef struct _GammaData GammaData;
 
 struct _GammaData
 {
-  gpointer gamma_table;
+  gconstpointer gamma_table;
   gint width;
   void (*gamma_func) (GammaData * data, gpointer dest, gpointer src);
 };
@@ -803,6 +612,7 @@ get_opt_enum (GstVideoConverter * convert, const gchar * opt, GType type,
 #define DEFAULT_OPT_MATRIX_MODE GST_VIDEO_MATRIX_MODE_FULL
 /* none, remap */
 #define DEFAULT_OPT_GAMMA_MODE GST_VIDEO_GAMMA_MODE_NONE
+#define DEFAULT_OPT_LINEAR_FLOAT FALSE
 /* none, merge-only, fast */
 #define DEFAULT_OPT_PRIMARIES_MODE GST_VIDEO_PRIMARIES_MODE_NONE
 /* options full, upsample-only, downsample-only, none */
@@ -825,6 +635,8 @@ get_opt_enum (GstVideoConverter * convert, const gchar * opt, GType type,
     GST_VIDEO_CONVERTER_OPT_MATRIX_MODE, GST_TYPE_VIDEO_MATRIX_MODE, DEFAULT_OPT_MATRIX_MODE)
 #define GET_OPT_GAMMA_MODE(c) get_opt_enum(c, \
     GST_VIDEO_CONVERTER_OPT_GAMMA_MODE, GST_TYPE_VIDEO_GAMMA_MODE, DEFAULT_OPT_GAMMA_MODE)
+#define GET_OPT_LINEAR_FLOAT(c) get_opt_bool(c, \
+    GST_VIDEO_CONVERTER_OPT_LINEAR_FLOAT, DEFAULT_OPT_LINEAR_FLOAT)
 #define GET_OPT_PRIMARIES_MODE(c) get_opt_enum(c, \
     GST_VIDEO_CONVERTER_OPT_PRIMARIES_MODE, GST_TYPE_VIDEO_PRIMARIES_MODE, DEFAULT_OPT_PRIMARIES_MODE)
 #define GET_OPT_CHROMA_MODE(c) get_opt_enum(c, \
@@ -1338,6 +1150,30 @@ video_converter_matrix16 (MatrixData * data, gpointer pixels)
   }
 }
 
+static void
+video_converter_matrix16_float (MatrixData * data, gpointer pixels)
+{
+  gint i;
+  gfloat r, g, b;
+  gfloat y, u, v;
+  guint16 *p = pixels;
+  gint width = data->width;
+  gfloat (*m)[4] = data->fm;
+
+  for (i = 0; i < width; i++) {
+    r = p[i * 4 + 1];
+    g = p[i * 4 + 2];
+    b = p[i * 4 + 3];
+
+    y = m[0][0] * r + m[0][1] * g + m[0][2] * b + m[0][3];
+    u = m[1][0] * r + m[1][1] * g + m[1][2] * b + m[1][3];
+    v = m[2][0] * r + m[2][1] * g + m[2][2] * b + m[2][3];
+
+    p[i * 4 + 1] = CLAMP (y, 0.0f, 65535.0f) + 0.5f;
+    p[i * 4 + 2] = CLAMP (u, 0.0f, 65535.0f) + 0.5f;
+    p[i * 4 + 3] = CLAMP (v, 0.0f, 65535.0f) + 0.5f;
+  }
+}
 
 static void
 prepare_matrix (GstVideoConverter * convert, MatrixData * data)
@@ -1388,6 +1224,27 @@ prepare_matrix (GstVideoConverter * convert, MatrixData * data)
   }
 }
 
+/* like prepare_matrix() but keeps the coefficients in floating point, only
+ * used for 16 bits linear light data where the 8 bit fixed point
+ * coefficients are not precise enough */
+static void
+prepare_matrix_float (GstVideoConverter * convert, MatrixData * data)
+{
+  gint i, j;
+
+  if (is_identity_matrix (data))
+    return;
+
+  for (i = 0; i < 3; i++)
+    for (j = 0; j < 4; j++)
+      data->fm[i][j] = data->dm[i][j];
+
+  data->width = convert->current_width;
+
+  GST_DEBUG ("use 16bit float matrix");
+  data->matrix_func = video_converter_matrix16_float;
+}
+
 static void
 compute_matrix_to_RGB (GstVideoConverter * convert, MatrixData * data)
 {
@@ -1467,7 +1324,7 @@ gamma_convert_u8_u16 (GammaData * data, gpointer dest, gpointer src)
   gint i;
   guint8 *s = src;
   guint16 *d = dest;
-  guint16 *table = data->gamma_table;
+  const guint16 *table = data->gamma_table;
   gint width = data->width * 4;
 
   for (i = 0; i < width; i += 4) {
@@ -1484,7 +1341,7 @@ gamma_convert_u16_u8 (GammaData * data, gpointer dest, gpointer src)
   gint i;
   guint16 *s = src;
   guint8 *d = dest;
-  guint8 *table = data->gamma_table;
+  const guint8 *table = data->gamma_table;
   gint width = data->width * 4;
 
   for (i = 0; i < width; i += 4) {
@@ -1501,7 +1358,7 @@ gamma_convert_u16_u16 (GammaData * data, gpointer dest, gpointer src)
   gint i;
   guint16 *s = src;
   guint16 *d = dest;
-  guint16 *table = data->gamma_table;
+  const guint16 *table = data->gamma_table;
   gint width = data->width * 4;
 
   for (i = 0; i < width; i += 4) {
@@ -1512,12 +1369,95 @@ gamma_convert_u16_u16 (GammaData * data, gpointer dest, gpointer src)
   }
 }
 
+typedef enum
+{
+  GAMMA_TABLE_DECODE_U8_U16,
+  GAMMA_TABLE_DECODE_U16_U16,
+  GAMMA_TABLE_ENCODE_U16_U8,
+  GAMMA_TABLE_ENCODE_U16_U16,
+  N_GAMMA_TABLE_TYPES
+} GammaTableType;
+
+#define N_GAMMA_TRANSFERS (GST_VIDEO_TRANSFER_ARIB_STD_B67 + 1)
+
+/* Gamma tables only depend on the transfer function and the table type, they
+ * are built once and shared between all converters (and all their threads)
+ * for the lifetime of the process. There's at most one table per known
+ * transfer function and type, about 320kB per transfer function when all
+ * types are used. */
+G_LOCK_DEFINE_STATIC (gamma_tables);
+static gpointer gamma_tables[N_GAMMA_TRANSFERS][N_GAMMA_TABLE_TYPES];
+
+static gconstpointer
+get_gamma_table (GstVideoTransferFunction func, GammaTableType type)
+{
+  gpointer table;
+  gint i;
+
+  /* unknown values are handled like GST_VIDEO_TRANSFER_UNKNOWN */
+  if ((guint) func >= N_GAMMA_TRANSFERS)
+    func = GST_VIDEO_TRANSFER_UNKNOWN;
+
+  G_LOCK (gamma_tables);
+  table = gamma_tables[func][type];
+  if (table == NULL) {
+    switch (type) {
+      case GAMMA_TABLE_DECODE_U8_U16:
+      {
+        guint16 *t = table = g_malloc (sizeof (guint16) * 256);
+
+        for (i = 0; i < 256; i++)
+          t[i] =
+              rint (gst_video_color_transfer_decode (func, i / 255.0) *
+              65535.0);
+        break;
+      }
+      case GAMMA_TABLE_DECODE_U16_U16:
+      {
+        guint16 *t = table = g_malloc (sizeof (guint16) * 65536);
+
+        for (i = 0; i < 65536; i++)
+          t[i] =
+              rint (gst_video_color_transfer_decode (func, i / 65535.0) *
+              65535.0);
+        break;
+      }
+      case GAMMA_TABLE_ENCODE_U16_U8:
+      {
+        guint8 *t = table = g_malloc (sizeof (guint8) * 65536);
+
+        for (i = 0; i < 65536; i++)
+          t[i] =
+              rint (gst_video_color_transfer_encode (func, i / 65535.0) *
+              255.0);
+        break;
+      }
+      case GAMMA_TABLE_ENCODE_U16_U16:
+      {
+        guint16 *t = table = g_malloc (sizeof (guint16) * 65536);
+
+        for (i = 0; i < 65536; i++)
+          t[i] =
+              rint (gst_video_color_transfer_encode (func, i / 65535.0) *
+              65535.0);
+        break;
+      }
+      default:
+        g_assert_not_reached ();
+        break;
+    }
+    GST_DEBUG ("created gamma table %d for transfer %d", type, func);
+    gamma_tables[func][type] = table;
+  }
+  G_UNLOCK (gamma_tables);
+
+  return table;
+}
+
 static void
 setup_gamma_decode (GstVideoConverter * convert)
 {
   GstVideoTransferFunction func;
-  guint16 *t;
-  gint i;
 
   func = convert->in_info.colorimetry.transfer;
 
@@ -1525,18 +1465,13 @@ setup_gamma_decode (GstVideoConverter * convert)
   if (convert->current_bits == 8) {
     GST_DEBUG ("gamma decode 8->16: %d", func);
     convert->gamma_dec.gamma_func = gamma_convert_u8_u16;
-    t = convert->gamma_dec.gamma_table = g_malloc (sizeof (guint16) * 256);
-
-    for (i = 0; i < 256; i++)
-      t[i] = rint (gst_video_color_transfer_decode (func, i / 255.0) * 65535.0);
+    convert->gamma_dec.gamma_table =
+        get_gamma_table (func, GAMMA_TABLE_DECODE_U8_U16);
   } else {
     GST_DEBUG ("gamma decode 16->16: %d", func);
     convert->gamma_dec.gamma_func = gamma_convert_u16_u16;
-    t = convert->gamma_dec.gamma_table = g_malloc (sizeof (guint16) * 65536);
-
-    for (i = 0; i < 65536; i++)
-      t[i] =
-          rint (gst_video_color_transfer_decode (func, i / 65535.0) * 65535.0);
+    convert->gamma_dec.gamma_table =
+        get_gamma_table (func, GAMMA_TABLE_DECODE_U16_U16);
   }
   convert->current_bits = 16;
   convert->current_pstride = 8;
@@ -1547,30 +1482,20 @@ static void
 setup_gamma_encode (GstVideoConverter * convert, gint target_bits)
 {
   GstVideoTransferFunction func;
-  gint i;
 
   func = convert->out_info.colorimetry.transfer;
 
   convert->gamma_enc.width = convert->current_width;
   if (target_bits == 8) {
-    guint8 *t;
-
     GST_DEBUG ("gamma encode 16->8: %d", func);
     convert->gamma_enc.gamma_func = gamma_convert_u16_u8;
-    t = convert->gamma_enc.gamma_table = g_malloc (sizeof (guint8) * 65536);
-
-    for (i = 0; i < 65536; i++)
-      t[i] = rint (gst_video_color_transfer_encode (func, i / 65535.0) * 255.0);
+    convert->gamma_enc.gamma_table =
+        get_gamma_table (func, GAMMA_TABLE_ENCODE_U16_U8);
   } else {
-    guint16 *t;
-
     GST_DEBUG ("gamma encode 16->16: %d", func);
     convert->gamma_enc.gamma_func = gamma_convert_u16_u16;
-    t = convert->gamma_enc.gamma_table = g_malloc (sizeof (guint16) * 65536);
-
-    for (i = 0; i < 65536; i++)
-      t[i] =
-          rint (gst_video_color_transfer_encode (func, i / 65535.0) * 65535.0);
+    convert->gamma_enc.gamma_table =
+        get_gamma_table (func, GAMMA_TABLE_ENCODE_U16_U16);
   }
 }
 
@@ -1852,7 +1777,10 @@ chain_convert (GstVideoConverter * convert, GstLineCache * prev, gint idx)
     if (same_primaries) {
       do_conversion = FALSE;
     } else {
-      prepare_matrix (convert, &convert->convert_matrix);
+      if (GET_OPT_LINEAR_FLOAT (convert))
+        prepare_matrix_float (convert, &convert->convert_matrix);
+      else
+        prepare_matrix (convert, &convert->convert_matrix);
       convert->in_bits = convert->out_bits = 16;
       pass_alloc = TRUE;
       do_conversion = TRUE;
@@ -2568,9 +2496,6 @@ gst_video_converter_free (GstVideoConverter * convert)
   g_free (convert->dither_lines);
   g_free (convert->dither);
 
-  g_free (convert->gamma_dec.gamma_table);
-  g_free (convert->gamma_enc.gamma_table);
-
   if (convert->tmpline) {
     for (i = 0; i < convert->conversion_runner->n_threads; i++)
       g_free (convert->tmpline[i]);
@@ -241,6 +241,18 @@ typedef enum {
  * Default is #GST_VIDEO_GAMMA_MODE_NONE.
  */
 #define GST_VIDEO_CONVERTER_OPT_GAMMA_MODE   "GstVideoConverter.gamma-mode"
+/**
+ * GST_VIDEO_CONVERTER_OPT_LINEAR_FLOAT:
+ *
+ * #G_TYPE_BOOLEAN, convert between primaries in linear light with floating
+ * point coefficients instead of 8 bit fixed point ones. This is more precise
+ * but slower, the floating point conversion is not accelerated. Only used
+ * when #GST_VIDEO_CONVERTER_OPT_GAMMA_MODE is #GST_VIDEO_GAMMA_MODE_REMAP.
+ * Default %FALSE.
+ *
+ * Since: 1.18
+ */
+#define GST_VIDEO_CONVERTER_OPT_LINEAR_FLOAT   "GstVideoConverter.linear-float"
 /**
  * GstVideoPrimariesMode:
  * @GST_VIDEO_PRIMARIES_MODE_NONE: disable conversion between primaries
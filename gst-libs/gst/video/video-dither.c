@@ -52,6 +52,11 @@ struct _GstVideoDither
   guint32 orc_mask32;
 
   gpointer errors;
+  /* for the ordered methods, the threshold pattern is repeated every
+   * pattern_mask + 1 lines and pixels. pattern_stride is the number of
+   * components in one line of the errors */
+  guint pattern_mask;
+  guint pattern_stride;
 };
 
 static void
@@ -250,14 +255,121 @@ static const guint16 bayer_map[16][16] = {
   {255, 145, 223, 95, 247, 119, 215, 87, 253, 143, 221, 93, 245, 117, 213, 85}
 };
 
+/* 32x32 blue noise threshold map with the ranks 0-1023, made with the
+ * void-and-cluster method. Unlike the bayer pattern it has no visible
+ * structure, which gets close to error diffusion while still only adding a
+ * fixed offset to each pixel, so lines can be dithered independently. */
+static const guint16 blue_noise_map[32][32] = {
+  {691, 165, 500, 93, 936, 543, 45, 180, 388, 303, 30, 946, 572, 731, 845, 397,
+      146, 971, 612, 291, 703, 344, 562, 817, 5, 973, 251, 88, 187, 728, 266,
+      578},
+  {420, 881, 325, 784, 436, 274, 663, 895, 789, 519, 671, 423, 252, 125, 478,
+      661, 263, 762, 414, 28, 948, 630, 229, 890, 469, 584, 383, 824, 649, 471,
+      994, 117},
+  {540, 41, 1015, 620, 151, 966, 338, 449, 79, 1005, 149, 758, 882, 617, 1020,
+      16, 576, 894, 218, 826, 447, 75, 755, 115, 672, 166, 769, 947, 292, 33,
+      367, 837},
+  {667, 248, 719, 380, 825, 15, 738, 570, 237, 625, 293, 497, 66, 352, 213,
+      807, 334, 496, 114, 552, 312, 916, 504, 282, 1013, 336, 51, 495, 606,
+      911, 746, 195},
+  {940, 460, 113, 566, 207, 492, 879, 116, 932, 778, 381, 841, 960, 712, 459,
+      935, 167, 725, 991, 652, 798, 158, 602, 409, 814, 541, 714, 223, 393,
+      144, 512, 321},
+  {601, 861, 766, 314, 984, 686, 262, 406, 666, 185, 4, 591, 128, 259, 558, 90,
+      637, 419, 34, 363, 241, 713, 942, 22, 196, 877, 102, 985, 836, 657, 796,
+      17},
+  {175, 399, 59, 905, 427, 70, 544, 816, 330, 513, 944, 440, 659, 799, 365,
+      884, 767, 224, 930, 850, 521, 86, 327, 764, 653, 453, 354, 579, 265, 82,
+      429, 1003},
+  {539, 285, 656, 193, 595, 756, 163, 988, 83, 859, 730, 308, 204, 978, 23,
+      499, 305, 594, 482, 147, 644, 1000, 433, 555, 273, 952, 157, 757, 485,
+      891, 317, 715},
+  {803, 957, 470, 844, 353, 934, 287, 627, 425, 247, 573, 58, 869, 407, 736,
+      177, 1007, 100, 783, 281, 374, 800, 136, 902, 56, 812, 626, 8, 968, 186,
+      631, 105},
+  {235, 43, 696, 120, 523, 10, 705, 493, 806, 154, 1012, 468, 619, 124, 528,
+      648, 834, 441, 680, 917, 2, 589, 244, 700, 366, 511, 234, 711, 387, 560,
+      855, 443},
+  {920, 622, 319, 1022, 780, 228, 871, 335, 46, 682, 370, 831, 708, 332, 901,
+      250, 364, 42, 220, 526, 743, 977, 464, 840, 179, 1018, 431, 880, 288, 65,
+      732, 356},
+  {535, 833, 200, 394, 585, 465, 133, 965, 542, 898, 279, 80, 219, 962, 62,
+      794, 623, 949, 849, 404, 174, 311, 64, 551, 662, 77, 593, 127, 809, 506,
+      1001, 145},
+  {13, 452, 740, 73, 915, 300, 635, 734, 199, 432, 605, 771, 498, 582, 424,
+      156, 490, 304, 568, 106, 693, 878, 389, 951, 275, 760, 340, 926, 654,
+      202, 322, 684},
+  {261, 603, 980, 161, 685, 848, 26, 386, 810, 67, 983, 171, 883, 290, 751,
+      1021, 675, 72, 770, 970, 477, 604, 792, 134, 488, 857, 221, 537, 27, 458,
+      786, 907},
+  {408, 852, 339, 532, 428, 230, 508, 1002, 257, 525, 677, 377, 110, 650, 31,
+      348, 238, 918, 184, 359, 264, 48, 210, 717, 358, 44, 992, 724, 385, 954,
+      561, 96},
+  {638, 206, 53, 773, 937, 97, 727, 609, 135, 919, 318, 823, 454, 943, 516,
+      835, 437, 720, 524, 633, 829, 1008, 515, 925, 567, 664, 445, 155, 851,
+      277, 173, 753},
+  {505, 899, 678, 286, 574, 379, 887, 329, 472, 750, 3, 580, 245, 763, 197,
+      596, 123, 885, 37, 412, 138, 673, 422, 270, 108, 808, 306, 615, 74, 669,
+      362, 990},
+  {298, 139, 438, 1014, 153, 802, 208, 47, 639, 865, 183, 974, 687, 87, 396,
+      993, 324, 660, 254, 775, 896, 331, 25, 744, 874, 201, 941, 520, 781, 928,
+      463, 29},
+  {745, 554, 821, 7, 636, 455, 981, 706, 400, 278, 548, 434, 307, 903, 628, 20,
+      791, 466, 950, 546, 198, 588, 964, 476, 629, 373, 14, 418, 236, 132, 586,
+      856},
+  {392, 959, 232, 355, 759, 260, 545, 142, 820, 938, 60, 788, 143, 509, 839,
+      268, 565, 169, 61, 369, 723, 84, 797, 243, 122, 549, 1023, 718, 876, 337,
+      699, 209},
+  {642, 109, 702, 514, 867, 95, 908, 342, 489, 222, 674, 1010, 347, 716, 191,
+      421, 976, 735, 868, 481, 1011, 310, 426, 913, 701, 822, 283, 640, 78,
+      479, 995, 50},
+  {491, 301, 923, 172, 417, 610, 689, 19, 765, 581, 119, 461, 598, 76, 924,
+      647, 112, 341, 217, 608, 126, 681, 529, 176, 351, 92, 446, 182, 777, 571,
+      269, 819},
+  {889, 772, 575, 35, 956, 309, 203, 998, 391, 900, 313, 860, 227, 776, 483,
+      294, 886, 517, 692, 830, 271, 888, 1, 972, 618, 864, 536, 961, 361, 909,
+      160, 405},
+  {69, 212, 368, 670, 779, 450, 847, 531, 152, 655, 36, 726, 402, 955, 6, 587,
+      795, 94, 444, 40, 395, 577, 752, 456, 253, 733, 57, 242, 613, 9, 722,
+      547},
+  {632, 457, 1017, 272, 131, 599, 81, 739, 256, 442, 969, 518, 148, 683, 349,
+      189, 999, 258, 729, 862, 986, 194, 328, 832, 129, 403, 893, 695, 474,
+      811, 299, 967},
+  {697, 111, 842, 534, 910, 246, 982, 350, 827, 569, 99, 804, 280, 564, 897,
+      451, 646, 376, 550, 141, 634, 501, 89, 665, 1004, 597, 326, 170, 989,
+      104, 378, 188},
+  {873, 323, 737, 0, 375, 698, 507, 38, 679, 912, 215, 382, 1016, 49, 828, 121,
+      768, 52, 953, 233, 357, 793, 914, 225, 486, 32, 787, 553, 413, 624, 921,
+      510},
+  {416, 239, 616, 448, 813, 190, 875, 430, 162, 320, 741, 621, 480, 721, 231,
+      538, 302, 872, 473, 818, 709, 21, 559, 384, 748, 296, 933, 98, 853, 249,
+      749, 39},
+  {996, 790, 168, 945, 91, 590, 276, 643, 963, 530, 11, 863, 164, 345, 939,
+      415, 690, 178, 592, 103, 297, 435, 975, 150, 866, 658, 214, 467, 694,
+      343, 159, 563},
+  {107, 475, 676, 316, 527, 1009, 761, 68, 801, 398, 927, 267, 668, 101, 611,
+      815, 12, 997, 390, 922, 645, 838, 255, 614, 71, 360, 533, 1019, 18, 805,
+      904, 651},
+  {371, 846, 24, 892, 410, 137, 346, 487, 240, 118, 583, 462, 782, 987, 494,
+      205, 557, 333, 754, 211, 522, 55, 742, 503, 929, 785, 130, 641, 289, 401,
+      502, 216},
+  {958, 284, 600, 747, 226, 704, 858, 607, 979, 707, 843, 192, 372, 54, 295,
+      906, 710, 85, 484, 854, 140, 1006, 411, 181, 315, 688, 439, 870, 556,
+      931, 63, 774}
+};
+
+#define ORDERED_OFFSET(d,x,y) \
+    (((y) & (d)->pattern_mask) * (d)->pattern_stride + \
+     ((x) & (d)->pattern_mask) * 4)
+
 static void
 dither_ordered_u8 (GstVideoDither * dither, gpointer pixels, guint x, guint y,
     guint width)
 {
   guint8 *p = pixels;
-  guint8 *c = (guint8 *) dither->errors + ((y & 15) * width + (x & 15)) * 4;
+  guint8 *c = (guint8 *) dither->errors + ORDERED_OFFSET (dither, x, y);
 
-  video_orc_dither_ordered_u8 (p, c, width * 4);
+  video_orc_dither_ordered_u8 (p + (x * 4), c, width * 4);
 }
 
 static void
@@ -265,9 +377,10 @@ dither_ordered_u8_mask (GstVideoDither * dither, gpointer pixels, guint x,
     guint y, guint width)
 {
   guint8 *p = pixels;
-  guint16 *c = (guint16 *) dither->errors + ((y & 15) * width + (x & 15)) * 4;
+  guint16 *c = (guint16 *) dither->errors + ORDERED_OFFSET (dither, x, y);
 
-  video_orc_dither_ordered_4u8_mask (p, c, dither->orc_mask64, width);
+  video_orc_dither_ordered_4u8_mask (p + (x * 4), c, dither->orc_mask64,
+      width);
 }
 
 static void
@@ -275,9 +388,10 @@ dither_ordered_u16_mask (GstVideoDither * dither, gpointer pixels, guint x,
     guint y, guint width)
 {
   guint16 *p = pixels;
-  guint16 *c = (guint16 *) dither->errors + ((y & 15) * width + (x & 15)) * 4;
+  guint16 *c = (guint16 *) dither->errors + ORDERED_OFFSET (dither, x, y);
 
-  video_orc_dither_ordered_4u16_mask (p, c, dither->orc_mask64, width);
+  video_orc_dither_ordered_4u16_mask (p + (x * 4), c, dither->orc_mask64,
+      width);
 }
 
 static void
@@ -291,10 +405,14 @@ alloc_errors (GstVideoDither * dither, guint lines)
   dither->errors = g_malloc0 (sizeof (guint16) * (width + 8) * n_comp * lines);
 }
 
+/* @map is a @size x @size pattern of thresholds with @bits bits. Each line
+ * of the errors holds @size extra pixels so that the pattern can be read
+ * from any x offset without wrapping. */
 static void
-setup_bayer (GstVideoDither * dither)
+setup_ordered (GstVideoDither * dither, const guint16 * map, guint size,
+    guint bits)
 {
-  guint i, j, k, width, n_comp, errdepth;
+  guint i, j, k, width, n_comp, errdepth, stride;
   guint8 *shift;
 
   width = dither->width;
@@ -314,28 +432,32 @@ setup_bayer (GstVideoDither * dither)
     errdepth = 16;
   }
 
-  alloc_errors (dither, 16);
+  stride = n_comp * (width + size);
+  dither->pattern_mask = size - 1;
+  dither->pattern_stride = stride;
+  dither->errors = g_malloc ((errdepth / 8) * stride * size);
 
   if (errdepth == 8) {
-    for (i = 0; i < 16; i++) {
-      guint8 *p = (guint8 *) dither->errors + (n_comp * width * i), v;
-      for (j = 0; j < width; j++) {
+    for (i = 0; i < size; i++) {
+      guint8 *p = (guint8 *) dither->errors + (stride * i);
+      guint16 v;
+      for (j = 0; j < width + size; j++) {
         for (k = 0; k < n_comp; k++) {
-          v = bayer_map[i & 15][j & 15];
-          if (shift[k] < 8)
-            v = v >> (8 - shift[k]);
-          p[n_comp * j + k] = v;
+          v = map[i * size + (j & (size - 1))];
+          if (shift[k] < bits)
+            v = v >> (bits - shift[k]);
+          p[n_comp * j + k] = MIN (v, 255);
         }
       }
     }
   } else {
-    for (i = 0; i < 16; i++) {
-      guint16 *p = (guint16 *) dither->errors + (n_comp * width * i), v;
-      for (j = 0; j < width; j++) {
+    for (i = 0; i < size; i++) {
+      guint16 *p = (guint16 *) dither->errors + (stride * i), v;
+      for (j = 0; j < width + size; j++) {
         for (k = 0; k < n_comp; k++) {
-          v = bayer_map[i & 15][j & 15];
-          if (shift[k] < 8)
-            v = v >> (8 - shift[k]);
+          v = map[i * size + (j & (size - 1))];
+          if (shift[k] < bits)
+            v = v >> (bits - shift[k]);
           p[n_comp * j + k] = v;
         }
       }
@@ -452,7 +574,10 @@ gst_video_dither_new (GstVideoDitherMethod method, GstVideoDitherFlags flags,
         dither->func = dither_sierra_lite_u16;
       break;
     case GST_VIDEO_DITHER_BAYER:
-      setup_bayer (dither);
+      setup_ordered (dither, &bayer_map[0][0], 16, 8);
+      break;
+    case GST_VIDEO_DITHER_BLUE_NOISE:
+      setup_ordered (dither, &blue_noise_map[0][0], 32, 10);
       break;
   }
   return dither;
@@ -32,6 +32,9 @@ G_BEGIN_DECLS
  * @GST_VIDEO_DITHER_FLOYD_STEINBERG: Dither with floyd-steinberg error diffusion
  * @GST_VIDEO_DITHER_SIERRA_LITE: Dither with Sierra Lite error diffusion
  * @GST_VIDEO_DITHER_BAYER: ordered dither using a bayer pattern
+ * @GST_VIDEO_DITHER_BLUE_NOISE: ordered dither using a blue noise pattern.
+ *   This looks close to error diffusion but, like the bayer pattern, lines
+ *   can be dithered independently and with SIMD. (Since: 1.18)
  *
  * Different dithering methods to use.
  */
@@ -41,6 +44,7 @@ typedef enum {
   GST_VIDEO_DITHER_FLOYD_STEINBERG,
   GST_VIDEO_DITHER_SIERRA_LITE,
   GST_VIDEO_DITHER_BAYER,
+  GST_VIDEO_DITHER_BLUE_NOISE,
 } GstVideoDitherMethod;
 
 /**
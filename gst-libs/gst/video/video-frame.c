@@ -30,6 +30,7 @@
 #include "video-frame.h"
 #include "video-tile.h"
 #include "gstvideometa.h"
+#include "gstvideoutilsprivate.h"
 
 #define CAT_PERFORMANCE video_frame_get_perf_category()
 
@@ -278,6 +279,26 @@ gst_video_frame_unmap (GstVideoFrame * frame)
     gst_buffer_unref (frame->buffer);
 }
 
+/* Number of bytes per line to copy for @plane */
+static guint
+video_frame_plane_copy_width (const GstVideoFrame * dest,
+    const GstVideoFrame * src, guint plane)
+{
+  guint w;
+
+  /* FIXME: assumes subsampling of component N is the same as plane N, which is
+   * currently true for all formats we have but it might not be in the future. */
+  w = GST_VIDEO_FRAME_COMP_WIDTH (dest,
+      plane) * GST_VIDEO_FRAME_COMP_PSTRIDE (dest, plane);
+  /* FIXME: workaround for complex formats like v210, UYVP and IYU1 that have
+   * pstride == 0 */
+  if (w == 0)
+    w = MIN (GST_VIDEO_INFO_PLANE_STRIDE (&dest->info, plane),
+        GST_VIDEO_INFO_PLANE_STRIDE (&src->info, plane));
+
+  return w;
+}
+
 /**
  * gst_video_frame_copy_plane:
  * @dest: a #GstVideoFrame
@@ -322,16 +343,7 @@ gst_video_frame_copy_plane (GstVideoFrame * dest, const GstVideoFrame * src,
     return TRUE;
   }
 
-  /* FIXME: assumes subsampling of component N is the same as plane N, which is
-   * currently true for all formats we have but it might not be in the future. */
-  w = GST_VIDEO_FRAME_COMP_WIDTH (dest,
-      plane) * GST_VIDEO_FRAME_COMP_PSTRIDE (dest, plane);
-  /* FIXME: workaround for complex formats like v210, UYVP and IYU1 that have
-   * pstride == 0 */
-  if (w == 0)
-    w = MIN (GST_VIDEO_INFO_PLANE_STRIDE (dinfo, plane),
-        GST_VIDEO_INFO_PLANE_STRIDE (sinfo, plane));
-
+  w = video_frame_plane_copy_width (dest, src, plane);
   h = GST_VIDEO_FRAME_COMP_HEIGHT (dest, plane);
 
   ss = GST_VIDEO_INFO_PLANE_STRIDE (sinfo, plane);
@@ -421,3 +433,160 @@ gst_video_frame_copy (GstVideoFrame * dest, const GstVideoFrame * src)
 
   return TRUE;
 }
+
+/* Don't bother waking up worker threads for less than this many lines
+ * of the first plane per thread */
+#define COPY_MIN_LINES_PER_THREAD 64
+
+typedef struct
+{
+  guint n_planes;
+  guint8 *dp[GST_VIDEO_MAX_PLANES];
+  const guint8 *sp[GST_VIDEO_MAX_PLANES];
+  gint ds[GST_VIDEO_MAX_PLANES];
+  gint ss[GST_VIDEO_MAX_PLANES];
+  guint w[GST_VIDEO_MAX_PLANES];
+  guint h[GST_VIDEO_MAX_PLANES];
+} FrameCopyTask;
+
+/* Shared by all copies, created once with one thread per processor and
+ * kept for the lifetime of the process, its idle worker threads just wait
+ * for the next copy. Each copy only hands out as many tasks as it needs so
+ * that frames of different sizes don't restart the worker threads. */
+static GMutex copy_runner_lock;
+static GstParallelizedTaskRunner *copy_runner;
+static gboolean copy_runner_failed;
+
+static void
+video_frame_copy_task (FrameCopyTask * task)
+{
+  guint i, j;
+
+  for (i = 0; i < task->n_planes; i++) {
+    guint8 *dp = task->dp[i];
+    const guint8 *sp = task->sp[i];
+
+    for (j = 0; j < task->h[i]; j++) {
+      memcpy (dp, sp, task->w[i]);
+      dp += task->ds[i];
+      sp += task->ss[i];
+    }
+  }
+}
+
+/**
+ * gst_video_frame_copy_full:
+ * @dest: a #GstVideoFrame
+ * @src: a #GstVideoFrame
+ * @n_threads: maximum number of threads to use, 0 for the number of
+ *     processors
+ *
+ * Copy the contents from @src to @dest like gst_video_frame_copy(), but
+ * split the copy of large frames in blocks of lines that are copied by up
+ * to @n_threads threads from a shared worker pool.
+ *
+ * Small frames, tiled formats and calls made while the worker pool is busy
+ * with another copy are handled on the calling thread.
+ *
+ * Returns: TRUE if the contents could be copied.
+ *
+ * Since: 1.18
+ */
+gboolean
+gst_video_frame_copy_full (GstVideoFrame * dest, const GstVideoFrame * src,
+    guint n_threads)
+{
+  const GstVideoInfo *sinfo;
+  GstVideoInfo *dinfo;
+  const GstVideoFormatInfo *finfo;
+  FrameCopyTask *tasks;
+  gpointer *tasks_p;
+  guint i, j, n_planes, n_tasks, height;
+
+  g_return_val_if_fail (dest != NULL, FALSE);
+  g_return_val_if_fail (src != NULL, FALSE);
+
+  sinfo = &src->info;
+  dinfo = &dest->info;
+
+  g_return_val_if_fail (dinfo->finfo->format == sinfo->finfo->format, FALSE);
+  g_return_val_if_fail (dinfo->width == sinfo->width
+      && dinfo->height == sinfo->height, FALSE);
+
+  finfo = dinfo->finfo;
+  height = GST_VIDEO_FRAME_COMP_HEIGHT (dest, 0);
+
+  if (n_threads == 0 || n_threads > g_get_num_processors ())
+    n_threads = g_get_num_processors ();
+  if (height / n_threads < COPY_MIN_LINES_PER_THREAD)
+    n_threads = MAX (height / COPY_MIN_LINES_PER_THREAD, 1);
+
+  if (n_threads == 1 || GST_VIDEO_FORMAT_INFO_IS_TILED (finfo))
+    return gst_video_frame_copy (dest, src);
+
+  if (!g_mutex_trylock (&copy_runner_lock)) {
+    GST_CAT_DEBUG (CAT_PERFORMANCE, "copy runner busy, copying serially");
+    return gst_video_frame_copy (dest, src);
+  }
+
+  if (copy_runner == NULL && !copy_runner_failed) {
+    copy_runner = gst_parallelized_task_runner_new (g_get_num_processors ());
+    copy_runner_failed = (copy_runner == NULL);
+  }
+  if (copy_runner == NULL) {
+    g_mutex_unlock (&copy_runner_lock);
+    return gst_video_frame_copy (dest, src);
+  }
+
+  n_planes = finfo->n_planes;
+  n_tasks = MIN (n_threads, copy_runner->n_threads);
+  tasks = g_newa (FrameCopyTask, n_tasks);
+  tasks_p = g_newa (gpointer, n_tasks);
+
+  for (i = 0; i < n_tasks; i++) {
+    tasks[i].n_planes = n_planes;
+    tasks_p[i] = &tasks[i];
+  }
+
+  for (i = 0; i < n_planes; i++) {
+    guint8 *dp = dest->data[i];
+    const guint8 *sp = src->data[i];
+    gint ds, ss;
+    guint w, h;
+
+    if (GST_VIDEO_FORMAT_INFO_HAS_PALETTE (finfo) && i == 1) {
+      /* palette is tiny, copy it here and let the tasks skip it */
+      memcpy (dp, sp, 256 * 4);
+      for (j = 0; j < n_tasks; j++)
+        tasks[j].h[i] = 0;
+      continue;
+    }
+
+    w = video_frame_plane_copy_width (dest, src, i);
+    h = GST_VIDEO_FRAME_COMP_HEIGHT (dest, i);
+    ds = GST_VIDEO_INFO_PLANE_STRIDE (dinfo, i);
+    ss = GST_VIDEO_INFO_PLANE_STRIDE (sinfo, i);
+
+    GST_CAT_DEBUG (CAT_PERFORMANCE, "copy plane %d, w:%d h:%d in %u tasks",
+        i, w, h, n_tasks);
+
+    for (j = 0; j < n_tasks; j++) {
+      guint first = (h * j) / n_tasks;
+      guint last = (h * (j + 1)) / n_tasks;
+
+      tasks[j].dp[i] = dp + (gsize) first * ds;
+      tasks[j].sp[i] = sp + (gsize) first * ss;
+      tasks[j].ds[i] = ds;
+      tasks[j].ss[i] = ss;
+      tasks[j].w[i] = w;
+      tasks[j].h[i] = last - first;
+    }
+  }
+
+  gst_parallelized_task_runner_run_n (copy_runner,
+      (GstParallelizedTaskFunc) video_frame_copy_task, tasks_p, n_tasks);
+
+  g_mutex_unlock (&copy_runner_lock);
+
+  return TRUE;
+}
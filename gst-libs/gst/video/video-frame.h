@@ -111,6 +111,10 @@ GST_VIDEO_API
 gboolean    gst_video_frame_copy_plane    (GstVideoFrame *dest, const GstVideoFrame *src,
                                            guint plane);
 
+GST_VIDEO_API
+gboolean    gst_video_frame_copy_full     (GstVideoFrame *dest, const GstVideoFrame *src,
+                                           guint n_threads);
+
 /* general info */
 #define GST_VIDEO_FRAME_FORMAT(f)         (GST_VIDEO_INFO_FORMAT(&(f)->info))
 #define GST_VIDEO_FRAME_WIDTH(f)          (GST_VIDEO_INFO_WIDTH(&(f)->info))
@@ -464,6 +464,22 @@ void video_orc_chroma_down_v4_u8 (guint8 * ORC_RESTRICT d1,
 void video_orc_chroma_down_v4_u16 (guint16 * ORC_RESTRICT d1,
     const guint16 * ORC_RESTRICT s1, const guint16 * ORC_RESTRICT s2,
     const guint16 * ORC_RESTRICT s3, const guint16 * ORC_RESTRICT s4, int n);
+void video_orc_chroma_up_h2_u8 (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n);
+void video_orc_chroma_up_h2_cs_u8 (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n);
+void video_orc_chroma_down_h2_cs_u8 (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n);
+void video_orc_chroma_up_vi2_u8 (guint8 * ORC_RESTRICT d1,
+    guint8 * ORC_RESTRICT d2, guint8 * ORC_RESTRICT d3,
+    guint8 * ORC_RESTRICT d4, const guint8 * ORC_RESTRICT s1,
+    const guint8 * ORC_RESTRICT s2, const guint8 * ORC_RESTRICT s3,
+    const guint8 * ORC_RESTRICT s4, int n);
+void video_orc_chroma_up_vi2_u16 (guint16 * ORC_RESTRICT d1,
+    guint16 * ORC_RESTRICT d2, guint16 * ORC_RESTRICT d3,
+    guint16 * ORC_RESTRICT d4, const guint16 * ORC_RESTRICT s1,
+    const guint16 * ORC_RESTRICT s2, const guint16 * ORC_RESTRICT s3,
+    const guint16 * ORC_RESTRICT s4, int n);
 void video_orc_dither_none_4u8_mask (guint8 * ORC_RESTRICT d1, int p1, int n);
 void video_orc_dither_none_4u16_mask (guint16 * ORC_RESTRICT d1, orc_int64 p1,
     int n);
@@ -31834,6 +31850,2422 @@ video_orc_chroma_down_v4_u16 (guint16 * ORC_RESTRICT d1,
 #endif
 
 
+/* video_orc_chroma_up_h2_u8 */
+#ifdef DISABLE_ORC
+void
+video_orc_chroma_up_h2_u8 (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n)
+{
+  int i;
+  orc_union64 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  orc_union64 var42;
+  orc_union64 var43;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var44;
+#else
+  orc_union32 var44;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var45;
+#else
+  orc_union32 var45;
+#endif
+  orc_union64 var46;
+  orc_union32 var47;
+  orc_union32 var48;
+  orc_union32 var49;
+  orc_union16 var50;
+  orc_union16 var51;
+  orc_union16 var52;
+  orc_union16 var53;
+  orc_union32 var54;
+  orc_union32 var55;
+  orc_union32 var56;
+  orc_union32 var57;
+  orc_union32 var58;
+  orc_union32 var59;
+  orc_union16 var60;
+  orc_union32 var61;
+  orc_union32 var62;
+  orc_union32 var63;
+  orc_union32 var64;
+  orc_union32 var65;
+  orc_union16 var66;
+  orc_union32 var67;
+
+  ptr0 = (orc_union64 *) d1;
+  ptr4 = (orc_union64 *) s1;
+  ptr5 = (orc_union64 *) s2;
+
+  /* 9: loadpw */
+  var44.x2[0] = 0x00000003;     /* 3 or 1.4822e-323f */
+  var44.x2[1] = 0x00000003;     /* 3 or 1.4822e-323f */
+  /* 12: loadpw */
+  var45.x2[0] = 0x00000002;     /* 2 or 9.88131e-324f */
+  var45.x2[1] = 0x00000002;     /* 2 or 9.88131e-324f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var42 = ptr4[i];
+    /* 1: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var42.i;
+      var47.i = _src.x2[1];
+      var48.i = _src.x2[0];
+    }
+    /* 2: loadq */
+    var43 = ptr5[i];
+    /* 3: select0ql */
+    {
+      orc_union64 _src;
+      _src.i = var43.i;
+      var49.i = _src.x2[0];
+    }
+    /* 4: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var48.i;
+      var50.i = _src.x2[1];
+    }
+    /* 5: select0lw */
+    {
+      orc_union32 _src;
+      _src.i = var47.i;
+      var51.i = _src.x2[0];
+    }
+    /* 6: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var49.i;
+      var52.i = _src.x2[1];
+      var53.i = _src.x2[0];
+    }
+    /* 7: convubw */
+    var54.x2[0] = (orc_uint8) var50.x2[0];
+    var54.x2[1] = (orc_uint8) var50.x2[1];
+    /* 8: convubw */
+    var55.x2[0] = (orc_uint8) var52.x2[0];
+    var55.x2[1] = (orc_uint8) var52.x2[1];
+    /* 10: mullw */
+    var56.x2[0] = (var54.x2[0] * var44.x2[0]) & 0xffff;
+    var56.x2[1] = (var54.x2[1] * var44.x2[1]) & 0xffff;
+    /* 11: addw */
+    var57.x2[0] = var56.x2[0] + var55.x2[0];
+    var57.x2[1] = var56.x2[1] + var55.x2[1];
+    /* 13: addw */
+    var58.x2[0] = var57.x2[0] + var45.x2[0];
+    var58.x2[1] = var57.x2[1] + var45.x2[1];
+    /* 14: shruw */
+    var59.x2[0] = ((orc_uint16) var58.x2[0]) >> 2;
+    var59.x2[1] = ((orc_uint16) var58.x2[1]) >> 2;
+    /* 15: convsuswb */
+    var60.x2[0] = ORC_CLAMP_UB (var59.x2[0]);
+    var60.x2[1] = ORC_CLAMP_UB (var59.x2[1]);
+    /* 16: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var51.i;
+      _dest.x2[1] = var60.i;
+      var61.i = _dest.i;
+    }
+    /* 17: mullw */
+    var62.x2[0] = (var55.x2[0] * var44.x2[0]) & 0xffff;
+    var62.x2[1] = (var55.x2[1] * var44.x2[1]) & 0xffff;
+    /* 18: addw */
+    var63.x2[0] = var62.x2[0] + var54.x2[0];
+    var63.x2[1] = var62.x2[1] + var54.x2[1];
+    /* 19: addw */
+    var64.x2[0] = var63.x2[0] + var45.x2[0];
+    var64.x2[1] = var63.x2[1] + var45.x2[1];
+    /* 20: shruw */
+    var65.x2[0] = ((orc_uint16) var64.x2[0]) >> 2;
+    var65.x2[1] = ((orc_uint16) var64.x2[1]) >> 2;
+    /* 21: convsuswb */
+    var66.x2[0] = ORC_CLAMP_UB (var65.x2[0]);
+    var66.x2[1] = ORC_CLAMP_UB (var65.x2[1]);
+    /* 22: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var53.i;
+      _dest.x2[1] = var66.i;
+      var67.i = _dest.i;
+    }
+    /* 23: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var61.i;
+      _dest.x2[1] = var67.i;
+      var46.i = _dest.i;
+    }
+    /* 24: storeq */
+    ptr0[i] = var46;
+  }
+
+}
+
+#else
+static void
+_backup_video_orc_chroma_up_h2_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union64 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  orc_union64 var42;
+  orc_union64 var43;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var44;
+#else
+  orc_union32 var44;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var45;
+#else
+  orc_union32 var45;
+#endif
+  orc_union64 var46;
+  orc_union32 var47;
+  orc_union32 var48;
+  orc_union32 var49;
+  orc_union16 var50;
+  orc_union16 var51;
+  orc_union16 var52;
+  orc_union16 var53;
+  orc_union32 var54;
+  orc_union32 var55;
+  orc_union32 var56;
+  orc_union32 var57;
+  orc_union32 var58;
+  orc_union32 var59;
+  orc_union16 var60;
+  orc_union32 var61;
+  orc_union32 var62;
+  orc_union32 var63;
+  orc_union32 var64;
+  orc_union32 var65;
+  orc_union16 var66;
+  orc_union32 var67;
+
+  ptr0 = (orc_union64 *) ex->arrays[0];
+  ptr4 = (orc_union64 *) ex->arrays[4];
+  ptr5 = (orc_union64 *) ex->arrays[5];
+
+  /* 9: loadpw */
+  var44.x2[0] = 0x00000003;     /* 3 or 1.4822e-323f */
+  var44.x2[1] = 0x00000003;     /* 3 or 1.4822e-323f */
+  /* 12: loadpw */
+  var45.x2[0] = 0x00000002;     /* 2 or 9.88131e-324f */
+  var45.x2[1] = 0x00000002;     /* 2 or 9.88131e-324f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var42 = ptr4[i];
+    /* 1: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var42.i;
+      var47.i = _src.x2[1];
+      var48.i = _src.x2[0];
+    }
+    /* 2: loadq */
+    var43 = ptr5[i];
+    /* 3: select0ql */
+    {
+      orc_union64 _src;
+      _src.i = var43.i;
+      var49.i = _src.x2[0];
+    }
+    /* 4: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var48.i;
+      var50.i = _src.x2[1];
+    }
+    /* 5: select0lw */
+    {
+      orc_union32 _src;
+      _src.i = var47.i;
+      var51.i = _src.x2[0];
+    }
+    /* 6: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var49.i;
+      var52.i = _src.x2[1];
+      var53.i = _src.x2[0];
+    }
+    /* 7: convubw */
+    var54.x2[0] = (orc_uint8) var50.x2[0];
+    var54.x2[1] = (orc_uint8) var50.x2[1];
+    /* 8: convubw */
+    var55.x2[0] = (orc_uint8) var52.x2[0];
+    var55.x2[1] = (orc_uint8) var52.x2[1];
+    /* 10: mullw */
+    var56.x2[0] = (var54.x2[0] * var44.x2[0]) & 0xffff;
+    var56.x2[1] = (var54.x2[1] * var44.x2[1]) & 0xffff;
+    /* 11: addw */
+    var57.x2[0] = var56.x2[0] + var55.x2[0];
+    var57.x2[1] = var56.x2[1] + var55.x2[1];
+    /* 13: addw */
+    var58.x2[0] = var57.x2[0] + var45.x2[0];
+    var58.x2[1] = var57.x2[1] + var45.x2[1];
+    /* 14: shruw */
+    var59.x2[0] = ((orc_uint16) var58.x2[0]) >> 2;
+    var59.x2[1] = ((orc_uint16) var58.x2[1]) >> 2;
+    /* 15: convsuswb */
+    var60.x2[0] = ORC_CLAMP_UB (var59.x2[0]);
+    var60.x2[1] = ORC_CLAMP_UB (var59.x2[1]);
+    /* 16: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var51.i;
+      _dest.x2[1] = var60.i;
+      var61.i = _dest.i;
+    }
+    /* 17: mullw */
+    var62.x2[0] = (var55.x2[0] * var44.x2[0]) & 0xffff;
+    var62.x2[1] = (var55.x2[1] * var44.x2[1]) & 0xffff;
+    /* 18: addw */
+    var63.x2[0] = var62.x2[0] + var54.x2[0];
+    var63.x2[1] = var62.x2[1] + var54.x2[1];
+    /* 19: addw */
+    var64.x2[0] = var63.x2[0] + var45.x2[0];
+    var64.x2[1] = var63.x2[1] + var45.x2[1];
+    /* 20: shruw */
+    var65.x2[0] = ((orc_uint16) var64.x2[0]) >> 2;
+    var65.x2[1] = ((orc_uint16) var64.x2[1]) >> 2;
+    /* 21: convsuswb */
+    var66.x2[0] = ORC_CLAMP_UB (var65.x2[0]);
+    var66.x2[1] = ORC_CLAMP_UB (var65.x2[1]);
+    /* 22: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var53.i;
+      _dest.x2[1] = var66.i;
+      var67.i = _dest.i;
+    }
+    /* 23: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var61.i;
+      _dest.x2[1] = var67.i;
+      var46.i = _dest.i;
+    }
+    /* 24: storeq */
+    ptr0[i] = var46;
+  }
+
+}
+
+void
+video_orc_chroma_up_h2_u8 (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 25, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 117, 112, 95, 104, 50, 95, 117, 56, 11, 8, 8, 12,
+        8, 8, 12, 8, 8, 14, 2, 3, 0, 0, 0, 14, 2, 2, 0, 0,
+        0, 20, 4, 20, 4, 20, 4, 20, 2, 20, 2, 20, 2, 20, 2, 20,
+        4, 20, 4, 20, 4, 197, 33, 32, 4, 192, 34, 5, 191, 37, 32, 190,
+        35, 33, 198, 38, 36, 34, 21, 1, 150, 39, 37, 21, 1, 150, 41, 38,
+        21, 1, 89, 40, 39, 16, 21, 1, 70, 40, 40, 41, 21, 1, 70, 40,
+        40, 17, 21, 1, 95, 40, 40, 17, 21, 1, 160, 37, 40, 195, 32, 35,
+        37, 21, 1, 89, 40, 41, 16, 21, 1, 70, 40, 40, 39, 21, 1, 70,
+        40, 40, 17, 21, 1, 95, 40, 40, 17, 21, 1, 160, 38, 40, 195, 33,
+        36, 38, 194, 0, 32, 33, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_h2_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_orc_chroma_up_h2_u8");
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_h2_u8);
+      orc_program_add_destination (p, 8, "d1");
+      orc_program_add_source (p, 8, "s1");
+      orc_program_add_source (p, 8, "s2");
+      orc_program_add_constant (p, 2, 0x00000003, "c1");
+      orc_program_add_constant (p, 2, 0x00000002, "c2");
+      orc_program_add_temporary (p, 4, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+      orc_program_add_temporary (p, 4, "t3");
+      orc_program_add_temporary (p, 2, "t4");
+      orc_program_add_temporary (p, 2, "t5");
+      orc_program_add_temporary (p, 2, "t6");
+      orc_program_add_temporary (p, 2, "t7");
+      orc_program_add_temporary (p, 4, "t8");
+      orc_program_add_temporary (p, 4, "t9");
+      orc_program_add_temporary (p, 4, "t10");
+
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "select0ql", 0, ORC_VAR_T3, ORC_VAR_S2,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "select1lw", 0, ORC_VAR_T6, ORC_VAR_T1,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "select0lw", 0, ORC_VAR_T4, ORC_VAR_T2,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T8, ORC_VAR_T6, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T10, ORC_VAR_T7,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T9, ORC_VAR_T8, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T9, ORC_VAR_T9, ORC_VAR_T10,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T9, ORC_VAR_T9, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T9, ORC_VAR_T9, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T6, ORC_VAR_T9,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_T1, ORC_VAR_T4, ORC_VAR_T6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T9, ORC_VAR_T10, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T9, ORC_VAR_T9, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T9, ORC_VAR_T9, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T9, ORC_VAR_T9, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T7, ORC_VAR_T9,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_T2, ORC_VAR_T5, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* video_orc_chroma_up_h2_cs_u8 */
+#ifdef DISABLE_ORC
+void
+video_orc_chroma_up_h2_cs_u8 (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n)
+{
+  int i;
+  orc_union64 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  orc_union64 var39;
+  orc_union64 var40;
+  orc_union64 var41;
+  orc_union32 var42;
+  orc_union32 var43;
+  orc_union32 var44;
+  orc_union16 var45;
+  orc_union16 var46;
+  orc_union16 var47;
+  orc_union16 var48;
+  orc_union32 var49;
+
+  ptr0 = (orc_union64 *) d1;
+  ptr4 = (orc_union64 *) s1;
+  ptr5 = (orc_union64 *) s2;
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var39 = ptr4[i];
+    /* 1: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var39.i;
+      var42.i = _src.x2[1];
+      var43.i = _src.x2[0];
+    }
+    /* 2: loadq */
+    var40 = ptr5[i];
+    /* 3: select0ql */
+    {
+      orc_union64 _src;
+      _src.i = var40.i;
+      var44.i = _src.x2[0];
+    }
+    /* 4: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var43.i;
+      var45.i = _src.x2[1];
+    }
+    /* 5: select0lw */
+    {
+      orc_union32 _src;
+      _src.i = var42.i;
+      var46.i = _src.x2[0];
+    }
+    /* 6: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var44.i;
+      var47.i = _src.x2[1];
+    }
+    /* 7: avgub */
+    var48.x2[0] = ((orc_uint8) var45.x2[0] + (orc_uint8) var47.x2[0] + 1) >> 1;
+    var48.x2[1] = ((orc_uint8) var45.x2[1] + (orc_uint8) var47.x2[1] + 1) >> 1;
+    /* 8: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var46.i;
+      _dest.x2[1] = var48.i;
+      var49.i = _dest.i;
+    }
+    /* 9: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var43.i;
+      _dest.x2[1] = var49.i;
+      var41.i = _dest.i;
+    }
+    /* 10: storeq */
+    ptr0[i] = var41;
+  }
+
+}
+
+#else
+static void
+_backup_video_orc_chroma_up_h2_cs_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union64 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  orc_union64 var39;
+  orc_union64 var40;
+  orc_union64 var41;
+  orc_union32 var42;
+  orc_union32 var43;
+  orc_union32 var44;
+  orc_union16 var45;
+  orc_union16 var46;
+  orc_union16 var47;
+  orc_union16 var48;
+  orc_union32 var49;
+
+  ptr0 = (orc_union64 *) ex->arrays[0];
+  ptr4 = (orc_union64 *) ex->arrays[4];
+  ptr5 = (orc_union64 *) ex->arrays[5];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var39 = ptr4[i];
+    /* 1: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var39.i;
+      var42.i = _src.x2[1];
+      var43.i = _src.x2[0];
+    }
+    /* 2: loadq */
+    var40 = ptr5[i];
+    /* 3: select0ql */
+    {
+      orc_union64 _src;
+      _src.i = var40.i;
+      var44.i = _src.x2[0];
+    }
+    /* 4: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var43.i;
+      var45.i = _src.x2[1];
+    }
+    /* 5: select0lw */
+    {
+      orc_union32 _src;
+      _src.i = var42.i;
+      var46.i = _src.x2[0];
+    }
+    /* 6: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var44.i;
+      var47.i = _src.x2[1];
+    }
+    /* 7: avgub */
+    var48.x2[0] = ((orc_uint8) var45.x2[0] + (orc_uint8) var47.x2[0] + 1) >> 1;
+    var48.x2[1] = ((orc_uint8) var45.x2[1] + (orc_uint8) var47.x2[1] + 1) >> 1;
+    /* 8: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var46.i;
+      _dest.x2[1] = var48.i;
+      var49.i = _dest.i;
+    }
+    /* 9: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var43.i;
+      _dest.x2[1] = var49.i;
+      var41.i = _dest.i;
+    }
+    /* 10: storeq */
+    ptr0[i] = var41;
+  }
+
+}
+
+void
+video_orc_chroma_up_h2_cs_u8 (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 28, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 117, 112, 95, 104, 50, 95, 99, 115, 95, 117, 56, 11,
+        8, 8, 12, 8, 8, 12, 8, 8, 20, 4, 20, 4, 20, 4, 20, 2,
+        20, 2, 20, 2, 20, 2, 197, 33, 32, 4, 192, 34, 5, 191, 36, 32,
+        190, 35, 33, 191, 38, 34, 21, 1, 39, 37, 36, 38, 195, 33, 35, 37,
+        194, 0, 32, 33, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_h2_cs_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_orc_chroma_up_h2_cs_u8");
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_h2_cs_u8);
+      orc_program_add_destination (p, 8, "d1");
+      orc_program_add_source (p, 8, "s1");
+      orc_program_add_source (p, 8, "s2");
+      orc_program_add_temporary (p, 4, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+      orc_program_add_temporary (p, 4, "t3");
+      orc_program_add_temporary (p, 2, "t4");
+      orc_program_add_temporary (p, 2, "t5");
+      orc_program_add_temporary (p, 2, "t6");
+      orc_program_add_temporary (p, 2, "t7");
+
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "select0ql", 0, ORC_VAR_T3, ORC_VAR_S2,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "select1lw", 0, ORC_VAR_T5, ORC_VAR_T1,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "select0lw", 0, ORC_VAR_T4, ORC_VAR_T2,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "select1lw", 0, ORC_VAR_T7, ORC_VAR_T3,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "avgub", 1, ORC_VAR_T6, ORC_VAR_T5, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_T2, ORC_VAR_T4, ORC_VAR_T6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* video_orc_chroma_down_h2_cs_u8 */
+#ifdef DISABLE_ORC
+void
+video_orc_chroma_down_h2_cs_u8 (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n)
+{
+  int i;
+  orc_union64 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  orc_union64 var42;
+  orc_union64 var43;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var44;
+#else
+  orc_union32 var44;
+#endif
+  orc_union64 var45;
+  orc_union32 var46;
+  orc_union32 var47;
+  orc_union32 var48;
+  orc_union16 var49;
+  orc_union16 var50;
+  orc_union16 var51;
+  orc_union16 var52;
+  orc_union32 var53;
+  orc_union32 var54;
+  orc_union32 var55;
+  orc_union32 var56;
+  orc_union32 var57;
+  orc_union32 var58;
+  orc_union32 var59;
+  orc_union32 var60;
+  orc_union16 var61;
+  orc_union32 var62;
+
+  ptr0 = (orc_union64 *) d1;
+  ptr4 = (orc_union64 *) s1;
+  ptr5 = (orc_union64 *) s2;
+
+  /* 13: loadpw */
+  var44.x2[0] = 0x00000002;     /* 2 or 9.88131e-324f */
+  var44.x2[1] = 0x00000002;     /* 2 or 9.88131e-324f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var42 = ptr5[i];
+    /* 1: select1ql */
+    {
+      orc_union64 _src;
+      _src.i = var42.i;
+      var46.i = _src.x2[1];
+    }
+    /* 2: loadq */
+    var43 = ptr4[i];
+    /* 3: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var43.i;
+      var47.i = _src.x2[1];
+      var48.i = _src.x2[0];
+    }
+    /* 4: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var46.i;
+      var49.i = _src.x2[1];
+    }
+    /* 5: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var48.i;
+      var50.i = _src.x2[1];
+      var51.i = _src.x2[0];
+    }
+    /* 6: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var47.i;
+      var52.i = _src.x2[1];
+    }
+    /* 7: convubw */
+    var53.x2[0] = (orc_uint8) var49.x2[0];
+    var53.x2[1] = (orc_uint8) var49.x2[1];
+    /* 8: convubw */
+    var54.x2[0] = (orc_uint8) var50.x2[0];
+    var54.x2[1] = (orc_uint8) var50.x2[1];
+    /* 9: convubw */
+    var55.x2[0] = (orc_uint8) var52.x2[0];
+    var55.x2[1] = (orc_uint8) var52.x2[1];
+    /* 10: addw */
+    var56.x2[0] = var53.x2[0] + var55.x2[0];
+    var56.x2[1] = var53.x2[1] + var55.x2[1];
+    /* 11: shlw */
+    var57.x2[0] = ((orc_uint16) var54.x2[0]) << 1;
+    var57.x2[1] = ((orc_uint16) var54.x2[1]) << 1;
+    /* 12: addw */
+    var58.x2[0] = var56.x2[0] + var57.x2[0];
+    var58.x2[1] = var56.x2[1] + var57.x2[1];
+    /* 14: addw */
+    var59.x2[0] = var58.x2[0] + var44.x2[0];
+    var59.x2[1] = var58.x2[1] + var44.x2[1];
+    /* 15: shruw */
+    var60.x2[0] = ((orc_uint16) var59.x2[0]) >> 2;
+    var60.x2[1] = ((orc_uint16) var59.x2[1]) >> 2;
+    /* 16: convsuswb */
+    var61.x2[0] = ORC_CLAMP_UB (var60.x2[0]);
+    var61.x2[1] = ORC_CLAMP_UB (var60.x2[1]);
+    /* 17: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var51.i;
+      _dest.x2[1] = var61.i;
+      var62.i = _dest.i;
+    }
+    /* 18: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var62.i;
+      _dest.x2[1] = var47.i;
+      var45.i = _dest.i;
+    }
+    /* 19: storeq */
+    ptr0[i] = var45;
+  }
+
+}
+
+#else
+static void
+_backup_video_orc_chroma_down_h2_cs_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union64 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  orc_union64 var42;
+  orc_union64 var43;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var44;
+#else
+  orc_union32 var44;
+#endif
+  orc_union64 var45;
+  orc_union32 var46;
+  orc_union32 var47;
+  orc_union32 var48;
+  orc_union16 var49;
+  orc_union16 var50;
+  orc_union16 var51;
+  orc_union16 var52;
+  orc_union32 var53;
+  orc_union32 var54;
+  orc_union32 var55;
+  orc_union32 var56;
+  orc_union32 var57;
+  orc_union32 var58;
+  orc_union32 var59;
+  orc_union32 var60;
+  orc_union16 var61;
+  orc_union32 var62;
+
+  ptr0 = (orc_union64 *) ex->arrays[0];
+  ptr4 = (orc_union64 *) ex->arrays[4];
+  ptr5 = (orc_union64 *) ex->arrays[5];
+
+  /* 13: loadpw */
+  var44.x2[0] = 0x00000002;     /* 2 or 9.88131e-324f */
+  var44.x2[1] = 0x00000002;     /* 2 or 9.88131e-324f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var42 = ptr5[i];
+    /* 1: select1ql */
+    {
+      orc_union64 _src;
+      _src.i = var42.i;
+      var46.i = _src.x2[1];
+    }
+    /* 2: loadq */
+    var43 = ptr4[i];
+    /* 3: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var43.i;
+      var47.i = _src.x2[1];
+      var48.i = _src.x2[0];
+    }
+    /* 4: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var46.i;
+      var49.i = _src.x2[1];
+    }
+    /* 5: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var48.i;
+      var50.i = _src.x2[1];
+      var51.i = _src.x2[0];
+    }
+    /* 6: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var47.i;
+      var52.i = _src.x2[1];
+    }
+    /* 7: convubw */
+    var53.x2[0] = (orc_uint8) var49.x2[0];
+    var53.x2[1] = (orc_uint8) var49.x2[1];
+    /* 8: convubw */
+    var54.x2[0] = (orc_uint8) var50.x2[0];
+    var54.x2[1] = (orc_uint8) var50.x2[1];
+    /* 9: convubw */
+    var55.x2[0] = (orc_uint8) var52.x2[0];
+    var55.x2[1] = (orc_uint8) var52.x2[1];
+    /* 10: addw */
+    var56.x2[0] = var53.x2[0] + var55.x2[0];
+    var56.x2[1] = var53.x2[1] + var55.x2[1];
+    /* 11: shlw */
+    var57.x2[0] = ((orc_uint16) var54.x2[0]) << 1;
+    var57.x2[1] = ((orc_uint16) var54.x2[1]) << 1;
+    /* 12: addw */
+    var58.x2[0] = var56.x2[0] + var57.x2[0];
+    var58.x2[1] = var56.x2[1] + var57.x2[1];
+    /* 14: addw */
+    var59.x2[0] = var58.x2[0] + var44.x2[0];
+    var59.x2[1] = var58.x2[1] + var44.x2[1];
+    /* 15: shruw */
+    var60.x2[0] = ((orc_uint16) var59.x2[0]) >> 2;
+    var60.x2[1] = ((orc_uint16) var59.x2[1]) >> 2;
+    /* 16: convsuswb */
+    var61.x2[0] = ORC_CLAMP_UB (var60.x2[0]);
+    var61.x2[1] = ORC_CLAMP_UB (var60.x2[1]);
+    /* 17: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var51.i;
+      _dest.x2[1] = var61.i;
+      var62.i = _dest.i;
+    }
+    /* 18: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var62.i;
+      _dest.x2[1] = var47.i;
+      var45.i = _dest.i;
+    }
+    /* 19: storeq */
+    ptr0[i] = var45;
+  }
+
+}
+
+void
+video_orc_chroma_down_h2_cs_u8 (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 30, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 100, 111, 119, 110, 95, 104, 50, 95, 99, 115, 95, 117,
+        56, 11, 8, 8, 12, 8, 8, 12, 8, 8, 14, 2, 1, 0, 0, 0,
+        14, 2, 2, 0, 0, 0, 20, 4, 20, 4, 20, 4, 20, 2, 20, 2,
+        20, 2, 20, 2, 20, 4, 20, 4, 20, 4, 193, 32, 5, 197, 34, 33,
+        4, 191, 36, 32, 198, 37, 35, 33, 191, 38, 34, 21, 1, 150, 39, 36,
+        21, 1, 150, 40, 37, 21, 1, 150, 41, 38, 21, 1, 70, 39, 39, 41,
+        21, 1, 93, 40, 40, 16, 21, 1, 70, 39, 39, 40, 21, 1, 70, 39,
+        39, 17, 21, 1, 95, 39, 39, 17, 21, 1, 160, 37, 39, 195, 33, 35,
+        37, 194, 0, 33, 34, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p,
+          _backup_video_orc_chroma_down_h2_cs_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_orc_chroma_down_h2_cs_u8");
+      orc_program_set_backup_function (p,
+          _backup_video_orc_chroma_down_h2_cs_u8);
+      orc_program_add_destination (p, 8, "d1");
+      orc_program_add_source (p, 8, "s1");
+      orc_program_add_source (p, 8, "s2");
+      orc_program_add_constant (p, 2, 0x00000001, "c1");
+      orc_program_add_constant (p, 2, 0x00000002, "c2");
+      orc_program_add_temporary (p, 4, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+      orc_program_add_temporary (p, 4, "t3");
+      orc_program_add_temporary (p, 2, "t4");
+      orc_program_add_temporary (p, 2, "t5");
+      orc_program_add_temporary (p, 2, "t6");
+      orc_program_add_temporary (p, 2, "t7");
+      orc_program_add_temporary (p, 4, "t8");
+      orc_program_add_temporary (p, 4, "t9");
+      orc_program_add_temporary (p, 4, "t10");
+
+      orc_program_append_2 (p, "select1ql", 0, ORC_VAR_T1, ORC_VAR_S2,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T3, ORC_VAR_T2, ORC_VAR_S1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "select1lw", 0, ORC_VAR_T5, ORC_VAR_T1,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T6, ORC_VAR_T4, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "select1lw", 0, ORC_VAR_T7, ORC_VAR_T3,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T8, ORC_VAR_T5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T9, ORC_VAR_T6, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T10, ORC_VAR_T7,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T10,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shlw", 1, ORC_VAR_T9, ORC_VAR_T9, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T9,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T6, ORC_VAR_T8,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_T2, ORC_VAR_T4, ORC_VAR_T6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D1, ORC_VAR_T2, ORC_VAR_T3,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* video_orc_chroma_up_vi2_u8 */
+#ifdef DISABLE_ORC
+void
+video_orc_chroma_up_vi2_u8 (guint8 * ORC_RESTRICT d1, guint8 * ORC_RESTRICT d2,
+    guint8 * ORC_RESTRICT d3, guint8 * ORC_RESTRICT d4,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4, int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  orc_union32 *ORC_RESTRICT ptr1;
+  orc_union32 *ORC_RESTRICT ptr2;
+  orc_union32 *ORC_RESTRICT ptr3;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union32 *ORC_RESTRICT ptr5;
+  const orc_union32 *ORC_RESTRICT ptr6;
+  const orc_union32 *ORC_RESTRICT ptr7;
+  orc_union32 var46;
+  orc_union32 var47;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var48;
+#else
+  orc_union32 var48;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var49;
+#else
+  orc_union32 var49;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var50;
+#else
+  orc_union32 var50;
+#endif
+  orc_union32 var51;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var52;
+#else
+  orc_union32 var52;
+#endif
+  orc_union32 var53;
+  orc_union32 var54;
+  orc_union32 var55;
+  orc_union32 var56;
+  orc_union32 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union16 var60;
+  orc_union16 var61;
+  orc_union32 var62;
+  orc_union32 var63;
+  orc_union32 var64;
+  orc_union32 var65;
+  orc_union32 var66;
+  orc_union32 var67;
+  orc_union32 var68;
+  orc_union16 var69;
+  orc_union32 var70;
+  orc_union32 var71;
+  orc_union32 var72;
+  orc_union32 var73;
+  orc_union16 var74;
+  orc_union16 var75;
+  orc_union16 var76;
+  orc_union16 var77;
+  orc_union16 var78;
+  orc_union32 var79;
+  orc_union32 var80;
+  orc_union32 var81;
+  orc_union32 var82;
+  orc_union32 var83;
+  orc_union32 var84;
+  orc_union16 var85;
+  orc_union32 var86;
+  orc_union32 var87;
+  orc_union32 var88;
+  orc_union32 var89;
+  orc_union32 var90;
+  orc_union16 var91;
+
+  ptr0 = (orc_union32 *) d1;
+  ptr1 = (orc_union32 *) d2;
+  ptr2 = (orc_union32 *) d3;
+  ptr3 = (orc_union32 *) d4;
+  ptr4 = (orc_union32 *) s1;
+  ptr5 = (orc_union32 *) s2;
+  ptr6 = (orc_union32 *) s3;
+  ptr7 = (orc_union32 *) s4;
+
+  /* 6: loadpw */
+  var48.x2[0] = 0x00000005;     /* 5 or 2.47033e-323f */
+  var48.x2[1] = 0x00000005;     /* 5 or 2.47033e-323f */
+  /* 8: loadpw */
+  var49.x2[0] = 0x00000003;     /* 3 or 1.4822e-323f */
+  var49.x2[1] = 0x00000003;     /* 3 or 1.4822e-323f */
+  /* 11: loadpw */
+  var50.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var50.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
+  /* 17: loadpw */
+  var52.x2[0] = 0x00000007;     /* 7 or 3.45846e-323f */
+  var52.x2[1] = 0x00000007;     /* 7 or 3.45846e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var46 = ptr4[i];
+    /* 1: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var46.i;
+      var58.i = _src.x2[1];
+      var59.i = _src.x2[0];
+    }
+    /* 2: loadl */
+    var47 = ptr6[i];
+    /* 3: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var47.i;
+      var60.i = _src.x2[1];
+      var61.i = _src.x2[0];
+    }
+    /* 4: convubw */
+    var62.x2[0] = (orc_uint8) var58.x2[0];
+    var62.x2[1] = (orc_uint8) var58.x2[1];
+    /* 5: convubw */
+    var63.x2[0] = (orc_uint8) var60.x2[0];
+    var63.x2[1] = (orc_uint8) var60.x2[1];
+    /* 7: mullw */
+    var64.x2[0] = (var62.x2[0] * var48.x2[0]) & 0xffff;
+    var64.x2[1] = (var62.x2[1] * var48.x2[1]) & 0xffff;
+    /* 9: mullw */
+    var65.x2[0] = (var63.x2[0] * var49.x2[0]) & 0xffff;
+    var65.x2[1] = (var63.x2[1] * var49.x2[1]) & 0xffff;
+    /* 10: addw */
+    var66.x2[0] = var64.x2[0] + var65.x2[0];
+    var66.x2[1] = var64.x2[1] + var65.x2[1];
+    /* 12: addw */
+    var67.x2[0] = var66.x2[0] + var50.x2[0];
+    var67.x2[1] = var66.x2[1] + var50.x2[1];
+    /* 13: shruw */
+    var68.x2[0] = ((orc_uint16) var67.x2[0]) >> 3;
+    var68.x2[1] = ((orc_uint16) var67.x2[1]) >> 3;
+    /* 14: convsuswb */
+    var69.x2[0] = ORC_CLAMP_UB (var68.x2[0]);
+    var69.x2[1] = ORC_CLAMP_UB (var68.x2[1]);
+    /* 15: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var59.i;
+      _dest.x2[1] = var69.i;
+      var51.i = _dest.i;
+    }
+    /* 16: storel */
+    ptr0[i] = var51;
+    /* 18: mullw */
+    var70.x2[0] = (var63.x2[0] * var52.x2[0]) & 0xffff;
+    var70.x2[1] = (var63.x2[1] * var52.x2[1]) & 0xffff;
+    /* 19: addw */
+    var71.x2[0] = var70.x2[0] + var62.x2[0];
+    var71.x2[1] = var70.x2[1] + var62.x2[1];
+    /* 20: addw */
+    var72.x2[0] = var71.x2[0] + var50.x2[0];
+    var72.x2[1] = var71.x2[1] + var50.x2[1];
+    /* 21: shruw */
+    var73.x2[0] = ((orc_uint16) var72.x2[0]) >> 3;
+    var73.x2[1] = ((orc_uint16) var72.x2[1]) >> 3;
+    /* 22: convsuswb */
+    var74.x2[0] = ORC_CLAMP_UB (var73.x2[0]);
+    var74.x2[1] = ORC_CLAMP_UB (var73.x2[1]);
+    /* 23: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var61.i;
+      _dest.x2[1] = var74.i;
+      var53.i = _dest.i;
+    }
+    /* 24: storel */
+    ptr2[i] = var53;
+    /* 25: loadl */
+    var54 = ptr5[i];
+    /* 26: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var54.i;
+      var75.i = _src.x2[1];
+      var76.i = _src.x2[0];
+    }
+    /* 27: loadl */
+    var55 = ptr7[i];
+    /* 28: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var55.i;
+      var77.i = _src.x2[1];
+      var78.i = _src.x2[0];
+    }
+    /* 29: convubw */
+    var79.x2[0] = (orc_uint8) var75.x2[0];
+    var79.x2[1] = (orc_uint8) var75.x2[1];
+    /* 30: convubw */
+    var80.x2[0] = (orc_uint8) var77.x2[0];
+    var80.x2[1] = (orc_uint8) var77.x2[1];
+    /* 31: mullw */
+    var81.x2[0] = (var79.x2[0] * var52.x2[0]) & 0xffff;
+    var81.x2[1] = (var79.x2[1] * var52.x2[1]) & 0xffff;
+    /* 32: addw */
+    var82.x2[0] = var81.x2[0] + var80.x2[0];
+    var82.x2[1] = var81.x2[1] + var80.x2[1];
+    /* 33: addw */
+    var83.x2[0] = var82.x2[0] + var50.x2[0];
+    var83.x2[1] = var82.x2[1] + var50.x2[1];
+    /* 34: shruw */
+    var84.x2[0] = ((orc_uint16) var83.x2[0]) >> 3;
+    var84.x2[1] = ((orc_uint16) var83.x2[1]) >> 3;
+    /* 35: convsuswb */
+    var85.x2[0] = ORC_CLAMP_UB (var84.x2[0]);
+    var85.x2[1] = ORC_CLAMP_UB (var84.x2[1]);
+    /* 36: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var76.i;
+      _dest.x2[1] = var85.i;
+      var56.i = _dest.i;
+    }
+    /* 37: storel */
+    ptr1[i] = var56;
+    /* 38: mullw */
+    var86.x2[0] = (var79.x2[0] * var49.x2[0]) & 0xffff;
+    var86.x2[1] = (var79.x2[1] * var49.x2[1]) & 0xffff;
+    /* 39: mullw */
+    var87.x2[0] = (var80.x2[0] * var48.x2[0]) & 0xffff;
+    var87.x2[1] = (var80.x2[1] * var48.x2[1]) & 0xffff;
+    /* 40: addw */
+    var88.x2[0] = var86.x2[0] + var87.x2[0];
+    var88.x2[1] = var86.x2[1] + var87.x2[1];
+    /* 41: addw */
+    var89.x2[0] = var88.x2[0] + var50.x2[0];
+    var89.x2[1] = var88.x2[1] + var50.x2[1];
+    /* 42: shruw */
+    var90.x2[0] = ((orc_uint16) var89.x2[0]) >> 3;
+    var90.x2[1] = ((orc_uint16) var89.x2[1]) >> 3;
+    /* 43: convsuswb */
+    var91.x2[0] = ORC_CLAMP_UB (var90.x2[0]);
+    var91.x2[1] = ORC_CLAMP_UB (var90.x2[1]);
+    /* 44: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var78.i;
+      _dest.x2[1] = var91.i;
+      var57.i = _dest.i;
+    }
+    /* 45: storel */
+    ptr3[i] = var57;
+  }
+
+}
+
+#else
+static void
+_backup_video_orc_chroma_up_vi2_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  orc_union32 *ORC_RESTRICT ptr1;
+  orc_union32 *ORC_RESTRICT ptr2;
+  orc_union32 *ORC_RESTRICT ptr3;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union32 *ORC_RESTRICT ptr5;
+  const orc_union32 *ORC_RESTRICT ptr6;
+  const orc_union32 *ORC_RESTRICT ptr7;
+  orc_union32 var46;
+  orc_union32 var47;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var48;
+#else
+  orc_union32 var48;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var49;
+#else
+  orc_union32 var49;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var50;
+#else
+  orc_union32 var50;
+#endif
+  orc_union32 var51;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var52;
+#else
+  orc_union32 var52;
+#endif
+  orc_union32 var53;
+  orc_union32 var54;
+  orc_union32 var55;
+  orc_union32 var56;
+  orc_union32 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union16 var60;
+  orc_union16 var61;
+  orc_union32 var62;
+  orc_union32 var63;
+  orc_union32 var64;
+  orc_union32 var65;
+  orc_union32 var66;
+  orc_union32 var67;
+  orc_union32 var68;
+  orc_union16 var69;
+  orc_union32 var70;
+  orc_union32 var71;
+  orc_union32 var72;
+  orc_union32 var73;
+  orc_union16 var74;
+  orc_union16 var75;
+  orc_union16 var76;
+  orc_union16 var77;
+  orc_union16 var78;
+  orc_union32 var79;
+  orc_union32 var80;
+  orc_union32 var81;
+  orc_union32 var82;
+  orc_union32 var83;
+  orc_union32 var84;
+  orc_union16 var85;
+  orc_union32 var86;
+  orc_union32 var87;
+  orc_union32 var88;
+  orc_union32 var89;
+  orc_union32 var90;
+  orc_union16 var91;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+  ptr1 = (orc_union32 *) ex->arrays[1];
+  ptr2 = (orc_union32 *) ex->arrays[2];
+  ptr3 = (orc_union32 *) ex->arrays[3];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+  ptr5 = (orc_union32 *) ex->arrays[5];
+  ptr6 = (orc_union32 *) ex->arrays[6];
+  ptr7 = (orc_union32 *) ex->arrays[7];
+
+  /* 6: loadpw */
+  var48.x2[0] = 0x00000005;     /* 5 or 2.47033e-323f */
+  var48.x2[1] = 0x00000005;     /* 5 or 2.47033e-323f */
+  /* 8: loadpw */
+  var49.x2[0] = 0x00000003;     /* 3 or 1.4822e-323f */
+  var49.x2[1] = 0x00000003;     /* 3 or 1.4822e-323f */
+  /* 11: loadpw */
+  var50.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var50.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
+  /* 17: loadpw */
+  var52.x2[0] = 0x00000007;     /* 7 or 3.45846e-323f */
+  var52.x2[1] = 0x00000007;     /* 7 or 3.45846e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var46 = ptr4[i];
+    /* 1: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var46.i;
+      var58.i = _src.x2[1];
+      var59.i = _src.x2[0];
+    }
+    /* 2: loadl */
+    var47 = ptr6[i];
+    /* 3: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var47.i;
+      var60.i = _src.x2[1];
+      var61.i = _src.x2[0];
+    }
+    /* 4: convubw */
+    var62.x2[0] = (orc_uint8) var58.x2[0];
+    var62.x2[1] = (orc_uint8) var58.x2[1];
+    /* 5: convubw */
+    var63.x2[0] = (orc_uint8) var60.x2[0];
+    var63.x2[1] = (orc_uint8) var60.x2[1];
+    /* 7: mullw */
+    var64.x2[0] = (var62.x2[0] * var48.x2[0]) & 0xffff;
+    var64.x2[1] = (var62.x2[1] * var48.x2[1]) & 0xffff;
+    /* 9: mullw */
+    var65.x2[0] = (var63.x2[0] * var49.x2[0]) & 0xffff;
+    var65.x2[1] = (var63.x2[1] * var49.x2[1]) & 0xffff;
+    /* 10: addw */
+    var66.x2[0] = var64.x2[0] + var65.x2[0];
+    var66.x2[1] = var64.x2[1] + var65.x2[1];
+    /* 12: addw */
+    var67.x2[0] = var66.x2[0] + var50.x2[0];
+    var67.x2[1] = var66.x2[1] + var50.x2[1];
+    /* 13: shruw */
+    var68.x2[0] = ((orc_uint16) var67.x2[0]) >> 3;
+    var68.x2[1] = ((orc_uint16) var67.x2[1]) >> 3;
+    /* 14: convsuswb */
+    var69.x2[0] = ORC_CLAMP_UB (var68.x2[0]);
+    var69.x2[1] = ORC_CLAMP_UB (var68.x2[1]);
+    /* 15: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var59.i;
+      _dest.x2[1] = var69.i;
+      var51.i = _dest.i;
+    }
+    /* 16: storel */
+    ptr0[i] = var51;
+    /* 18: mullw */
+    var70.x2[0] = (var63.x2[0] * var52.x2[0]) & 0xffff;
+    var70.x2[1] = (var63.x2[1] * var52.x2[1]) & 0xffff;
+    /* 19: addw */
+    var71.x2[0] = var70.x2[0] + var62.x2[0];
+    var71.x2[1] = var70.x2[1] + var62.x2[1];
+    /* 20: addw */
+    var72.x2[0] = var71.x2[0] + var50.x2[0];
+    var72.x2[1] = var71.x2[1] + var50.x2[1];
+    /* 21: shruw */
+    var73.x2[0] = ((orc_uint16) var72.x2[0]) >> 3;
+    var73.x2[1] = ((orc_uint16) var72.x2[1]) >> 3;
+    /* 22: convsuswb */
+    var74.x2[0] = ORC_CLAMP_UB (var73.x2[0]);
+    var74.x2[1] = ORC_CLAMP_UB (var73.x2[1]);
+    /* 23: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var61.i;
+      _dest.x2[1] = var74.i;
+      var53.i = _dest.i;
+    }
+    /* 24: storel */
+    ptr2[i] = var53;
+    /* 25: loadl */
+    var54 = ptr5[i];
+    /* 26: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var54.i;
+      var75.i = _src.x2[1];
+      var76.i = _src.x2[0];
+    }
+    /* 27: loadl */
+    var55 = ptr7[i];
+    /* 28: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var55.i;
+      var77.i = _src.x2[1];
+      var78.i = _src.x2[0];
+    }
+    /* 29: convubw */
+    var79.x2[0] = (orc_uint8) var75.x2[0];
+    var79.x2[1] = (orc_uint8) var75.x2[1];
+    /* 30: convubw */
+    var80.x2[0] = (orc_uint8) var77.x2[0];
+    var80.x2[1] = (orc_uint8) var77.x2[1];
+    /* 31: mullw */
+    var81.x2[0] = (var79.x2[0] * var52.x2[0]) & 0xffff;
+    var81.x2[1] = (var79.x2[1] * var52.x2[1]) & 0xffff;
+    /* 32: addw */
+    var82.x2[0] = var81.x2[0] + var80.x2[0];
+    var82.x2[1] = var81.x2[1] + var80.x2[1];
+    /* 33: addw */
+    var83.x2[0] = var82.x2[0] + var50.x2[0];
+    var83.x2[1] = var82.x2[1] + var50.x2[1];
+    /* 34: shruw */
+    var84.x2[0] = ((orc_uint16) var83.x2[0]) >> 3;
+    var84.x2[1] = ((orc_uint16) var83.x2[1]) >> 3;
+    /* 35: convsuswb */
+    var85.x2[0] = ORC_CLAMP_UB (var84.x2[0]);
+    var85.x2[1] = ORC_CLAMP_UB (var84.x2[1]);
+    /* 36: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var76.i;
+      _dest.x2[1] = var85.i;
+      var56.i = _dest.i;
+    }
+    /* 37: storel */
+    ptr1[i] = var56;
+    /* 38: mullw */
+    var86.x2[0] = (var79.x2[0] * var49.x2[0]) & 0xffff;
+    var86.x2[1] = (var79.x2[1] * var49.x2[1]) & 0xffff;
+    /* 39: mullw */
+    var87.x2[0] = (var80.x2[0] * var48.x2[0]) & 0xffff;
+    var87.x2[1] = (var80.x2[1] * var48.x2[1]) & 0xffff;
+    /* 40: addw */
+    var88.x2[0] = var86.x2[0] + var87.x2[0];
+    var88.x2[1] = var86.x2[1] + var87.x2[1];
+    /* 41: addw */
+    var89.x2[0] = var88.x2[0] + var50.x2[0];
+    var89.x2[1] = var88.x2[1] + var50.x2[1];
+    /* 42: shruw */
+    var90.x2[0] = ((orc_uint16) var89.x2[0]) >> 3;
+    var90.x2[1] = ((orc_uint16) var89.x2[1]) >> 3;
+    /* 43: convsuswb */
+    var91.x2[0] = ORC_CLAMP_UB (var90.x2[0]);
+    var91.x2[1] = ORC_CLAMP_UB (var90.x2[1]);
+    /* 44: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var78.i;
+      _dest.x2[1] = var91.i;
+      var57.i = _dest.i;
+    }
+    /* 45: storel */
+    ptr3[i] = var57;
+  }
+
+}
+
+void
+video_orc_chroma_up_vi2_u8 (guint8 * ORC_RESTRICT d1, guint8 * ORC_RESTRICT d2,
+    guint8 * ORC_RESTRICT d3, guint8 * ORC_RESTRICT d4,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 26, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 117, 112, 95, 118, 105, 50, 95, 117, 56, 11, 4, 4,
+        11, 4, 4, 11, 4, 4, 11, 4, 4, 12, 4, 4, 12, 4, 4, 12,
+        4, 4, 12, 4, 4, 14, 2, 5, 0, 0, 0, 14, 2, 3, 0, 0,
+        0, 14, 2, 4, 0, 0, 0, 14, 2, 7, 0, 0, 0, 20, 2, 20,
+        2, 20, 2, 20, 2, 20, 2, 20, 2, 20, 2, 20, 2, 20, 4, 20,
+        4, 20, 4, 20, 4, 20, 4, 20, 4, 198, 36, 32, 4, 198, 38, 34,
+        6, 21, 1, 150, 40, 36, 21, 1, 150, 42, 38, 21, 1, 89, 44, 40,
+        16, 21, 1, 89, 45, 42, 17, 21, 1, 70, 44, 44, 45, 21, 1, 70,
+        44, 44, 18, 21, 1, 95, 44, 44, 17, 21, 1, 160, 36, 44, 195, 0,
+        32, 36, 21, 1, 89, 44, 42, 19, 21, 1, 70, 44, 44, 40, 21, 1,
+        70, 44, 44, 18, 21, 1, 95, 44, 44, 17, 21, 1, 160, 38, 44, 195,
+        2, 34, 38, 198, 37, 33, 5, 198, 39, 35, 7, 21, 1, 150, 41, 37,
+        21, 1, 150, 43, 39, 21, 1, 89, 44, 41, 19, 21, 1, 70, 44, 44,
+        43, 21, 1, 70, 44, 44, 18, 21, 1, 95, 44, 44, 17, 21, 1, 160,
+        37, 44, 195, 1, 33, 37, 21, 1, 89, 44, 41, 17, 21, 1, 89, 45,
+        43, 16, 21, 1, 70, 44, 44, 45, 21, 1, 70, 44, 44, 18, 21, 1,
+        95, 44, 44, 17, 21, 1, 160, 39, 44, 195, 3, 35, 39, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_vi2_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_orc_chroma_up_vi2_u8");
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_vi2_u8);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_destination (p, 4, "d2");
+      orc_program_add_destination (p, 4, "d3");
+      orc_program_add_destination (p, 4, "d4");
+      orc_program_add_source (p, 4, "s1");
+      orc_program_add_source (p, 4, "s2");
+      orc_program_add_source (p, 4, "s3");
+      orc_program_add_source (p, 4, "s4");
+      orc_program_add_constant (p, 2, 0x00000005, "c1");
+      orc_program_add_constant (p, 2, 0x00000003, "c2");
+      orc_program_add_constant (p, 2, 0x00000004, "c3");
+      orc_program_add_constant (p, 2, 0x00000007, "c4");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 2, "t3");
+      orc_program_add_temporary (p, 2, "t4");
+      orc_program_add_temporary (p, 2, "t5");
+      orc_program_add_temporary (p, 2, "t6");
+      orc_program_add_temporary (p, 2, "t7");
+      orc_program_add_temporary (p, 2, "t8");
+      orc_program_add_temporary (p, 4, "t9");
+      orc_program_add_temporary (p, 4, "t10");
+      orc_program_add_temporary (p, 4, "t11");
+      orc_program_add_temporary (p, 4, "t12");
+      orc_program_add_temporary (p, 4, "t13");
+      orc_program_add_temporary (p, 4, "t14");
+
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T5, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T7, ORC_VAR_T3, ORC_VAR_S3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T9, ORC_VAR_T5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T11, ORC_VAR_T7,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T13, ORC_VAR_T9, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T14, ORC_VAR_T11, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_T14,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T5, ORC_VAR_T13,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T13, ORC_VAR_T11, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_T9,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T7, ORC_VAR_T13,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D3, ORC_VAR_T3, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T6, ORC_VAR_T2, ORC_VAR_S2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T8, ORC_VAR_T4, ORC_VAR_S4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T10, ORC_VAR_T6,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T12, ORC_VAR_T8,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T13, ORC_VAR_T10, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_T12,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T6, ORC_VAR_T13,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D2, ORC_VAR_T2, ORC_VAR_T6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T13, ORC_VAR_T10, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T14, ORC_VAR_T12, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_T14,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T8, ORC_VAR_T13,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D4, ORC_VAR_T4, ORC_VAR_T8,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_D2] = d2;
+  ex->arrays[ORC_VAR_D3] = d3;
+  ex->arrays[ORC_VAR_D4] = d4;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* video_orc_chroma_up_vi2_u16 */
+#ifdef DISABLE_ORC
+void
+video_orc_chroma_up_vi2_u16 (guint16 * ORC_RESTRICT d1,
+    guint16 * ORC_RESTRICT d2, guint16 * ORC_RESTRICT d3,
+    guint16 * ORC_RESTRICT d4, const guint16 * ORC_RESTRICT s1,
+    const guint16 * ORC_RESTRICT s2, const guint16 * ORC_RESTRICT s3,
+    const guint16 * ORC_RESTRICT s4, int n)
+{
+  int i;
+  orc_union64 *ORC_RESTRICT ptr0;
+  orc_union64 *ORC_RESTRICT ptr1;
+  orc_union64 *ORC_RESTRICT ptr2;
+  orc_union64 *ORC_RESTRICT ptr3;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  const orc_union64 *ORC_RESTRICT ptr6;
+  const orc_union64 *ORC_RESTRICT ptr7;
+  orc_union64 var46;
+  orc_union64 var47;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var48;
+#else
+  orc_union64 var48;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var49;
+#else
+  orc_union64 var49;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var50;
+#else
+  orc_union64 var50;
+#endif
+  orc_union64 var51;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var52;
+#else
+  orc_union64 var52;
+#endif
+  orc_union64 var53;
+  orc_union64 var54;
+  orc_union64 var55;
+  orc_union64 var56;
+  orc_union64 var57;
+  orc_union32 var58;
+  orc_union32 var59;
+  orc_union32 var60;
+  orc_union32 var61;
+  orc_union64 var62;
+  orc_union64 var63;
+  orc_union64 var64;
+  orc_union64 var65;
+  orc_union64 var66;
+  orc_union64 var67;
+  orc_union64 var68;
+  orc_union32 var69;
+  orc_union64 var70;
+  orc_union64 var71;
+  orc_union64 var72;
+  orc_union64 var73;
+  orc_union32 var74;
+  orc_union32 var75;
+  orc_union32 var76;
+  orc_union32 var77;
+  orc_union32 var78;
+  orc_union64 var79;
+  orc_union64 var80;
+  orc_union64 var81;
+  orc_union64 var82;
+  orc_union64 var83;
+  orc_union64 var84;
+  orc_union32 var85;
+  orc_union64 var86;
+  orc_union64 var87;
+  orc_union64 var88;
+  orc_union64 var89;
+  orc_union64 var90;
+  orc_union32 var91;
+
+  ptr0 = (orc_union64 *) d1;
+  ptr1 = (orc_union64 *) d2;
+  ptr2 = (orc_union64 *) d3;
+  ptr3 = (orc_union64 *) d4;
+  ptr4 = (orc_union64 *) s1;
+  ptr5 = (orc_union64 *) s2;
+  ptr6 = (orc_union64 *) s3;
+  ptr7 = (orc_union64 *) s4;
+
+  /* 6: loadpl */
+  var48.x2[0] = 0x00000005;     /* 5 or 2.47033e-323f */
+  var48.x2[1] = 0x00000005;     /* 5 or 2.47033e-323f */
+  /* 8: loadpl */
+  var49.x2[0] = 0x00000003;     /* 3 or 1.4822e-323f */
+  var49.x2[1] = 0x00000003;     /* 3 or 1.4822e-323f */
+  /* 11: loadpl */
+  var50.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var50.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
+  /* 17: loadpl */
+  var52.x2[0] = 0x00000007;     /* 7 or 3.45846e-323f */
+  var52.x2[1] = 0x00000007;     /* 7 or 3.45846e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var46 = ptr4[i];
+    /* 1: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var46.i;
+      var58.i = _src.x2[1];
+      var59.i = _src.x2[0];
+    }
+    /* 2: loadq */
+    var47 = ptr6[i];
+    /* 3: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var47.i;
+      var60.i = _src.x2[1];
+      var61.i = _src.x2[0];
+    }
+    /* 4: convuwl */
+    var62.x2[0] = (orc_uint16) var58.x2[0];
+    var62.x2[1] = (orc_uint16) var58.x2[1];
+    /* 5: convuwl */
+    var63.x2[0] = (orc_uint16) var60.x2[0];
+    var63.x2[1] = (orc_uint16) var60.x2[1];
+    /* 7: mulll */
+    var64.x2[0] =
+        (((orc_uint32) var62.x2[0]) * ((orc_uint32) var48.x2[0])) & 0xffffffff;
+    var64.x2[1] =
+        (((orc_uint32) var62.x2[1]) * ((orc_uint32) var48.x2[1])) & 0xffffffff;
+    /* 9: mulll */
+    var65.x2[0] =
+        (((orc_uint32) var63.x2[0]) * ((orc_uint32) var49.x2[0])) & 0xffffffff;
+    var65.x2[1] =
+        (((orc_uint32) var63.x2[1]) * ((orc_uint32) var49.x2[1])) & 0xffffffff;
+    /* 10: addl */
+    var66.x2[0] = ((orc_uint32) var64.x2[0]) + ((orc_uint32) var65.x2[0]);
+    var66.x2[1] = ((orc_uint32) var64.x2[1]) + ((orc_uint32) var65.x2[1]);
+    /* 12: addl */
+    var67.x2[0] = ((orc_uint32) var66.x2[0]) + ((orc_uint32) var50.x2[0]);
+    var67.x2[1] = ((orc_uint32) var66.x2[1]) + ((orc_uint32) var50.x2[1]);
+    /* 13: shrul */
+    var68.x2[0] = ((orc_uint32) var67.x2[0]) >> 3;
+    var68.x2[1] = ((orc_uint32) var67.x2[1]) >> 3;
+    /* 14: convsuslw */
+    var69.x2[0] = ORC_CLAMP_UW (var68.x2[0]);
+    var69.x2[1] = ORC_CLAMP_UW (var68.x2[1]);
+    /* 15: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var59.i;
+      _dest.x2[1] = var69.i;
+      var51.i = _dest.i;
+    }
+    /* 16: storeq */
+    ptr0[i] = var51;
+    /* 18: mulll */
+    var70.x2[0] =
+        (((orc_uint32) var63.x2[0]) * ((orc_uint32) var52.x2[0])) & 0xffffffff;
+    var70.x2[1] =
+        (((orc_uint32) var63.x2[1]) * ((orc_uint32) var52.x2[1])) & 0xffffffff;
+    /* 19: addl */
+    var71.x2[0] = ((orc_uint32) var70.x2[0]) + ((orc_uint32) var62.x2[0]);
+    var71.x2[1] = ((orc_uint32) var70.x2[1]) + ((orc_uint32) var62.x2[1]);
+    /* 20: addl */
+    var72.x2[0] = ((orc_uint32) var71.x2[0]) + ((orc_uint32) var50.x2[0]);
+    var72.x2[1] = ((orc_uint32) var71.x2[1]) + ((orc_uint32) var50.x2[1]);
+    /* 21: shrul */
+    var73.x2[0] = ((orc_uint32) var72.x2[0]) >> 3;
+    var73.x2[1] = ((orc_uint32) var72.x2[1]) >> 3;
+    /* 22: convsuslw */
+    var74.x2[0] = ORC_CLAMP_UW (var73.x2[0]);
+    var74.x2[1] = ORC_CLAMP_UW (var73.x2[1]);
+    /* 23: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var61.i;
+      _dest.x2[1] = var74.i;
+      var53.i = _dest.i;
+    }
+    /* 24: storeq */
+    ptr2[i] = var53;
+    /* 25: loadq */
+    var54 = ptr5[i];
+    /* 26: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var54.i;
+      var75.i = _src.x2[1];
+      var76.i = _src.x2[0];
+    }
+    /* 27: loadq */
+    var55 = ptr7[i];
+    /* 28: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var55.i;
+      var77.i = _src.x2[1];
+      var78.i = _src.x2[0];
+    }
+    /* 29: convuwl */
+    var79.x2[0] = (orc_uint16) var75.x2[0];
+    var79.x2[1] = (orc_uint16) var75.x2[1];
+    /* 30: convuwl */
+    var80.x2[0] = (orc_uint16) var77.x2[0];
+    var80.x2[1] = (orc_uint16) var77.x2[1];
+    /* 31: mulll */
+    var81.x2[0] =
+        (((orc_uint32) var79.x2[0]) * ((orc_uint32) var52.x2[0])) & 0xffffffff;
+    var81.x2[1] =
+        (((orc_uint32) var79.x2[1]) * ((orc_uint32) var52.x2[1])) & 0xffffffff;
+    /* 32: addl */
+    var82.x2[0] = ((orc_uint32) var81.x2[0]) + ((orc_uint32) var80.x2[0]);
+    var82.x2[1] = ((orc_uint32) var81.x2[1]) + ((orc_uint32) var80.x2[1]);
+    /* 33: addl */
+    var83.x2[0] = ((orc_uint32) var82.x2[0]) + ((orc_uint32) var50.x2[0]);
+    var83.x2[1] = ((orc_uint32) var82.x2[1]) + ((orc_uint32) var50.x2[1]);
+    /* 34: shrul */
+    var84.x2[0] = ((orc_uint32) var83.x2[0]) >> 3;
+    var84.x2[1] = ((orc_uint32) var83.x2[1]) >> 3;
+    /* 35: convsuslw */
+    var85.x2[0] = ORC_CLAMP_UW (var84.x2[0]);
+    var85.x2[1] = ORC_CLAMP_UW (var84.x2[1]);
+    /* 36: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var76.i;
+      _dest.x2[1] = var85.i;
+      var56.i = _dest.i;
+    }
+    /* 37: storeq */
+    ptr1[i] = var56;
+    /* 38: mulll */
+    var86.x2[0] =
+        (((orc_uint32) var79.x2[0]) * ((orc_uint32) var49.x2[0])) & 0xffffffff;
+    var86.x2[1] =
+        (((orc_uint32) var79.x2[1]) * ((orc_uint32) var49.x2[1])) & 0xffffffff;
+    /* 39: mulll */
+    var87.x2[0] =
+        (((orc_uint32) var80.x2[0]) * ((orc_uint32) var48.x2[0])) & 0xffffffff;
+    var87.x2[1] =
+        (((orc_uint32) var80.x2[1]) * ((orc_uint32) var48.x2[1])) & 0xffffffff;
+    /* 40: addl */
+    var88.x2[0] = ((orc_uint32) var86.x2[0]) + ((orc_uint32) var87.x2[0]);
+    var88.x2[1] = ((orc_uint32) var86.x2[1]) + ((orc_uint32) var87.x2[1]);
+    /* 41: addl */
+    var89.x2[0] = ((orc_uint32) var88.x2[0]) + ((orc_uint32) var50.x2[0]);
+    var89.x2[1] = ((orc_uint32) var88.x2[1]) + ((orc_uint32) var50.x2[1]);
+    /* 42: shrul */
+    var90.x2[0] = ((orc_uint32) var89.x2[0]) >> 3;
+    var90.x2[1] = ((orc_uint32) var89.x2[1]) >> 3;
+    /* 43: convsuslw */
+    var91.x2[0] = ORC_CLAMP_UW (var90.x2[0]);
+    var91.x2[1] = ORC_CLAMP_UW (var90.x2[1]);
+    /* 44: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var78.i;
+      _dest.x2[1] = var91.i;
+      var57.i = _dest.i;
+    }
+    /* 45: storeq */
+    ptr3[i] = var57;
+  }
+
+}
+
+#else
+static void
+_backup_video_orc_chroma_up_vi2_u16 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union64 *ORC_RESTRICT ptr0;
+  orc_union64 *ORC_RESTRICT ptr1;
+  orc_union64 *ORC_RESTRICT ptr2;
+  orc_union64 *ORC_RESTRICT ptr3;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  const orc_union64 *ORC_RESTRICT ptr6;
+  const orc_union64 *ORC_RESTRICT ptr7;
+  orc_union64 var46;
+  orc_union64 var47;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var48;
+#else
+  orc_union64 var48;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var49;
+#else
+  orc_union64 var49;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var50;
+#else
+  orc_union64 var50;
+#endif
+  orc_union64 var51;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var52;
+#else
+  orc_union64 var52;
+#endif
+  orc_union64 var53;
+  orc_union64 var54;
+  orc_union64 var55;
+  orc_union64 var56;
+  orc_union64 var57;
+  orc_union32 var58;
+  orc_union32 var59;
+  orc_union32 var60;
+  orc_union32 var61;
+  orc_union64 var62;
+  orc_union64 var63;
+  orc_union64 var64;
+  orc_union64 var65;
+  orc_union64 var66;
+  orc_union64 var67;
+  orc_union64 var68;
+  orc_union32 var69;
+  orc_union64 var70;
+  orc_union64 var71;
+  orc_union64 var72;
+  orc_union64 var73;
+  orc_union32 var74;
+  orc_union32 var75;
+  orc_union32 var76;
+  orc_union32 var77;
+  orc_union32 var78;
+  orc_union64 var79;
+  orc_union64 var80;
+  orc_union64 var81;
+  orc_union64 var82;
+  orc_union64 var83;
+  orc_union64 var84;
+  orc_union32 var85;
+  orc_union64 var86;
+  orc_union64 var87;
+  orc_union64 var88;
+  orc_union64 var89;
+  orc_union64 var90;
+  orc_union32 var91;
+
+  ptr0 = (orc_union64 *) ex->arrays[0];
+  ptr1 = (orc_union64 *) ex->arrays[1];
+  ptr2 = (orc_union64 *) ex->arrays[2];
+  ptr3 = (orc_union64 *) ex->arrays[3];
+  ptr4 = (orc_union64 *) ex->arrays[4];
+  ptr5 = (orc_union64 *) ex->arrays[5];
+  ptr6 = (orc_union64 *) ex->arrays[6];
+  ptr7 = (orc_union64 *) ex->arrays[7];
+
+  /* 6: loadpl */
+  var48.x2[0] = 0x00000005;     /* 5 or 2.47033e-323f */
+  var48.x2[1] = 0x00000005;     /* 5 or 2.47033e-323f */
+  /* 8: loadpl */
+  var49.x2[0] = 0x00000003;     /* 3 or 1.4822e-323f */
+  var49.x2[1] = 0x00000003;     /* 3 or 1.4822e-323f */
+  /* 11: loadpl */
+  var50.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var50.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
+  /* 17: loadpl */
+  var52.x2[0] = 0x00000007;     /* 7 or 3.45846e-323f */
+  var52.x2[1] = 0x00000007;     /* 7 or 3.45846e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var46 = ptr4[i];
+    /* 1: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var46.i;
+      var58.i = _src.x2[1];
+      var59.i = _src.x2[0];
+    }
+    /* 2: loadq */
+    var47 = ptr6[i];
+    /* 3: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var47.i;
+      var60.i = _src.x2[1];
+      var61.i = _src.x2[0];
+    }
+    /* 4: convuwl */
+    var62.x2[0] = (orc_uint16) var58.x2[0];
+    var62.x2[1] = (orc_uint16) var58.x2[1];
+    /* 5: convuwl */
+    var63.x2[0] = (orc_uint16) var60.x2[0];
+    var63.x2[1] = (orc_uint16) var60.x2[1];
+    /* 7: mulll */
+    var64.x2[0] =
+        (((orc_uint32) var62.x2[0]) * ((orc_uint32) var48.x2[0])) & 0xffffffff;
+    var64.x2[1] =
+        (((orc_uint32) var62.x2[1]) * ((orc_uint32) var48.x2[1])) & 0xffffffff;
+    /* 9: mulll */
+    var65.x2[0] =
+        (((orc_uint32) var63.x2[0]) * ((orc_uint32) var49.x2[0])) & 0xffffffff;
+    var65.x2[1] =
+        (((orc_uint32) var63.x2[1]) * ((orc_uint32) var49.x2[1])) & 0xffffffff;
+    /* 10: addl */
+    var66.x2[0] = ((orc_uint32) var64.x2[0]) + ((orc_uint32) var65.x2[0]);
+    var66.x2[1] = ((orc_uint32) var64.x2[1]) + ((orc_uint32) var65.x2[1]);
+    /* 12: addl */
+    var67.x2[0] = ((orc_uint32) var66.x2[0]) + ((orc_uint32) var50.x2[0]);
+    var67.x2[1] = ((orc_uint32) var66.x2[1]) + ((orc_uint32) var50.x2[1]);
+    /* 13: shrul */
+    var68.x2[0] = ((orc_uint32) var67.x2[0]) >> 3;
+    var68.x2[1] = ((orc_uint32) var67.x2[1]) >> 3;
+    /* 14: convsuslw */
+    var69.x2[0] = ORC_CLAMP_UW (var68.x2[0]);
+    var69.x2[1] = ORC_CLAMP_UW (var68.x2[1]);
+    /* 15: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var59.i;
+      _dest.x2[1] = var69.i;
+      var51.i = _dest.i;
+    }
+    /* 16: storeq */
+    ptr0[i] = var51;
+    /* 18: mulll */
+    var70.x2[0] =
+        (((orc_uint32) var63.x2[0]) * ((orc_uint32) var52.x2[0])) & 0xffffffff;
+    var70.x2[1] =
+        (((orc_uint32) var63.x2[1]) * ((orc_uint32) var52.x2[1])) & 0xffffffff;
+    /* 19: addl */
+    var71.x2[0] = ((orc_uint32) var70.x2[0]) + ((orc_uint32) var62.x2[0]);
+    var71.x2[1] = ((orc_uint32) var70.x2[1]) + ((orc_uint32) var62.x2[1]);
+    /* 20: addl */
+    var72.x2[0] = ((orc_uint32) var71.x2[0]) + ((orc_uint32) var50.x2[0]);
+    var72.x2[1] = ((orc_uint32) var71.x2[1]) + ((orc_uint32) var50.x2[1]);
+    /* 21: shrul */
+    var73.x2[0] = ((orc_uint32) var72.x2[0]) >> 3;
+    var73.x2[1] = ((orc_uint32) var72.x2[1]) >> 3;
+    /* 22: convsuslw */
+    var74.x2[0] = ORC_CLAMP_UW (var73.x2[0]);
+    var74.x2[1] = ORC_CLAMP_UW (var73.x2[1]);
+    /* 23: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var61.i;
+      _dest.x2[1] = var74.i;
+      var53.i = _dest.i;
+    }
+    /* 24: storeq */
+    ptr2[i] = var53;
+    /* 25: loadq */
+    var54 = ptr5[i];
+    /* 26: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var54.i;
+      var75.i = _src.x2[1];
+      var76.i = _src.x2[0];
+    }
+    /* 27: loadq */
+    var55 = ptr7[i];
+    /* 28: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var55.i;
+      var77.i = _src.x2[1];
+      var78.i = _src.x2[0];
+    }
+    /* 29: convuwl */
+    var79.x2[0] = (orc_uint16) var75.x2[0];
+    var79.x2[1] = (orc_uint16) var75.x2[1];
+    /* 30: convuwl */
+    var80.x2[0] = (orc_uint16) var77.x2[0];
+    var80.x2[1] = (orc_uint16) var77.x2[1];
+    /* 31: mulll */
+    var81.x2[0] =
+        (((orc_uint32) var79.x2[0]) * ((orc_uint32) var52.x2[0])) & 0xffffffff;
+    var81.x2[1] =
+        (((orc_uint32) var79.x2[1]) * ((orc_uint32) var52.x2[1])) & 0xffffffff;
+    /* 32: addl */
+    var82.x2[0] = ((orc_uint32) var81.x2[0]) + ((orc_uint32) var80.x2[0]);
+    var82.x2[1] = ((orc_uint32) var81.x2[1]) + ((orc_uint32) var80.x2[1]);
+    /* 33: addl */
+    var83.x2[0] = ((orc_uint32) var82.x2[0]) + ((orc_uint32) var50.x2[0]);
+    var83.x2[1] = ((orc_uint32) var82.x2[1]) + ((orc_uint32) var50.x2[1]);
+    /* 34: shrul */
+    var84.x2[0] = ((orc_uint32) var83.x2[0]) >> 3;
+    var84.x2[1] = ((orc_uint32) var83.x2[1]) >> 3;
+    /* 35: convsuslw */
+    var85.x2[0] = ORC_CLAMP_UW (var84.x2[0]);
+    var85.x2[1] = ORC_CLAMP_UW (var84.x2[1]);
+    /* 36: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var76.i;
+      _dest.x2[1] = var85.i;
+      var56.i = _dest.i;
+    }
+    /* 37: storeq */
+    ptr1[i] = var56;
+    /* 38: mulll */
+    var86.x2[0] =
+        (((orc_uint32) var79.x2[0]) * ((orc_uint32) var49.x2[0])) & 0xffffffff;
+    var86.x2[1] =
+        (((orc_uint32) var79.x2[1]) * ((orc_uint32) var49.x2[1])) & 0xffffffff;
+    /* 39: mulll */
+    var87.x2[0] =
+        (((orc_uint32) var80.x2[0]) * ((orc_uint32) var48.x2[0])) & 0xffffffff;
+    var87.x2[1] =
+        (((orc_uint32) var80.x2[1]) * ((orc_uint32) var48.x2[1])) & 0xffffffff;
+    /* 40: addl */
+    var88.x2[0] = ((orc_uint32) var86.x2[0]) + ((orc_uint32) var87.x2[0]);
+    var88.x2[1] = ((orc_uint32) var86.x2[1]) + ((orc_uint32) var87.x2[1]);
+    /* 41: addl */
+    var89.x2[0] = ((orc_uint32) var88.x2[0]) + ((orc_uint32) var50.x2[0]);
+    var89.x2[1] = ((orc_uint32) var88.x2[1]) + ((orc_uint32) var50.x2[1]);
+    /* 42: shrul */
+    var90.x2[0] = ((orc_uint32) var89.x2[0]) >> 3;
+    var90.x2[1] = ((orc_uint32) var89.x2[1]) >> 3;
+    /* 43: convsuslw */
+    var91.x2[0] = ORC_CLAMP_UW (var90.x2[0]);
+    var91.x2[1] = ORC_CLAMP_UW (var90.x2[1]);
+    /* 44: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var78.i;
+      _dest.x2[1] = var91.i;
+      var57.i = _dest.i;
+    }
+    /* 45: storeq */
+    ptr3[i] = var57;
+  }
+
+}
+
+void
+video_orc_chroma_up_vi2_u16 (guint16 * ORC_RESTRICT d1,
+    guint16 * ORC_RESTRICT d2, guint16 * ORC_RESTRICT d3,
+    guint16 * ORC_RESTRICT d4, const guint16 * ORC_RESTRICT s1,
+    const guint16 * ORC_RESTRICT s2, const guint16 * ORC_RESTRICT s3,
+    const guint16 * ORC_RESTRICT s4, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 27, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 117, 112, 95, 118, 105, 50, 95, 117, 49, 54, 11, 8,
+        8, 11, 8, 8, 11, 8, 8, 11, 8, 8, 12, 8, 8, 12, 8, 8,
+        12, 8, 8, 12, 8, 8, 14, 4, 5, 0, 0, 0, 14, 4, 3, 0,
+        0, 0, 14, 4, 4, 0, 0, 0, 14, 4, 7, 0, 0, 0, 20, 4,
+        20, 4, 20, 4, 20, 4, 20, 4, 20, 4, 20, 4, 20, 4, 20, 8,
+        20, 8, 20, 8, 20, 8, 20, 8, 20, 8, 197, 36, 32, 4, 197, 38,
+        34, 6, 21, 1, 154, 40, 36, 21, 1, 154, 42, 38, 21, 1, 120, 44,
+        40, 16, 21, 1, 120, 45, 42, 17, 21, 1, 103, 44, 44, 45, 21, 1,
+        103, 44, 44, 18, 21, 1, 126, 44, 44, 17, 21, 1, 166, 36, 44, 194,
+        0, 32, 36, 21, 1, 120, 44, 42, 19, 21, 1, 103, 44, 44, 40, 21,
+        1, 103, 44, 44, 18, 21, 1, 126, 44, 44, 17, 21, 1, 166, 38, 44,
+        194, 2, 34, 38, 197, 37, 33, 5, 197, 39, 35, 7, 21, 1, 154, 41,
+        37, 21, 1, 154, 43, 39, 21, 1, 120, 44, 41, 19, 21, 1, 103, 44,
+        44, 43, 21, 1, 103, 44, 44, 18, 21, 1, 126, 44, 44, 17, 21, 1,
+        166, 37, 44, 194, 1, 33, 37, 21, 1, 120, 44, 41, 17, 21, 1, 120,
+        45, 43, 16, 21, 1, 103, 44, 44, 45, 21, 1, 103, 44, 44, 18, 21,
+        1, 126, 44, 44, 17, 21, 1, 166, 39, 44, 194, 3, 35, 39, 2, 0,
+
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_vi2_u16);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_orc_chroma_up_vi2_u16");
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_vi2_u16);
+      orc_program_add_destination (p, 8, "d1");
+      orc_program_add_destination (p, 8, "d2");
+      orc_program_add_destination (p, 8, "d3");
+      orc_program_add_destination (p, 8, "d4");
+      orc_program_add_source (p, 8, "s1");
+      orc_program_add_source (p, 8, "s2");
+      orc_program_add_source (p, 8, "s3");
+      orc_program_add_source (p, 8, "s4");
+      orc_program_add_constant (p, 4, 0x00000005, "c1");
+      orc_program_add_constant (p, 4, 0x00000003, "c2");
+      orc_program_add_constant (p, 4, 0x00000004, "c3");
+      orc_program_add_constant (p, 4, 0x00000007, "c4");
+      orc_program_add_temporary (p, 4, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+      orc_program_add_temporary (p, 4, "t3");
+      orc_program_add_temporary (p, 4, "t4");
+      orc_program_add_temporary (p, 4, "t5");
+      orc_program_add_temporary (p, 4, "t6");
+      orc_program_add_temporary (p, 4, "t7");
+      orc_program_add_temporary (p, 4, "t8");
+      orc_program_add_temporary (p, 8, "t9");
+      orc_program_add_temporary (p, 8, "t10");
+      orc_program_add_temporary (p, 8, "t11");
+      orc_program_add_temporary (p, 8, "t12");
+      orc_program_add_temporary (p, 8, "t13");
+      orc_program_add_temporary (p, 8, "t14");
+
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T5, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T7, ORC_VAR_T3, ORC_VAR_S3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T9, ORC_VAR_T5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T11, ORC_VAR_T7,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T13, ORC_VAR_T9, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T14, ORC_VAR_T11, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_T14,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T5, ORC_VAR_T13,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T13, ORC_VAR_T11, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_T9,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T7, ORC_VAR_T13,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D3, ORC_VAR_T3, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T6, ORC_VAR_T2, ORC_VAR_S2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T8, ORC_VAR_T4, ORC_VAR_S4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T10, ORC_VAR_T6,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T12, ORC_VAR_T8,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T13, ORC_VAR_T10, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_T12,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T6, ORC_VAR_T13,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D2, ORC_VAR_T2, ORC_VAR_T6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T13, ORC_VAR_T10, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T14, ORC_VAR_T12, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_T14,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T13, ORC_VAR_T13, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T8, ORC_VAR_T13,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D4, ORC_VAR_T4, ORC_VAR_T8,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_D2] = d2;
+  ex->arrays[ORC_VAR_D3] = d3;
+  ex->arrays[ORC_VAR_D4] = d4;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
 /* video_orc_dither_none_4u8_mask */
 #ifdef DISABLE_ORC
 void
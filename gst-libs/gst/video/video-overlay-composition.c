@@ -61,6 +61,7 @@
 #include "video-overlay-composition.h"
 #include "video-blend.h"
 #include "gstvideometa.h"
+#include "gstvideoutilsprivate.h"
 #include <string.h>
 
 struct _GstVideoOverlayComposition
@@ -132,16 +133,43 @@ struct _GstVideoOverlayRectangle
   /* store initial per-pixel alpha values: */
   guint8 *initial_alpha;
 
-  /* FIXME: we may also need a (private) way to cache converted/scaled
-   * pixel blobs */
   GMutex lock;
 
+  /* converted/scaled variants of this rectangle, most recently used first.
+   * Protected by the cache lock */
   GList *scaled_rectangles;
+
+  /* for variants: the rectangle they were made from, their link in the
+   * global LRU list and the memory they account for. Variants whose pixels
+   * were handed out are pinned and never evicted, callers may use those
+   * pixels as long as the rectangle is alive */
+  GstVideoOverlayRectangle *cache_owner;
+  GList cache_link;
+  gsize cache_size;
+  gboolean cache_pinned;
+
+  /* subsampled chroma of the overlay for blending onto 4:2:0 frames */
+  GstVideoBlendChroma *blend_chroma;
 };
 
 #define GST_RECTANGLE_LOCK(rect)   g_mutex_lock(&rect->lock)
 #define GST_RECTANGLE_UNLOCK(rect) g_mutex_unlock(&rect->lock)
 
+/* Converted/scaled variants are kept per rectangle, at most
+ * MAX_CACHED_VARIANTS each, and all together within the cache limit. The
+ * least recently used ones are dropped first. Pinned ones are not counted
+ * against MAX_CACHED_VARIANTS and only go away with their rectangle, so the
+ * limits only apply to intermediate variants that were never handed out */
+#define MAX_CACHED_VARIANTS 8
+#define DEFAULT_CACHE_LIMIT (64 * 1024 * 1024)
+
+static GMutex cache_lock;
+static GQueue cache_lru = G_QUEUE_INIT;
+static gsize cache_size = 0;
+static gsize cache_limit = DEFAULT_CACHE_LIMIT;
+static guint64 cache_hits = 0;
+static guint64 cache_misses = 0;
+
 /* --------------------------- utility functions --------------------------- */
 
 #ifndef GST_DISABLE_GST_DEBUG
@@ -445,6 +473,11 @@ gst_video_overlay_composition_get_rectangle (GstVideoOverlayComposition * comp,
   return comp->rectangles[n];
 }
 
+static GstBuffer
+    * gst_video_overlay_rectangle_get_pixels_raw_full
+    (GstVideoOverlayRectangle * rectangle, GstVideoOverlayFormatFlags flags,
+    gboolean unscaled, GstVideoFormat format);
+
 static gboolean
 gst_video_overlay_rectangle_needs_scaling (GstVideoOverlayRectangle * r)
 {
@@ -478,7 +511,7 @@ gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
   GstVideoFrame rectangle_frame;
   GstVideoFormat fmt;
   GstBuffer *pixels = NULL;
-  gboolean ret = TRUE;
+  gboolean ret = TRUE, native;
   guint n, num;
   int w, h;
 
@@ -489,6 +522,10 @@ gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
   h = GST_VIDEO_FRAME_HEIGHT (video_buf);
   fmt = GST_VIDEO_FRAME_FORMAT (video_buf);
 
+  /* 4:2:0 frames get the overlay blended in place, from a cached AYUV
+   * version of the rectangle in the right size */
+  native = __gst_video_blend_is_native (&video_buf->info);
+
   num = comp->num_rectangles;
   GST_LOG ("Blending composition %p with %u rectangles onto video buffer %p "
       "(%ux%u, format %u)", comp, num, video_buf, w, h, fmt);
@@ -504,7 +541,15 @@ gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
         GST_VIDEO_INFO_FORMAT (&rect->info));
 
     needs_scaling = gst_video_overlay_rectangle_needs_scaling (rect);
-    if (needs_scaling) {
+    if (native) {
+      pixels = gst_video_overlay_rectangle_get_pixels_raw_full (rect,
+          GST_VIDEO_OVERLAY_FORMAT_FLAG_GLOBAL_ALPHA, FALSE,
+          GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_YUV);
+      gst_video_info_set_format (&scaled_info,
+          GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_YUV, rect->render_width,
+          rect->render_height);
+      vinfo = &scaled_info;
+    } else if (needs_scaling) {
       gst_video_blend_scale_linear_RGBA (&rect->info, rect->pixels,
           rect->render_height, rect->render_width, &scaled_info, &pixels);
       vinfo = &scaled_info;
@@ -515,8 +560,15 @@ gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
 
     gst_video_frame_map (&rectangle_frame, vinfo, pixels, GST_MAP_READ);
 
-    ret = gst_video_blend (video_buf, &rectangle_frame, rect->x, rect->y,
-        rect->global_alpha);
+    if (native) {
+      GST_RECTANGLE_LOCK (rect);
+      ret = __gst_video_blend_cached (video_buf, &rectangle_frame, rect->x,
+          rect->y, rect->global_alpha, &rect->blend_chroma);
+      GST_RECTANGLE_UNLOCK (rect);
+    } else {
+      ret = gst_video_blend (video_buf, &rectangle_frame, rect->x, rect->y,
+          rect->global_alpha);
+    }
     gst_video_frame_unmap (&rectangle_frame);
     if (!ret) {
       GST_WARNING ("Could not blend overlay rectangle onto video buffer");
@@ -630,6 +682,127 @@ gst_video_overlay_composition_get_seqnum (GstVideoOverlayComposition * comp)
 GST_DEFINE_MINI_OBJECT_TYPE (GstVideoOverlayRectangle,
     gst_video_overlay_rectangle);
 
+/* called with the cache lock, the caller unrefs the garbage after
+ * releasing it */
+static void
+gst_video_overlay_rectangle_cache_remove (GstVideoOverlayRectangle * variant,
+    GList ** garbage)
+{
+  GstVideoOverlayRectangle *owner = variant->cache_owner;
+
+  GST_LOG ("dropping cached variant %p (%" G_GSIZE_FORMAT " bytes) of "
+      "rectangle %p", variant, variant->cache_size, owner);
+
+  owner->scaled_rectangles = g_list_remove (owner->scaled_rectangles, variant);
+  g_queue_unlink (&cache_lru, &variant->cache_link);
+  cache_size -= variant->cache_size;
+  variant->cache_owner = NULL;
+  variant->cache_pinned = FALSE;
+
+  *garbage = g_list_prepend (*garbage, variant);
+}
+
+/* called with the cache lock */
+static void
+gst_video_overlay_rectangle_cache_touch (GstVideoOverlayRectangle * variant)
+{
+  GstVideoOverlayRectangle *owner = variant->cache_owner;
+
+  owner->scaled_rectangles = g_list_remove (owner->scaled_rectangles, variant);
+  owner->scaled_rectangles = g_list_prepend (owner->scaled_rectangles, variant);
+  g_queue_unlink (&cache_lru, &variant->cache_link);
+  g_queue_push_head_link (&cache_lru, &variant->cache_link);
+}
+
+/* called with the cache lock, evicts the least recently used variants until
+ * the cache fits in the limit, except for @keep and the pinned ones */
+static void
+gst_video_overlay_rectangle_cache_trim (GstVideoOverlayRectangle * keep,
+    GList ** garbage)
+{
+  GList *l = cache_lru.tail;
+
+  while (cache_size > cache_limit && l != NULL) {
+    GstVideoOverlayRectangle *variant = l->data;
+
+    l = l->prev;
+    if (variant != keep && !variant->cache_pinned)
+      gst_video_overlay_rectangle_cache_remove (variant, garbage);
+  }
+}
+
+/* called with the cache lock, takes ownership of @variant */
+static void
+gst_video_overlay_rectangle_cache_insert (GstVideoOverlayRectangle *
+    rectangle, GstVideoOverlayRectangle * variant, GList ** garbage)
+{
+  GstVideoOverlayRectangle *oldest = NULL;
+  guint n_unpinned = 0;
+  GList *l;
+
+  variant->cache_owner = rectangle;
+  variant->cache_link.data = variant;
+  variant->cache_size = gst_buffer_get_size (variant->pixels);
+
+  rectangle->scaled_rectangles =
+      g_list_prepend (rectangle->scaled_rectangles, variant);
+  g_queue_push_head_link (&cache_lru, &variant->cache_link);
+  cache_size += variant->cache_size;
+
+  for (l = rectangle->scaled_rectangles; l != NULL; l = l->next) {
+    GstVideoOverlayRectangle *r = l->data;
+
+    if (!r->cache_pinned) {
+      n_unpinned++;
+      if (r != variant)
+        oldest = r;
+    }
+  }
+  if (n_unpinned > MAX_CACHED_VARIANTS && oldest != NULL)
+    gst_video_overlay_rectangle_cache_remove (oldest, garbage);
+
+  gst_video_overlay_rectangle_cache_trim (variant, garbage);
+}
+
+/* takes ownership of @variant */
+static void
+gst_video_overlay_rectangle_cache_add (GstVideoOverlayRectangle * rectangle,
+    GstVideoOverlayRectangle * variant)
+{
+  GList *garbage = NULL;
+
+  g_mutex_lock (&cache_lock);
+  gst_video_overlay_rectangle_cache_insert (rectangle, variant, &garbage);
+  g_mutex_unlock (&cache_lock);
+
+  g_list_free_full (garbage, (GDestroyNotify) gst_video_overlay_rectangle_unref);
+}
+
+/* Pins @variant because its pixels are handed out, it then stays in the
+ * cache for as long as @rectangle is alive. There's only ever one variant
+ * per format, size and alpha type that gets handed out, as all lookups find
+ * the pinned one. Takes ownership of @variant */
+static void
+gst_video_overlay_rectangle_cache_pin (GstVideoOverlayRectangle * rectangle,
+    GstVideoOverlayRectangle * variant)
+{
+  GList *garbage = NULL;
+
+  g_mutex_lock (&cache_lock);
+  if (variant->cache_owner == NULL) {
+    /* evicted by another thread meanwhile, put it back */
+    variant->cache_pinned = TRUE;
+    gst_video_overlay_rectangle_cache_insert (rectangle, variant, &garbage);
+  } else {
+    variant->cache_pinned = TRUE;
+    garbage = g_list_prepend (garbage, variant);
+  }
+  gst_video_overlay_rectangle_cache_trim (NULL, &garbage);
+  g_mutex_unlock (&cache_lock);
+
+  g_list_free_full (garbage, (GDestroyNotify) gst_video_overlay_rectangle_unref);
+}
+
 static void
 gst_video_overlay_rectangle_free (GstMiniObject * mini_obj)
 {
@@ -639,15 +812,22 @@ gst_video_overlay_rectangle_free (GstMiniObject * mini_obj)
       GST_MINI_OBJECT_CAST (rect));
   gst_buffer_replace (&rect->pixels, NULL);
 
-  while (rect->scaled_rectangles != NULL) {
-    GstVideoOverlayRectangle *scaled_rect = rect->scaled_rectangles->data;
+  if (rect->scaled_rectangles != NULL) {
+    GList *garbage = NULL;
 
-    gst_video_overlay_rectangle_unref (scaled_rect);
+    g_mutex_lock (&cache_lock);
+    while (rect->scaled_rectangles != NULL)
+      gst_video_overlay_rectangle_cache_remove (rect->scaled_rectangles->data,
+          &garbage);
+    g_mutex_unlock (&cache_lock);
 
-    rect->scaled_rectangles =
-        g_list_delete_link (rect->scaled_rectangles, rect->scaled_rectangles);
+    g_list_free_full (garbage,
+        (GDestroyNotify) gst_video_overlay_rectangle_unref);
   }
 
+  if (rect->blend_chroma)
+    __gst_video_blend_chroma_free (rect->blend_chroma);
+
   g_free (rect->initial_alpha);
   g_mutex_clear (&rect->lock);
 
@@ -1174,8 +1354,9 @@ gst_video_overlay_rectangle_convert (GstVideoInfo * src, GstBuffer * src_buffer,
   gst_video_frame_unmap (&dest_frame);
 }
 
+/* returns a reference to the pixels */
 static GstBuffer *
-gst_video_overlay_rectangle_get_pixels_raw_internal (GstVideoOverlayRectangle *
+gst_video_overlay_rectangle_get_pixels_raw_full (GstVideoOverlayRectangle *
     rectangle, GstVideoOverlayFormatFlags flags, gboolean unscaled,
     GstVideoFormat wanted_format)
 {
@@ -1218,16 +1399,16 @@ gst_video_overlay_rectangle_get_pixels_raw_internal (GstVideoOverlayRectangle *
     if ((!apply_global_alpha
             || rectangle->applied_global_alpha == rectangle->global_alpha)
         && (!revert_global_alpha || rectangle->applied_global_alpha == 1.0)) {
-      return rectangle->pixels;
+      return gst_buffer_ref (rectangle->pixels);
     } else {
       /* only apply/revert global-alpha */
-      scaled_rect = rectangle;
+      scaled_rect = gst_video_overlay_rectangle_ref (rectangle);
       goto done;
     }
   }
 
   /* see if we've got one cached already */
-  GST_RECTANGLE_LOCK (rectangle);
+  g_mutex_lock (&cache_lock);
   for (l = rectangle->scaled_rectangles; l != NULL; l = l->next) {
     GstVideoOverlayRectangle *r = l->data;
 
@@ -1235,34 +1416,37 @@ gst_video_overlay_rectangle_get_pixels_raw_internal (GstVideoOverlayRectangle *
         GST_VIDEO_INFO_HEIGHT (&r->info) == wanted_height &&
         GST_VIDEO_INFO_FORMAT (&r->info) == wanted_format &&
         gst_video_overlay_rectangle_is_same_alpha_type (r->flags, flags)) {
-      /* we'll keep these rectangles around until finalize, so it's ok not
-       * to take our own ref here */
-      scaled_rect = r;
+      /* it might get evicted by another thread while we use it */
+      scaled_rect = gst_video_overlay_rectangle_ref (r);
+      gst_video_overlay_rectangle_cache_touch (r);
       break;
     }
   }
-  GST_RECTANGLE_UNLOCK (rectangle);
+  if (scaled_rect != NULL)
+    cache_hits++;
+  else
+    cache_misses++;
+  g_mutex_unlock (&cache_lock);
 
   if (scaled_rect != NULL)
     goto done;
 
   /* maybe have one in the right format though */
   if (format != wanted_format) {
-    GST_RECTANGLE_LOCK (rectangle);
+    g_mutex_lock (&cache_lock);
     for (l = rectangle->scaled_rectangles; l != NULL; l = l->next) {
       GstVideoOverlayRectangle *r = l->data;
 
       if (GST_VIDEO_INFO_FORMAT (&r->info) == wanted_format &&
           gst_video_overlay_rectangle_is_same_alpha_type (r->flags, flags)) {
-        /* we'll keep these rectangles around until finalize, so it's ok not
-         * to take our own ref here */
-        conv_rect = r;
+        conv_rect = gst_video_overlay_rectangle_ref (r);
+        gst_video_overlay_rectangle_cache_touch (r);
         break;
       }
     }
-    GST_RECTANGLE_UNLOCK (rectangle);
+    g_mutex_unlock (&cache_lock);
   } else {
-    conv_rect = rectangle;
+    conv_rect = gst_video_overlay_rectangle_ref (rectangle);
   }
 
   if (conv_rect == NULL) {
@@ -1275,14 +1459,12 @@ gst_video_overlay_rectangle_get_pixels_raw_internal (GstVideoOverlayRectangle *
     conv_rect = gst_video_overlay_rectangle_new_raw (buf,
         0, 0, width, height, rectangle->flags);
     if (rectangle->global_alpha != 1.0)
-      gst_video_overlay_rectangle_set_global_alpha (scaled_rect,
+      gst_video_overlay_rectangle_set_global_alpha (conv_rect,
           rectangle->global_alpha);
     gst_buffer_unref (buf);
     /* keep this converted one around as well in any case */
-    GST_RECTANGLE_LOCK (rectangle);
-    rectangle->scaled_rectangles =
-        g_list_prepend (rectangle->scaled_rectangles, conv_rect);
-    GST_RECTANGLE_UNLOCK (rectangle);
+    gst_video_overlay_rectangle_cache_add (rectangle,
+        gst_video_overlay_rectangle_ref (conv_rect));
   }
 
   /* now we continue from conv_rect */
@@ -1332,10 +1514,9 @@ gst_video_overlay_rectangle_get_pixels_raw_internal (GstVideoOverlayRectangle *
         conv_rect->global_alpha);
   gst_buffer_unref (buf);
 
-  GST_RECTANGLE_LOCK (rectangle);
-  rectangle->scaled_rectangles =
-      g_list_prepend (rectangle->scaled_rectangles, scaled_rect);
-  GST_RECTANGLE_UNLOCK (rectangle);
+  gst_video_overlay_rectangle_cache_add (rectangle,
+      gst_video_overlay_rectangle_ref (scaled_rect));
+  gst_video_overlay_rectangle_unref (conv_rect);
 
 done:
 
@@ -1344,14 +1525,39 @@ done:
       && scaled_rect->applied_global_alpha != rectangle->global_alpha) {
     gst_video_overlay_rectangle_apply_global_alpha (scaled_rect,
         rectangle->global_alpha);
-    gst_video_overlay_rectangle_set_global_alpha (scaled_rect,
-        rectangle->global_alpha);
+    /* not set_global_alpha(), we don't hold the only reference here */
+    scaled_rect->global_alpha = rectangle->global_alpha;
+    scaled_rect->flags |= GST_VIDEO_OVERLAY_FORMAT_FLAG_GLOBAL_ALPHA;
   } else if (revert_global_alpha && scaled_rect->applied_global_alpha != 1.0) {
     gst_video_overlay_rectangle_apply_global_alpha (scaled_rect, 1.0);
   }
   GST_RECTANGLE_UNLOCK (rectangle);
 
-  return scaled_rect->pixels;
+  buf = gst_buffer_ref (scaled_rect->pixels);
+
+  /* keep the pixels alive for callers that don't take a reference */
+  if (scaled_rect != rectangle)
+    gst_video_overlay_rectangle_cache_pin (rectangle, scaled_rect);
+  else
+    gst_video_overlay_rectangle_unref (scaled_rect);
+
+  return buf;
+}
+
+/* returns pixels that stay valid as long as @rectangle is alive */
+static GstBuffer *
+gst_video_overlay_rectangle_get_pixels_raw_internal (GstVideoOverlayRectangle *
+    rectangle, GstVideoOverlayFormatFlags flags, gboolean unscaled,
+    GstVideoFormat wanted_format)
+{
+  GstBuffer *buf;
+
+  buf = gst_video_overlay_rectangle_get_pixels_raw_full (rectangle, flags,
+      unscaled, wanted_format);
+  /* the rectangle or its pinned variant holds another reference */
+  gst_buffer_unref (buf);
+
+  return buf;
 }
 
 
@@ -1509,6 +1715,61 @@ gst_video_overlay_rectangle_get_pixels_unscaled_ayuv (GstVideoOverlayRectangle *
       flags, TRUE, GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_YUV);
 }
 
+/**
+ * gst_video_overlay_rectangle_set_cache_limit:
+ * @max_size: maximum size in bytes
+ *
+ * Sets how much memory all rectangles together may use to keep the
+ * converted and scaled pixel data returned by the
+ * gst_video_overlay_rectangle_get_pixels_*() functions around. When the limit
+ * is exceeded, the least recently used pixel data is dropped and will be
+ * recreated when requested again. Independently of the limit, each rectangle
+ * only keeps a few variants. The default limit is 64 MiB.
+ *
+ * Pixel data that was returned to the caller is never dropped, it stays valid
+ * as long as the rectangle is alive. The limit only applies to intermediate
+ * data, e.g. converted pixels that were only used to create scaled ones.
+ *
+ * Since: 1.18
+ */
+void
+gst_video_overlay_rectangle_set_cache_limit (gsize max_size)
+{
+  GList *garbage = NULL;
+
+  g_mutex_lock (&cache_lock);
+  cache_limit = max_size;
+  gst_video_overlay_rectangle_cache_trim (NULL, &garbage);
+  g_mutex_unlock (&cache_lock);
+
+  g_list_free_full (garbage, (GDestroyNotify) gst_video_overlay_rectangle_unref);
+}
+
+/**
+ * gst_video_overlay_rectangle_get_cache_stats:
+ * @hits: (out) (optional): number of requests served from the cache
+ * @misses: (out) (optional): number of requests that needed a conversion
+ * @size: (out) (optional): memory currently used by the cache, in bytes
+ *
+ * Retrieves statistics about the cache of converted and scaled pixel data
+ * shared by all rectangles, see gst_video_overlay_rectangle_set_cache_limit().
+ *
+ * Since: 1.18
+ */
+void
+gst_video_overlay_rectangle_get_cache_stats (guint64 * hits, guint64 * misses,
+    gsize * size)
+{
+  g_mutex_lock (&cache_lock);
+  if (hits)
+    *hits = cache_hits;
+  if (misses)
+    *misses = cache_misses;
+  if (size)
+    *size = cache_size;
+  g_mutex_unlock (&cache_lock);
+}
+
 /**
  * gst_video_overlay_rectangle_get_flags:
  * @rectangle: a #GstVideoOverlayRectangle
@@ -184,6 +184,14 @@ GST_VIDEO_API
 void                         gst_video_overlay_rectangle_set_global_alpha         (GstVideoOverlayRectangle  * rectangle,
                                                                                    gfloat                      global_alpha);
 
+GST_VIDEO_API
+void                         gst_video_overlay_rectangle_set_cache_limit          (gsize                       max_size);
+
+GST_VIDEO_API
+void                         gst_video_overlay_rectangle_get_cache_stats          (guint64                   * hits,
+                                                                                   guint64                   * misses,
+                                                                                   gsize                     * size);
+
 /**
  * GstVideoOverlayComposition:
  *
@@ -164,10 +164,6 @@ struct _GstDecodeBin
   GstDecodeChain *decode_chain; /* Top level decode chain */
   guint nbpads;                 /* unique identifier for source pads */
 
-  GMutex factories_lock;
-  guint32 factories_cookie;     /* Cookie from last time when factories was updated */
-  GList *factories;             /* factories we can use for selecting elements */
-
   GMutex subtitle_lock;         /* Protects changes to subtitles and encoding */
   GList *subtitles;             /* List of elements with subtitle-encoding,
                                  * protected by above mutex! */
@@ -1046,51 +1042,9 @@ gst_decode_bin_class_init (GstDecodeBinClass * klass)
   g_type_class_ref (GST_TYPE_DECODE_PAD);
 }
 
-/* Must be called with factories lock! */
-static void
-gst_decode_bin_update_factories_list (GstDecodeBin * dbin)
-{
-  guint cookie;
-  GList *factories, *tmp;
-
-  cookie = gst_registry_get_feature_list_cookie (gst_registry_get ());
-  if (!dbin->factories || dbin->factories_cookie != cookie) {
-    if (dbin->factories)
-      gst_plugin_feature_list_free (dbin->factories);
-    factories =
-        gst_element_factory_list_get_elements
-        (GST_ELEMENT_FACTORY_TYPE_DECODABLE, GST_RANK_MARGINAL);
-
-    if (dbin->force_sw_decoders) {
-      /* filter out Hardware class elements */
-      dbin->factories = NULL;
-      for (tmp = factories; tmp; tmp = g_list_next (tmp)) {
-        GstElementFactory *factory = GST_ELEMENT_FACTORY_CAST (tmp->data);
-        if (!gst_element_factory_list_is_type (factory,
-                GST_ELEMENT_FACTORY_TYPE_HARDWARE)) {
-          dbin->factories = g_list_prepend (dbin->factories, factory);
-        } else {
-          gst_object_unref (factory);
-        }
-      }
-      g_list_free (factories);
-    } else {
-      dbin->factories = factories;
-    }
-
-    dbin->factories =
-        g_list_sort (dbin->factories,
-        gst_playback_utils_compare_factories_func);
-    dbin->factories_cookie = cookie;
-  }
-}
-
 static void
 gst_decode_bin_init (GstDecodeBin * decode_bin)
 {
-  /* first filter out the interesting element factories */
-  g_mutex_init (&decode_bin->factories_lock);
-
   /* we create the typefind element only once */
   decode_bin->typefind = gst_element_factory_make ("typefind", "typefind");
   if (!decode_bin->typefind) {
@@ -1158,10 +1112,6 @@ gst_decode_bin_dispose (GObject * object)
 
   decode_bin = GST_DECODE_BIN (object);
 
-  if (decode_bin->factories)
-    gst_plugin_feature_list_free (decode_bin->factories);
-  decode_bin->factories = NULL;
-
   if (decode_bin->decode_chain)
     gst_decode_chain_free (decode_bin->decode_chain);
   decode_bin->decode_chain = NULL;
@@ -1193,7 +1143,6 @@ gst_decode_bin_finalize (GObject * object)
   g_mutex_clear (&decode_bin->subtitle_lock);
   g_mutex_clear (&decode_bin->buffering_lock);
   g_mutex_clear (&decode_bin->buffering_post_lock);
-  g_mutex_clear (&decode_bin->factories_lock);
   g_mutex_clear (&decode_bin->cleanup_lock);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
@@ -1428,12 +1377,7 @@ gst_decode_bin_autoplug_factories (GstElement * element, GstPad * pad,
   GST_DEBUG_OBJECT (element, "finding factories");
 
   /* return all compatible factories for caps */
-  g_mutex_lock (&dbin->factories_lock);
-  gst_decode_bin_update_factories_list (dbin);
-  list =
-      gst_element_factory_list_filter (dbin->factories, caps, GST_PAD_SINK,
-      gst_caps_is_fixed (caps));
-  g_mutex_unlock (&dbin->factories_lock);
+  list = gst_playback_utils_filter_factories (caps, dbin->force_sw_decoders);
 
   result = g_value_array_new (g_list_length (list));
   for (tmp = list; tmp; tmp = tmp->next) {
@@ -266,6 +266,7 @@ struct _GstDecodebin3
   /* Properties */
   GstCaps *caps;
   gboolean force_sw_decoders;
+  gboolean fast_start;
 };
 
 struct _GstDecodebin3Class
@@ -374,6 +375,7 @@ enum
   PROP_0,
   PROP_CAPS,
   PROP_FORCE_SW_DECODERS,
+  PROP_FAST_START,
 };
 
 /* signals */
@@ -426,6 +428,7 @@ G_DEFINE_TYPE (GstDecodebin3, gst_decodebin3, GST_TYPE_BIN);
 static GstStaticCaps default_raw_caps = GST_STATIC_CAPS (DEFAULT_RAW_CAPS);
 
 #define DEFAULT_FORCE_SW_DECODERS FALSE
+#define DEFAULT_FAST_START FALSE
 
 static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
     GST_PAD_SINK,
@@ -569,6 +572,21 @@ gst_decodebin3_class_init (GstDecodebin3Class * klass)
           DEFAULT_FORCE_SW_DECODERS,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstDecodeBin::fast-start:
+   *
+   * If set to %TRUE, the type of each input is cached per URI and
+   * typefinding is skipped when the same input is opened again. See the
+   * #GstParseBin:fast-start property.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_klass, PROP_FAST_START,
+      g_param_spec_boolean ("fast-start", "Fast Start",
+          "Cache the type of the inputs per URI and skip typefinding when "
+          "opening the same input again", DEFAULT_FAST_START,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /* FIXME : ADD SIGNALS ! */
   /**
    * GstDecodebin3::select-stream
@@ -646,6 +664,7 @@ gst_decodebin3_init (GstDecodebin3 * dbin)
 
   dbin->caps = gst_static_caps_get (&default_raw_caps);
   dbin->force_sw_decoders = DEFAULT_FORCE_SW_DECODERS;
+  dbin->fast_start = DEFAULT_FAST_START;
 
   GST_OBJECT_FLAG_SET (dbin, GST_BIN_FLAG_STREAMS_AWARE);
 }
@@ -700,6 +719,9 @@ gst_decodebin3_set_property (GObject * object, guint prop_id,
     case PROP_FORCE_SW_DECODERS:
       dbin->force_sw_decoders = g_value_get_boolean (value);
       break;
+    case PROP_FAST_START:
+      dbin->fast_start = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -722,6 +744,9 @@ gst_decodebin3_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_FORCE_SW_DECODERS:
       g_value_set_boolean (value, dbin->force_sw_decoders);
       break;
+    case PROP_FAST_START:
+      g_value_set_boolean (value, dbin->fast_start);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -819,6 +844,8 @@ ensure_input_parsebin (GstDecodebin3 * dbin, DecodebinInput * input)
         (GCallback) parsebin_autoplug_continue_cb, dbin);
   }
 
+  g_object_set (input->parsebin, "fast-start", dbin->fast_start, NULL);
+
   if (GST_OBJECT_PARENT (GST_OBJECT (input->parsebin)) != GST_OBJECT (dbin)) {
     gst_bin_add (GST_BIN (dbin), input->parsebin);
     set_state = TRUE;
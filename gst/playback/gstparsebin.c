@@ -100,6 +100,7 @@
 #include <gst/gst-i18n-plugin.h>
 
 #include <string.h>
+#include <glib/gstdio.h>
 #include <gst/gst.h>
 #include <gst/pbutils/pbutils.h>
 
@@ -159,10 +160,6 @@ struct _GstParseBin
   GstParseChain *parse_chain;   /* Top level parse chain */
   guint nbpads;                 /* unique identifier for source pads */
 
-  GMutex factories_lock;
-  guint32 factories_cookie;     /* Cookie from last time when factories was updated */
-  GList *factories;             /* factories we can use for selecting elements */
-
   GMutex subtitle_lock;         /* Protects changes to subtitles and encoding */
   GList *subtitles;             /* List of elements with subtitle-encoding,
                                  * protected by above mutex! */
@@ -185,6 +182,15 @@ struct _GstParseBin
                                  * before stopping the element.
                                  * Protected by the object lock */
 
+  GstCaps *sink_caps;           /* caps set by the application, typefind's
+                                 * force-caps can be a cached type instead.
+                                 * Protected by the object lock */
+
+  gboolean fast_start;          /* cache typefind results per URI */
+  /* Protected by the object lock */
+  gchar *fast_start_key;        /* cache key of the current input */
+  GstCaps *fast_start_type;     /* type of the current input */
+  gboolean fast_start_hit;      /* if the type came from the cache */
 };
 
 struct _GstParseBinClass
@@ -232,6 +238,7 @@ enum
 /* by default we use the automatic values above */
 #define DEFAULT_EXPOSE_ALL_STREAMS  TRUE
 #define DEFAULT_CONNECTION_SPEED    0
+#define DEFAULT_FAST_START          FALSE
 
 /* Properties */
 enum
@@ -240,7 +247,8 @@ enum
   PROP_SUBTITLE_ENCODING,
   PROP_SINK_CAPS,
   PROP_EXPOSE_ALL_STREAMS,
-  PROP_CONNECTION_SPEED
+  PROP_CONNECTION_SPEED,
+  PROP_FAST_START
 };
 
 static GstBinClass *parent_class;
@@ -834,6 +842,28 @@ gst_parse_bin_class_init (GstParseBinClass * klass)
           0, G_MAXUINT64 / 1000, DEFAULT_CONNECTION_SPEED,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstParseBin:fast-start:
+   *
+   * Remember the type of the input and the streams that were exposed for it,
+   * keyed by the URI of the input, its size and its modification time. When
+   * the same input is opened again, typefinding is skipped and the parsers
+   * and demuxers are plugged right away. The cached type is dropped if the
+   * exposed streams differ or an error occurs before they are exposed.
+   *
+   * Only local files are cached, other inputs are always typefound as
+   * their content can change without their URI or size changing. The cache
+   * is shared by all instances in the process. The cached type doesn't show
+   * up in #GstParseBin:sink-caps, and caps set there take precedence.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_klass, PROP_FAST_START,
+      g_param_spec_boolean ("fast-start", "Fast Start",
+          "Cache the type of the input per URI and skip typefinding when "
+          "opening the same input again", DEFAULT_FAST_START,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   klass->autoplug_continue =
       GST_DEBUG_FUNCPTR (gst_parse_bin_autoplug_continue);
   klass->autoplug_factories =
@@ -862,31 +892,9 @@ gst_parse_bin_class_init (GstParseBinClass * klass)
   g_type_class_ref (GST_TYPE_PARSE_PAD);
 }
 
-static void
-gst_parse_bin_update_factories_list (GstParseBin * parsebin)
-{
-  guint cookie;
-
-  cookie = gst_registry_get_feature_list_cookie (gst_registry_get ());
-  if (!parsebin->factories || parsebin->factories_cookie != cookie) {
-    if (parsebin->factories)
-      gst_plugin_feature_list_free (parsebin->factories);
-    parsebin->factories =
-        gst_element_factory_list_get_elements
-        (GST_ELEMENT_FACTORY_TYPE_DECODABLE, GST_RANK_MARGINAL);
-    parsebin->factories =
-        g_list_sort (parsebin->factories,
-        gst_playback_utils_compare_factories_func);
-    parsebin->factories_cookie = cookie;
-  }
-}
-
 static void
 gst_parse_bin_init (GstParseBin * parse_bin)
 {
-  /* first filter out the interesting element factories */
-  g_mutex_init (&parse_bin->factories_lock);
-
   /* we create the typefind element only once */
   parse_bin->typefind = gst_element_factory_make ("typefind", "typefind");
   if (!parse_bin->typefind) {
@@ -931,6 +939,7 @@ gst_parse_bin_init (GstParseBin * parse_bin)
 
   parse_bin->expose_allstreams = DEFAULT_EXPOSE_ALL_STREAMS;
   parse_bin->connection_speed = DEFAULT_CONNECTION_SPEED;
+  parse_bin->fast_start = DEFAULT_FAST_START;
 
   g_mutex_init (&parse_bin->cleanup_lock);
   parse_bin->cleanup_thread = NULL;
@@ -945,10 +954,6 @@ gst_parse_bin_dispose (GObject * object)
 
   parse_bin = GST_PARSE_BIN (object);
 
-  if (parse_bin->factories)
-    gst_plugin_feature_list_free (parse_bin->factories);
-  parse_bin->factories = NULL;
-
   if (parse_bin->parse_chain)
     gst_parse_chain_free (parse_bin->parse_chain);
   parse_bin->parse_chain = NULL;
@@ -959,6 +964,11 @@ gst_parse_bin_dispose (GObject * object)
   g_list_free (parse_bin->subtitles);
   parse_bin->subtitles = NULL;
 
+  gst_caps_replace (&parse_bin->sink_caps, NULL);
+  g_free (parse_bin->fast_start_key);
+  parse_bin->fast_start_key = NULL;
+  gst_caps_replace (&parse_bin->fast_start_type, NULL);
+
   G_OBJECT_CLASS (parent_class)->dispose (object);
 }
 
@@ -972,7 +982,6 @@ gst_parse_bin_finalize (GObject * object)
   g_mutex_clear (&parse_bin->expose_lock);
   g_mutex_clear (&parse_bin->dyn_lock);
   g_mutex_clear (&parse_bin->subtitle_lock);
-  g_mutex_clear (&parse_bin->factories_lock);
   g_mutex_clear (&parse_bin->cleanup_lock);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
@@ -983,6 +992,10 @@ gst_parse_bin_set_sink_caps (GstParseBin * parsebin, GstCaps * caps)
 {
   GST_DEBUG_OBJECT (parsebin, "Setting new caps: %" GST_PTR_FORMAT, caps);
 
+  GST_OBJECT_LOCK (parsebin);
+  gst_caps_replace (&parsebin->sink_caps, caps);
+  GST_OBJECT_UNLOCK (parsebin);
+
   g_object_set (parsebin->typefind, "force-caps", caps, NULL);
 }
 
@@ -993,11 +1006,281 @@ gst_parse_bin_get_sink_caps (GstParseBin * parsebin)
 
   GST_DEBUG_OBJECT (parsebin, "Getting currently set caps");
 
-  g_object_get (parsebin->typefind, "force-caps", &caps, NULL);
+  GST_OBJECT_LOCK (parsebin);
+  caps = parsebin->sink_caps ? gst_caps_ref (parsebin->sink_caps) : NULL;
+  GST_OBJECT_UNLOCK (parsebin);
 
   return caps;
 }
 
+/* Fast-start cache: the type typefind found for a local file and the caps
+ * of the streams that were exposed for it, keyed by URI, size and
+ * modification time. Shared by all instances, the least recently used entries are dropped
+ * once there are more than FAST_START_CACHE_SIZE. */
+#define FAST_START_CACHE_SIZE 256
+
+typedef struct
+{
+  gchar *key;
+  GstCaps *type;
+  GstCaps *streams;
+} FastStartEntry;
+
+static GMutex fast_start_lock;
+static GHashTable *fast_start_cache;    /* key -> FastStartEntry */
+static GQueue fast_start_lru = G_QUEUE_INIT;    /* most recently used first */
+
+static void
+fast_start_entry_free (FastStartEntry * entry)
+{
+  g_free (entry->key);
+  gst_caps_unref (entry->type);
+  gst_caps_unref (entry->streams);
+  g_slice_free (FastStartEntry, entry);
+}
+
+/* call with fast_start_lock */
+static void
+fast_start_cache_remove_entry (FastStartEntry * entry)
+{
+  g_queue_remove (&fast_start_lru, entry);
+  g_hash_table_remove (fast_start_cache, entry->key);
+  fast_start_entry_free (entry);
+}
+
+static GstCaps *
+fast_start_cache_lookup (const gchar * key)
+{
+  FastStartEntry *entry = NULL;
+  GstCaps *type = NULL;
+
+  g_mutex_lock (&fast_start_lock);
+  if (fast_start_cache)
+    entry = g_hash_table_lookup (fast_start_cache, key);
+  if (entry) {
+    g_queue_remove (&fast_start_lru, entry);
+    g_queue_push_head (&fast_start_lru, entry);
+    type = gst_caps_ref (entry->type);
+  }
+  g_mutex_unlock (&fast_start_lock);
+
+  return type;
+}
+
+/* Stores @type and @streams for @key, or checks them against the cached
+ * ones if @hit. Returns FALSE if a cached entry turned out to be wrong. */
+static gboolean
+fast_start_cache_update (const gchar * key, GstCaps * type, GstCaps * streams,
+    gboolean hit)
+{
+  FastStartEntry *entry;
+  gboolean valid = TRUE;
+
+  g_mutex_lock (&fast_start_lock);
+  if (fast_start_cache == NULL)
+    fast_start_cache = g_hash_table_new (g_str_hash, g_str_equal);
+
+  entry = g_hash_table_lookup (fast_start_cache, key);
+  if (entry && hit) {
+    valid = gst_caps_is_equal (entry->streams, streams);
+    if (!valid)
+      fast_start_cache_remove_entry (entry);
+  } else if (!hit) {
+    if (entry)
+      fast_start_cache_remove_entry (entry);
+
+    entry = g_slice_new (FastStartEntry);
+    entry->key = g_strdup (key);
+    entry->type = gst_caps_ref (type);
+    entry->streams = gst_caps_ref (streams);
+    g_hash_table_insert (fast_start_cache, entry->key, entry);
+    g_queue_push_head (&fast_start_lru, entry);
+
+    while (fast_start_lru.length > FAST_START_CACHE_SIZE)
+      fast_start_cache_remove_entry (g_queue_peek_tail (&fast_start_lru));
+  }
+  g_mutex_unlock (&fast_start_lock);
+
+  return valid;
+}
+
+static void
+fast_start_cache_remove (const gchar * key)
+{
+  FastStartEntry *entry = NULL;
+
+  g_mutex_lock (&fast_start_lock);
+  if (fast_start_cache)
+    entry = g_hash_table_lookup (fast_start_cache, key);
+  if (entry)
+    fast_start_cache_remove_entry (entry);
+  g_mutex_unlock (&fast_start_lock);
+}
+
+/* Returns the cache key for the current input, or NULL if it's not a local
+ * file. Other inputs can change without their URI or size changing, so the
+ * cached type could be wrong for them. */
+static gchar *
+gst_parse_bin_fast_start_key (GstParseBin * parsebin)
+{
+  GstPad *sinkpad;
+  GstQuery *query;
+  gchar *uri = NULL, *filename = NULL, *key = NULL;
+  GStatBuf st;
+
+  sinkpad = gst_element_get_static_pad (GST_ELEMENT_CAST (parsebin), "sink");
+
+  query = gst_query_new_uri ();
+  if (gst_pad_peer_query (sinkpad, query))
+    gst_query_parse_uri (query, &uri);
+  gst_query_unref (query);
+  gst_object_unref (sinkpad);
+
+  if (uri == NULL || !gst_uri_has_protocol (uri, "file"))
+    goto done;
+
+  /* works before upstream is started, and catches files being replaced */
+  filename = g_filename_from_uri (uri, NULL, NULL);
+  if (filename && g_stat (filename, &st) == 0 && st.st_size > 0)
+    key = g_strdup_printf ("%s %" G_GINT64_FORMAT " %" G_GINT64_FORMAT, uri,
+        (gint64) st.st_size, (gint64) st.st_mtime);
+
+done:
+  g_free (filename);
+  g_free (uri);
+
+  return key;
+}
+
+/* Looks up the current input in the cache and makes typefind use the cached
+ * type on a hit */
+static void
+gst_parse_bin_fast_start_lookup (GstParseBin * parsebin)
+{
+  GstCaps *type;
+  gchar *key;
+
+  key = gst_parse_bin_fast_start_key (parsebin);
+  if (key == NULL)
+    return;
+
+  type = fast_start_cache_lookup (key);
+
+  GST_OBJECT_LOCK (parsebin);
+  g_free (parsebin->fast_start_key);
+  parsebin->fast_start_key = key;
+  parsebin->fast_start_hit = (type != NULL);
+  GST_OBJECT_UNLOCK (parsebin);
+
+  if (type) {
+    GST_INFO_OBJECT (parsebin, "Using cached type %" GST_PTR_FORMAT " for %s",
+        type, key);
+    g_object_set (parsebin->typefind, "force-caps", type, NULL);
+    gst_caps_unref (type);
+  } else {
+    GST_DEBUG_OBJECT (parsebin, "No cached type for %s", key);
+  }
+}
+
+static void
+gst_parse_bin_fast_start_begin (GstParseBin * parsebin)
+{
+  GstCaps *caps;
+
+  if (!parsebin->fast_start)
+    return;
+
+  /* the application told us what the input is */
+  caps = gst_parse_bin_get_sink_caps (parsebin);
+  if (caps) {
+    gst_caps_unref (caps);
+    return;
+  }
+
+  gst_parse_bin_fast_start_lookup (parsebin);
+}
+
+static void
+gst_parse_bin_fast_start_end (GstParseBin * parsebin)
+{
+  GstCaps *caps;
+  gboolean hit;
+
+  GST_OBJECT_LOCK (parsebin);
+  hit = parsebin->fast_start_hit;
+  parsebin->fast_start_hit = FALSE;
+  g_free (parsebin->fast_start_key);
+  parsebin->fast_start_key = NULL;
+  gst_caps_replace (&parsebin->fast_start_type, NULL);
+  GST_OBJECT_UNLOCK (parsebin);
+
+  /* the cached type only applies to this input, go back to what the
+   * application set, possibly while we were running */
+  if (hit) {
+    caps = gst_parse_bin_get_sink_caps (parsebin);
+    g_object_set (parsebin->typefind, "force-caps", caps, NULL);
+    if (caps)
+      gst_caps_unref (caps);
+  }
+}
+
+/* Called when the streams are exposed for the first time, stores the type
+ * and the streams in the cache or validates the cached ones */
+static void
+gst_parse_bin_fast_start_update (GstParseBin * parsebin, GList * endpads)
+{
+  GstCaps *type, *streams;
+  gboolean hit;
+  gchar *key;
+  GList *tmp;
+
+  GST_OBJECT_LOCK (parsebin);
+  key = parsebin->fast_start_key;
+  parsebin->fast_start_key = NULL;
+  type = parsebin->fast_start_type;
+  parsebin->fast_start_type = NULL;
+  hit = parsebin->fast_start_hit;
+  GST_OBJECT_UNLOCK (parsebin);
+
+  if (key == NULL || type == NULL)
+    goto done;
+
+  streams = gst_caps_new_empty ();
+  for (tmp = endpads; tmp; tmp = tmp->next)
+    gst_caps_append (streams, get_pad_caps (GST_PAD_CAST (tmp->data)));
+
+  if (!fast_start_cache_update (key, type, streams, hit)) {
+    GST_WARNING_OBJECT (parsebin, "Cached type for %s was wrong, got streams "
+        "%" GST_PTR_FORMAT, key, streams);
+  }
+  gst_caps_unref (streams);
+
+done:
+  g_free (key);
+  if (type)
+    gst_caps_unref (type);
+}
+
+/* An error before the streams got exposed, don't trust the cached type */
+static void
+gst_parse_bin_fast_start_error (GstParseBin * parsebin)
+{
+  gchar *key = NULL;
+
+  GST_OBJECT_LOCK (parsebin);
+  if (parsebin->fast_start_hit) {
+    key = parsebin->fast_start_key;
+    parsebin->fast_start_key = NULL;
+  }
+  GST_OBJECT_UNLOCK (parsebin);
+
+  if (key) {
+    GST_WARNING_OBJECT (parsebin, "Error with cached type, dropping %s", key);
+    fast_start_cache_remove (key);
+    g_free (key);
+  }
+}
+
 static void
 gst_parse_bin_set_subs_encoding (GstParseBin * parsebin, const gchar * encoding)
 {
@@ -1055,6 +1338,9 @@ gst_parse_bin_set_property (GObject * object, guint prop_id,
       parsebin->connection_speed = g_value_get_uint64 (value) * 1000;
       GST_OBJECT_UNLOCK (parsebin);
       break;
+    case PROP_FAST_START:
+      parsebin->fast_start = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1083,6 +1369,9 @@ gst_parse_bin_get_property (GObject * object, guint prop_id,
       g_value_set_uint64 (value, parsebin->connection_speed / 1000);
       GST_OBJECT_UNLOCK (parsebin);
       break;
+    case PROP_FAST_START:
+      g_value_set_boolean (value, parsebin->fast_start);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1123,12 +1412,7 @@ gst_parse_bin_autoplug_factories (GstElement * element, GstPad * pad,
   GST_DEBUG_OBJECT (element, "finding factories");
 
   /* return all compatible factories for caps */
-  g_mutex_lock (&parsebin->factories_lock);
-  gst_parse_bin_update_factories_list (parsebin);
-  list =
-      gst_element_factory_list_filter (parsebin->factories, caps, GST_PAD_SINK,
-      gst_caps_is_fixed (caps));
-  g_mutex_unlock (&parsebin->factories_lock);
+  list = gst_playback_utils_filter_factories (caps, FALSE);
 
   result = g_value_array_new (g_list_length (list));
   for (tmp = list; tmp; tmp = tmp->next) {
@@ -2387,6 +2671,11 @@ type_found (GstElement * typefind, guint probability,
 
   parse_bin->have_type = TRUE;
 
+  GST_OBJECT_LOCK (parse_bin);
+  if (parse_bin->fast_start_key)
+    gst_caps_replace (&parse_bin->fast_start_type, caps);
+  GST_OBJECT_UNLOCK (parse_bin);
+
   pad = gst_element_get_static_pad (typefind, "src");
   sink_pad = gst_element_get_static_pad (typefind, "sink");
 
@@ -3556,6 +3845,8 @@ retry:
   /* re-order pads : video, then audio, then others */
   endpads = g_list_sort (endpads, (GCompareFunc) sort_end_pads);
 
+  gst_parse_bin_fast_start_update (parsebin, endpads);
+
   /* Don't expose if we're currently shutting down */
   DYN_LOCK (parsebin);
   if (G_UNLIKELY (parsebin->shutdown)) {
@@ -4303,6 +4594,8 @@ gst_parse_bin_change_state (GstElement * element, GstStateChange transition)
       parsebin->have_type_id =
           g_signal_connect (parsebin->typefind, "have-type",
           G_CALLBACK (type_found), parsebin);
+
+      gst_parse_bin_fast_start_begin (parsebin);
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       if (parsebin->have_type_id)
@@ -4314,6 +4607,7 @@ gst_parse_bin_change_state (GstElement * element, GstStateChange transition)
       parsebin->shutdown = TRUE;
       unblock_pads (parsebin);
       DYN_UNLOCK (parsebin);
+      gst_parse_bin_fast_start_end (parsebin);
     default:
       break;
   }
@@ -4389,6 +4683,9 @@ gst_parse_bin_handle_message (GstBin * bin, GstMessage * msg)
               g_list_prepend (parsebin->filtered_errors, gst_message_ref (msg));
         GST_OBJECT_UNLOCK (parsebin);
       }
+
+      if (!drop)
+        gst_parse_bin_fast_start_error (parsebin);
       break;
     }
     default:
@@ -162,3 +162,198 @@ gst_playback_utils_compare_factories_func (gconstpointer p1, gconstpointer p2)
    * and then by factory name */
   return gst_plugin_feature_rank_compare_func (p1, p2);
 }
+
+/* Factory cache: the decodable factories sorted for autoplugging, and the
+ * result of filtering them with the caps of the pads that were autoplugged
+ * so far. Shared by all decodebin and parsebin instances in the process so
+ * that starting many of them doesn't filter the registry over and over
+ * again. Everything is thrown away when the registry changes or when the
+ * rank of one of the factories was changed. */
+
+#define FACTORY_CACHE_SIZE 256
+
+typedef struct
+{
+  GstCaps *caps;
+  gboolean force_sw_decoders;
+  GList *factories;             /* filtered factories, with a ref each */
+  GList link;                   /* in factory_cache_lru */
+} FactoryCacheEntry;
+
+static GMutex factory_cache_lock;
+static gboolean factory_cache_built;
+static guint32 factory_cache_cookie;
+static guint factory_cache_generation;  /* bumped on every rebuild */
+static GList *factory_cache_decodable; /* all decodable factories */
+static guint *factory_cache_ranks;      /* their ranks when building */
+static GList *factory_cache_all;        /* those of rank >= marginal, sorted */
+static GList *factory_cache_sw;         /* the same without hardware ones */
+static GHashTable *factory_cache;       /* FactoryCacheEntry set */
+static GQueue factory_cache_lru = G_QUEUE_INIT; /* most recently used first */
+
+static guint
+factory_cache_entry_hash (gconstpointer key)
+{
+  const FactoryCacheEntry *entry = key;
+  guint i, n = gst_caps_get_size (entry->caps);
+  guint hash = entry->force_sw_decoders;
+
+  for (i = 0; i < n; i++) {
+    hash = hash * 31 +
+        gst_structure_get_name_id (gst_caps_get_structure (entry->caps, i));
+  }
+
+  return hash;
+}
+
+static gboolean
+factory_cache_entry_equal (gconstpointer a, gconstpointer b)
+{
+  const FactoryCacheEntry *entry_a = a, *entry_b = b;
+
+  return entry_a->force_sw_decoders == entry_b->force_sw_decoders &&
+      gst_caps_is_strictly_equal (entry_a->caps, entry_b->caps);
+}
+
+static void
+factory_cache_entry_free (FactoryCacheEntry * entry)
+{
+  gst_caps_unref (entry->caps);
+  gst_plugin_feature_list_free (entry->factories);
+  g_slice_free (FactoryCacheEntry, entry);
+}
+
+/* call with factory_cache_lock */
+static gboolean
+factory_cache_is_valid (void)
+{
+  GList *tmp;
+  guint i;
+
+  if (!factory_cache_built || factory_cache_cookie !=
+      gst_registry_get_feature_list_cookie (gst_registry_get ()))
+    return FALSE;
+
+  /* including the factories below marginal rank, so raising the rank of one
+   * that isn't listed yet is noticed too */
+  for (tmp = factory_cache_decodable, i = 0; tmp; tmp = tmp->next, i++) {
+    if (gst_plugin_feature_get_rank (tmp->data) != factory_cache_ranks[i])
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/* call with factory_cache_lock */
+static void
+factory_cache_update (void)
+{
+  GList *tmp;
+  guint32 cookie;
+  guint i;
+
+  if (factory_cache_is_valid ())
+    return;
+
+  cookie = gst_registry_get_feature_list_cookie (gst_registry_get ());
+
+  if (factory_cache == NULL) {
+    factory_cache = g_hash_table_new_full (factory_cache_entry_hash,
+        factory_cache_entry_equal, NULL,
+        (GDestroyNotify) factory_cache_entry_free);
+  }
+  g_queue_init (&factory_cache_lru);
+  g_hash_table_remove_all (factory_cache);
+
+  g_list_free (factory_cache_sw);
+  gst_plugin_feature_list_free (factory_cache_all);
+  gst_plugin_feature_list_free (factory_cache_decodable);
+
+  factory_cache_decodable =
+      gst_element_factory_list_get_elements (GST_ELEMENT_FACTORY_TYPE_DECODABLE,
+      GST_RANK_NONE);
+
+  g_free (factory_cache_ranks);
+  factory_cache_ranks =
+      g_new (guint, g_list_length (factory_cache_decodable));
+  factory_cache_all = NULL;
+  for (tmp = factory_cache_decodable, i = 0; tmp; tmp = tmp->next, i++) {
+    factory_cache_ranks[i] = gst_plugin_feature_get_rank (tmp->data);
+    if (factory_cache_ranks[i] >= GST_RANK_MARGINAL)
+      factory_cache_all =
+          g_list_prepend (factory_cache_all, gst_object_ref (tmp->data));
+  }
+  factory_cache_all = g_list_sort (factory_cache_all,
+      gst_playback_utils_compare_factories_func);
+
+  /* filter out Hardware class elements */
+  factory_cache_sw = NULL;
+  for (tmp = factory_cache_all; tmp; tmp = tmp->next) {
+    if (!gst_element_factory_list_is_type (tmp->data,
+            GST_ELEMENT_FACTORY_TYPE_HARDWARE))
+      factory_cache_sw = g_list_prepend (factory_cache_sw, tmp->data);
+  }
+  factory_cache_sw = g_list_reverse (factory_cache_sw);
+
+  factory_cache_cookie = cookie;
+  factory_cache_built = TRUE;
+  factory_cache_generation++;
+}
+
+/* Returns the decodable factories that can handle @caps, parsers first and
+ * then sorted by rank, leaving out hardware elements if @force_sw_decoders.
+ * Free with gst_plugin_feature_list_free() */
+GList *
+gst_playback_utils_filter_factories (GstCaps * caps,
+    gboolean force_sw_decoders)
+{
+  FactoryCacheEntry key = { caps, force_sw_decoders, };
+  FactoryCacheEntry *entry;
+  GList *factories, *result;
+  guint generation;
+
+  g_mutex_lock (&factory_cache_lock);
+  factory_cache_update ();
+
+  entry = g_hash_table_lookup (factory_cache, &key);
+  if (entry) {
+    g_queue_unlink (&factory_cache_lru, &entry->link);
+    g_queue_push_head_link (&factory_cache_lru, &entry->link);
+    result = gst_plugin_feature_list_copy (entry->factories);
+    g_mutex_unlock (&factory_cache_lock);
+    return result;
+  }
+
+  /* filter without holding the lock, so other instances can go ahead */
+  factories = gst_plugin_feature_list_copy (force_sw_decoders ?
+      factory_cache_sw : factory_cache_all);
+  generation = factory_cache_generation;
+  g_mutex_unlock (&factory_cache_lock);
+
+  result = gst_element_factory_list_filter (factories, caps, GST_PAD_SINK,
+      gst_caps_is_fixed (caps));
+  gst_plugin_feature_list_free (factories);
+
+  g_mutex_lock (&factory_cache_lock);
+  /* another thread may have added the same caps meanwhile */
+  if (factory_cache_generation == generation
+      && !g_hash_table_contains (factory_cache, &key)) {
+    entry = g_slice_new (FactoryCacheEntry);
+    entry->caps = gst_caps_ref (caps);
+    entry->force_sw_decoders = force_sw_decoders;
+    entry->factories = gst_plugin_feature_list_copy (result);
+    entry->link.data = entry;
+    entry->link.prev = entry->link.next = NULL;
+    g_hash_table_add (factory_cache, entry);
+    g_queue_push_head_link (&factory_cache_lru, &entry->link);
+
+    while (factory_cache_lru.length > FACTORY_CACHE_SIZE) {
+      GList *link = g_queue_pop_tail_link (&factory_cache_lru);
+
+      g_hash_table_remove (factory_cache, link->data);
+    }
+  }
+  g_mutex_unlock (&factory_cache_lock);
+
+  return result;
+}
@@ -36,6 +36,10 @@ gst_playback_utils_get_n_common_capsfeatures (GstElementFactory * fact1,
 G_GNUC_INTERNAL
 gint
 gst_playback_utils_compare_factories_func (gconstpointer p1, gconstpointer p2);
+G_GNUC_INTERNAL
+GList *
+gst_playback_utils_filter_factories (GstCaps * caps,
+                                     gboolean force_sw_decoders);
 G_END_DECLS
 
 #endif /* __GST_PLAYBACK_UTILS_H__ */
@@ -46,6 +46,243 @@
 GST_DEBUG_CATEGORY_STATIC (type_find_debug);
 #define GST_CAT_DEFAULT type_find_debug
 
+/* ScanWindow: the start of the stream, with the offsets of the 0x000001
+ * start codes and of the 0xff bytes (that frame sync words start with) in it.
+ * The core runs all typefinders on the same data one after the other, so
+ * rather than each scanner walking the same kilobytes byte by byte, the
+ * window is indexed once per typefind run and shared. It starts small and
+ * only grows when a scanner gets past its end, and never beyond the length
+ * that scanner probes, so it doesn't pull in more data than the scanners
+ * would read by themselves. The indices are built with memchr(), which is
+ * vectorised in any decent libc. */
+
+#define SCAN_WINDOW_MIN_SIZE 4096
+#define SCAN_WINDOW_MAX_SIZE (128 * 1024)
+/* beyond this many positions the rest of the window is left unindexed and
+ * scanned the old way, there's no point in indexing a buffer of zeroes */
+#define SCAN_WINDOW_MAX_POSITIONS (16 * 1024)
+/* bytes compared every SCAN_WINDOW_MIN_SIZE bytes beyond the first
+ * SCAN_WINDOW_MIN_SIZE to check that the window is still valid */
+#define SCAN_WINDOW_SAMPLE_SIZE 64
+
+typedef struct
+{
+  /* the typefind run the window was built for */
+  GstTypeFind *tf;
+  gpointer tf_data;
+  guint64 length;
+
+  guint8 *data;
+  guint size;
+
+  /* offsets of all start codes below start_codes_end, sorted */
+  GArray *start_codes;
+  guint start_codes_end;
+  gboolean start_codes_full;
+  /* offsets of all 0xff bytes below syncs_end, sorted */
+  GArray *syncs;
+  guint syncs_end;
+  gboolean syncs_full;
+} ScanWindow;
+
+static void
+scan_window_free (ScanWindow * w)
+{
+  g_free (w->data);
+  g_array_free (w->start_codes, TRUE);
+  g_array_free (w->syncs, TRUE);
+  g_slice_free (ScanWindow, w);
+}
+
+static GPrivate scan_window_key =
+G_PRIVATE_INIT ((GDestroyNotify) scan_window_free);
+
+/* indexes the data between the end of the indices and the end of the
+ * window */
+static void
+scan_window_index (ScanWindow * w)
+{
+  const guint8 *data = w->data;
+  const guint8 *end = w->data + w->size;
+  const guint8 *p;
+  guint32 pos;
+
+  if (!w->start_codes_full) {
+    /* a start code can't begin in the last two bytes */
+    p = data + w->start_codes_end + 2;
+    while (p < end && (p = memchr (p, 0x01, end - p)) != NULL) {
+      if (p[-1] == 0x00 && p[-2] == 0x00) {
+        pos = p - 2 - data;
+        if (w->start_codes->len == SCAN_WINDOW_MAX_POSITIONS) {
+          w->start_codes_full = TRUE;
+          w->start_codes_end = pos;
+          break;
+        }
+        g_array_append_val (w->start_codes, pos);
+      }
+      p++;
+    }
+    if (!w->start_codes_full)
+      w->start_codes_end = MAX (w->size, 2) - 2;
+  }
+
+  if (!w->syncs_full) {
+    p = data + w->syncs_end;
+    while (p < end && (p = memchr (p, 0xff, end - p)) != NULL) {
+      pos = p - data;
+      if (w->syncs->len == SCAN_WINDOW_MAX_POSITIONS) {
+        w->syncs_full = TRUE;
+        w->syncs_end = pos;
+        break;
+      }
+      g_array_append_val (w->syncs, pos);
+      p++;
+    }
+    if (!w->syncs_full)
+      w->syncs_end = w->size;
+  }
+}
+
+/* grows the window to @size bytes, returns FALSE if it didn't grow */
+static gboolean
+scan_window_grow (GstTypeFind * tf, ScanWindow * w, guint size)
+{
+  const guint8 *data;
+
+  size = MIN (size, SCAN_WINDOW_MAX_SIZE);
+  if (w->length > 0 && w->length < size)
+    size = w->length;
+
+  if (size <= w->size)
+    return FALSE;
+
+  data = gst_type_find_peek (tf, 0, size);
+  if (data == NULL)
+    return FALSE;
+
+  /* the data already in the window doesn't change during a typefind run */
+  w->data = g_realloc (w->data, size);
+  memcpy (w->data + w->size, data + w->size, size - w->size);
+  w->size = size;
+  scan_window_index (w);
+
+  GST_LOG ("indexed %u bytes: %u start codes, %u sync candidates", size,
+      w->start_codes->len, w->syncs->len);
+
+  return TRUE;
+}
+
+/* Whether @w was built in the current typefind run. The GstTypeFind and its
+ * data identify the run, but the caller may put them on the stack, so the
+ * next run can get the same pointers. To catch that, the first
+ * SCAN_WINDOW_MIN_SIZE bytes, which every scanner reads anyway, are compared
+ * and the rest of the window is only sampled rather than compared in full
+ * every time a scanner asks for the window. */
+static gboolean
+scan_window_is_current (ScanWindow * w, GstTypeFind * tf, guint64 length)
+{
+  const guint8 *data;
+  guint offset, head_size;
+
+  if (w->size == 0 || w->tf != tf || w->tf_data != tf->data
+      || w->length != length)
+    return FALSE;
+
+  head_size = MIN (w->size, SCAN_WINDOW_MIN_SIZE);
+  data = gst_type_find_peek (tf, 0, head_size);
+  if (data == NULL || memcmp (data, w->data, head_size) != 0)
+    return FALSE;
+
+  if (w->size == head_size)
+    return TRUE;
+
+  data = gst_type_find_peek (tf, 0, w->size);
+  if (data == NULL)
+    return FALSE;
+
+  for (offset = head_size; offset < w->size; offset += SCAN_WINDOW_MIN_SIZE) {
+    guint len = MIN (SCAN_WINDOW_SAMPLE_SIZE, w->size - offset);
+
+    if (memcmp (data + offset, w->data + offset, len) != 0)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/* returns the scan window for the current typefind run, or NULL if there's
+ * not enough data to make it worthwhile */
+static ScanWindow *
+scan_window_get (GstTypeFind * tf)
+{
+  ScanWindow *w = g_private_get (&scan_window_key);
+  guint64 length = gst_type_find_get_length (tf);
+
+  if (w != NULL && scan_window_is_current (w, tf, length))
+    return w;
+
+  if (w == NULL) {
+    w = g_slice_new0 (ScanWindow);
+    w->start_codes = g_array_new (FALSE, FALSE, sizeof (guint32));
+    w->syncs = g_array_new (FALSE, FALSE, sizeof (guint32));
+    g_private_set (&scan_window_key, w);
+  }
+
+  w->tf = tf;
+  w->tf_data = tf->data;
+  w->length = length;
+  w->size = 0;
+  g_array_set_size (w->start_codes, 0);
+  w->start_codes_end = 0;
+  w->start_codes_full = FALSE;
+  g_array_set_size (w->syncs, 0);
+  w->syncs_end = 0;
+  w->syncs_full = FALSE;
+
+  if (!scan_window_grow (tf, w, SCAN_WINDOW_MIN_SIZE))
+    return NULL;
+
+  return w;
+}
+
+/* returns the first start code (or 0xff byte if @syncs is set) at or after
+ * @offset. The window grows as needed, but not beyond @max_offset, the
+ * length the caller probes. Returns the end of the indexed data if there's
+ * none before it, or @offset if that's not indexed. */
+static guint64
+scan_window_next (GstTypeFind * tf, ScanWindow * w, gboolean syncs,
+    guint64 offset, guint64 max_offset)
+{
+  GArray *positions;
+  guint end, lo, hi;
+  gboolean full;
+
+  while (TRUE) {
+    positions = syncs ? w->syncs : w->start_codes;
+    end = syncs ? w->syncs_end : w->start_codes_end;
+    full = syncs ? w->syncs_full : w->start_codes_full;
+
+    if (offset < end) {
+      lo = 0;
+      hi = positions->len;
+      while (lo < hi) {
+        guint mid = lo + (hi - lo) / 2;
+
+        if (g_array_index (positions, guint32, mid) < offset)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      if (lo < positions->len)
+        return g_array_index (positions, guint32, lo);
+    }
+
+    if (full || end >= max_offset
+        || !scan_window_grow (tf, w, MIN (w->size * 2, max_offset)))
+      return MAX (offset, end);
+  }
+}
+
 /* DataScanCtx: helper for typefind functions that scan through data
  * step-by-step, to avoid doing a peek at each and every offset */
 
@@ -56,6 +293,8 @@ typedef struct
   guint64 offset;
   const guint8 *data;
   guint size;
+  /* optional, to skip ahead to start codes */
+  ScanWindow *window;
 } DataScanCtx;
 
 static inline void
@@ -121,6 +360,100 @@ data_scan_ctx_memcmp (GstTypeFind * tf, DataScanCtx * c, guint offset,
   return (memcmp (c->data + offset, data, len) == 0);
 }
 
+/* Moves @c ahead to the next 0x000001 start code, but not beyond @max_offset.
+ * Only skips over data the scan window has already looked at, so the caller
+ * must still check for the start code itself. */
+static inline void
+data_scan_ctx_skip_to_start_code (GstTypeFind * tf, DataScanCtx * c,
+    guint64 max_offset)
+{
+  guint64 next;
+
+  if (c->window == NULL)
+    return;
+
+  next = scan_window_next (tf, c->window, FALSE, c->offset, max_offset);
+  next = MIN (next, max_offset);
+  if (next > c->offset && next - c->offset < G_MAXUINT)
+    data_scan_ctx_advance (tf, c, next - c->offset);
+}
+
+/* Magic prefix index: the signatures of the "start with" and RIFF typefinders
+ * that give GST_TYPE_FIND_MAXIMUM, indexed by their first byte. Typefinders
+ * that scan through the data for sync words check it first and don't bother
+ * when the stream is already certain to be something else, the signature's
+ * typefinder will claim it with maximum probability anyway. It's filled in
+ * plugin_init() and read-only afterwards. */
+
+typedef struct
+{
+  const guint8 *data;
+  guint size;
+  guint probability;
+  GstCaps *caps;
+}
+GstTypeFindData;
+
+static GSList *magic_index[256];
+static GSList *magic_riff_index;
+
+static void
+magic_index_add (GstTypeFindData * sw_data, gboolean riff)
+{
+  if (sw_data->probability < GST_TYPE_FIND_MAXIMUM)
+    return;
+
+  if (riff) {
+    magic_riff_index = g_slist_prepend (magic_riff_index, sw_data);
+  } else {
+    magic_index[sw_data->data[0]] =
+        g_slist_prepend (magic_index[sw_data->data[0]], sw_data);
+  }
+}
+
+static const GstTypeFindData *
+magic_index_lookup (GstTypeFind * tf)
+{
+  const GstTypeFindData *sw_data;
+  const guint8 *data;
+  GSList *l;
+
+  data = gst_type_find_peek (tf, 0, 1);
+  if (data == NULL)
+    return NULL;
+
+  for (l = magic_index[data[0]]; l != NULL; l = l->next) {
+    sw_data = l->data;
+    data = gst_type_find_peek (tf, 0, sw_data->size);
+    if (data && memcmp (data, sw_data->data, sw_data->size) == 0)
+      return sw_data;
+  }
+
+  data = gst_type_find_peek (tf, 0, 12);
+  if (data && (memcmp (data, "RIFF", 4) == 0 || memcmp (data, "AVF0", 4) == 0)) {
+    for (l = magic_riff_index; l != NULL; l = l->next) {
+      sw_data = l->data;
+      if (memcmp (data + 8, sw_data->data, 4) == 0)
+        return sw_data;
+    }
+  }
+
+  return NULL;
+}
+
+static gboolean
+magic_index_has_match (GstTypeFind * tf)
+{
+  const GstTypeFindData *sw_data = magic_index_lookup (tf);
+
+  if (sw_data == NULL)
+    return FALSE;
+
+  GST_LOG ("stream starts with %s signature, not scanning",
+      gst_structure_get_name (gst_caps_get_structure (sw_data->caps, 0)));
+  return TRUE;
+}
+
 /*** text/plain ***/
 static gboolean xml_check_first_element (GstTypeFind * tf,
     const gchar * element, guint elen, gboolean strict);
@@ -169,6 +502,9 @@ utf8_type_find (GstTypeFind * tf, gpointer unused)
   GstTypeFindProbability start_prob, mid_prob;
   guint64 length;
 
+  if (magic_index_has_match (tf))
+    return;
+
   /* leave xml to the xml typefinders */
   if (xml_check_first_element (tf, "", 0, TRUE))
     return;
@@ -342,6 +678,10 @@ utf16_type_find (GstTypeFind * tf, gpointer unused)
     {2, "\xff\xfe", check_utf16, 10, G_LITTLE_ENDIAN},
     {2, "\xfe\xff", check_utf16, 20, G_BIG_ENDIAN},
   };
+
+  if (magic_index_has_match (tf))
+    return;
+
   unicode_type_find (tf, utf16tester, G_N_ELEMENTS (utf16tester),
       "text/utf-16", TRUE);
 }
@@ -357,6 +697,10 @@ utf32_type_find (GstTypeFind * tf, gpointer unused)
     {4, "\xff\xfe\x00\x00", check_utf32, 10, G_LITTLE_ENDIAN},
     {4, "\x00\x00\xfe\xff", check_utf32, 20, G_BIG_ENDIAN}
   };
+
+  if (magic_index_has_match (tf))
+    return;
+
   unicode_type_find (tf, utf32tester, G_N_ELEMENTS (utf32tester),
       "text/utf-32", TRUE);
 }
@@ -1183,6 +1527,9 @@ aac_type_find (GstTypeFind * tf, gpointer unused)
   GstCaps *best_caps = NULL;
   gint best_count = 0;
 
+  if (magic_index_has_match (tf))
+    return;
+
   while (c.offset < AAC_AMOUNT) {
     guint snc, len, offset, i;
 
@@ -1505,10 +1852,15 @@ mp3_type_find_at_offset (GstTypeFind * tf, guint64 start_off,
   gint last_free_offset = -1;
   gint last_free_framelen = -1;
   gboolean headerstart = TRUE;
+  ScanWindow *window = NULL;
 
   *found_layer = 0;
   *found_prob = 0;
 
+  /* the window only covers the start of the stream */
+  if (start_off == 0)
+    window = scan_window_get (tf);
+
   size = 0;
   skipped = 0;
   while (skipped < GST_MP3_TYPEFIND_TRY_SYNC) {
@@ -1522,6 +1874,23 @@ mp3_type_find_at_offset (GstTypeFind * tf, guint64 start_off,
         break;
       data_end = data + size;
     }
+    if (window != NULL && *data != 0xFF) {
+      guint64 next = scan_window_next (tf, window, TRUE, skipped,
+          GST_MP3_TYPEFIND_TRY_SYNC);
+
+      /* jump straight to the next byte that could start a frame header */
+      next = MIN (next, GST_MP3_TYPEFIND_TRY_SYNC);
+      if (next > skipped) {
+        if (next - skipped < size) {
+          data += next - skipped;
+          size -= next - skipped;
+        } else {
+          size = 0;
+        }
+        skipped = next;
+        continue;
+      }
+    }
     if (*data == 0xFF) {
       const guint8 *head_data = NULL;
       guint layer = 0, bitrate, samplerate, channels;
@@ -1646,6 +2015,9 @@ mp3_type_find (GstTypeFind * tf, gpointer unused)
   guint layer, mid_layer;
   guint64 length;
 
+  if (magic_index_has_match (tf))
+    return;
+
   mp3_type_find_at_offset (tf, 0, &layer, &prob);
   length = gst_type_find_get_length (tf);
 
@@ -1797,6 +2169,9 @@ ac3_type_find (GstTypeFind * tf, gpointer unused)
 {
   DataScanCtx c = { 0, NULL, 0 };
 
+  if (magic_index_has_match (tf))
+    return;
+
   /* Search for an ac3 frame; not necessarily right at the start, but give it
    * a lower probability if not found right at the start. Check that the
    * frame is followed by a second frame at the expected offset.
@@ -1964,6 +2339,9 @@ dts_type_find (GstTypeFind * tf, gpointer unused)
 {
   DataScanCtx c = { 0, NULL, 0 };
 
+  if (magic_index_has_match (tf))
+    return;
+
   /* Search for an dts frame; not necessarily right at the start, but give it
    * a lower probability if not found right at the start. Check that the
    * frame is followed by a second frame at the expected offset. */
@@ -2363,6 +2741,9 @@ mpeg_sys_type_find (GstTypeFind * tf, gpointer unused)
   guint32 sync_word = 0xffffffff;
   guint potential_headers = 0;
 
+  if (magic_index_has_match (tf))
+    return;
+
   G_STMT_START {
     gint len;
 
@@ -2545,6 +2926,9 @@ mpeg_ts_type_find (GstTypeFind * tf, gpointer unused)
   guint size = 0;
   guint64 skipped = 0;
 
+  if (magic_index_has_match (tf))
+    return;
+
   while (skipped < GST_MPEGTS_TYPEFIND_SCAN_LENGTH) {
     if (size < MPEGTS_HDR_SIZE) {
       data = gst_type_find_peek (tf, skipped, GST_MPEGTS_TYPEFIND_SYNC_SIZE);
@@ -2596,9 +2980,10 @@ static gboolean
 mpeg_find_next_header (GstTypeFind * tf, DataScanCtx * c,
     guint64 max_extra_offset)
 {
-  guint64 extra_offset;
+  guint64 end_offset = c->offset + max_extra_offset;
 
-  for (extra_offset = 0; extra_offset <= max_extra_offset; ++extra_offset) {
+  while (c->offset <= end_offset) {
+    data_scan_ctx_skip_to_start_code (tf, c, end_offset);
     if (!data_scan_ctx_ensure_data (tf, c, 4))
       return FALSE;
     if (IS_MPEG_HEADER (c->data)) {
@@ -2634,6 +3019,11 @@ mpeg4_video_type_find (GstTypeFind * tf, gpointer unused)
   guint num_vop_headers = 0;
   guint8 sc;
 
+  if (magic_index_has_match (tf))
+    return;
+
+  c.window = scan_window_get (tf);
+
   while (c.offset < GST_MPEGVID_TYPEFIND_TRY_SYNC) {
     if (num_vop_headers >= GST_MPEGVID_TYPEFIND_TRY_PICTURES)
       break;
@@ -2755,6 +3145,9 @@ h263_video_type_find (GstTypeFind * tf, gpointer unused)
   guint bad = 0;
   guint pc_type, pb_mode;
 
+  if (magic_index_has_match (tf))
+    return;
+
   while (c.offset < H263_MAX_PROBE_LENGTH) {
     if (G_UNLIKELY (!data_scan_ctx_ensure_data (tf, &c, 4)))
       break;
@@ -2820,7 +3213,13 @@ h264_video_type_find (GstTypeFind * tf, gpointer unused)
   int good = 0;
   int bad = 0;
 
+  if (magic_index_has_match (tf))
+    return;
+
+  c.window = scan_window_get (tf);
+
   while (c.offset < H264_MAX_PROBE_LENGTH) {
+    data_scan_ctx_skip_to_start_code (tf, &c, H264_MAX_PROBE_LENGTH);
     if (G_UNLIKELY (!data_scan_ctx_ensure_data (tf, &c, 4)))
       break;
 
@@ -2917,7 +3316,13 @@ h265_video_type_find (GstTypeFind * tf, gpointer unused)
   int good = 0;
   int bad = 0;
 
+  if (magic_index_has_match (tf))
+    return;
+
+  c.window = scan_window_get (tf);
+
   while (c.offset < H265_MAX_PROBE_LENGTH) {
+    data_scan_ctx_skip_to_start_code (tf, &c, H265_MAX_PROBE_LENGTH);
     if (G_UNLIKELY (!data_scan_ctx_ensure_data (tf, &c, 5)))
       break;
 
@@ -3011,10 +3416,16 @@ mpeg_video_stream_type_find (GstTypeFind * tf, gpointer unused)
   gint num_pic_headers = 0;
   gint found = 0;
 
+  if (magic_index_has_match (tf))
+    return;
+
+  c.window = scan_window_get (tf);
+
   while (c.offset < GST_MPEGVID_TYPEFIND_TRY_SYNC) {
     if (found >= GST_MPEGVID_TYPEFIND_TRY_PICTURES)
       break;
 
+    data_scan_ctx_skip_to_start_code (tf, &c, GST_MPEGVID_TYPEFIND_TRY_SYNC);
     if (!data_scan_ctx_ensure_data (tf, &c, 5))
       break;
 
@@ -5813,15 +6224,6 @@ aa_type_find (GstTypeFind * tf, gpointer private)
 }
 
 /*** generic typefind for streams that have some data at a specific position***/
-typedef struct
-{
-  const guint8 *data;
-  guint size;
-  guint probability;
-  GstCaps *caps;
-}
-GstTypeFindData;
-
 static void
 start_with_type_find (GstTypeFind * tf, gpointer private)
 {
@@ -5856,6 +6258,8 @@ G_BEGIN_DECLS{                                                          \
                      ext, sw_data->caps, sw_data,                       \
                      (GDestroyNotify) (sw_data_destroy))) {             \
     sw_data_destroy (sw_data);                                          \
+  } else {                                                              \
+    magic_index_add (sw_data, FALSE);                                   \
   }                                                                     \
 }G_END_DECLS
 
@@ -5885,6 +6289,8 @@ G_BEGIN_DECLS{                                                          \
                       ext, sw_data->caps, sw_data,                      \
                       (GDestroyNotify) (sw_data_destroy))) {            \
     sw_data_destroy (sw_data);                                          \
+  } else {                                                              \
+    magic_index_add (sw_data, TRUE);                                    \
   }                                                                     \
 }G_END_DECLS
 
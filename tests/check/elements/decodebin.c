@@ -19,6 +19,10 @@
  * Boston, MA 02110-1301, USA.
  */
 
+/* FIXME 0.11: suppress warnings for deprecated API such as GValueArray
+ * with newer GLib versions (>= 2.31.0) */
+#define GLIB_DISABLE_DEPRECATION_WARNINGS
+
 #ifdef HAVE_CONFIG_H
 # include <config.h>
 #endif
@@ -709,6 +713,190 @@ GST_START_TEST (test_buffering_aggregation)
 
 GST_END_TEST;
 
+static gboolean
+parsebin_autoplug_continue_cb (GstElement * parsebin, GstPad * pad,
+    GstCaps * caps, gpointer user_data)
+{
+  /* expose the typefind output directly, we don't need any parsers */
+  return FALSE;
+}
+
+static void
+parsebin_pad_added_cb (GstElement * parsebin, GstPad * pad, GstBin * pipe)
+{
+  GstElement *sink;
+  GstPad *sinkpad;
+
+  sink = gst_element_factory_make ("fakesink", NULL);
+  gst_bin_add (pipe, sink);
+  sinkpad = gst_element_get_static_pad (sink, "sink");
+  fail_unless_equals_int (gst_pad_link (pad, sinkpad), GST_PAD_LINK_OK);
+  gst_object_unref (sinkpad);
+  gst_element_sync_state_with_parent (sink);
+}
+
+/* Plays test.mp3 through a parsebin with fast-start to PAUSED and returns
+ * the type typefind was forced to, if any. If @app_caps is set, it's set
+ * as the sink-caps while PAUSED and must still be there after stopping. */
+static GstCaps *
+run_parsebin_fast_start (GstCaps * app_caps)
+{
+  GstStateChangeReturn sret;
+  GstElement *pipe, *src, *parsebin, *typefind;
+  GstCaps *caps, *sink_caps;
+  gchar *path;
+
+  pipe = gst_pipeline_new (NULL);
+
+  src = gst_element_factory_make ("filesrc", NULL);
+  fail_unless (src != NULL);
+  path = g_build_filename (GST_TEST_FILES_PATH, "test.mp3", NULL);
+  g_object_set (src, "location", path, NULL);
+  g_free (path);
+
+  parsebin = gst_element_factory_make ("parsebin", NULL);
+  fail_unless (parsebin != NULL);
+  g_object_set (parsebin, "fast-start", TRUE, NULL);
+  g_signal_connect (parsebin, "autoplug-continue",
+      G_CALLBACK (parsebin_autoplug_continue_cb), NULL);
+  g_signal_connect (parsebin, "pad-added",
+      G_CALLBACK (parsebin_pad_added_cb), pipe);
+
+  gst_bin_add_many (GST_BIN (pipe), src, parsebin, NULL);
+  fail_unless (gst_element_link (src, parsebin));
+
+  typefind = gst_bin_get_by_name (GST_BIN (parsebin), "typefind");
+  fail_unless (typefind != NULL);
+
+  gst_element_set_state (pipe, GST_STATE_PAUSED);
+  sret = gst_element_get_state (pipe, NULL, NULL, GST_CLOCK_TIME_NONE);
+  fail_unless_equals_int (sret, GST_STATE_CHANGE_SUCCESS);
+
+  /* the cached type is passed to typefind, but is not the application's
+   * sink caps */
+  g_object_get (typefind, "force-caps", &caps, NULL);
+  g_object_get (parsebin, "sink-caps", &sink_caps, NULL);
+  fail_unless (sink_caps == NULL);
+
+  if (app_caps)
+    g_object_set (parsebin, "sink-caps", app_caps, NULL);
+
+  gst_element_set_state (pipe, GST_STATE_READY);
+
+  g_object_get (parsebin, "sink-caps", &sink_caps, NULL);
+  if (app_caps) {
+    fail_unless (sink_caps != NULL);
+    fail_unless (gst_caps_is_equal (sink_caps, app_caps));
+    gst_caps_unref (sink_caps);
+  } else {
+    fail_unless (sink_caps == NULL);
+  }
+
+  /* and typefind is back to the application's caps */
+  g_object_get (typefind, "force-caps", &sink_caps, NULL);
+  if (app_caps) {
+    fail_unless (sink_caps != NULL);
+    fail_unless (gst_caps_is_equal (sink_caps, app_caps));
+    gst_caps_unref (sink_caps);
+  } else {
+    fail_unless (sink_caps == NULL);
+  }
+
+  gst_object_unref (typefind);
+  gst_element_set_state (pipe, GST_STATE_NULL);
+  gst_object_unref (pipe);
+
+  return caps;
+}
+
+GST_START_TEST (test_parsebin_fast_start)
+{
+  GstCaps *caps, *app_caps;
+
+  /* first open has to typefind */
+  caps = run_parsebin_fast_start (NULL);
+  fail_unless (caps == NULL);
+
+  /* second open uses the type found the first time */
+  caps = run_parsebin_fast_start (NULL);
+  fail_unless (caps != NULL);
+  fail_unless (gst_structure_has_name (gst_caps_get_structure (caps, 0),
+          "audio/mpeg"));
+  gst_caps_unref (caps);
+
+  /* sink caps set by the application while running survive stopping */
+  app_caps = gst_caps_new_empty_simple ("audio/mpeg");
+  caps = run_parsebin_fast_start (app_caps);
+  fail_unless (caps != NULL);
+  gst_caps_unref (caps);
+  gst_caps_unref (app_caps);
+}
+
+GST_END_TEST;
+
+static gboolean
+autoplug_factories_contains (GstElement * dec, GstCaps * caps,
+    const gchar * name)
+{
+  GValueArray *factories = NULL;
+  GstPad *pad;
+  gboolean found = FALSE;
+  guint i;
+
+  pad = gst_pad_new ("src", GST_PAD_SRC);
+  g_signal_emit_by_name (dec, "autoplug-factories", pad, caps, &factories);
+  gst_object_unref (pad);
+  fail_unless (factories != NULL);
+
+  for (i = 0; i < factories->n_values; i++) {
+    GstPluginFeature *feature =
+        g_value_get_object (g_value_array_get_nth (factories, i));
+
+    if (g_str_equal (gst_plugin_feature_get_name (feature), name))
+      found = TRUE;
+  }
+  g_value_array_free (factories);
+
+  return found;
+}
+
+GST_START_TEST (test_autoplug_factories_cache)
+{
+  GstPluginFeature *feature;
+  GstElement *dec;
+  GstCaps *caps;
+
+  gst_plugin_register_static (GST_VERSION_MAJOR, GST_VERSION_MINOR,
+      "fakemp3parse", "fakemp3parse", plugin_init, VERSION, "LGPL",
+      "gst-plugins-base", GST_PACKAGE_NAME, GST_PACKAGE_ORIGIN);
+
+  feature = gst_registry_find_feature (gst_registry_get (),
+      "testmpegaudioparse", GST_TYPE_ELEMENT_FACTORY);
+  gst_plugin_feature_set_rank (feature, GST_RANK_PRIMARY + 100);
+
+  dec = gst_element_factory_make ("decodebin", NULL);
+  fail_unless (dec != NULL);
+  caps = gst_caps_from_string ("audio/mpeg, mpegversion=1, layer=3");
+
+  fail_unless (autoplug_factories_contains (dec, caps, "testmpegaudioparse"));
+  /* again, from the cache */
+  fail_unless (autoplug_factories_contains (dec, caps, "testmpegaudioparse"));
+
+  /* changing the rank invalidates the cached lists */
+  gst_plugin_feature_set_rank (feature, GST_RANK_NONE);
+  fail_if (autoplug_factories_contains (dec, caps, "testmpegaudioparse"));
+
+  /* and so does raising it from NONE, the usual way to enable a decoder */
+  gst_plugin_feature_set_rank (feature, GST_RANK_PRIMARY + 100);
+  fail_unless (autoplug_factories_contains (dec, caps, "testmpegaudioparse"));
+
+  gst_caps_unref (caps);
+  gst_object_unref (dec);
+  gst_object_unref (feature);
+}
+
+GST_END_TEST;
+
 static Suite *
 decodebin_suite (void)
 {
@@ -721,6 +909,8 @@ decodebin_suite (void)
   tcase_add_test (tc_chain, test_mp3_parser_loop);
   tcase_add_test (tc_chain, test_parser_negotiation);
   tcase_add_test (tc_chain, test_buffering_aggregation);
+  tcase_add_test (tc_chain, test_parsebin_fast_start);
+  tcase_add_test (tc_chain, test_autoplug_factories_cache);
 
   return s;
 }
@@ -0,0 +1,450 @@
+/* GStreamer
+ *
+ * unit tests for oggdemux
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+
+#include <glib/gstdio.h>
+#include <gst/check/gstcheck.h>
+#include <ogg/ogg.h>
+
+/* one Opus packet with a single 20 ms CELT frame */
+#define OPUS_TOC_20MS 0xf8
+#define OPUS_PACKET_SAMPLES 960
+#define OPUS_PACKET_DURATION (20 * GST_MSECOND)
+
+static void
+packetin (ogg_stream_state * os, const guint8 * data, gsize size,
+    gint64 granulepos, gint64 packetno, gboolean bos, gboolean eos)
+{
+  ogg_packet packet;
+
+  packet.packet = (guint8 *) data;
+  packet.bytes = size;
+  packet.b_o_s = bos;
+  packet.e_o_s = eos;
+  packet.granulepos = granulepos;
+  packet.packetno = packetno;
+  fail_unless (ogg_stream_packetin (os, &packet) == 0);
+}
+
+/* appends all pages that can be flushed out of @os to @data */
+static void
+flush_pages (ogg_stream_state * os, GByteArray * data)
+{
+  ogg_page page;
+
+  while (ogg_stream_flush (os, &page)) {
+    g_byte_array_append (data, page.header, page.header_len);
+    g_byte_array_append (data, page.body, page.body_len);
+  }
+}
+
+/* the OpusHead and OpusTags packets on their own pages */
+static void
+opus_headers (ogg_stream_state * os, GByteArray * bos_data,
+    GByteArray * header_data)
+{
+  static const guint8 head[19] = {
+    'O', 'p', 'u', 's', 'H', 'e', 'a', 'd', 1, 1, 0, 0,
+    0x80, 0xbb, 0, 0, 0, 0, 0
+  };
+  static const guint8 tags[16] = {
+    'O', 'p', 'u', 's', 'T', 'a', 'g', 's', 0, 0, 0, 0, 0, 0, 0, 0
+  };
+
+  packetin (os, head, sizeof (head), 0, 0, TRUE, FALSE);
+  flush_pages (os, bos_data);
+  packetin (os, tags, sizeof (tags), 0, 1, FALSE, FALSE);
+  flush_pages (os, header_data);
+}
+
+static gchar *
+write_temp_file (GByteArray * data)
+{
+  GError *err = NULL;
+  gchar *location;
+  gint fd;
+
+  fd = g_file_open_tmp ("oggdemux-XXXXXX.ogg", &location, &err);
+  fail_unless (fd >= 0, "failed to create temporary file: %s",
+      err ? err->message : "");
+  g_close (fd, NULL);
+
+  fail_unless (g_file_set_contents (location, (const gchar *) data->data,
+          data->len, NULL));
+
+  return location;
+}
+
+/* Two Opus streams interleaved the way a muxer orders pages by their start
+ * time: stream 1 has pages of one second, stream 2 pages of 200 ms. The long
+ * page of stream 1 ending at 2 s comes before the short pages of stream 2
+ * that end between 1.2 s and 2 s. */
+#define SEEK_TEST_SECONDS 5
+#define LONG_PAGE_PACKETS 50
+#define SHORT_PAGE_PACKETS 10
+
+static gchar *
+create_interleaved_file (void)
+{
+  ogg_stream_state os1, os2;
+  GByteArray *data, *headers;
+  guint8 packet[32];
+  gint64 packetno1 = 2, packetno2 = 2;
+  gint64 samples1 = 0, samples2 = 0;
+  gint n_packets = SEEK_TEST_SECONDS * GST_SECOND / OPUS_PACKET_DURATION;
+  gint i, j;
+  gchar *location;
+
+  memset (packet, 0, sizeof (packet));
+  packet[0] = OPUS_TOC_20MS;
+
+  data = g_byte_array_new ();
+  headers = g_byte_array_new ();
+
+  ogg_stream_init (&os1, 1);
+  ogg_stream_init (&os2, 2);
+  opus_headers (&os1, data, headers);
+  opus_headers (&os2, data, headers);
+  g_byte_array_append (data, headers->data, headers->len);
+  g_byte_array_free (headers, TRUE);
+
+  for (i = 0; i < n_packets; i += LONG_PAGE_PACKETS) {
+    for (j = 0; j < LONG_PAGE_PACKETS; j++) {
+      samples1 += OPUS_PACKET_SAMPLES;
+      packetin (&os1, packet, sizeof (packet), samples1, packetno1++, FALSE,
+          i + j + 1 == n_packets);
+    }
+    flush_pages (&os1, data);
+
+    for (j = 0; j < LONG_PAGE_PACKETS; j++) {
+      samples2 += OPUS_PACKET_SAMPLES;
+      packetin (&os2, packet, sizeof (packet), samples2, packetno2++, FALSE,
+          i + j + 1 == n_packets);
+      if ((j + 1) % SHORT_PAGE_PACKETS == 0)
+        flush_pages (&os2, data);
+    }
+  }
+
+  ogg_stream_clear (&os1);
+  ogg_stream_clear (&os2);
+
+  location = write_temp_file (data);
+  g_byte_array_free (data, TRUE);
+
+  return location;
+}
+
+static GMutex first_pts_lock;
+static GHashTable *first_pts;
+
+static GstPadProbeReturn
+first_pts_probe (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER (info);
+  gchar *name;
+
+  if (GST_BUFFER_FLAG_IS_SET (buffer, GST_BUFFER_FLAG_HEADER))
+    return GST_PAD_PROBE_OK;
+
+  g_mutex_lock (&first_pts_lock);
+  name = gst_pad_get_name (pad);
+  if (!g_hash_table_contains (first_pts, name))
+    g_hash_table_insert (first_pts, name,
+        g_memdup (&GST_BUFFER_PTS (buffer), sizeof (GstClockTime)));
+  else
+    g_free (name);
+  g_mutex_unlock (&first_pts_lock);
+
+  return GST_PAD_PROBE_OK;
+}
+
+static void
+pad_added_cb (GstElement * demux, GstPad * srcpad, GstElement * pipeline)
+{
+  GstElement *sink;
+  GstPad *sinkpad;
+
+  sink = gst_element_factory_make ("fakesink", NULL);
+  fail_unless (sink != NULL, "Failed to create fakesink element");
+  g_object_set (sink, "sync", FALSE, "async", FALSE, NULL);
+
+  gst_bin_add (GST_BIN (pipeline), sink);
+
+  sinkpad = gst_element_get_static_pad (sink, "sink");
+  fail_unless_equals_int (gst_pad_link (srcpad, sinkpad), GST_PAD_LINK_OK);
+  gst_object_unref (sinkpad);
+
+  gst_pad_add_probe (srcpad, GST_PAD_PROBE_TYPE_BUFFER, first_pts_probe,
+      NULL, NULL);
+
+  gst_element_sync_state_with_parent (sink);
+}
+
+static void
+wait_for_eos (GstElement * pipeline)
+{
+  GstMessage *msg;
+
+  msg = gst_bus_timed_pop_filtered (GST_ELEMENT_BUS (pipeline),
+      GST_CLOCK_TIME_NONE, GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+}
+
+/* after playing the file once, the seek index knows all pages. Seeking to
+ * a position between the end of a short page of stream 2 and the end of
+ * the long page of stream 1 that comes before it in the file must still
+ * start stream 1 before the target */
+GST_START_TEST (test_seek_interleaved_pages)
+{
+  GstElement *pipeline, *src, *demux;
+  GstClockTime target = 1950 * GST_MSECOND, *pts;
+  gchar *location;
+
+  location = create_interleaved_file ();
+  first_pts = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+
+  pipeline = gst_pipeline_new (NULL);
+  src = gst_element_factory_make ("filesrc", NULL);
+  demux = gst_element_factory_make ("oggdemux", NULL);
+  fail_unless (src != NULL && demux != NULL);
+  g_object_set (src, "location", location, NULL);
+  gst_bin_add_many (GST_BIN (pipeline), src, demux, NULL);
+  fail_unless (gst_element_link (src, demux));
+  g_signal_connect (demux, "pad-added", G_CALLBACK (pad_added_cb), pipeline);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  wait_for_eos (pipeline);
+
+  g_mutex_lock (&first_pts_lock);
+  g_hash_table_remove_all (first_pts);
+  g_mutex_unlock (&first_pts_lock);
+
+  fail_unless (gst_element_seek_simple (demux, GST_FORMAT_TIME,
+          GST_SEEK_FLAG_FLUSH, target));
+  wait_for_eos (pipeline);
+
+  g_mutex_lock (&first_pts_lock);
+  fail_unless_equals_int (g_hash_table_size (first_pts), 2);
+  pts = g_hash_table_lookup (first_pts, "src_00000001");
+  fail_unless (pts != NULL);
+  fail_unless (*pts <= target, "stream 1 starts at %" GST_TIME_FORMAT
+      " after the seek target %" GST_TIME_FORMAT, GST_TIME_ARGS (*pts),
+      GST_TIME_ARGS (target));
+  pts = g_hash_table_lookup (first_pts, "src_00000002");
+  fail_unless (pts != NULL);
+  fail_unless (*pts <= target, "stream 2 starts at %" GST_TIME_FORMAT
+      " after the seek target %" GST_TIME_FORMAT, GST_TIME_ARGS (*pts),
+      GST_TIME_ARGS (target));
+  g_mutex_unlock (&first_pts_lock);
+
+  fail_unless (gst_bus_poll (GST_ELEMENT_BUS (pipeline), GST_MESSAGE_ERROR,
+          0) == NULL);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  g_hash_table_unref (first_pts);
+  first_pts = NULL;
+  g_unlink (location);
+  g_free (location);
+}
+
+GST_END_TEST;
+
+/* packets of a single Opus stream for the sub-buffer test. The large one
+ * has more than 255 lacing values and spans two pages */
+#define SUBBUFFER_SMALL_PACKET 100
+#define SUBBUFFER_LARGE_PACKET 70000
+#define SUBBUFFER_N_PACKETS 5
+#define SUBBUFFER_SPANNING_PACKET 2
+
+static GstStaticPadTemplate ogg_srctemplate = GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS ("application/ogg"));
+
+static GList *output_buffers;
+
+static guint8 *
+create_subbuffer_packet (gint num, gsize * size)
+{
+  guint8 *data;
+  gsize i;
+
+  *size = num == SUBBUFFER_SPANNING_PACKET ?
+      SUBBUFFER_LARGE_PACKET : SUBBUFFER_SMALL_PACKET;
+  data = g_malloc (*size);
+  data[0] = OPUS_TOC_20MS;
+  for (i = 1; i < *size; i++)
+    data[i] = (i * 7 + num) & 0xff;
+
+  return data;
+}
+
+/* page 1: packets 0 and 1, pages 2 and 3: packet 2 and packet 3 at the
+ * end of page 3, page 4: packet 4 */
+static GstBuffer *
+create_subbuffer_stream (void)
+{
+  ogg_stream_state os;
+  GByteArray *data;
+  guint8 *packet;
+  gsize size;
+  gint i;
+
+  data = g_byte_array_new ();
+
+  ogg_stream_init (&os, 0x1234);
+  opus_headers (&os, data, data);
+
+  for (i = 0; i < SUBBUFFER_N_PACKETS; i++) {
+    packet = create_subbuffer_packet (i, &size);
+    packetin (&os, packet, size, (i + 1) * OPUS_PACKET_SAMPLES, i + 2, FALSE,
+        i + 1 == SUBBUFFER_N_PACKETS);
+    g_free (packet);
+    if (i == 1 || i == 3 || i + 1 == SUBBUFFER_N_PACKETS)
+      flush_pages (&os, data);
+  }
+  ogg_stream_clear (&os);
+
+  size = data->len;
+  return gst_buffer_new_wrapped (g_byte_array_free (data, FALSE), size);
+}
+
+static GstFlowReturn
+output_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+{
+  if (GST_BUFFER_FLAG_IS_SET (buffer, GST_BUFFER_FLAG_HEADER))
+    gst_buffer_unref (buffer);
+  else
+    output_buffers = g_list_append (output_buffers, buffer);
+
+  return GST_FLOW_OK;
+}
+
+static gboolean
+output_event (GstPad * pad, GstObject * parent, GstEvent * event)
+{
+  gst_event_unref (event);
+  return TRUE;
+}
+
+static void
+pad_added_collect_cb (GstElement * demux, GstPad * srcpad, GstPad ** sinkpad)
+{
+  fail_unless (*sinkpad == NULL);
+
+  *sinkpad = gst_pad_new ("sink", GST_PAD_SINK);
+  gst_pad_set_chain_function (*sinkpad, output_chain);
+  gst_pad_set_event_function (*sinkpad, output_event);
+  gst_pad_set_active (*sinkpad, TRUE);
+  fail_unless_equals_int (gst_pad_link (srcpad, *sinkpad), GST_PAD_LINK_OK);
+}
+
+/* packets that start and end on a page in the input buffer share its
+ * memory, the packet spanning two pages is copied together */
+GST_START_TEST (test_packet_subbuffers)
+{
+  GstElement *demux;
+  GstPad *srcpad, *sinkpad = NULL;
+  GstBuffer *input;
+  GstCaps *caps;
+  GstMapInfo in_map, out_map;
+  GList *walk;
+  guint8 *expected;
+  gsize size;
+  gint i;
+
+  demux = gst_check_setup_element ("oggdemux");
+  g_signal_connect (demux, "pad-added", G_CALLBACK (pad_added_collect_cb),
+      &sinkpad);
+  srcpad = gst_check_setup_src_pad (demux, &ogg_srctemplate);
+  gst_pad_set_active (srcpad, TRUE);
+  fail_unless_equals_int (gst_element_set_state (demux, GST_STATE_PLAYING),
+      GST_STATE_CHANGE_SUCCESS);
+
+  caps = gst_caps_new_empty_simple ("application/ogg");
+  gst_check_setup_events (srcpad, demux, caps, GST_FORMAT_BYTES);
+  gst_caps_unref (caps);
+
+  input = create_subbuffer_stream ();
+  fail_unless_equals_int (gst_pad_push (srcpad, gst_buffer_ref (input)),
+      GST_FLOW_OK);
+  fail_unless (gst_pad_push_event (srcpad, gst_event_new_eos ()));
+
+  fail_unless (sinkpad != NULL);
+  fail_unless_equals_int (g_list_length (output_buffers), SUBBUFFER_N_PACKETS);
+
+  gst_buffer_map (input, &in_map, GST_MAP_READ);
+  for (walk = output_buffers, i = 0; walk; walk = walk->next, i++) {
+    gboolean shared;
+
+    expected = create_subbuffer_packet (i, &size);
+    gst_buffer_map (walk->data, &out_map, GST_MAP_READ);
+    fail_unless_equals_int (out_map.size, size);
+    fail_unless (memcmp (out_map.data, expected, size) == 0,
+        "packet %d has the wrong contents", i);
+
+    shared = out_map.data >= in_map.data
+        && out_map.data + out_map.size <= in_map.data + in_map.size;
+    if (i == SUBBUFFER_SPANNING_PACKET)
+      fail_if (shared, "packet spanning pages shares the input memory");
+    else if (i > SUBBUFFER_SPANNING_PACKET)
+      fail_unless (shared, "packet %d was copied", i);
+
+    gst_buffer_unmap (walk->data, &out_map);
+    g_free (expected);
+  }
+  gst_buffer_unmap (input, &in_map);
+  gst_buffer_unref (input);
+
+  g_list_free_full (output_buffers, (GDestroyNotify) gst_buffer_unref);
+  output_buffers = NULL;
+
+  gst_element_set_state (demux, GST_STATE_NULL);
+  gst_pad_set_active (srcpad, FALSE);
+  gst_check_teardown_src_pad (demux);
+  gst_check_teardown_element (demux);
+  gst_pad_set_active (sinkpad, FALSE);
+  gst_object_unref (sinkpad);
+}
+
+GST_END_TEST;
+
+static Suite *
+oggdemux_suite (void)
+{
+  Suite *s = suite_create ("oggdemux");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_seek_interleaved_pages);
+  tcase_add_test (tc_chain, test_packet_subbuffers);
+
+  return s;
+}
+
+GST_CHECK_MAIN (oggdemux);
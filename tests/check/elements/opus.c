@@ -27,6 +27,8 @@
 #include <gst/check/gstcheck.h>
 #include <gst/check/gstharness.h>
 
+#include <math.h>
+
 #if G_BYTE_ORDER == G_BIG_ENDIAN
 #define AFORMAT "S16BE"
 #else
@@ -488,6 +490,67 @@ GST_START_TEST (test_opus_decode_plc_timestamps_with_fec)
 
 GST_END_TEST;
 
+#define MC_CHANNELS 6
+#define MC_TONE_CHANNEL 4       /* rear left in GStreamer order */
+#define MC_FRAME_SAMPLES 960
+
+/* 5.1 is stored in a different channel order in Opus, make sure each
+ * channel comes out of the decoder where it went into the encoder */
+GST_START_TEST (test_opus_multichannel_order)
+{
+  GstHarness *h = gst_harness_new_parse ("opusenc ! opusdec");
+  gdouble energy[MC_CHANNELS] = { 0, };
+  GstBuffer *buf;
+  GstMapInfo map;
+  guint i, n, c;
+
+  gst_harness_set_src_caps_str (h, "audio/x-raw, format = (string) " AFORMAT
+      ", layout = (string) interleaved, rate = (int) 48000, "
+      "channels = (int) 6, channel-mask = (bitmask) 0x3f");
+
+  for (n = 0; n < 20; n++) {
+    gint16 *samples;
+
+    buf = gst_buffer_new_allocate (NULL,
+        MC_FRAME_SAMPLES * MC_CHANNELS * sizeof (gint16), NULL);
+    gst_buffer_memset (buf, 0, 0, gst_buffer_get_size (buf));
+    gst_buffer_map (buf, &map, GST_MAP_WRITE);
+    samples = (gint16 *) map.data;
+    for (i = 0; i < MC_FRAME_SAMPLES; i++) {
+      samples[i * MC_CHANNELS + MC_TONE_CHANNEL] = 16000 *
+          sin (2 * G_PI * 440 * (n * MC_FRAME_SAMPLES + i) / 48000.0);
+    }
+    gst_buffer_unmap (buf, &map);
+
+    GST_BUFFER_PTS (buf) = n * 20 * GST_MSECOND;
+    GST_BUFFER_DURATION (buf) = 20 * GST_MSECOND;
+    fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+  }
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+
+  fail_unless (gst_harness_buffers_in_queue (h) > 0);
+  while ((buf = gst_harness_try_pull (h))) {
+    const gint16 *samples;
+
+    gst_buffer_map (buf, &map, GST_MAP_READ);
+    samples = (const gint16 *) map.data;
+    for (i = 0; i < map.size / sizeof (gint16); i++)
+      energy[i % MC_CHANNELS] += (gdouble) samples[i] * samples[i];
+    gst_buffer_unmap (buf, &map);
+    gst_buffer_unref (buf);
+  }
+
+  for (c = 0; c < MC_CHANNELS; c++) {
+    if (c != MC_TONE_CHANNEL)
+      fail_unless (energy[MC_TONE_CHANNEL] > 10 * energy[c],
+          "channel %u has more energy than expected", c);
+  }
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 static Suite *
 opus_suite (void)
 {
@@ -502,6 +565,7 @@ opus_suite (void)
   tcase_add_test (tc_chain, test_opus_encode_properties);
   tcase_add_test (tc_chain, test_opusdec_getcaps);
   tcase_add_test (tc_chain, test_opus_decode_plc_timestamps_with_fec);
+  tcase_add_test (tc_chain, test_opus_multichannel_order);
 
   return s;
 }
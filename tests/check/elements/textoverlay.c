@@ -815,6 +815,71 @@ GST_START_TEST (test_video_render_static_text)
 
 GST_END_TEST;
 
+/* render the given texts on consecutive black frames and return the last
+ * output frame */
+static GstBuffer *
+render_texts (const gchar ** texts, guint n_texts)
+{
+  GstElement *textoverlay;
+  GstBuffer *inbuffer, *outbuffer;
+  GstCaps *incaps;
+  guint i;
+
+  textoverlay = setup_textoverlay (TRUE);
+  g_object_set (textoverlay, "text", texts[0], NULL);
+
+  fail_unless (gst_element_set_state (textoverlay,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  incaps = create_video_caps (VIDEO_CAPS_STRING);
+  gst_check_setup_events_textoverlay (myvideosrcpad, textoverlay, incaps,
+      GST_FORMAT_TIME, "video");
+
+  for (i = 0; i < n_texts; i++) {
+    g_object_set (textoverlay, "text", texts[i], NULL);
+
+    inbuffer = create_black_buffer (incaps);
+    GST_BUFFER_TIMESTAMP (inbuffer) = i * GST_SECOND;
+    GST_BUFFER_DURATION (inbuffer) = GST_SECOND;
+    fail_unless (gst_pad_push (myvideosrcpad, inbuffer) == GST_FLOW_OK);
+  }
+  gst_caps_unref (incaps);
+
+  fail_unless_equals_int (g_list_length (buffers), n_texts);
+  outbuffer = gst_buffer_ref (GST_BUFFER_CAST (g_list_last (buffers)->data));
+
+  cleanup_textoverlay (textoverlay);
+
+  return outbuffer;
+}
+
+GST_START_TEST (test_video_render_changed_text)
+{
+  const gchar *texts[] = { "0:00:01.000", "0:00:01.040", "0:00:01.040",
+    "0:00:02.080"
+  };
+  GstBuffer *updated, *full;
+  GstMapInfo updated_map, full_map;
+
+  /* text that changes partly from frame to frame must look exactly like
+   * the same text rendered from scratch */
+  updated = render_texts (texts, G_N_ELEMENTS (texts));
+  full = render_texts (&texts[G_N_ELEMENTS (texts) - 1], 1);
+
+  gst_buffer_map (updated, &updated_map, GST_MAP_READ);
+  gst_buffer_map (full, &full_map, GST_MAP_READ);
+  fail_unless_equals_int (updated_map.size, full_map.size);
+  fail_unless (memcmp (updated_map.data, full_map.data, full_map.size) == 0);
+  gst_buffer_unmap (updated, &updated_map);
+  gst_buffer_unmap (full, &full_map);
+
+  gst_buffer_unref (updated);
+  gst_buffer_unref (full);
+}
+
+GST_END_TEST;
+
 static gpointer
 test_video_waits_for_text_send_text_newsegment_thread (gpointer data)
 {
@@ -1153,6 +1218,7 @@ textoverlay_suite (void)
   tcase_add_test (tc_chain,
       test_video_render_with_any_features_and_no_allocation_meta);
   tcase_add_test (tc_chain, test_video_render_static_text);
+  tcase_add_test (tc_chain, test_video_render_changed_text);
   tcase_add_test (tc_chain, test_render_continuity);
   tcase_add_test (tc_chain, test_video_waits_for_text);
 
@@ -0,0 +1,313 @@
+/* GStreamer
+ *
+ * unit test for theoradec
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+#include <gst/video/video.h>
+
+#include <theora/theoradec.h>
+#include <theora/theoraenc.h>
+
+/* several stripes of fragment rows, and a picture region that has to be
+ * cropped out of the frame on every side */
+#define FRAME_WIDTH 176
+#define FRAME_HEIGHT 144
+#define PIC_X 2
+#define PIC_Y 4
+#define PIC_WIDTH 170
+#define PIC_HEIGHT 136
+#define NUM_FRAMES 8
+/* a zero-length packet repeating the previous frame follows this one */
+#define DUP_FRAME 4
+#define NUM_HEADERS 3
+
+static void
+fill_image (th_ycbcr_buffer img, gint n)
+{
+  gint comp, x, y;
+
+  /* some texture that moves from frame to frame, so there are inter
+   * frames with both coded and uncoded blocks */
+  for (comp = 0; comp < 3; comp++) {
+    for (y = 0; y < img[comp].height; y++) {
+      for (x = 0; x < img[comp].width; x++) {
+        img[comp].data[y * img[comp].stride + x] =
+            (x * (comp + 1) + y * 3 + ((x * y) >> 5) +
+            (x < img[comp].width / 2 ? n * 4 : 0)) & 0xff;
+      }
+    }
+  }
+}
+
+static GstBuffer *
+buffer_from_packet (ogg_packet * op)
+{
+  if (op->bytes == 0)
+    return gst_buffer_new ();
+
+  return gst_buffer_new_wrapped (g_memdup (op->packet, op->bytes), op->bytes);
+}
+
+/* Encodes NUM_FRAMES frames, returns the headers followed by the data
+ * packets */
+static GPtrArray *
+encode_stream (void)
+{
+  GPtrArray *packets;
+  th_ycbcr_buffer img;
+  th_enc_ctx *enc;
+  th_comment tc;
+  th_info ti;
+  ogg_packet op;
+  gint comp, n;
+
+  th_info_init (&ti);
+  ti.frame_width = FRAME_WIDTH;
+  ti.frame_height = FRAME_HEIGHT;
+  ti.pic_x = PIC_X;
+  ti.pic_y = PIC_Y;
+  ti.pic_width = PIC_WIDTH;
+  ti.pic_height = PIC_HEIGHT;
+  ti.fps_numerator = 25;
+  ti.fps_denominator = 1;
+  ti.aspect_numerator = 1;
+  ti.aspect_denominator = 1;
+  ti.colorspace = TH_CS_UNSPECIFIED;
+  ti.pixel_fmt = TH_PF_420;
+  ti.quality = 48;
+
+  enc = th_encode_alloc (&ti);
+  fail_unless (enc != NULL);
+  th_info_clear (&ti);
+
+  packets = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_buffer_unref);
+
+  th_comment_init (&tc);
+  while (th_encode_flushheader (enc, &tc, &op) > 0)
+    g_ptr_array_add (packets, buffer_from_packet (&op));
+  th_comment_clear (&tc);
+  fail_unless_equals_int (packets->len, NUM_HEADERS);
+
+  for (comp = 0; comp < 3; comp++) {
+    img[comp].width = comp ? FRAME_WIDTH / 2 : FRAME_WIDTH;
+    img[comp].height = comp ? FRAME_HEIGHT / 2 : FRAME_HEIGHT;
+    img[comp].stride = img[comp].width;
+    img[comp].data = g_malloc (img[comp].stride * img[comp].height);
+  }
+
+  for (n = 0; n < NUM_FRAMES; n++) {
+    fill_image (img, n);
+    fail_unless_equals_int (th_encode_ycbcr_in (enc, img), 0);
+    while (th_encode_packetout (enc, n == NUM_FRAMES - 1, &op) > 0)
+      g_ptr_array_add (packets, buffer_from_packet (&op));
+
+    if (n == DUP_FRAME)
+      g_ptr_array_add (packets, gst_buffer_new ());
+  }
+
+  for (comp = 0; comp < 3; comp++)
+    g_free (img[comp].data);
+  th_encode_free (enc);
+
+  return packets;
+}
+
+/* Decodes @packets with libtheora's whole-frame output and returns the
+ * cropped I420 pictures, one per data packet */
+static GPtrArray *
+decode_reference (GPtrArray * packets, GstVideoInfo * vinfo)
+{
+  th_setup_info *setup = NULL;
+  th_dec_ctx *dec = NULL;
+  GPtrArray *frames;
+  th_comment tc;
+  th_info ti;
+  guint i;
+
+  frames = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_buffer_unref);
+
+  th_info_init (&ti);
+  th_comment_init (&tc);
+
+  for (i = 0; i < packets->len; i++) {
+    GstBuffer *buf = g_ptr_array_index (packets, i);
+    th_ycbcr_buffer ycbcr;
+    GstVideoFrame frame;
+    GstBuffer *out;
+    ogg_packet op = { 0, };
+    GstMapInfo map;
+    gint comp, y;
+
+    gst_buffer_map (buf, &map, GST_MAP_READ);
+    op.packet = map.data;
+    op.bytes = map.size;
+    op.b_o_s = (i == 0);
+    op.granulepos = -1;
+    op.packetno = i;
+
+    if (i < NUM_HEADERS) {
+      fail_unless (th_decode_headerin (&ti, &tc, &setup, &op) > 0);
+      gst_buffer_unmap (buf, &map);
+      if (i == NUM_HEADERS - 1) {
+        dec = th_decode_alloc (&ti, setup);
+        fail_unless (dec != NULL);
+      }
+      continue;
+    }
+
+    /* a zero-length packet gives TH_DUPFRAME */
+    fail_unless (th_decode_packetin (dec, &op, NULL) >= 0);
+    gst_buffer_unmap (buf, &map);
+    fail_unless_equals_int (th_decode_ycbcr_out (dec, ycbcr), 0);
+
+    out = gst_buffer_new_and_alloc (GST_VIDEO_INFO_SIZE (vinfo));
+    fail_unless (gst_video_frame_map (&frame, vinfo, out, GST_MAP_WRITE));
+    for (comp = 0; comp < 3; comp++) {
+      gint shift = comp ? 1 : 0;
+      guint8 *src = ycbcr[comp].data +
+          (PIC_Y >> shift) * ycbcr[comp].stride + (PIC_X >> shift);
+      guint8 *dest = GST_VIDEO_FRAME_COMP_DATA (&frame, comp);
+
+      for (y = 0; y < GST_VIDEO_FRAME_COMP_HEIGHT (&frame, comp); y++) {
+        memcpy (dest, src, GST_VIDEO_FRAME_COMP_WIDTH (&frame, comp));
+        dest += GST_VIDEO_FRAME_COMP_STRIDE (&frame, comp);
+        src += ycbcr[comp].stride;
+      }
+    }
+    gst_video_frame_unmap (&frame);
+
+    g_ptr_array_add (frames, out);
+  }
+
+  th_setup_free (setup);
+  th_comment_clear (&tc);
+  th_info_clear (&ti);
+  th_decode_free (dec);
+
+  return frames;
+}
+
+static void
+compare_frames (GstBuffer * buf, GstVideoInfo * out_info, GstBuffer * ref,
+    GstVideoInfo * ref_info, guint n)
+{
+  GstVideoFrame frame, ref_frame;
+  gint comp, y;
+
+  fail_unless (gst_video_frame_map (&frame, out_info, buf, GST_MAP_READ));
+  fail_unless (gst_video_frame_map (&ref_frame, ref_info, ref, GST_MAP_READ));
+
+  for (comp = 0; comp < 3; comp++) {
+    for (y = 0; y < GST_VIDEO_FRAME_COMP_HEIGHT (&frame, comp); y++) {
+      const guint8 *line = (const guint8 *)
+          GST_VIDEO_FRAME_COMP_DATA (&frame, comp) +
+          y * GST_VIDEO_FRAME_COMP_STRIDE (&frame, comp);
+      const guint8 *ref_line = (const guint8 *)
+          GST_VIDEO_FRAME_COMP_DATA (&ref_frame, comp) +
+          y * GST_VIDEO_FRAME_COMP_STRIDE (&ref_frame, comp);
+
+      fail_unless (memcmp (line, ref_line,
+              GST_VIDEO_FRAME_COMP_WIDTH (&frame, comp)) == 0,
+          "frame %u differs in component %d, line %d", n, comp, y);
+    }
+  }
+
+  gst_video_frame_unmap (&ref_frame);
+  gst_video_frame_unmap (&frame);
+}
+
+/* theoradec copies the picture from libtheora's stripe callback while
+ * decoding, and the whole frame only for duplicate frames. Both have to
+ * give the same pictures as libtheora's whole-frame output. */
+GST_START_TEST (test_stripe_output)
+{
+  GPtrArray *packets, *reference;
+  GstVideoInfo ref_info, out_info;
+  GstHarness *h;
+  GstCaps *caps;
+  guint i, n = 0;
+
+  packets = encode_stream ();
+  gst_video_info_set_format (&ref_info, GST_VIDEO_FORMAT_I420, PIC_WIDTH,
+      PIC_HEIGHT);
+  reference = decode_reference (packets, &ref_info);
+  fail_unless_equals_int (reference->len, NUM_FRAMES + 1);
+
+  h = gst_harness_new ("theoradec");
+  gst_harness_set_src_caps_str (h, "video/x-theora");
+
+  for (i = 0; i < packets->len; i++) {
+    GstBuffer *buf = gst_buffer_ref (g_ptr_array_index (packets, i));
+    GstBuffer *out;
+
+    if (i >= NUM_HEADERS) {
+      GST_BUFFER_PTS (buf) = gst_util_uint64_scale (n, GST_SECOND, 25);
+      GST_BUFFER_DURATION (buf) = GST_SECOND / 25;
+    }
+    fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+
+    if (i < NUM_HEADERS)
+      continue;
+
+    out = gst_harness_pull (h);
+    fail_unless (out != NULL);
+    /* the harness doesn't support crop metas, the picture is cropped */
+    fail_if (gst_buffer_get_video_crop_meta (out) != NULL);
+
+    if (n == 0) {
+      caps = gst_pad_get_current_caps (h->sinkpad);
+      fail_unless (gst_video_info_from_caps (&out_info, caps));
+      gst_caps_unref (caps);
+      fail_unless_equals_int (GST_VIDEO_INFO_FORMAT (&out_info),
+          GST_VIDEO_FORMAT_I420);
+      fail_unless_equals_int (GST_VIDEO_INFO_WIDTH (&out_info), PIC_WIDTH);
+      fail_unless_equals_int (GST_VIDEO_INFO_HEIGHT (&out_info), PIC_HEIGHT);
+    }
+
+    compare_frames (out, &out_info, g_ptr_array_index (reference, n),
+        &ref_info, n);
+    gst_buffer_unref (out);
+    n++;
+  }
+  fail_unless_equals_int (n, NUM_FRAMES + 1);
+
+  gst_harness_teardown (h);
+  g_ptr_array_unref (reference);
+  g_ptr_array_unref (packets);
+}
+
+GST_END_TEST;
+
+static Suite *
+theoradec_suite (void)
+{
+  Suite *s = suite_create ("theoradec");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_stripe_output);
+
+  return s;
+}
+
+GST_CHECK_MAIN (theoradec);
@@ -477,6 +477,173 @@ GST_START_TEST (test_manifest_typefinding)
 
 GST_END_TEST;
 
+typedef struct
+{
+  const guint8 *data;
+  gsize size;
+  GstTypeFindProbability prob;
+  guint64 peek_end;
+} FactoryTypeFind;
+
+static const guint8 *
+factory_type_find_peek (gpointer data, gint64 offset, guint size)
+{
+  FactoryTypeFind *ft = data;
+
+  if (offset < 0 || offset + size > ft->size)
+    return NULL;
+
+  ft->peek_end = MAX (ft->peek_end, offset + size);
+  return ft->data + offset;
+}
+
+static void
+factory_type_find_suggest (gpointer data, guint probability, GstCaps * caps)
+{
+  FactoryTypeFind *ft = data;
+
+  ft->prob = MAX (ft->prob, probability);
+}
+
+/* runs a single typefind function on @data, @peek_end is set to the end of
+ * the data it looked at if not %NULL */
+static GstTypeFindProbability
+typefind_data_with_factory_full (const gchar * name, const guint8 * data,
+    gsize size, guint64 * peek_end)
+{
+  FactoryTypeFind ft = { data, size, GST_TYPE_FIND_NONE, 0 };
+  GstPluginFeature *feature;
+  GstTypeFind tf = { NULL, };
+
+  tf.peek = factory_type_find_peek;
+  tf.suggest = factory_type_find_suggest;
+  tf.data = &ft;
+
+  feature = gst_registry_lookup_feature (gst_registry_get (), name);
+  fail_unless (feature != NULL);
+  gst_type_find_factory_call_function (GST_TYPE_FIND_FACTORY (feature), &tf);
+  gst_object_unref (feature);
+
+  if (peek_end)
+    *peek_end = ft.peek_end;
+
+  return ft.prob;
+}
+
+static GstTypeFindProbability
+typefind_data_with_factory (const gchar * name, const guint8 * data,
+    gsize size)
+{
+  return typefind_data_with_factory_full (name, data, size, NULL);
+}
+
+GST_START_TEST (test_magic_prefix_skips_scanning)
+{
+  const guint8 flv_header[] = { 'F', 'L', 'V', 0x01, 0x05, 0x00, 0x00, 0x00,
+    0x09
+  };
+  GstTypeFindProbability prob;
+  GstCaps *caps;
+  gsize size = 16 + (256 + 640) * 2;
+  guint8 *data;
+
+  /* ac3 frames after some padding */
+  data = g_malloc0 (size);
+  make_ac3_packet (data + 16, 256 * 2, 8);
+  make_ac3_packet (data + 16 + 256 * 2, 640 * 2, 8);
+  prob = typefind_data_with_factory ("audio/x-ac3", data, size);
+  fail_unless (prob > GST_TYPE_FIND_NONE);
+
+  /* with an flv header in front the ac3 typefinder doesn't scan at all */
+  memcpy (data, flv_header, sizeof (flv_header));
+  prob = typefind_data_with_factory ("audio/x-ac3", data, size);
+  fail_unless_equals_int (prob, GST_TYPE_FIND_NONE);
+
+  caps = typefind_data (data, size, &prob);
+  fail_unless (caps != NULL);
+  fail_unless_equals_string (gst_structure_get_name (gst_caps_get_structure
+          (caps, 0)), "video/x-flv");
+  fail_unless_equals_int (prob, GST_TYPE_FIND_MAXIMUM);
+  gst_caps_unref (caps);
+
+  g_free (data);
+}
+
+GST_END_TEST;
+
+/* h264 NALs after a long run of junk, so the scanner has to skip ahead */
+static guint8 *
+make_h264_stream (gsize * size, guint8 nal_flags)
+{
+  const gsize junk = 1000, nal_size = 4 + 1 + 200, num_nals = 64;
+  guint8 *data, *nal;
+  guint i;
+
+  *size = junk + num_nals * nal_size;
+  data = g_malloc (*size);
+  memset (data, 0x55, junk);
+
+  for (i = 0; i < num_nals; i++) {
+    nal = data + junk + i * nal_size;
+    GST_WRITE_UINT32_BE (nal, 0x00000001);
+    /* SPS, PPS, then IDR slices */
+    nal[4] = nal_flags | (i == 0 ? 7 : (i == 1 ? 8 : 5));
+    memset (nal + 5, 0xaa, nal_size - 5);
+  }
+
+  return data;
+}
+
+GST_START_TEST (test_shared_scan_window)
+{
+  GstTypeFindProbability prob;
+  guint8 *data;
+  gsize size;
+
+  data = make_h264_stream (&size, 0x60);
+  prob = typefind_data_with_factory ("video/x-h264", data, size);
+  fail_unless_equals_int (prob, GST_TYPE_FIND_LIKELY);
+
+  /* again, now reusing the indexed window */
+  prob = typefind_data_with_factory ("video/x-h264", data, size);
+  fail_unless_equals_int (prob, GST_TYPE_FIND_LIKELY);
+  g_free (data);
+
+  /* same size, different data: the window must not be reused, the
+   * forbidden bit is set so this is not h264 */
+  data = make_h264_stream (&size, 0x80);
+  prob = typefind_data_with_factory ("video/x-h264", data, size);
+  fail_unless_equals_int (prob, GST_TYPE_FIND_NONE);
+  g_free (data);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_scan_window_reads_little)
+{
+  GstTypeFindProbability prob;
+  guint64 peek_end;
+  guint8 *nals, *data;
+  gsize nals_size, size = 512 * 1024;
+
+  /* the stream is identified in the first few KiB, the scan window
+   * shouldn't make the scanner look at much more than that */
+  nals = make_h264_stream (&nals_size, 0x60);
+  data = g_malloc (size);
+  memcpy (data, nals, nals_size);
+  memset (data + nals_size, 0x55, size - nals_size);
+  g_free (nals);
+
+  prob = typefind_data_with_factory_full ("video/x-h264", data, size,
+      &peek_end);
+  fail_unless_equals_int (prob, GST_TYPE_FIND_LIKELY);
+  fail_unless (peek_end <= 16 * 1024, "peeked up to %" G_GUINT64_FORMAT,
+      peek_end);
+  g_free (data);
+}
+
+GST_END_TEST;
+
 static Suite *
 typefindfunctions_suite (void)
 {
@@ -494,6 +661,9 @@ typefindfunctions_suite (void)
   tcase_add_test (tc_chain, test_random_data);
   tcase_add_test (tc_chain, test_hls_m3u8);
   tcase_add_test (tc_chain, test_manifest_typefinding);
+  tcase_add_test (tc_chain, test_magic_prefix_skips_scanning);
+  tcase_add_test (tc_chain, test_shared_scan_window);
+  tcase_add_test (tc_chain, test_scan_window_reads_little);
 
   return s;
 }
@@ -74,6 +74,7 @@ struct _GstAudioDecoderTester
   gboolean setoutputformat_on_decoding;
   gboolean output_too_many_frames;
   gboolean delay_decoding;
+  gboolean use_output_allocator;
   GstBuffer *prev_buf;
 };
 
@@ -173,7 +174,13 @@ gst_audio_decoder_tester_handle_frame (GstAudioDecoder * dec,
         memcpy (data, map.data, sizeof (guint64));
       }
 
-      output_buffer = gst_buffer_new_wrapped (data, size);
+      if (tester->use_output_allocator) {
+        output_buffer = gst_audio_decoder_allocate_output_buffer (dec, size);
+        gst_buffer_fill (output_buffer, 0, data, size);
+        g_free (data);
+      } else {
+        output_buffer = gst_buffer_new_wrapped (data, size);
+      }
 
       gst_buffer_unmap (cur_buf, &map);
 
@@ -313,6 +320,89 @@ GST_START_TEST (audiodecoder_playback)
 
 GST_END_TEST;
 
+GST_START_TEST (audiodecoder_output_buffer_pool)
+{
+  GstBuffer *buffer;
+  GstBufferPool *pool = NULL;
+  guint64 i;
+
+  GstHarness *h = setup_audiodecodertester (NULL, NULL);
+
+  ((GstAudioDecoderTester *) h->element)->use_output_allocator = TRUE;
+
+  for (i = 0; i < NUM_BUFFERS; i++) {
+    GstMapInfo map;
+
+    fail_unless (gst_harness_push (h, create_test_buffer (i)) == GST_FLOW_OK);
+
+    buffer = gst_harness_pull (h);
+
+    /* all output buffers are from the same pool */
+    fail_unless (buffer->pool != NULL);
+    if (pool == NULL)
+      pool = buffer->pool;
+    fail_unless (buffer->pool == pool);
+
+    gst_buffer_map (buffer, &map, GST_MAP_READ);
+    fail_unless_equals_int (map.size, sizeof (guint64));
+    fail_unless_equals_uint64 (i, *(guint64 *) map.data);
+    gst_buffer_unmap (buffer, &map);
+
+    gst_buffer_unref (buffer);
+  }
+
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (audiodecoder_buffer_list)
+{
+  GstBufferList *list;
+  GstBuffer *buffer;
+  GstMapInfo map;
+  guint64 i;
+
+  GstHarness *h = setup_audiodecodertester (NULL, NULL);
+
+  ((GstAudioDecoderTester *) h->element)->use_output_allocator = TRUE;
+
+  /* get caps and segment out of the way */
+  fail_unless (gst_harness_push (h, create_test_buffer (0)) == GST_FLOW_OK);
+  gst_buffer_unref (gst_harness_pull (h));
+
+  list = gst_buffer_list_new ();
+  for (i = 1; i <= NUM_BUFFERS; i++)
+    gst_buffer_list_add (list, create_test_buffer (i));
+
+  fail_unless (gst_pad_push_list (h->srcpad, list) == GST_FLOW_OK);
+
+  /* the output of the whole list is collected into a single buffer */
+  fail_unless_equals_int (1, gst_harness_buffers_in_queue (h));
+  buffer = gst_harness_pull (h);
+
+  fail_unless_equals_uint64 (GST_BUFFER_PTS (buffer),
+      gst_util_uint64_scale_round (1, GST_SECOND, TEST_MSECS_PER_SAMPLE));
+  fail_unless_equals_uint64 (GST_BUFFER_DURATION (buffer),
+      NUM_BUFFERS * gst_util_uint64_scale_round (1, GST_SECOND,
+          TEST_MSECS_PER_SAMPLE));
+
+  gst_buffer_map (buffer, &map, GST_MAP_READ);
+  fail_unless_equals_int (map.size, NUM_BUFFERS * sizeof (guint64));
+  for (i = 0; i < NUM_BUFFERS; i++)
+    fail_unless_equals_uint64 (i + 1, ((guint64 *) map.data)[i]);
+  gst_buffer_unmap (buffer, &map);
+  gst_buffer_unref (buffer);
+
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+  fail_unless_equals_int (0, gst_harness_buffers_in_queue (h));
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
 
 static void
 check_audiodecoder_negotiation (GstHarness * h)
@@ -1144,6 +1234,8 @@ gst_audiodecoder_suite (void)
 
   suite_add_tcase (s, tc);
   tcase_add_test (tc, audiodecoder_playback);
+  tcase_add_test (tc, audiodecoder_output_buffer_pool);
+  tcase_add_test (tc, audiodecoder_buffer_list);
   tcase_add_test (tc, audiodecoder_negotiation_with_buffer);
 
   tcase_add_test (tc, audiodecoder_negotiation_with_gap_event);
@@ -41,6 +41,11 @@ typedef struct _GstAudioEncoderTesterClass GstAudioEncoderTesterClass;
 struct _GstAudioEncoderTester
 {
   GstAudioEncoder parent;
+
+  /* encode this many frames per input buffer */
+  gint frames_per_buffer;
+  guint64 frames_out;
+  GstMemory *last_input_memory;
 };
 
 struct _GstAudioEncoderTesterClass
@@ -66,8 +71,17 @@ gst_audio_encoder_tester_stop (GstAudioEncoder * enc)
 static gboolean
 gst_audio_encoder_tester_set_format (GstAudioEncoder * enc, GstAudioInfo * info)
 {
+  GstAudioEncoderTester *tester = (GstAudioEncoderTester *) enc;
   GstCaps *caps;
 
+  if (tester->frames_per_buffer > 0) {
+    gint frame_samples = TEST_AUDIO_RATE / tester->frames_per_buffer;
+
+    gst_audio_encoder_set_frame_samples_min (enc, frame_samples);
+    gst_audio_encoder_set_frame_samples_max (enc, frame_samples);
+    gst_audio_encoder_set_frame_max (enc, tester->frames_per_buffer);
+  }
+
   caps = gst_caps_new_simple ("audio/x-test-custom", "rate", G_TYPE_INT,
       TEST_AUDIO_RATE, "channels", G_TYPE_INT, TEST_AUDIO_CHANNELS, NULL);
   gst_audio_encoder_set_output_format (enc, caps);
@@ -80,6 +94,7 @@ static GstFlowReturn
 gst_audio_encoder_tester_handle_frame (GstAudioEncoder * enc,
     GstBuffer * buffer)
 {
+  GstAudioEncoderTester *tester = (GstAudioEncoderTester *) enc;
   guint8 *data;
   GstMapInfo map;
   guint64 input_num;
@@ -88,6 +103,24 @@ gst_audio_encoder_tester_handle_frame (GstAudioEncoder * enc,
   if (buffer == NULL)
     return GST_FLOW_OK;
 
+  tester->last_input_memory = gst_buffer_peek_memory (buffer, 0);
+
+  if (tester->frames_per_buffer > 0) {
+    gint frame_samples = TEST_AUDIO_RATE / tester->frames_per_buffer;
+    gsize frames = gst_buffer_get_size (buffer) / (frame_samples * 2 * 2);
+    GstFlowReturn ret = GST_FLOW_OK;
+
+    while (frames-- && ret == GST_FLOW_OK) {
+      data = g_malloc (sizeof (guint64));
+      *(guint64 *) data = tester->frames_out++;
+
+      output_buffer = gst_buffer_new_wrapped (data, sizeof (guint64));
+      ret = gst_audio_encoder_finish_frame (enc, output_buffer, frame_samples);
+    }
+
+    return ret;
+  }
+
   gst_buffer_map (buffer, &map, GST_MAP_READ);
   input_num = *((guint64 *) map.data);
   gst_buffer_unmap (buffer, &map);
@@ -313,6 +346,93 @@ GST_START_TEST (audioencoder_flush_events)
 
 GST_END_TEST;
 
+GST_START_TEST (audioencoder_zero_copy_input)
+{
+  GstAudioEncoderTester *tester;
+  GstBuffer *buffer;
+  GstMemory *mem;
+  guint64 i;
+
+  GstHarness *h = setup_audioencodertester ();
+  tester = (GstAudioEncoderTester *) h->element;
+
+  /* every input buffer is exactly one frame, so the subclass gets to see
+   * the input memory itself */
+  for (i = 0; i < NUM_BUFFERS; i++) {
+    buffer = create_test_buffer (i);
+    mem = gst_buffer_peek_memory (buffer, 0);
+
+    fail_unless (gst_harness_push (h, buffer) == GST_FLOW_OK);
+    fail_unless (tester->last_input_memory == mem);
+
+    gst_buffer_unref (gst_harness_pull (h));
+  }
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+static GstPadProbeReturn
+count_buffer_lists (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  guint *n_lists = user_data;
+
+  *n_lists += 1;
+
+  return GST_PAD_PROBE_OK;
+}
+
+#define FRAMES_PER_BUFFER 4
+GST_START_TEST (audioencoder_frame_batching)
+{
+  GstBuffer *buffer;
+  GstPad *srcpad;
+  guint n_lists = 0;
+  guint64 i;
+
+  GstHarness *h = setup_audioencodertester ();
+
+  ((GstAudioEncoderTester *) h->element)->frames_per_buffer =
+      FRAMES_PER_BUFFER;
+
+  srcpad = gst_element_get_static_pad (h->element, "src");
+  gst_pad_add_probe (srcpad, GST_PAD_PROBE_TYPE_BUFFER_LIST,
+      count_buffer_lists, &n_lists, NULL);
+  gst_object_unref (srcpad);
+
+  for (i = 0; i < NUM_BUFFERS; i++)
+    fail_unless (gst_harness_push (h, create_test_buffer (i)) == GST_FLOW_OK);
+
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+
+  /* all frames of an input buffer were pushed downstream as one list */
+  fail_unless_equals_int (n_lists, NUM_BUFFERS);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h),
+      NUM_BUFFERS * FRAMES_PER_BUFFER);
+
+  for (i = 0; i < NUM_BUFFERS * FRAMES_PER_BUFFER; i++) {
+    GstMapInfo map;
+
+    buffer = gst_harness_pull (h);
+
+    gst_buffer_map (buffer, &map, GST_MAP_READ);
+    fail_unless_equals_uint64 (*(guint64 *) map.data, i);
+    gst_buffer_unmap (buffer, &map);
+
+    fail_unless_equals_uint64 (GST_BUFFER_PTS (buffer),
+        i * GST_SECOND / FRAMES_PER_BUFFER);
+    fail_unless_equals_uint64 (GST_BUFFER_DURATION (buffer),
+        GST_SECOND / FRAMES_PER_BUFFER);
+
+    gst_buffer_unref (buffer);
+  }
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 /* make sure tags sent right before eos are pushed */
 GST_START_TEST (audioencoder_tags_before_eos)
 {
@@ -403,6 +523,8 @@ gst_audioencoder_suite (void)
 
   suite_add_tcase (s, tc);
   tcase_add_test (tc, audioencoder_playback);
+  tcase_add_test (tc, audioencoder_zero_copy_input);
+  tcase_add_test (tc, audioencoder_frame_batching);
 
   tcase_add_test (tc, audioencoder_tags_before_eos);
   tcase_add_test (tc, audioencoder_events_before_eos);
@@ -48,6 +48,10 @@ typedef struct _GstRtpDummyPayClass GstRtpDummyPayClass;
 struct _GstRtpDummyPay
 {
   GstRTPBasePayload payload;
+
+  /* push every packet only when the next input buffer is handled */
+  gboolean delay;
+  GstBuffer *delayed;
 };
 
 struct _GstRtpDummyPayClass
@@ -59,6 +63,7 @@ GType gst_rtp_dummy_pay_get_type (void);
 
 G_DEFINE_TYPE (GstRtpDummyPay, gst_rtp_dummy_pay, GST_TYPE_RTP_BASE_PAYLOAD);
 
+static void gst_rtp_dummy_pay_finalize (GObject * object);
 static GstFlowReturn gst_rtp_dummy_pay_handle_buffer (GstRTPBasePayload * pay,
     GstBuffer * buffer);
 
@@ -77,12 +82,16 @@ GST_STATIC_PAD_TEMPLATE ("src",
 static void
 gst_rtp_dummy_pay_class_init (GstRtpDummyPayClass * klass)
 {
+  GObjectClass *gobject_class;
   GstElementClass *gstelement_class;
   GstRTPBasePayloadClass *gstrtpbasepayload_class;
 
+  gobject_class = G_OBJECT_CLASS (klass);
   gstelement_class = GST_ELEMENT_CLASS (klass);
   gstrtpbasepayload_class = GST_RTP_BASE_PAYLOAD_CLASS (klass);
 
+  gobject_class->finalize = gst_rtp_dummy_pay_finalize;
+
   gst_element_class_add_static_pad_template (gstelement_class,
       &gst_rtp_dummy_pay_sink_template);
   gst_element_class_add_static_pad_template (gstelement_class,
@@ -98,6 +107,16 @@ gst_rtp_dummy_pay_init (GstRtpDummyPay * pay)
       TRUE, "dummy", DEFAULT_CLOCK_RATE);
 }
 
+static void
+gst_rtp_dummy_pay_finalize (GObject * object)
+{
+  GstRtpDummyPay *pay = GST_RTP_DUMMY_PAY (object);
+
+  gst_buffer_replace (&pay->delayed, NULL);
+
+  G_OBJECT_CLASS (gst_rtp_dummy_pay_parent_class)->finalize (object);
+}
+
 static GstRtpDummyPay *
 rtp_dummy_pay_new (void)
 {
@@ -108,6 +127,7 @@ static GstFlowReturn
 gst_rtp_dummy_pay_handle_buffer (GstRTPBasePayload * pay, GstBuffer * buffer)
 {
   GstBuffer *paybuffer;
+  GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
 
   GST_LOG ("payloading buffer pts=%" GST_TIME_FORMAT " offset=%"
       G_GUINT64_FORMAT, GST_TIME_ARGS (GST_BUFFER_PTS (buffer)),
@@ -125,6 +145,11 @@ gst_rtp_dummy_pay_handle_buffer (GstRTPBasePayload * pay, GstBuffer * buffer)
       gst_rtp_base_payload_allocate_output_buffer (GST_RTP_BASE_PAYLOAD (pay),
       0, 0, 0);
 
+  /* every input buffer is considered a complete frame */
+  gst_rtp_buffer_map (paybuffer, GST_MAP_WRITE, &rtp);
+  gst_rtp_buffer_set_marker (&rtp, TRUE);
+  gst_rtp_buffer_unmap (&rtp);
+
   GST_BUFFER_PTS (paybuffer) = GST_BUFFER_PTS (buffer);
   GST_BUFFER_OFFSET (paybuffer) = GST_BUFFER_OFFSET (buffer);
 
@@ -134,6 +159,15 @@ gst_rtp_dummy_pay_handle_buffer (GstRTPBasePayload * pay, GstBuffer * buffer)
       G_GUINT64_FORMAT, GST_TIME_ARGS (GST_BUFFER_PTS (paybuffer)),
       GST_BUFFER_OFFSET (paybuffer));
 
+  if (GST_RTP_DUMMY_PAY (pay)->delay) {
+    GstBuffer *delayed = GST_RTP_DUMMY_PAY (pay)->delayed;
+
+    GST_RTP_DUMMY_PAY (pay)->delayed = paybuffer;
+    if (delayed == NULL)
+      return GST_FLOW_OK;
+    paybuffer = delayed;
+  }
+
   if (GST_BUFFER_PTS (paybuffer) < BUFFER_BEFORE_LIST) {
     return gst_rtp_base_payload_push (pay, paybuffer);
   } else {
@@ -349,6 +383,13 @@ push_buffer_full (State * state, GstFlowReturn expected,
       } else {
         GST_BUFFER_FLAG_UNSET (buf, GST_BUFFER_FLAG_DISCONT);
       }
+    } else if (!g_strcmp0 (field, "marker")) {
+      gboolean marker = va_arg (var_args, gboolean);
+      if (marker) {
+        GST_BUFFER_FLAG_SET (buf, GST_BUFFER_FLAG_MARKER);
+      } else {
+        GST_BUFFER_FLAG_UNSET (buf, GST_BUFFER_FLAG_MARKER);
+      }
     } else {
       if (!mapped) {
         gst_rtp_buffer_map (buf, GST_MAP_WRITE, &rtp);
@@ -490,6 +531,9 @@ validate_buffer_valist (GstBuffer * buf, const gchar * field, va_list var_args)
         guint csrc_count = va_arg (var_args, guint);
         fail_unless_equals_int (gst_rtp_buffer_get_csrc_count (&rtp),
             csrc_count);
+      } else if (!g_strcmp0 (field, "marker")) {
+        gboolean marker = va_arg (var_args, gboolean);
+        fail_unless_equals_int (gst_rtp_buffer_get_marker (&rtp), marker);
       } else {
         fail ("test cannot validate unknown buffer field '%s'", field);
       }
@@ -1854,6 +1898,80 @@ GST_START_TEST (rtp_base_payload_property_source_info_test)
 
 GST_END_TEST;
 
+/* with subframe-input, only the part of a frame that carries the MARKER flag
+ * gets the RTP marker bit, all parts of a frame share the RTP timestamp */
+GST_START_TEST (rtp_base_payload_property_subframe_input_test)
+{
+  State *state;
+  guint32 rtptime;
+  guint16 seq;
+
+  state = create_payloader ("application/x-rtp", &sinktmpl,
+      "perfect-rtptime", FALSE, "subframe-input", TRUE, NULL);
+
+  set_state (state, GST_STATE_PLAYING);
+
+  push_buffer (state, "pts", 0 * GST_SECOND, "marker", FALSE, NULL);
+  push_buffer (state, "pts", 0 * GST_SECOND, "marker", FALSE, NULL);
+  push_buffer (state, "pts", 0 * GST_SECOND, "marker", TRUE, NULL);
+  push_buffer (state, "pts", 1 * GST_SECOND, "marker", TRUE, NULL);
+
+  /* parts are pushed right away, without changing when packets are full */
+  fail_unless (gst_rtp_base_payload_needs_subframe_flush (GST_RTP_BASE_PAYLOAD
+          (state->element)));
+  fail_if (gst_rtp_base_payload_is_filled (GST_RTP_BASE_PAYLOAD
+          (state->element), 0, 0));
+
+  set_state (state, GST_STATE_NULL);
+
+  validate_buffers_received (4);
+
+  validate_buffer (0, "pts", 0 * GST_SECOND, "marker", FALSE, NULL);
+  get_buffer_field (0, "rtptime", &rtptime, "seq", &seq, NULL);
+
+  validate_buffer (1, "rtptime", rtptime, "seq", seq + 1, "marker", FALSE,
+      NULL);
+  validate_buffer (2, "rtptime", rtptime, "seq", seq + 2, "marker", TRUE,
+      NULL);
+  validate_buffer (3, "rtptime", rtptime + 1 * DEFAULT_CLOCK_RATE,
+      "seq", seq + 3, "marker", TRUE, NULL);
+
+  destroy_payloader (state);
+}
+
+GST_END_TEST;
+
+/* with subframe-input, whether a packet ends a frame is decided when its data
+ * is payloaded, also if it is only pushed while handling a later input
+ * buffer */
+GST_START_TEST (rtp_base_payload_property_subframe_input_delayed_test)
+{
+  State *state;
+
+  state = create_payloader ("application/x-rtp", &sinktmpl,
+      "perfect-rtptime", FALSE, "subframe-input", TRUE, NULL);
+  GST_RTP_DUMMY_PAY (state->element)->delay = TRUE;
+
+  set_state (state, GST_STATE_PLAYING);
+
+  push_buffer (state, "pts", 0 * GST_SECOND, "marker", FALSE, NULL);
+  push_buffer (state, "pts", 0 * GST_SECOND, "marker", TRUE, NULL);
+  push_buffer (state, "pts", 1 * GST_SECOND, "marker", FALSE, NULL);
+  push_buffer (state, "pts", 1 * GST_SECOND, "marker", TRUE, NULL);
+
+  set_state (state, GST_STATE_NULL);
+
+  validate_buffers_received (3);
+
+  validate_buffer (0, "pts", 0 * GST_SECOND, "marker", FALSE, NULL);
+  validate_buffer (1, "pts", 0 * GST_SECOND, "marker", TRUE, NULL);
+  validate_buffer (2, "pts", 1 * GST_SECOND, "marker", FALSE, NULL);
+
+  destroy_payloader (state);
+}
+
+GST_END_TEST;
+
 /* push a single buffer to the payloader which should successfully payload it
  * into an RTP packet. besides the payloaded RTP packet there should be the
  * three events initial events: stream-start, caps and segment. because of that
@@ -2050,6 +2168,9 @@ rtp_basepayloading_suite (void)
   tcase_add_test (tc_chain, rtp_base_payload_property_ptime_multiple_test);
   tcase_add_test (tc_chain, rtp_base_payload_property_stats_test);
   tcase_add_test (tc_chain, rtp_base_payload_property_source_info_test);
+  tcase_add_test (tc_chain, rtp_base_payload_property_subframe_input_test);
+  tcase_add_test (tc_chain,
+      rtp_base_payload_property_subframe_input_delayed_test);
   tcase_add_test (tc_chain, rtp_base_payload_property_twcc_ext_id_test);
 
   tcase_add_test (tc_chain, rtp_base_payload_framerate_attribute);
@@ -1084,6 +1084,147 @@ GST_START_TEST (test_convert_frame)
 
 GST_END_TEST;
 
+GST_START_TEST (test_convert_frame_raw)
+{
+  GstVideoInfo vinfo;
+  GstCaps *from_caps, *to_caps;
+  GstBuffer *from_buffer;
+  GstSample *from_sample, *to_sample;
+  GstVideoFrame frame;
+  GError *error = NULL;
+  const guint8 *y;
+  gint i;
+  GstMapInfo map;
+
+  from_buffer = gst_buffer_new_and_alloc (640 * 480 * 4);
+
+  gst_buffer_map (from_buffer, &map, GST_MAP_WRITE);
+  for (i = 0; i < 640 * 480; i++) {
+    map.data[4 * i + 0] = 0;    /* x */
+    map.data[4 * i + 1] = 255;  /* R */
+    map.data[4 * i + 2] = 255;  /* G */
+    map.data[4 * i + 3] = 255;  /* B */
+  }
+  gst_buffer_unmap (from_buffer, &map);
+
+  gst_video_info_init (&vinfo);
+  fail_unless (gst_video_info_set_format (&vinfo, GST_VIDEO_FORMAT_xRGB, 640,
+          480));
+  vinfo.fps_n = 25;
+  vinfo.fps_d = 1;
+  from_caps = gst_video_info_to_caps (&vinfo);
+  from_sample = gst_sample_new (from_buffer, from_caps, NULL, NULL);
+
+  /* square output, the 4:3 image gets black borders above and below */
+  fail_unless (gst_video_info_set_format (&vinfo, GST_VIDEO_FORMAT_I420, 320,
+          320));
+  to_caps = gst_video_info_to_caps (&vinfo);
+
+  /* twice, the second conversion reuses the cached converter */
+  for (i = 0; i < 2; i++) {
+    to_sample = gst_video_convert_sample (from_sample, to_caps,
+        GST_CLOCK_TIME_NONE, &error);
+    fail_unless (to_sample != NULL);
+    fail_unless (error == NULL);
+
+    fail_unless (gst_video_info_from_caps (&vinfo,
+            gst_sample_get_caps (to_sample)));
+    fail_unless_equals_int (GST_VIDEO_INFO_FORMAT (&vinfo),
+        GST_VIDEO_FORMAT_I420);
+    fail_unless_equals_int (GST_VIDEO_INFO_WIDTH (&vinfo), 320);
+    fail_unless_equals_int (GST_VIDEO_INFO_HEIGHT (&vinfo), 320);
+    fail_unless_equals_int (GST_VIDEO_INFO_FPS_N (&vinfo), 25);
+
+    fail_unless (gst_video_frame_map (&frame, &vinfo,
+            gst_sample_get_buffer (to_sample), GST_MAP_READ));
+    y = GST_VIDEO_FRAME_PLANE_DATA (&frame, 0);
+    /* border */
+    fail_unless_equals_int (y[0], 16);
+    /* image */
+    fail_unless_equals_int (y[160 * GST_VIDEO_FRAME_PLANE_STRIDE (&frame,
+                0) + 160], 235);
+    gst_video_frame_unmap (&frame);
+
+    gst_sample_unref (to_sample);
+  }
+
+  gst_buffer_unref (from_buffer);
+  gst_caps_unref (from_caps);
+  gst_sample_unref (from_sample);
+  gst_caps_unref (to_caps);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_convert_frame_raw_no_par)
+{
+  GstVideoInfo vinfo;
+  GstCaps *from_caps, *to_caps;
+  GstBuffer *from_buffer;
+  GstSample *from_sample, *to_sample;
+  GstVideoFrame frame;
+  GError *error = NULL;
+  const guint8 *y;
+  gint i;
+  GstMapInfo map;
+
+  from_buffer = gst_buffer_new_and_alloc (320 * 240 * 4);
+
+  gst_buffer_map (from_buffer, &map, GST_MAP_WRITE);
+  for (i = 0; i < 320 * 240; i++) {
+    map.data[4 * i + 0] = 0;    /* x */
+    map.data[4 * i + 1] = 255;  /* R */
+    map.data[4 * i + 2] = 255;  /* G */
+    map.data[4 * i + 3] = 255;  /* B */
+  }
+  gst_buffer_unmap (from_buffer, &map);
+
+  /* anamorphic 16:9 input */
+  gst_video_info_init (&vinfo);
+  fail_unless (gst_video_info_set_format (&vinfo, GST_VIDEO_FORMAT_xRGB, 320,
+          240));
+  vinfo.par_n = 4;
+  vinfo.par_d = 3;
+  vinfo.fps_n = 25;
+  vinfo.fps_d = 1;
+  from_caps = gst_video_info_to_caps (&vinfo);
+  from_sample = gst_sample_new (from_buffer, from_caps, NULL, NULL);
+
+  /* no pixel-aspect-ratio, it gets fixated to keep the DAR and the image
+   * fills the whole output */
+  to_caps = gst_caps_new_simple ("video/x-raw", "format", G_TYPE_STRING,
+      "I420", "width", G_TYPE_INT, 160, "height", G_TYPE_INT, 160, NULL);
+
+  to_sample = gst_video_convert_sample (from_sample, to_caps,
+      GST_CLOCK_TIME_NONE, &error);
+  fail_unless (to_sample != NULL);
+  fail_unless (error == NULL);
+
+  fail_unless (gst_video_info_from_caps (&vinfo,
+          gst_sample_get_caps (to_sample)));
+  fail_unless_equals_int (GST_VIDEO_INFO_WIDTH (&vinfo), 160);
+  fail_unless_equals_int (GST_VIDEO_INFO_HEIGHT (&vinfo), 160);
+  fail_unless_equals_int (GST_VIDEO_INFO_PAR_N (&vinfo), 16);
+  fail_unless_equals_int (GST_VIDEO_INFO_PAR_D (&vinfo), 9);
+
+  fail_unless (gst_video_frame_map (&frame, &vinfo,
+          gst_sample_get_buffer (to_sample), GST_MAP_READ));
+  y = GST_VIDEO_FRAME_PLANE_DATA (&frame, 0);
+  /* no borders */
+  fail_unless_equals_int (y[0], 235);
+  fail_unless_equals_int (y[159 * GST_VIDEO_FRAME_PLANE_STRIDE (&frame,
+              0) + 159], 235);
+  gst_video_frame_unmap (&frame);
+
+  gst_sample_unref (to_sample);
+  gst_buffer_unref (from_buffer);
+  gst_caps_unref (from_caps);
+  gst_sample_unref (from_sample);
+  gst_caps_unref (to_caps);
+}
+
+GST_END_TEST;
+
 typedef struct
 {
   GMainLoop *loop;
@@ -1228,6 +1369,111 @@ GST_START_TEST (test_convert_frame_async_error)
 
 GST_END_TEST;
 
+#ifndef GST_DISABLE_GST_DEBUG
+static gint converter_reused;
+
+static void
+count_converter_reuse_log (GstDebugCategory * category, GstDebugLevel level,
+    const gchar * file, const gchar * function, gint line, GObject * object,
+    GstDebugMessage * message, gpointer user_data)
+{
+  if (g_str_has_prefix (gst_debug_message_get (message),
+          "reusing cached converter"))
+    g_atomic_int_inc (&converter_reused);
+}
+#endif
+
+typedef struct
+{
+  GMainLoop *loop;
+  GstSample *sample;
+  GError *error;
+  GThread *thread;
+} ConvertFrameThreadContext;
+
+static void
+convert_sample_async_thread_callback (GstSample * sample, GError * err,
+    ConvertFrameThreadContext * cf_data)
+{
+  cf_data->sample = sample;
+  cf_data->error = err;
+  cf_data->thread = g_thread_self ();
+
+  g_main_loop_quit (cf_data->loop);
+}
+
+GST_START_TEST (test_convert_frame_async_raw_reuse)
+{
+  GstVideoInfo vinfo;
+  GstCaps *from_caps, *to_caps;
+  GstBuffer *from_buffer;
+  GstSample *from_sample;
+  GMainLoop *loop;
+  ConvertFrameThreadContext cf_data = { NULL, NULL, NULL, NULL };
+  gint i;
+
+#ifndef GST_DISABLE_GST_DEBUG
+  gst_debug_set_threshold_for_name ("default", GST_LEVEL_DEBUG);
+  gst_debug_add_log_function (count_converter_reuse_log, NULL, NULL);
+#endif
+
+  /* a size not used by any other test, so nothing is cached yet */
+  gst_video_info_init (&vinfo);
+  fail_unless (gst_video_info_set_format (&vinfo, GST_VIDEO_FORMAT_xRGB, 176,
+          144));
+  from_buffer = gst_buffer_new_and_alloc (GST_VIDEO_INFO_SIZE (&vinfo));
+  gst_buffer_memset (from_buffer, 0, 0x80, GST_VIDEO_INFO_SIZE (&vinfo));
+  from_caps = gst_video_info_to_caps (&vinfo);
+  from_sample = gst_sample_new (from_buffer, from_caps, NULL, NULL);
+  gst_buffer_unref (from_buffer);
+  gst_caps_unref (from_caps);
+
+  fail_unless (gst_video_info_set_format (&vinfo, GST_VIDEO_FORMAT_I420, 88,
+          72));
+  to_caps = gst_video_info_to_caps (&vinfo);
+
+  loop = cf_data.loop = g_main_loop_new (NULL, FALSE);
+
+  for (i = 0; i < 2; i++) {
+    gst_video_convert_sample_async (from_sample, to_caps,
+        GST_CLOCK_TIME_NONE,
+        (GstVideoConvertSampleCallback) convert_sample_async_thread_callback,
+        &cf_data, NULL);
+    g_main_loop_run (loop);
+    fail_unless (cf_data.sample != NULL);
+    fail_unless (cf_data.error == NULL);
+    /* the conversion ran on a worker, the result is dispatched from the
+     * main context */
+    fail_unless (cf_data.thread == g_thread_self ());
+
+    fail_unless (gst_video_info_from_caps (&vinfo,
+            gst_sample_get_caps (cf_data.sample)));
+    fail_unless_equals_int (GST_VIDEO_INFO_WIDTH (&vinfo), 88);
+    fail_unless_equals_int (GST_VIDEO_INFO_HEIGHT (&vinfo), 72);
+    gst_sample_unref (cf_data.sample);
+    cf_data.sample = NULL;
+
+#ifndef GST_DISABLE_GST_DEBUG
+    /* the first conversion creates the converter, the second reuses it */
+    if (i == 0)
+      fail_unless_equals_int (g_atomic_int_get (&converter_reused), 0);
+    else
+      fail_unless (g_atomic_int_get (&converter_reused) > 0);
+#endif
+  }
+
+#ifndef GST_DISABLE_GST_DEBUG
+  gst_debug_remove_log_function (count_converter_reuse_log);
+  gst_debug_set_threshold_for_name ("default", GST_LEVEL_NONE);
+#endif
+
+  gst_caps_unref (to_caps);
+  gst_sample_unref (from_sample);
+  g_main_loop_unref (loop);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_video_size_from_caps)
 {
   GstVideoInfo vinfo;
@@ -1654,6 +1900,131 @@ GST_START_TEST (test_overlay_composition_premultiplied_alpha)
 
 GST_END_TEST;
 
+GST_START_TEST (test_overlay_composition_cache)
+{
+  GstVideoOverlayRectangle *rect;
+  GstBuffer *pix, *pix1, *pix2;
+  guint64 hits, misses, hits2, misses2;
+  gsize size, expected;
+  gint i;
+
+  pix = gst_buffer_new_and_alloc (16 * 16 * sizeof (guint32));
+  gst_buffer_memset (pix, 0, 0x80, gst_buffer_get_size (pix));
+  gst_buffer_add_video_meta (pix, GST_VIDEO_FRAME_FLAG_NONE,
+      GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB, 16, 16);
+  rect = gst_video_overlay_rectangle_new_raw (pix, 0, 0, 32, 32,
+      GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+  gst_buffer_unref (pix);
+
+  /* start from an empty cache */
+  gst_video_overlay_rectangle_set_cache_limit (0);
+  gst_video_overlay_rectangle_set_cache_limit (64 * 1024 * 1024);
+  gst_video_overlay_rectangle_get_cache_stats (&hits, &misses, &size);
+  fail_unless_equals_int (size, 0);
+
+  /* converted and scaled, then from the cache */
+  pix1 = gst_video_overlay_rectangle_get_pixels_ayuv (rect,
+      GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+  pix2 = gst_video_overlay_rectangle_get_pixels_ayuv (rect,
+      GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+  fail_unless (pix1 == pix2);
+  gst_video_overlay_rectangle_get_cache_stats (&hits2, &misses2, &size);
+  fail_unless_equals_uint64 (hits2, hits + 1);
+  fail_unless_equals_uint64 (misses2, misses + 1);
+  fail_unless_equals_int (size, (16 * 16 + 32 * 32) * 4);
+
+  /* the variant that was returned is always kept, even over the limit, only
+   * the intermediate AYUV one that it was scaled from is dropped */
+  gst_video_overlay_rectangle_set_cache_limit (0);
+  gst_video_overlay_rectangle_get_cache_stats (NULL, NULL, &size);
+  fail_unless_equals_int (size, 32 * 32 * 4);
+  pix1 = gst_video_overlay_rectangle_get_pixels_ayuv (rect,
+      GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+  fail_unless (pix1 == pix2);
+  gst_video_overlay_rectangle_get_cache_stats (&hits, &misses, &size);
+  fail_unless_equals_uint64 (hits, hits2 + 1);
+  fail_unless_equals_uint64 (misses, misses2);
+  fail_unless_equals_int (size, 32 * 32 * 4);
+  gst_video_overlay_rectangle_set_cache_limit (64 * 1024 * 1024);
+
+  /* everything that was returned is kept while the rectangle is alive, also
+   * beyond the number of variants cached per rectangle */
+  expected = 32 * 32 * 4;
+  for (i = 1; i <= 10; i++) {
+    gst_video_overlay_rectangle_set_render_rectangle (rect, 0, 0, 16 + i,
+        16 + i);
+    pix1 = gst_video_overlay_rectangle_get_pixels_raw (rect,
+        GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+    fail_unless_equals_int (gst_buffer_get_size (pix1),
+        (16 + i) * (16 + i) * 4);
+    expected += (16 + i) * (16 + i) * 4;
+  }
+  gst_video_overlay_rectangle_get_cache_stats (NULL, NULL, &size);
+  fail_unless_equals_int (size, expected);
+
+  gst_video_overlay_rectangle_unref (rect);
+  gst_video_overlay_rectangle_get_cache_stats (NULL, NULL, &size);
+  fail_unless_equals_int (size, 0);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_overlay_composition_cache_pinned)
+{
+  GstVideoOverlayRectangle *rect1, *rect2;
+  GstBuffer *pix, *pix1, *pix2, *pix3;
+  GstMapInfo map;
+  gsize i;
+
+  pix = gst_buffer_new_and_alloc (16 * 16 * sizeof (guint32));
+  gst_buffer_memset (pix, 0, 0x80, gst_buffer_get_size (pix));
+  gst_buffer_add_video_meta (pix, GST_VIDEO_FRAME_FLAG_NONE,
+      GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB, 16, 16);
+  rect1 = gst_video_overlay_rectangle_new_raw (pix, 0, 0, 32, 32,
+      GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+  rect2 = gst_video_overlay_rectangle_new_raw (pix, 0, 0, 48, 48,
+      GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+  gst_buffer_unref (pix);
+
+  /* nothing may be cached beyond the pixels handed out */
+  gst_video_overlay_rectangle_set_cache_limit (0);
+
+  pix1 = gst_video_overlay_rectangle_get_pixels_raw (rect1,
+      GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+  pix2 = gst_video_overlay_rectangle_get_pixels_raw (rect2,
+      GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+  /* a newer variant in the same format doesn't replace the older one */
+  gst_video_overlay_rectangle_set_render_rectangle (rect1, 0, 0, 24, 24);
+  pix3 = gst_video_overlay_rectangle_get_pixels_raw (rect1,
+      GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+  fail_unless_equals_int (gst_buffer_get_size (pix3), 24 * 24 * 4);
+  gst_video_overlay_rectangle_set_cache_limit (0);
+
+  /* all are still valid, without taking a reference */
+  fail_unless (gst_buffer_map (pix1, &map, GST_MAP_READ));
+  fail_unless_equals_int (map.size, 32 * 32 * 4);
+  for (i = 0; i < map.size; i++)
+    fail_unless_equals_int (map.data[i], 0x80);
+  gst_buffer_unmap (pix1, &map);
+
+  fail_unless (gst_buffer_map (pix2, &map, GST_MAP_READ));
+  fail_unless_equals_int (map.size, 48 * 48 * 4);
+  for (i = 0; i < map.size; i++)
+    fail_unless_equals_int (map.data[i], 0x80);
+  gst_buffer_unmap (pix2, &map);
+
+  /* and requesting the first size again returns the same pixels */
+  gst_video_overlay_rectangle_set_render_rectangle (rect1, 0, 0, 32, 32);
+  fail_unless (gst_video_overlay_rectangle_get_pixels_raw (rect1,
+          GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE) == pix1);
+
+  gst_video_overlay_rectangle_unref (rect1);
+  gst_video_overlay_rectangle_unref (rect2);
+  gst_video_overlay_rectangle_set_cache_limit (64 * 1024 * 1024);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_overlay_composition_global_alpha)
 {
   GstVideoOverlayRectangle *rect1;
@@ -2310,93 +2681,299 @@ GST_END_TEST;
 #define WIDTH 320
 #define HEIGHT 240
 #define TIME 0.1
-#define GET_LINE(l) (pixels + CLAMP (l, 0, HEIGHT-1) * WIDTH * 4)
-GST_START_TEST (test_video_chroma)
+#define GET_LINE(l) (pixels + CLAMP (l, 0, HEIGHT-1) * WIDTH * pstride)
+static void
+run_chroma_benchmark (GstVideoFormat format, GstVideoChromaSite site,
+    GstVideoChromaFlags flags, gint factor, GTimer * timer)
 {
+  GstVideoChromaResample *resample;
   guint8 *pixels;
   guint n_lines;
-  gint i, j, k, offset, count;
+  gint i, j, offset, count, pstride;
   gpointer lines[10];
+  gdouble elapsed, resample_sec;
+
+  pstride = format == GST_VIDEO_FORMAT_AYUV64 ? 8 : 4;
+  pixels = make_pixels (pstride * 2, WIDTH, HEIGHT);
+
+  resample = gst_video_chroma_resample_new (GST_VIDEO_CHROMA_METHOD_LINEAR,
+      site, flags, format, factor, factor);
+
+  gst_video_chroma_resample_get_info (resample, &n_lines, &offset);
+  fail_unless (n_lines < 10);
+
+  /* warmup */
+  for (j = 0; j < n_lines; j++)
+    lines[j] = GET_LINE (offset + j);
+  gst_video_chroma_resample (resample, lines, WIDTH);
+
+  count = 0;
+  g_timer_start (timer);
+  while (TRUE) {
+    for (i = 0; i < HEIGHT; i += n_lines) {
+      for (j = 0; j < n_lines; j++)
+        lines[j] = GET_LINE (i + offset + j);
+
+      gst_video_chroma_resample (resample, lines, WIDTH);
+    }
+    count++;
+    elapsed = g_timer_elapsed (timer, NULL);
+    if (elapsed >= TIME)
+      break;
+  }
+  resample_sec = count / elapsed;
+  GST_DEBUG ("%f %s/sec (%f MB/sec) %s site %d flags %d  %d/%f",
+      resample_sec, factor < 0 ? "downsamples" : "upsamples",
+      resample_sec * WIDTH * HEIGHT * pstride / (1024.0 * 1024.0),
+      gst_video_format_to_string (format), site, flags, count, elapsed);
+  gst_video_chroma_resample_free (resample);
+
+  g_free (pixels);
+}
+
+GST_START_TEST (test_video_chroma)
+{
   GTimer *timer;
-  gdouble elapsed, subsample_sec;
+  gint i, j, k;
   GstVideoChromaSite sites[] = {
     GST_VIDEO_CHROMA_SITE_NONE,
     GST_VIDEO_CHROMA_SITE_H_COSITED,
   };
+  GstVideoFormat formats[] = {
+    GST_VIDEO_FORMAT_AYUV,
+    GST_VIDEO_FORMAT_AYUV64,
+  };
+  GstVideoChromaFlags flags[] = {
+    GST_VIDEO_CHROMA_FLAG_NONE,
+    GST_VIDEO_CHROMA_FLAG_INTERLACED,
+  };
 
   timer = g_timer_new ();
-  pixels = make_pixels (8, WIDTH, HEIGHT);
 
-  for (k = 0; k < G_N_ELEMENTS (sites); k++) {
-    GstVideoChromaResample *resample;
+  for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+    for (j = 0; j < G_N_ELEMENTS (flags); j++) {
+      for (k = 0; k < G_N_ELEMENTS (sites); k++) {
+        run_chroma_benchmark (formats[i], sites[k], flags[j], -1, timer);
+        run_chroma_benchmark (formats[i], sites[k], flags[j], 1, timer);
+      }
+    }
+  }
 
-    resample = gst_video_chroma_resample_new (GST_VIDEO_CHROMA_METHOD_LINEAR,
-        sites[k], GST_VIDEO_CHROMA_FLAG_NONE, GST_VIDEO_FORMAT_AYUV, -1, -1);
+  g_timer_destroy (timer);
+}
 
-    gst_video_chroma_resample_get_info (resample, &n_lines, &offset);
-    fail_unless (n_lines < 10);
+GST_END_TEST;
+#undef GET_LINE
+#undef WIDTH
+#undef HEIGHT
+#undef TIME
 
-    /* warmup */
-    for (j = 0; j < n_lines; j++)
-      lines[j] = GET_LINE (offset + j);
-    gst_video_chroma_resample (resample, lines, WIDTH);
+#define FILT(a,b,c,d,s) (((a) * (b) + (c) * (d) + (1 << ((s) - 1))) >> (s))
 
-    count = 0;
-    g_timer_start (timer);
-    while (TRUE) {
-      for (i = 0; i < HEIGHT; i += n_lines) {
-        for (j = 0; j < n_lines; j++)
-          lines[j] = GET_LINE (i + offset + j);
+/* reference for the 2x horizontal filters on one AYUV line */
+static void
+chroma_h2_reference (guint8 * p, gint width, gint factor, gboolean cosited)
+{
+  guint8 *orig = g_memdup (p, width * 4);
+  gint i, c;
+
+  for (c = 2; c < 4; c++) {
+#define O(i) (orig[(i) * 4 + c])
+#define P(i) (p[(i) * 4 + c])
+    if (factor > 0 && !cosited) {
+      for (i = 1; i < width - 1; i += 2) {
+        P (i) = FILT (O (i - 1), 3, O (i + 1), 1, 2);
+        P (i + 1) = FILT (O (i - 1), 1, O (i + 1), 3, 2);
+      }
+    } else if (factor > 0) {
+      for (i = 1; i < width - 1; i += 2)
+        P (i) = FILT (O (i - 1), 1, O (i + 1), 1, 1);
+    } else if (cosited && width >= 2) {
+      P (0) = FILT (O (0), 3, O (1), 1, 2);
+      for (i = 2; i < width - 2; i += 2)
+        P (i) = (O (i - 1) + 2 * O (i) + O (i + 1) + 2) >> 2;
+      if (i < width)
+        P (i) = FILT (O (i - 1), 1, O (i), 3, 2);
+    } else if (!cosited) {
+      for (i = 0; i < width - 1; i += 2)
+        P (i) = FILT (O (i), 1, O (i + 1), 1, 1);
+    }
+#undef O
+#undef P
+  }
+  g_free (orig);
+}
 
-        gst_video_chroma_resample (resample, lines, WIDTH);
+GST_START_TEST (test_video_chroma_h2)
+{
+  gint widths[] = { 1, 2, 3, 4, 5, 76, 77 };
+  gint i, j, k;
+
+  for (i = 0; i < G_N_ELEMENTS (widths); i++) {
+    gint width = widths[i];
+
+    for (j = 0; j < 2; j++) {
+      gboolean cosited = (j == 1);
+
+      for (k = -1; k <= 1; k += 2) {
+        GstVideoChromaResample *resample;
+        guint8 *pixels, *expected;
+        gpointer lines[1];
+        gint l, run;
+
+        resample =
+            gst_video_chroma_resample_new (GST_VIDEO_CHROMA_METHOD_LINEAR,
+            cosited ? GST_VIDEO_CHROMA_SITE_H_COSITED :
+            GST_VIDEO_CHROMA_SITE_NONE, GST_VIDEO_CHROMA_FLAG_NONE,
+            GST_VIDEO_FORMAT_AYUV, k, 0);
+        fail_unless (resample != NULL);
+
+        /* run twice to also reuse any internal scratch memory */
+        for (run = 0; run < 2; run++) {
+          pixels = g_malloc (width * 4);
+          for (l = 0; l < width * 4; l++)
+            pixels[l] = g_random_int_range (0, 256);
+          expected = g_memdup (pixels, width * 4);
+          chroma_h2_reference (expected, width, k, cosited);
+
+          lines[0] = pixels;
+          gst_video_chroma_resample (resample, lines, width);
+
+          if (memcmp (pixels, expected, width * 4) != 0) {
+            gst_util_dump_mem (pixels, width * 4);
+            gst_util_dump_mem (expected, width * 4);
+            fail ("width %d, factor %d, cosited %d", width, k, cosited);
+          }
+
+          g_free (pixels);
+          g_free (expected);
+        }
+        gst_video_chroma_resample_free (resample);
       }
-      count++;
-      elapsed = g_timer_elapsed (timer, NULL);
-      if (elapsed >= TIME)
-        break;
     }
-    subsample_sec = count / elapsed;
-    GST_DEBUG ("%f downsamples/sec  %d/%f", subsample_sec, count, elapsed);
-    gst_video_chroma_resample_free (resample);
+  }
+}
 
-    resample = gst_video_chroma_resample_new (GST_VIDEO_CHROMA_METHOD_LINEAR,
-        sites[k], GST_VIDEO_CHROMA_FLAG_NONE, GST_VIDEO_FORMAT_AYUV, 1, 1);
+GST_END_TEST;
+
+GST_START_TEST (test_video_chroma_vi2)
+{
+  GstVideoFormat formats[] = {
+    GST_VIDEO_FORMAT_AYUV,
+    GST_VIDEO_FORMAT_AYUV64,
+  };
+  gint width = 77;
+  gint f, i, j, c;
+
+  for (f = 0; f < G_N_ELEMENTS (formats); f++) {
+    GstVideoChromaResample *resample;
+    guint n_lines;
+    gint offset, bits = f == 0 ? 8 : 16;
+    guint16 *l[4], *ref[4];
+    guint8 *l8[4];
+    gpointer lines[4];
 
+    resample = gst_video_chroma_resample_new (GST_VIDEO_CHROMA_METHOD_LINEAR,
+        GST_VIDEO_CHROMA_SITE_NONE, GST_VIDEO_CHROMA_FLAG_INTERLACED,
+        formats[f], 0, 1);
     gst_video_chroma_resample_get_info (resample, &n_lines, &offset);
-    fail_unless (n_lines < 10);
+    fail_unless_equals_int (n_lines, 4);
+
+    /* the reference works on 16 bits per component for both formats */
+    for (j = 0; j < 4; j++) {
+      l[j] = g_new (guint16, width * 4);
+      ref[j] = g_new (guint16, width * 4);
+      l8[j] = g_new (guint8, width * 4);
+      for (i = 0; i < width * 4; i++) {
+        ref[j][i] = g_random_int_range (0, 1 << bits);
+        l[j][i] = ref[j][i];
+        l8[j][i] = ref[j][i];
+      }
+      lines[j] = bits == 8 ? (gpointer) l8[j] : (gpointer) l[j];
+    }
 
-    /* warmup */
-    for (j = 0; j < n_lines; j++)
-      lines[j] = GET_LINE (offset + j);
-    gst_video_chroma_resample (resample, lines, WIDTH);
+    for (i = 0; i < width; i++) {
+      for (c = 2; c < 4; c++) {
+        guint a = ref[0][i * 4 + c], b = ref[2][i * 4 + c];
+        guint d = ref[1][i * 4 + c], e = ref[3][i * 4 + c];
 
-    count = 0;
-    g_timer_start (timer);
-    while (TRUE) {
-      for (i = 0; i < HEIGHT; i += n_lines) {
-        for (j = 0; j < n_lines; j++)
-          lines[j] = GET_LINE (i + offset + j);
+        ref[0][i * 4 + c] = FILT (a, 5, b, 3, 3);
+        ref[1][i * 4 + c] = FILT (d, 7, e, 1, 3);
+        ref[2][i * 4 + c] = FILT (a, 1, b, 7, 3);
+        ref[3][i * 4 + c] = FILT (d, 3, e, 5, 3);
+      }
+    }
 
-        gst_video_chroma_resample (resample, lines, WIDTH);
+    gst_video_chroma_resample (resample, lines, width);
+
+    for (j = 0; j < 4; j++) {
+      for (i = 0; i < width * 4; i++) {
+        guint v = bits == 8 ? l8[j][i] : l[j][i];
+        fail_unless_equals_int (v, ref[j][i]);
       }
-      count++;
-      elapsed = g_timer_elapsed (timer, NULL);
-      if (elapsed >= TIME)
-        break;
+      g_free (l[j]);
+      g_free (ref[j]);
+      g_free (l8[j]);
     }
-    subsample_sec = count / elapsed;
-    GST_DEBUG ("%f upsamples/sec  %d/%f", subsample_sec, count, elapsed);
     gst_video_chroma_resample_free (resample);
   }
+}
+
+GST_END_TEST;
+#undef FILT
 
+GST_START_TEST (test_video_dither_blue_noise)
+{
+  GstVideoDither *dither, *dither2;
+  guint quant[GST_VIDEO_MAX_COMPONENTS] = { 256, 256, 256, 256 };
+  guint16 *pixels, *line;
+  gint width = 64, height = 32;
+  gint i, j, k;
+  guint64 sum[4] = { 0, };
+
+  dither = gst_video_dither_new (GST_VIDEO_DITHER_BLUE_NOISE,
+      GST_VIDEO_DITHER_FLAG_QUANTIZE, GST_VIDEO_FORMAT_AYUV64, quant, width);
+  fail_unless (dither != NULL);
+
+  /* halfway between two quantization steps, the pattern must round up
+   * exactly half of the pixels of each 32x32 tile */
+  pixels = g_new (guint16, width * height * 4);
+  for (i = 0; i < width * height * 4; i++)
+    pixels[i] = 0x1280;
+
+  for (i = 0; i < height; i++)
+    gst_video_dither_line (dither, pixels + i * width * 4, 0, i, width);
+
+  for (i = 0; i < height; i++) {
+    for (j = 0; j < 32; j++) {
+      for (k = 0; k < 4; k++) {
+        guint16 v = pixels[(i * width + j) * 4 + k];
+
+        fail_unless (v == 0x1200 || v == 0x1300);
+        sum[k] += v;
+      }
+    }
+  }
+  for (k = 0; k < 4; k++)
+    fail_unless_equals_uint64 (sum[k], 32 * 32 * (guint64) 0x1280);
+
+  /* dithering a line in two parts gives the same result */
+  dither2 = gst_video_dither_new (GST_VIDEO_DITHER_BLUE_NOISE,
+      GST_VIDEO_DITHER_FLAG_QUANTIZE, GST_VIDEO_FORMAT_AYUV64, quant, width);
+  line = g_new (guint16, width * 4);
+  for (i = 0; i < width * 4; i++)
+    line[i] = 0x1280;
+  gst_video_dither_line (dither2, line, 0, 5, 20);
+  gst_video_dither_line (dither2, line, 20, 5, width - 20);
+  fail_unless (memcmp (line, pixels + 5 * width * 4, width * 8) == 0);
+
+  g_free (line);
   g_free (pixels);
-  g_timer_destroy (timer);
+  gst_video_dither_free (dither2);
+  gst_video_dither_free (dither);
 }
 
 GST_END_TEST;
-#undef WIDTH
-#undef HEIGHT
-#undef TIME
 
 GST_START_TEST (test_video_scaler)
 {
@@ -2694,6 +3271,107 @@ GST_START_TEST (test_video_convert)
 
 GST_END_TEST;
 
+GST_START_TEST (test_video_convert_linear_float)
+{
+  GstVideoInfo ininfo, outinfo;
+  GstVideoFrame inframe, outframe;
+  GstBuffer *inbuffer, *outbuffer;
+  GstVideoConverter *convert;
+  gint max_err[2] = { 0, 0 };
+  gint i, x, y;
+
+  fail_unless (gst_video_info_set_format (&ininfo, GST_VIDEO_FORMAT_I420, 320,
+          240));
+  ininfo.colorimetry.range = GST_VIDEO_COLOR_RANGE_16_235;
+  ininfo.colorimetry.matrix = GST_VIDEO_COLOR_MATRIX_BT709;
+  ininfo.colorimetry.transfer = GST_VIDEO_TRANSFER_BT709;
+  ininfo.colorimetry.primaries = GST_VIDEO_COLOR_PRIMARIES_BT2020;
+  outinfo = ininfo;
+  outinfo.colorimetry.primaries = GST_VIDEO_COLOR_PRIMARIES_BT709;
+
+  inbuffer = gst_buffer_new_and_alloc (ininfo.size);
+  outbuffer = gst_buffer_new_and_alloc (outinfo.size);
+
+  /* a grey ramp, both primaries share the D65 white point so grey must stay
+   * grey */
+  gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_WRITE);
+  for (y = 0; y < GST_VIDEO_FRAME_HEIGHT (&inframe); y++) {
+    guint8 *p = GST_VIDEO_FRAME_COMP_DATA (&inframe, 0) +
+        y * GST_VIDEO_FRAME_COMP_STRIDE (&inframe, 0);
+
+    for (x = 0; x < GST_VIDEO_FRAME_WIDTH (&inframe); x++)
+      p[x] = 16 + (x * 219) / (GST_VIDEO_FRAME_WIDTH (&inframe) - 1);
+  }
+  for (y = 0; y < GST_VIDEO_FRAME_COMP_HEIGHT (&inframe, 1); y++) {
+    memset (GST_VIDEO_FRAME_COMP_DATA (&inframe, 1) +
+        y * GST_VIDEO_FRAME_COMP_STRIDE (&inframe, 1), 128,
+        GST_VIDEO_FRAME_COMP_WIDTH (&inframe, 1));
+    memset (GST_VIDEO_FRAME_COMP_DATA (&inframe, 2) +
+        y * GST_VIDEO_FRAME_COMP_STRIDE (&inframe, 2), 128,
+        GST_VIDEO_FRAME_COMP_WIDTH (&inframe, 2));
+  }
+  gst_video_frame_unmap (&inframe);
+
+  for (i = 0; i < 2; i++) {
+    gboolean linear_float = i == 1;
+
+    gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_READ);
+    gst_video_frame_map (&outframe, &outinfo, outbuffer, GST_MAP_WRITE);
+
+    /* run with multiple threads so that the shared gamma tables are
+     * requested concurrently */
+    convert = gst_video_converter_new (&ininfo, &outinfo,
+        gst_structure_new ("options",
+            GST_VIDEO_CONVERTER_OPT_GAMMA_MODE,
+            GST_TYPE_VIDEO_GAMMA_MODE, GST_VIDEO_GAMMA_MODE_REMAP,
+            GST_VIDEO_CONVERTER_OPT_PRIMARIES_MODE,
+            GST_TYPE_VIDEO_PRIMARIES_MODE, GST_VIDEO_PRIMARIES_MODE_FAST,
+            GST_VIDEO_CONVERTER_OPT_DITHER_METHOD,
+            GST_TYPE_VIDEO_DITHER_METHOD, GST_VIDEO_DITHER_NONE,
+            GST_VIDEO_CONVERTER_OPT_LINEAR_FLOAT, G_TYPE_BOOLEAN,
+            linear_float, GST_VIDEO_CONVERTER_OPT_THREADS, G_TYPE_UINT, 4,
+            NULL));
+    gst_video_converter_frame (convert, &inframe, &outframe);
+    gst_video_converter_free (convert);
+
+    for (y = 0; y < GST_VIDEO_FRAME_HEIGHT (&outframe); y++) {
+      guint8 *s = GST_VIDEO_FRAME_COMP_DATA (&inframe, 0) +
+          y * GST_VIDEO_FRAME_COMP_STRIDE (&inframe, 0);
+      guint8 *d = GST_VIDEO_FRAME_COMP_DATA (&outframe, 0) +
+          y * GST_VIDEO_FRAME_COMP_STRIDE (&outframe, 0);
+
+      for (x = 0; x < GST_VIDEO_FRAME_WIDTH (&outframe); x++)
+        max_err[i] = MAX (max_err[i], ABS (d[x] - s[x]));
+    }
+
+    if (linear_float) {
+      fail_unless (max_err[i] <= 2, "luma off by %d", max_err[i]);
+      for (y = 0; y < GST_VIDEO_FRAME_COMP_HEIGHT (&outframe, 1); y++) {
+        guint8 *u = GST_VIDEO_FRAME_COMP_DATA (&outframe, 1) +
+            y * GST_VIDEO_FRAME_COMP_STRIDE (&outframe, 1);
+        guint8 *v = GST_VIDEO_FRAME_COMP_DATA (&outframe, 2) +
+            y * GST_VIDEO_FRAME_COMP_STRIDE (&outframe, 2);
+
+        for (x = 0; x < GST_VIDEO_FRAME_COMP_WIDTH (&outframe, 1); x++) {
+          fail_unless (ABS (u[x] - 128) <= 1, "%d,%d: u %d", x, y, u[x]);
+          fail_unless (ABS (v[x] - 128) <= 1, "%d,%d: v %d", x, y, v[x]);
+        }
+      }
+    }
+    gst_video_frame_unmap (&outframe);
+    gst_video_frame_unmap (&inframe);
+  }
+
+  gst_buffer_unref (outbuffer);
+  gst_buffer_unref (inbuffer);
+
+  /* the float matrix is at least as accurate as the fixed point one */
+  fail_unless (max_err[1] <= max_err[0], "float error %d > fixed error %d",
+      max_err[1], max_err[0]);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_video_transfer)
 {
   gint i, j;
@@ -2996,6 +3674,142 @@ GST_START_TEST (test_overlay_composition_over_transparency)
 
 GST_END_TEST;
 
+static guint
+overlay_native_get_comp (GstVideoFrame * frame, gint c, gint x, gint y)
+{
+  guint8 *p = GST_VIDEO_FRAME_COMP_DATA (frame, c) +
+      y * GST_VIDEO_FRAME_COMP_STRIDE (frame, c) +
+      x * GST_VIDEO_FRAME_COMP_PSTRIDE (frame, c);
+
+  if (GST_VIDEO_FRAME_COMP_DEPTH (frame, c) > 8)
+    return GST_READ_UINT16_LE (p) >> 8;
+  return *p;
+}
+
+static void
+overlay_native_fill_comp (GstVideoFrame * frame, gint c, guint val)
+{
+  gint x, y;
+
+  for (y = 0; y < GST_VIDEO_FRAME_COMP_HEIGHT (frame, c); y++) {
+    for (x = 0; x < GST_VIDEO_FRAME_COMP_WIDTH (frame, c); x++) {
+      guint8 *p = GST_VIDEO_FRAME_COMP_DATA (frame, c) +
+          y * GST_VIDEO_FRAME_COMP_STRIDE (frame, c) +
+          x * GST_VIDEO_FRAME_COMP_PSTRIDE (frame, c);
+
+      if (GST_VIDEO_FRAME_COMP_DEPTH (frame, c) > 8)
+        GST_WRITE_UINT16_LE (p, val << 8);
+      else
+        *p = val;
+    }
+  }
+}
+
+static void
+overlay_native_check (GstVideoFormat format,
+    GstVideoOverlayComposition * comp, gint ox, gint oy, gint ow, gint oh)
+{
+  GstVideoFrame frame;
+  GstVideoInfo vinfo;
+  GstBuffer *buf;
+  gint x, y;
+
+  fail_unless (gst_video_info_set_format (&vinfo, format, 64, 48));
+  buf = gst_buffer_new_and_alloc (GST_VIDEO_INFO_SIZE (&vinfo));
+  fail_unless (gst_video_frame_map (&frame, &vinfo, buf, GST_MAP_READWRITE));
+
+  overlay_native_fill_comp (&frame, 0, 16);
+  overlay_native_fill_comp (&frame, 1, 128);
+  overlay_native_fill_comp (&frame, 2, 128);
+
+  fail_unless (gst_video_overlay_composition_blend (comp, &frame));
+
+  for (y = 0; y < 48; y++) {
+    for (x = 0; x < 64; x++) {
+      gboolean inside = x >= ox && x < ox + ow && y >= oy && y < oy + oh;
+
+      fail_unless_equals_int (overlay_native_get_comp (&frame, 0, x, y),
+          inside ? 235 : 16);
+    }
+  }
+
+  for (y = 0; y < 24; y++) {
+    for (x = 0; x < 32; x++) {
+      gint covered = 0, k, l;
+      guint u, v;
+
+      for (k = 0; k < 2; k++)
+        for (l = 0; l < 2; l++)
+          if (2 * x + l >= ox && 2 * x + l < ox + ow
+              && 2 * y + k >= oy && 2 * y + k < oy + oh)
+            covered++;
+
+      u = overlay_native_get_comp (&frame, 1, x, y);
+      v = overlay_native_get_comp (&frame, 2, x, y);
+      if (covered == 4) {
+        fail_unless_equals_int (u, 200);
+        fail_unless_equals_int (v, 60);
+      } else if (covered == 0) {
+        fail_unless_equals_int (u, 128);
+        fail_unless_equals_int (v, 128);
+      } else {
+        fail_unless (u > 128 && u < 200);
+        fail_unless (v > 60 && v < 128);
+      }
+    }
+  }
+
+  gst_video_frame_unmap (&frame);
+  gst_buffer_unref (buf);
+}
+
+GST_START_TEST (test_overlay_blend_native)
+{
+  GstVideoFormat formats[] = { GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_NV12,
+    GST_VIDEO_FORMAT_P010_10LE
+  };
+  gint positions[][2] = { {5, 3}, {60, 44}, {-4, -2} };
+  GstVideoOverlayComposition *comp;
+  GstVideoOverlayRectangle *rect;
+  GstMapInfo map;
+  GstBuffer *pix;
+  gint i, j;
+
+  pix = gst_buffer_new_and_alloc (9 * 7 * 4);
+  gst_buffer_map (pix, &map, GST_MAP_WRITE);
+  for (i = 0; i < 9 * 7; i++) {
+    map.data[i * 4 + 0] = 0xff;
+    map.data[i * 4 + 1] = 235;
+    map.data[i * 4 + 2] = 200;
+    map.data[i * 4 + 3] = 60;
+  }
+  gst_buffer_unmap (pix, &map);
+  gst_buffer_add_video_meta (pix, GST_VIDEO_FRAME_FLAG_NONE,
+      GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_YUV, 9, 7);
+
+  for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+    /* odd position, even position partly outside the frame on both sides */
+    for (j = 0; j < G_N_ELEMENTS (positions); j++) {
+      rect = gst_video_overlay_rectangle_new_raw (pix, positions[j][0],
+          positions[j][1], 9, 7, GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+      comp = gst_video_overlay_composition_new (rect);
+
+      /* the second time blends from the cached chroma */
+      overlay_native_check (formats[i], comp, positions[j][0],
+          positions[j][1], 9, 7);
+      overlay_native_check (formats[i], comp, positions[j][0],
+          positions[j][1], 9, 7);
+
+      gst_video_overlay_composition_unref (comp);
+      gst_video_overlay_rectangle_unref (rect);
+    }
+  }
+
+  gst_buffer_unref (pix);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_video_format_enum_stability)
 {
   /* When adding new formats, adding a format in the middle of the enum will
@@ -3744,6 +4558,70 @@ GST_START_TEST (test_video_meta_align)
 
 GST_END_TEST;
 
+GST_START_TEST (test_video_frame_copy_full)
+{
+  static const GstVideoFormat formats[] = {
+    GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_BGRA,
+    GST_VIDEO_FORMAT_P010_10LE
+  };
+  /* alternating sizes use a different number of copy tasks each time */
+  static const gint heights[] = { 1080, 200, 720, 1080 };
+  gint i, p, k;
+
+  for (i = 0; i < G_N_ELEMENTS (formats) * G_N_ELEMENTS (heights); i++) {
+    GstVideoFormat format = formats[i % G_N_ELEMENTS (formats)];
+    gint height = heights[i / G_N_ELEMENTS (formats)];
+    GstVideoInfo sinfo, dinfo;
+    GstVideoAlignment align;
+    GstBuffer *sbuf, *dbuf;
+    GstVideoFrame sframe, dframe;
+    GstMapInfo map;
+
+    gst_video_info_set_format (&sinfo, format, 1920, height);
+    gst_video_info_set_format (&dinfo, format, 1920, height);
+    /* give the destination a different stride */
+    gst_video_alignment_reset (&align);
+    align.padding_right = 64;
+    fail_unless (gst_video_info_align (&dinfo, &align));
+
+    sbuf = gst_buffer_new_and_alloc (GST_VIDEO_INFO_SIZE (&sinfo));
+    gst_buffer_map (sbuf, &map, GST_MAP_WRITE);
+    for (k = 0; k < map.size; k++)
+      map.data[k] = k % 251;
+    gst_buffer_unmap (sbuf, &map);
+    dbuf = gst_buffer_new_and_alloc (GST_VIDEO_INFO_SIZE (&dinfo));
+    gst_buffer_memset (dbuf, 0, 0, GST_VIDEO_INFO_SIZE (&dinfo));
+
+    fail_unless (gst_video_frame_map (&sframe, &sinfo, sbuf, GST_MAP_READ));
+    fail_unless (gst_video_frame_map (&dframe, &dinfo, dbuf, GST_MAP_WRITE));
+
+    fail_unless (gst_video_frame_copy_full (&dframe, &sframe, 4));
+
+    for (p = 0; p < GST_VIDEO_FRAME_N_PLANES (&sframe); p++) {
+      gint w = GST_VIDEO_FRAME_COMP_WIDTH (&sframe, p) *
+          GST_VIDEO_FRAME_COMP_PSTRIDE (&sframe, p);
+
+      for (k = 0; k < GST_VIDEO_FRAME_COMP_HEIGHT (&sframe, p); k++) {
+        guint8 *sp = (guint8 *) GST_VIDEO_FRAME_PLANE_DATA (&sframe, p) +
+            k * GST_VIDEO_FRAME_PLANE_STRIDE (&sframe, p);
+        guint8 *dp = (guint8 *) GST_VIDEO_FRAME_PLANE_DATA (&dframe, p) +
+            k * GST_VIDEO_FRAME_PLANE_STRIDE (&dframe, p);
+
+        fail_unless (memcmp (sp, dp, w) == 0,
+            "%s plane %d line %d differs",
+            gst_video_format_to_string (format), p, k);
+      }
+    }
+
+    gst_video_frame_unmap (&dframe);
+    gst_video_frame_unmap (&sframe);
+    gst_buffer_unref (dbuf);
+    gst_buffer_unref (sbuf);
+  }
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_video_flags)
 {
   GstBuffer *buf;
@@ -3808,15 +4686,23 @@ video_suite (void)
   tcase_add_test (tc_chain, test_parse_colorimetry);
   tcase_add_test (tc_chain, test_events);
   tcase_add_test (tc_chain, test_convert_frame);
+  tcase_add_test (tc_chain, test_convert_frame_raw);
+  tcase_add_test (tc_chain, test_convert_frame_raw_no_par);
   tcase_add_test (tc_chain, test_convert_frame_async);
   tcase_add_test (tc_chain, test_convert_frame_async_error);
+  tcase_add_test (tc_chain, test_convert_frame_async_raw_reuse);
   tcase_add_test (tc_chain, test_video_size_from_caps);
   tcase_add_test (tc_chain, test_interlace_mode);
   tcase_add_test (tc_chain, test_overlay_composition);
   tcase_add_test (tc_chain, test_overlay_composition_premultiplied_alpha);
   tcase_add_test (tc_chain, test_overlay_composition_global_alpha);
+  tcase_add_test (tc_chain, test_overlay_composition_cache);
+  tcase_add_test (tc_chain, test_overlay_composition_cache_pinned);
   tcase_add_test (tc_chain, test_video_pack_unpack2);
   tcase_add_test (tc_chain, test_video_chroma);
+  tcase_add_test (tc_chain, test_video_chroma_h2);
+  tcase_add_test (tc_chain, test_video_chroma_vi2);
+  tcase_add_test (tc_chain, test_video_dither_blue_noise);
   tcase_add_test (tc_chain, test_video_scaler);
   tcase_add_test (tc_chain, test_video_color_convert_rgb_rgb);
   tcase_add_test (tc_chain, test_video_color_convert_rgb_yuv);
@@ -3825,10 +4711,12 @@ video_suite (void)
   tcase_add_test (tc_chain, test_video_color_convert_other);
   tcase_add_test (tc_chain, test_video_size_convert);
   tcase_add_test (tc_chain, test_video_convert);
+  tcase_add_test (tc_chain, test_video_convert_linear_float);
   tcase_add_test (tc_chain, test_video_transfer);
   tcase_add_test (tc_chain, test_overlay_blend);
   tcase_add_test (tc_chain, test_video_center_rect);
   tcase_add_test (tc_chain, test_overlay_composition_over_transparency);
+  tcase_add_test (tc_chain, test_overlay_blend_native);
   tcase_add_test (tc_chain, test_video_format_enum_stability);
   tcase_add_test (tc_chain, test_video_formats_pstrides);
   tcase_add_test (tc_chain, test_hdr);
@@ -3837,6 +4725,7 @@ video_suite (void)
   tcase_add_test (tc_chain, test_video_info_align);
   tcase_add_test (tc_chain, test_video_meta_align);
   tcase_add_test (tc_chain, test_video_flags);
+  tcase_add_test (tc_chain, test_video_frame_copy_full);
 
   return s;
 }
@@ -178,6 +178,27 @@ gst_video_decoder_tester_handle_frame (GstVideoDecoder * dec,
   return GST_FLOW_OK;
 }
 
+static GstFlowReturn
+gst_video_decoder_tester_handle_frame_threaded (GstVideoDecoder * dec,
+    GstVideoCodecFrame * frame)
+{
+  GstMapInfo map;
+  guint64 input_num;
+
+  gst_buffer_map (frame->input_buffer, &map, GST_MAP_READ);
+  input_num = *((guint64 *) map.data);
+  gst_buffer_unmap (frame->input_buffer, &map);
+
+  /* let the worker threads finish out of order */
+  g_usleep ((input_num * 7) % 5 * 100);
+
+  gst_buffer_map (frame->output_buffer, &map, GST_MAP_WRITE);
+  memcpy (map.data, &input_num, sizeof (guint64));
+  gst_buffer_unmap (frame->output_buffer, &map);
+
+  return GST_FLOW_OK;
+}
+
 static void
 gst_video_decoder_tester_class_init (GstVideoDecoderTesterClass * klass)
 {
@@ -202,6 +223,8 @@ gst_video_decoder_tester_class_init (GstVideoDecoderTesterClass * klass)
   videodecoder_class->stop = gst_video_decoder_tester_stop;
   videodecoder_class->flush = gst_video_decoder_tester_flush;
   videodecoder_class->handle_frame = gst_video_decoder_tester_handle_frame;
+  videodecoder_class->handle_frame_threaded =
+      gst_video_decoder_tester_handle_frame_threaded;
   videodecoder_class->set_format = gst_video_decoder_tester_set_format;
 }
 
@@ -345,6 +368,350 @@ GST_START_TEST (videodecoder_playback)
 GST_END_TEST;
 
 
+GST_START_TEST (videodecoder_playback_frame_threads)
+{
+  GstSegment segment;
+  GstBuffer *buffer;
+  GstStructure *stats;
+  guint64 i, n_threaded = 0, threaded_frames, pool_acquired;
+  guint queued_frames, pool_outstanding, max_pool_outstanding;
+  GList *iter;
+
+  setup_videodecodertester (NULL, NULL);
+  gst_video_decoder_set_frame_threads (GST_VIDEO_DECODER (dec), 4);
+  fail_unless_equals_int (gst_video_decoder_get_frame_threads
+      (GST_VIDEO_DECODER (dec)), 4);
+
+  gst_pad_set_active (mysrcpad, TRUE);
+  gst_element_set_state (dec, GST_STATE_PLAYING);
+  gst_pad_set_active (mysinkpad, TRUE);
+
+  send_startup_events ();
+
+  gst_segment_init (&segment, GST_FORMAT_TIME);
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_segment (&segment)));
+
+  /* every 10th frame depends on the previous ones and has to wait for
+   * them, all others are decoded in parallel */
+  for (i = 0; i < NUM_BUFFERS; i++) {
+    buffer = create_test_buffer (i);
+    if (i % 10 == 9)
+      GST_BUFFER_FLAG_SET (buffer, GST_BUFFER_FLAG_DELTA_UNIT);
+    else
+      n_threaded++;
+
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  }
+
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_eos ()));
+
+  /* output must be in decoding order */
+  fail_unless_equals_int (g_list_length (buffers), NUM_BUFFERS);
+  i = 0;
+  for (iter = buffers; iter; iter = g_list_next (iter)) {
+    GstMapInfo map;
+    guint64 num;
+
+    buffer = iter->data;
+
+    gst_buffer_map (buffer, &map, GST_MAP_READ);
+    num = *(guint64 *) map.data;
+    fail_unless_equals_uint64 (num, i);
+    fail_unless (GST_BUFFER_PTS (buffer) == gst_util_uint64_scale_round (i,
+            GST_SECOND * TEST_VIDEO_FPS_D, TEST_VIDEO_FPS_N));
+    gst_buffer_unmap (buffer, &map);
+    i++;
+  }
+
+  stats = gst_video_decoder_get_stats (GST_VIDEO_DECODER (dec));
+  fail_unless (gst_structure_get (stats,
+          "threaded-frames", G_TYPE_UINT64, &threaded_frames,
+          "queued-frames", G_TYPE_UINT, &queued_frames, NULL));
+  fail_unless_equals_uint64 (threaded_frames, n_threaded);
+  fail_unless_equals_int (queued_frames, 0);
+
+  /* all output buffers came from the pool and are still held by us */
+  fail_unless (gst_structure_get (stats,
+          "pool-acquired", G_TYPE_UINT64, &pool_acquired,
+          "pool-outstanding", G_TYPE_UINT, &pool_outstanding,
+          "max-pool-outstanding", G_TYPE_UINT, &max_pool_outstanding, NULL));
+  fail_unless_equals_uint64 (pool_acquired, NUM_BUFFERS);
+  fail_unless_equals_int (pool_outstanding, NUM_BUFFERS);
+  fail_unless_equals_int (max_pool_outstanding, NUM_BUFFERS);
+  gst_structure_free (stats);
+
+  /* only the pooled buffers are tracked, not copies of them */
+  {
+    GstBuffer *copy;
+
+    copy = gst_buffer_copy (buffers->data);
+    gst_buffer_unref (copy);
+
+    stats = gst_video_decoder_get_stats (GST_VIDEO_DECODER (dec));
+    fail_unless (gst_structure_get (stats,
+            "pool-outstanding", G_TYPE_UINT, &pool_outstanding, NULL));
+    fail_unless_equals_int (pool_outstanding, NUM_BUFFERS);
+    gst_structure_free (stats);
+  }
+
+  g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
+  buffers = NULL;
+
+  /* released to the pool again */
+  stats = gst_video_decoder_get_stats (GST_VIDEO_DECODER (dec));
+  fail_unless (gst_structure_get (stats,
+          "pool-outstanding", G_TYPE_UINT, &pool_outstanding, NULL));
+  fail_unless_equals_int (pool_outstanding, 0);
+  gst_structure_free (stats);
+
+  cleanup_videodecodertest ();
+}
+
+GST_END_TEST;
+
+#define POOL_TEST_SIZE 2
+#define POOL_TEST_MAX_SIZE 6
+
+static GAsyncQueue *release_queue;
+static gint release_delay;
+static gint release_stop;
+
+static gboolean
+_mysinkpad_pool_query (GstPad * pad, GstObject * parent, GstQuery * query)
+{
+  if (GST_QUERY_TYPE (query) == GST_QUERY_ALLOCATION) {
+    GstCaps *caps;
+    GstVideoInfo info;
+
+    gst_query_parse_allocation (query, &caps, NULL);
+    if (caps == NULL || !gst_video_info_from_caps (&info, caps))
+      return FALSE;
+
+    gst_query_add_allocation_pool (query, NULL, info.size, 0,
+        POOL_TEST_SIZE);
+    return TRUE;
+  }
+
+  return gst_pad_query_default (pad, parent, query);
+}
+
+static GstFlowReturn
+_mysinkpad_release_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
+{
+  g_async_queue_push (release_queue, buf);
+  return GST_FLOW_OK;
+}
+
+/* gives the output buffers back to the pool after release_delay */
+static gpointer
+release_thread_func (gpointer data)
+{
+  gpointer item;
+
+  while ((item = g_async_queue_pop (release_queue)) != &release_stop) {
+    g_usleep (g_atomic_int_get (&release_delay));
+    gst_buffer_unref (item);
+  }
+
+  return NULL;
+}
+
+static guint
+get_pool_max_buffers (void)
+{
+  GstStructure *stats;
+  guint max_buffers;
+
+  stats = gst_video_decoder_get_stats (GST_VIDEO_DECODER (dec));
+  fail_unless (gst_structure_get (stats,
+          "pool-max-buffers", G_TYPE_UINT, &max_buffers, NULL));
+  gst_structure_free (stats);
+
+  return max_buffers;
+}
+
+GST_START_TEST (videodecoder_adaptive_pool_size)
+{
+  GstSegment segment;
+  GThread *release_thread;
+  guint64 i;
+  guint max_pool_size, grown_size;
+  gint n_caps = 0;
+  GList *iter;
+
+  setup_videodecodertester (NULL, NULL);
+  gst_video_decoder_set_frame_threads (GST_VIDEO_DECODER (dec), 2);
+  g_object_set (dec, "max-pool-size", POOL_TEST_MAX_SIZE, NULL);
+  g_object_get (dec, "max-pool-size", &max_pool_size, NULL);
+  fail_unless_equals_int (max_pool_size, POOL_TEST_MAX_SIZE);
+  gst_pad_set_query_function (mysinkpad, _mysinkpad_pool_query);
+  gst_pad_set_chain_function (mysinkpad, _mysinkpad_release_chain);
+
+  release_queue = g_async_queue_new ();
+  g_atomic_int_set (&release_delay, 2000);
+  release_thread = g_thread_new ("release", release_thread_func, NULL);
+
+  gst_pad_set_active (mysrcpad, TRUE);
+  gst_element_set_state (dec, GST_STATE_PLAYING);
+  gst_pad_set_active (mysinkpad, TRUE);
+
+  send_startup_events ();
+
+  gst_segment_init (&segment, GST_FORMAT_TIME);
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_segment (&segment)));
+
+  fail_unless (gst_pad_push (mysrcpad, create_test_buffer (0)) == GST_FLOW_OK);
+  fail_unless_equals_int (get_pool_max_buffers (), POOL_TEST_SIZE);
+
+  /* downstream holds on to the buffers, decoding keeps waiting for free
+   * ones and the pool grows up to max-pool-size */
+  for (i = 1; i < 100; i++)
+    fail_unless (gst_pad_push (mysrcpad, create_test_buffer (i)) ==
+        GST_FLOW_OK);
+  grown_size = get_pool_max_buffers ();
+  fail_unless_equals_int (grown_size, POOL_TEST_MAX_SIZE);
+
+  /* downstream gives them back right away, the extra buffers are not
+   * used anymore and the pool is shrunk again */
+  g_atomic_int_set (&release_delay, 0);
+  for (; i < 1000; i++)
+    fail_unless (gst_pad_push (mysrcpad, create_test_buffer (i)) ==
+        GST_FLOW_OK);
+  fail_unless (get_pool_max_buffers () < grown_size);
+  fail_unless (get_pool_max_buffers () >= POOL_TEST_SIZE);
+
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_eos ()));
+
+  g_async_queue_push (release_queue, &release_stop);
+  g_thread_join (release_thread);
+  g_async_queue_unref (release_queue);
+  release_queue = NULL;
+
+  /* resizing the pool never renegotiated the caps */
+  for (iter = events; iter; iter = g_list_next (iter)) {
+    if (GST_EVENT_TYPE (iter->data) == GST_EVENT_CAPS)
+      n_caps++;
+  }
+  fail_unless_equals_int (n_caps, 1);
+
+  cleanup_videodecodertest ();
+}
+
+GST_END_TEST;
+
+GST_START_TEST (videodecoder_playback_output_queue)
+{
+  GstSegment segment;
+  GstBuffer *buffer;
+  guint64 i;
+  guint queue_size;
+  GList *iter;
+
+  setup_videodecodertester (NULL, NULL);
+  g_object_set (dec, "output-queue-size", 4, NULL);
+  g_object_get (dec, "output-queue-size", &queue_size, NULL);
+  fail_unless_equals_int (queue_size, 4);
+
+  gst_pad_set_active (mysrcpad, TRUE);
+  gst_element_set_state (dec, GST_STATE_PLAYING);
+  gst_pad_set_active (mysinkpad, TRUE);
+
+  send_startup_events ();
+
+  gst_segment_init (&segment, GST_FORMAT_TIME);
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_segment (&segment)));
+
+  for (i = 0; i < NUM_BUFFERS; i++) {
+    buffer = create_test_buffer (i);
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  }
+
+  /* EOS is serialized after all buffers queued for the output thread */
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_eos ()));
+
+  fail_unless_equals_int (g_list_length (buffers), NUM_BUFFERS);
+  i = 0;
+  for (iter = buffers; iter; iter = g_list_next (iter)) {
+    GstMapInfo map;
+    guint64 num;
+
+    buffer = iter->data;
+
+    gst_buffer_map (buffer, &map, GST_MAP_READ);
+    num = *(guint64 *) map.data;
+    fail_unless_equals_uint64 (num, i);
+    gst_buffer_unmap (buffer, &map);
+    i++;
+  }
+
+  g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
+  buffers = NULL;
+
+  cleanup_videodecodertest ();
+}
+
+GST_END_TEST;
+
+GST_START_TEST (videodecoder_qos_skip_droppable)
+{
+  GstVideoDecoderTester *dectester;
+  GstSegment segment;
+  GstBuffer *buffer;
+  guint64 i;
+
+  setup_videodecodertester (NULL, NULL);
+  dectester = (GstVideoDecoderTester *) dec;
+
+  gst_pad_set_active (mysrcpad, TRUE);
+  gst_element_set_state (dec, GST_STATE_PLAYING);
+  gst_pad_set_active (mysinkpad, TRUE);
+
+  send_startup_events ();
+
+  gst_segment_init (&segment, GST_FORMAT_TIME);
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_segment (&segment)));
+
+  buffer = create_test_buffer (0);
+  fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  fail_unless_equals_uint64 (dectester->last_buf_num, 0);
+
+  /* downstream is way behind */
+  gst_pad_push_event (mysinkpad, gst_event_new_qos (GST_QOS_TYPE_UNDERFLOW,
+          1.0, 10 * GST_SECOND, 0));
+
+  /* droppable frames are decoded by default */
+  buffer = create_test_buffer (1);
+  GST_BUFFER_FLAG_SET (buffer,
+      GST_BUFFER_FLAG_DELTA_UNIT | GST_BUFFER_FLAG_DROPPABLE);
+  fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  fail_unless_equals_uint64 (dectester->last_buf_num, 1);
+
+  g_object_set (dec, "drop-droppable", TRUE, NULL);
+
+  /* late non-reference frames never reach handle_frame */
+  for (i = 2; i < 10; i++) {
+    buffer = create_test_buffer (i);
+    GST_BUFFER_FLAG_SET (buffer,
+        GST_BUFFER_FLAG_DELTA_UNIT | GST_BUFFER_FLAG_DROPPABLE);
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+    fail_unless_equals_uint64 (dectester->last_buf_num, 1);
+  }
+
+  /* other frames are still decoded, and dropped late after that */
+  buffer = create_test_buffer (i);
+  fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  fail_unless_equals_uint64 (dectester->last_buf_num, i);
+
+  fail_unless_equals_int (g_list_length (buffers), 1);
+
+  g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
+  buffers = NULL;
+
+  cleanup_videodecodertest ();
+}
+
+GST_END_TEST;
+
 GST_START_TEST (videodecoder_playback_with_events)
 {
   GstSegment segment;
@@ -616,6 +983,161 @@ GST_START_TEST (videodecoder_playback_first_frames_not_decoded)
 
 GST_END_TEST;
 
+#define NUM_PENDING_FRAMES 64
+GST_START_TEST (videodecoder_pending_frames_lookup)
+{
+  GstSegment segment;
+  GstBuffer *buffer;
+  GstVideoCodecFrame *frame;
+  GList *l, *ol;
+  gint numbers[NUM_PENDING_FRAMES];
+  guint64 i;
+
+  setup_videodecodertester (NULL, NULL);
+
+  gst_pad_set_active (mysrcpad, TRUE);
+  gst_element_set_state (dec, GST_STATE_PLAYING);
+  gst_pad_set_active (mysinkpad, TRUE);
+
+  send_startup_events ();
+
+  gst_segment_init (&segment, GST_FORMAT_TIME);
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_segment (&segment)));
+
+  /* delta units without a keyframe can't be decoded by the tester and stay
+   * pending in the decoder */
+  for (i = 0; i < NUM_PENDING_FRAMES; i++) {
+    buffer = create_test_buffer (i);
+    GST_BUFFER_FLAG_SET (buffer, GST_BUFFER_FLAG_DELTA_UNIT);
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  }
+
+  ol = l = gst_video_decoder_get_frames (GST_VIDEO_DECODER (dec));
+  fail_unless_equals_int (g_list_length (l), NUM_PENDING_FRAMES);
+  for (i = 0; l; l = l->next, i++) {
+    GstVideoCodecFrame *tmp = l->data;
+
+    numbers[i] = tmp->system_frame_number;
+    if (i > 0)
+      fail_unless (numbers[i] > numbers[i - 1]);
+
+    frame = gst_video_decoder_get_frame (GST_VIDEO_DECODER (dec), numbers[i]);
+    fail_unless (frame == tmp);
+    gst_video_codec_frame_unref (frame);
+  }
+  g_list_free_full (ol, (GDestroyNotify) gst_video_codec_frame_unref);
+
+  /* release every odd frame and the oldest one */
+  for (i = 0; i < NUM_PENDING_FRAMES; i++) {
+    if (i % 2 == 0 && i != 0)
+      continue;
+    frame = gst_video_decoder_get_frame (GST_VIDEO_DECODER (dec), numbers[i]);
+    fail_unless (frame != NULL);
+    gst_video_decoder_release_frame (GST_VIDEO_DECODER (dec), frame);
+  }
+
+  for (i = 0; i < NUM_PENDING_FRAMES; i++) {
+    frame = gst_video_decoder_get_frame (GST_VIDEO_DECODER (dec), numbers[i]);
+    if (i % 2 == 0 && i != 0) {
+      fail_unless (frame != NULL);
+      fail_unless_equals_int (frame->system_frame_number, numbers[i]);
+      gst_video_codec_frame_unref (frame);
+    } else {
+      fail_unless (frame == NULL);
+    }
+  }
+
+  frame = gst_video_decoder_get_oldest_frame (GST_VIDEO_DECODER (dec));
+  fail_unless (frame != NULL);
+  fail_unless_equals_int (frame->system_frame_number, numbers[2]);
+  gst_video_codec_frame_unref (frame);
+
+  ol = gst_video_decoder_get_frames (GST_VIDEO_DECODER (dec));
+  fail_unless_equals_int (g_list_length (ol), NUM_PENDING_FRAMES / 2 - 1);
+  g_list_free_full (ol, (GDestroyNotify) gst_video_codec_frame_unref);
+
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_eos ()));
+
+  g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
+  buffers = NULL;
+
+  cleanup_videodecodertest ();
+}
+
+GST_END_TEST;
+
+GST_START_TEST (videodecoder_pending_frames_reused_number)
+{
+  GstSegment segment;
+  GstBuffer *buffer;
+  GstVideoCodecFrame *frame, *first, *second;
+  GList *frames;
+  gint number;
+  guint64 i;
+
+  setup_videodecodertester (NULL, NULL);
+
+  gst_pad_set_active (mysrcpad, TRUE);
+  gst_element_set_state (dec, GST_STATE_PLAYING);
+  gst_pad_set_active (mysinkpad, TRUE);
+
+  send_startup_events ();
+
+  gst_segment_init (&segment, GST_FORMAT_TIME);
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_segment (&segment)));
+
+  for (i = 0; i < 3; i++) {
+    buffer = create_test_buffer (i);
+    GST_BUFFER_FLAG_SET (buffer, GST_BUFFER_FLAG_DELTA_UNIT);
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  }
+
+  frames = gst_video_decoder_get_frames (GST_VIDEO_DECODER (dec));
+  fail_unless_equals_int (g_list_length (frames), 3);
+  first = frames->data;
+  second = frames->next->data;
+
+  /* a subclass gives the second frame the number of the first one */
+  number = second->system_frame_number;
+  second->system_frame_number = first->system_frame_number;
+
+  /* the oldest frame with a number is returned */
+  frame = gst_video_decoder_get_frame (GST_VIDEO_DECODER (dec),
+      first->system_frame_number);
+  fail_unless (frame == first);
+  gst_video_codec_frame_unref (frame);
+  frame = gst_video_decoder_get_frame (GST_VIDEO_DECODER (dec), number);
+  fail_unless (frame == NULL);
+
+  gst_video_decoder_release_frame (GST_VIDEO_DECODER (dec),
+      gst_video_codec_frame_ref (first));
+  frame = gst_video_decoder_get_frame (GST_VIDEO_DECODER (dec),
+      first->system_frame_number);
+  fail_unless (frame == second);
+  gst_video_codec_frame_unref (frame);
+
+  gst_video_decoder_release_frame (GST_VIDEO_DECODER (dec),
+      gst_video_codec_frame_ref (second));
+  frame = gst_video_decoder_get_frame (GST_VIDEO_DECODER (dec),
+      first->system_frame_number);
+  fail_unless (frame == NULL);
+
+  g_list_free_full (frames, (GDestroyNotify) gst_video_codec_frame_unref);
+
+  frames = gst_video_decoder_get_frames (GST_VIDEO_DECODER (dec));
+  fail_unless_equals_int (g_list_length (frames), 1);
+  g_list_free_full (frames, (GDestroyNotify) gst_video_codec_frame_unref);
+
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_eos ()));
+
+  g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
+  buffers = NULL;
+
+  cleanup_videodecodertest ();
+}
+
+GST_END_TEST;
+
 GST_START_TEST (videodecoder_buffer_after_segment)
 {
   GstSegment segment;
@@ -1268,7 +1790,13 @@ gst_videodecoder_suite (void)
 
   tcase_add_test (tc, videodecoder_playback);
   tcase_add_test (tc, videodecoder_playback_with_events);
+  tcase_add_test (tc, videodecoder_playback_frame_threads);
+  tcase_add_test (tc, videodecoder_adaptive_pool_size);
+  tcase_add_test (tc, videodecoder_playback_output_queue);
+  tcase_add_test (tc, videodecoder_qos_skip_droppable);
   tcase_add_test (tc, videodecoder_playback_first_frames_not_decoded);
+  tcase_add_test (tc, videodecoder_pending_frames_lookup);
+  tcase_add_test (tc, videodecoder_pending_frames_reused_number);
   tcase_add_test (tc, videodecoder_buffer_after_segment);
   tcase_add_test (tc, videodecoder_first_data_is_gap);
 
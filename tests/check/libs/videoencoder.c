@@ -174,6 +174,29 @@ gst_video_encoder_tester_handle_frame (GstVideoEncoder * enc,
       enc_tester->num_subframes);
 }
 
+/* every frame is independent, the earlier frames of each group of 4 take
+ * longer so that they are finished out of order */
+static GstFlowReturn
+gst_video_encoder_tester_handle_frame_threaded (GstVideoEncoder * enc,
+    GstVideoCodecFrame * frame)
+{
+  GstMapInfo map;
+  guint64 input_num;
+  guint8 *data;
+
+  gst_buffer_map (frame->input_buffer, &map, GST_MAP_READ);
+  input_num = *((guint64 *) map.data);
+  gst_buffer_unmap (frame->input_buffer, &map);
+
+  g_usleep ((3 - input_num % 4) * 1000);
+
+  data = g_malloc (sizeof (guint64));
+  *(guint64 *) data = input_num;
+  frame->output_buffer = gst_buffer_new_wrapped (data, sizeof (guint64));
+
+  return GST_FLOW_OK;
+}
+
 static GstFlowReturn
 gst_video_encoder_tester_pre_push (GstVideoEncoder * enc,
     GstVideoCodecFrame * frame)
@@ -205,6 +228,8 @@ gst_video_encoder_tester_class_init (GstVideoEncoderTesterClass * klass)
   videoencoder_class->start = gst_video_encoder_tester_start;
   videoencoder_class->stop = gst_video_encoder_tester_stop;
   videoencoder_class->handle_frame = gst_video_encoder_tester_handle_frame;
+  videoencoder_class->handle_frame_threaded =
+      gst_video_encoder_tester_handle_frame_threaded;
   videoencoder_class->pre_push = gst_video_encoder_tester_pre_push;
   videoencoder_class->set_format = gst_video_encoder_tester_set_format;
 
@@ -320,7 +345,9 @@ GST_START_TEST (videoencoder_playback)
 {
   GstSegment segment;
   GstBuffer *buffer;
-  guint64 i;
+  GstStructure *stats;
+  guint64 i, output_buffers;
+  guint max_pending_frames;
   GList *iter;
 
   setup_videoencodertester ();
@@ -367,6 +394,131 @@ GST_START_TEST (videoencoder_playback)
     i++;
   }
 
+  /* every frame is encoded right away */
+  stats = gst_video_encoder_get_stats (GST_VIDEO_ENCODER (enc));
+  fail_unless (gst_structure_get (stats,
+          "max-pending-frames", G_TYPE_UINT, &max_pending_frames,
+          "output-buffers", G_TYPE_UINT64, &output_buffers, NULL));
+  fail_unless_equals_int (max_pending_frames, 1);
+  fail_unless_equals_uint64 (output_buffers, 0);
+  gst_structure_free (stats);
+
+  g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
+  buffers = NULL;
+
+  cleanup_videoencodertest ();
+}
+
+GST_END_TEST;
+
+static gboolean
+_mysrcpad_latency_query (GstPad * pad, GstObject * parent, GstQuery * query)
+{
+  if (GST_QUERY_TYPE (query) != GST_QUERY_LATENCY)
+    return gst_pad_query_default (pad, parent, query);
+
+  gst_query_set_latency (query, TRUE, 0, 0);
+  return TRUE;
+}
+
+GST_START_TEST (videoencoder_playback_frame_threads)
+{
+  GstSegment segment;
+  GstBuffer *buffer;
+  GstStructure *stats;
+  GstQuery *query;
+  GstBus *bus;
+  GstMessage *msg;
+  GstClockTime min_latency, max_latency;
+  gboolean live;
+  guint64 i, threaded_frames;
+  guint queued_frames, max_queued_frames;
+  GList *iter;
+
+  setup_videoencodertester ();
+  gst_pad_set_query_function (mysrcpad, _mysrcpad_latency_query);
+  gst_video_encoder_set_frame_threads (GST_VIDEO_ENCODER (enc), 4);
+  fail_unless_equals_int (gst_video_encoder_get_frame_threads
+      (GST_VIDEO_ENCODER (enc)), 4);
+
+  gst_pad_set_active (mysrcpad, TRUE);
+  gst_element_set_state (enc, GST_STATE_PLAYING);
+  gst_pad_set_active (mysinkpad, TRUE);
+
+  bus = gst_bus_new ();
+  gst_element_set_bus (enc, bus);
+
+  send_startup_events ();
+
+  /* the framerate is known now, output is delayed by up to 3 frames */
+  msg = gst_bus_pop_filtered (bus, GST_MESSAGE_LATENCY);
+  fail_unless (msg != NULL);
+  gst_message_unref (msg);
+
+  query = gst_query_new_latency ();
+  fail_unless (gst_pad_peer_query (mysinkpad, query));
+  gst_query_parse_latency (query, &live, &min_latency, &max_latency);
+  fail_unless (live);
+  fail_unless_equals_uint64 (min_latency, gst_util_uint64_scale (3,
+          GST_SECOND * TEST_VIDEO_FPS_D, TEST_VIDEO_FPS_N));
+  fail_unless_equals_uint64 (max_latency, min_latency);
+  gst_query_unref (query);
+
+  gst_segment_init (&segment, GST_FORMAT_TIME);
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_segment (&segment)));
+
+  for (i = 0; i < NUM_BUFFERS; i++) {
+    buffer = create_test_buffer (i);
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  }
+
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_eos ()));
+
+  /* output must be in input order, and all frames are keyframes */
+  fail_unless_equals_int (g_list_length (buffers), NUM_BUFFERS);
+  i = 0;
+  for (iter = buffers; iter; iter = g_list_next (iter)) {
+    GstMapInfo map;
+    guint64 num;
+
+    buffer = iter->data;
+
+    gst_buffer_map (buffer, &map, GST_MAP_READ);
+    num = *(guint64 *) map.data;
+    fail_unless_equals_uint64 (num, i);
+    fail_unless (GST_BUFFER_PTS (buffer) == gst_util_uint64_scale_round (i,
+            GST_SECOND * TEST_VIDEO_FPS_D, TEST_VIDEO_FPS_N));
+    fail_if (GST_BUFFER_FLAG_IS_SET (buffer, GST_BUFFER_FLAG_DELTA_UNIT));
+    gst_buffer_unmap (buffer, &map);
+    i++;
+  }
+
+  stats = gst_video_encoder_get_stats (GST_VIDEO_ENCODER (enc));
+  fail_unless (gst_structure_get (stats,
+          "threaded-frames", G_TYPE_UINT64, &threaded_frames,
+          "queued-frames", G_TYPE_UINT, &queued_frames,
+          "max-queued-frames", G_TYPE_UINT, &max_queued_frames, NULL));
+  fail_unless_equals_uint64 (threaded_frames, NUM_BUFFERS);
+  fail_unless_equals_int (queued_frames, 0);
+  fail_unless (max_queued_frames <= 4);
+  gst_structure_free (stats);
+
+  /* fewer threads, less latency */
+  gst_video_encoder_set_frame_threads (GST_VIDEO_ENCODER (enc), 2);
+  msg = gst_bus_pop_filtered (bus, GST_MESSAGE_LATENCY);
+  fail_unless (msg != NULL);
+  gst_message_unref (msg);
+
+  query = gst_query_new_latency ();
+  fail_unless (gst_pad_peer_query (mysinkpad, query));
+  gst_query_parse_latency (query, &live, &min_latency, &max_latency);
+  fail_unless_equals_uint64 (min_latency, gst_util_uint64_scale (1,
+          GST_SECOND * TEST_VIDEO_FPS_D, TEST_VIDEO_FPS_N));
+  gst_query_unref (query);
+
+  gst_bus_set_flushing (bus, TRUE);
+  gst_object_unref (bus);
+
   g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
   buffers = NULL;
 
@@ -920,6 +1072,7 @@ gst_videoencoder_suite (void)
 
   suite_add_tcase (s, tc);
   tcase_add_test (tc, videoencoder_playback);
+  tcase_add_test (tc, videoencoder_playback_frame_threads);
 
   tcase_add_test (tc, videoencoder_tags_before_eos);
   tcase_add_test (tc, videoencoder_events_before_eos);
@@ -156,10 +156,9 @@ check_chain_final_state (gpointer key, ChainState * state, gpointer data)
   return TRUE;
 }
 
-static GstPadProbeReturn
-eos_buffer_probe (GstPad * pad, GstPadProbeInfo * info, gpointer unused)
+static void
+check_buffer (GstBuffer * buffer)
 {
-  GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER (info);
   gint ret;
   gint size;
   gchar *oggbuffer;
@@ -194,6 +193,20 @@ eos_buffer_probe (GstPad * pad, GstPadProbeInfo * info, gpointer unused)
             "Non-video buffer doesn't have DELTA_UNIT in stream with video");
     }
   }
+}
+
+static GstPadProbeReturn
+eos_buffer_probe (GstPad * pad, GstPadProbeInfo * info, gpointer unused)
+{
+  if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_BUFFER_LIST) {
+    GstBufferList *list = GST_PAD_PROBE_INFO_BUFFER_LIST (info);
+    guint i, len = gst_buffer_list_length (list);
+
+    for (i = 0; i < len; i++)
+      check_buffer (gst_buffer_list_get (list, i));
+  } else {
+    check_buffer (GST_PAD_PROBE_INFO_BUFFER (info));
+  }
 
   return GST_PAD_PROBE_OK;
 }
@@ -208,7 +221,8 @@ start_pipeline (GstElement * bin, GstPad * pad)
   eos_chain_states =
       g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
   probe_id =
-      gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER,
+      gst_pad_add_probe (pad,
+      GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST,
       (GstPadProbeCallback) eos_buffer_probe, NULL, NULL);
 
   ret = gst_element_set_state (bin, GST_STATE_PLAYING);
@@ -248,8 +262,10 @@ eos_watch (GstBus * bus, GstMessage * message, GMainLoop * loop)
   return TRUE;
 }
 
+typedef void (*PipelineSetupFunc) (GstElement * bin, GstPad * srcpad);
+
 static void
-test_pipeline (const char *pipeline)
+run_pipeline (const char *pipeline, PipelineSetupFunc setup)
 {
   GstElement *bin, *sink;
   GstPad *pad, *sinkpad;
@@ -283,6 +299,9 @@ test_pipeline (const char *pipeline)
   bus_watch = gst_bus_add_watch (bus, (GstBusFunc) eos_watch, loop);
   gst_object_unref (bus);
 
+  if (setup)
+    setup (bin, pad);
+
   start_pipeline (bin, pad);
   g_main_loop_run (loop);
 
@@ -310,6 +329,12 @@ test_pipeline (const char *pipeline)
   gst_object_unref (bin);
 }
 
+static void
+test_pipeline (const char *pipeline)
+{
+  run_pipeline (pipeline, NULL);
+}
+
 GST_START_TEST (test_vorbis)
 {
   test_pipeline
@@ -368,6 +393,105 @@ GST_START_TEST (test_vorbis_theora)
 
 GST_END_TEST;
 
+static GMutex queue_time_lock;
+/* newest data page pushed by oggmux so far */
+static GstClockTime queue_time_last_ts;
+/* queue_time_last_ts when the audio stream ended */
+static GstClockTime queue_time_audio_eos_ts;
+
+static void
+queue_time_check_buffer (GstBuffer * buffer)
+{
+  if (GST_BUFFER_FLAG_IS_SET (buffer, GST_BUFFER_FLAG_HEADER) ||
+      !GST_BUFFER_PTS_IS_VALID (buffer))
+    return;
+
+  g_mutex_lock (&queue_time_lock);
+  if (!GST_CLOCK_TIME_IS_VALID (queue_time_last_ts) ||
+      GST_BUFFER_PTS (buffer) > queue_time_last_ts)
+    queue_time_last_ts = GST_BUFFER_PTS (buffer);
+  g_mutex_unlock (&queue_time_lock);
+}
+
+static GstPadProbeReturn
+queue_time_src_probe (GstPad * pad, GstPadProbeInfo * info, gpointer unused)
+{
+  if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_BUFFER_LIST) {
+    GstBufferList *list = GST_PAD_PROBE_INFO_BUFFER_LIST (info);
+    guint i, len = gst_buffer_list_length (list);
+
+    for (i = 0; i < len; i++)
+      queue_time_check_buffer (gst_buffer_list_get (list, i));
+  } else {
+    queue_time_check_buffer (GST_PAD_PROBE_INFO_BUFFER (info));
+  }
+
+  return GST_PAD_PROBE_OK;
+}
+
+static GstPadProbeReturn
+queue_time_audio_eos_probe (GstPad * pad, GstPadProbeInfo * info,
+    gpointer unused)
+{
+  if (GST_EVENT_TYPE (GST_PAD_PROBE_INFO_EVENT (info)) == GST_EVENT_EOS) {
+    g_mutex_lock (&queue_time_lock);
+    queue_time_audio_eos_ts = queue_time_last_ts;
+    g_mutex_unlock (&queue_time_lock);
+  }
+
+  return GST_PAD_PROBE_OK;
+}
+
+static void
+queue_time_setup (GstElement * bin, GstPad * srcpad)
+{
+  GstElement *aqueue;
+  GstPad *pad, *muxpad;
+
+  queue_time_last_ts = GST_CLOCK_TIME_NONE;
+  queue_time_audio_eos_ts = GST_CLOCK_TIME_NONE;
+
+  gst_pad_add_probe (srcpad,
+      GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST,
+      (GstPadProbeCallback) queue_time_src_probe, NULL, NULL);
+
+  aqueue = gst_bin_get_by_name (GST_BIN (bin), "aqueue");
+  fail_unless (aqueue != NULL);
+  pad = gst_element_get_static_pad (aqueue, "src");
+  muxpad = gst_pad_get_peer (pad);
+  fail_unless (muxpad != NULL);
+  gst_pad_add_probe (muxpad, GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM,
+      (GstPadProbeCallback) queue_time_audio_eos_probe, NULL, NULL);
+  gst_object_unref (muxpad);
+  gst_object_unref (pad);
+  gst_object_unref (aqueue);
+}
+
+GST_START_TEST (test_theora_vorbis_max_queue_time)
+{
+  /* 1s of video and 2s of silence. The tiny vorbis packets don't fill a
+   * page and the delays are too long to force one out, so the audio stream
+   * only completes a data page at EOS. Without max-queue-time all video
+   * pages would be held back until then. */
+  run_pipeline
+      ("videotestsrc pattern=snow num-buffers=30 ! video/x-raw,framerate=30/1 "
+      "! videoconvert ! theoraenc ! queue ! .video_%u "
+      "oggmux name=mux max-queue-time=100000000 max-delay=10000000000 "
+      "max-page-delay=10000000000 "
+      "audiotestsrc wave=silence num-buffers=87 ! audioconvert ! vorbisenc "
+      "! queue name=aqueue ! mux.audio_%u", queue_time_setup);
+
+  /* the video pages went out while the audio stream was starved, all but
+   * the last 100ms (plus the page in progress) of them */
+  fail_unless (GST_CLOCK_TIME_IS_VALID (queue_time_audio_eos_ts),
+      "no data pages were pushed before the audio stream ended");
+  fail_unless (queue_time_audio_eos_ts >= 750 * GST_MSECOND,
+      "video pages up to %" GST_TIME_FORMAT " were pushed, expected at least "
+      "up to 750ms", GST_TIME_ARGS (queue_time_audio_eos_ts));
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_simple_cleanup)
 {
   GstElement *oggmux;
@@ -426,6 +550,7 @@ oggmux_suite (void)
   if (have_vorbisenc && have_theoraenc) {
     tcase_add_test (tc_chain, test_vorbis_theora);
     tcase_add_test (tc_chain, test_theora_vorbis);
+    tcase_add_test (tc_chain, test_theora_vorbis_max_queue_time);
   }
 
   tcase_add_test (tc_chain, test_simple_cleanup);
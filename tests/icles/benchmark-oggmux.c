@@ -0,0 +1,193 @@
+/* GStreamer oggmux benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <stdlib.h>
+#include <gst/gst.h>
+#include <gst/app/app.h>
+
+/* 20 seconds of 200 fps video and 2.5 ms opus frames */
+#define NUM_VIDEO_BUFFERS 4000
+#define NUM_AUDIO_BUFFERS 8000
+
+#define DEFAULT_ITERATIONS 10
+
+typedef struct
+{
+  GstCaps *caps;
+  GPtrArray *buffers;
+} Stream;
+
+static gboolean
+pull_stream (GstElement * pipeline, const gchar * name, Stream * stream)
+{
+  GstElement *sink = gst_bin_get_by_name (GST_BIN (pipeline), name);
+  GstSample *sample;
+
+  stream->caps = NULL;
+  stream->buffers = g_ptr_array_new_with_free_func (
+      (GDestroyNotify) gst_buffer_unref);
+
+  while ((sample = gst_app_sink_pull_sample (GST_APP_SINK (sink)))) {
+    if (stream->caps == NULL)
+      stream->caps = gst_caps_ref (gst_sample_get_caps (sample));
+    g_ptr_array_add (stream->buffers,
+        gst_buffer_ref (gst_sample_get_buffer (sample)));
+    gst_sample_unref (sample);
+  }
+  gst_object_unref (sink);
+
+  return stream->caps != NULL;
+}
+
+static gboolean
+have_element (const gchar * name)
+{
+  GstElementFactory *factory = gst_element_factory_find (name);
+
+  if (factory == NULL) {
+    gst_println ("%s not available, skipping", name);
+    return FALSE;
+  }
+  gst_object_unref (factory);
+  return TRUE;
+}
+
+static gboolean
+encode_streams (Stream * video, Stream * audio)
+{
+  GstElement *pipeline;
+  GError *err = NULL;
+  gchar *desc;
+  gboolean ret;
+
+  desc = g_strdup_printf ("videotestsrc num-buffers=%d ! "
+      "video/x-raw,width=64,height=48,framerate=200/1 ! theoraenc ! "
+      "appsink name=v sync=false "
+      "audiotestsrc num-buffers=%d samplesperbuffer=120 ! "
+      "audio/x-raw,rate=48000,channels=2 ! opusenc frame-size=2.5 ! "
+      "appsink name=a sync=false", NUM_VIDEO_BUFFERS, NUM_AUDIO_BUFFERS);
+  pipeline = gst_parse_launch (desc, &err);
+  g_free (desc);
+
+  if (pipeline == NULL) {
+    gst_printerrn ("Could not create encoding pipeline: %s", err->message);
+    g_clear_error (&err);
+    return FALSE;
+  }
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  ret = pull_stream (pipeline, "v", video) && pull_stream (pipeline, "a",
+      audio);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  return ret;
+}
+
+static void
+push_stream (GstElement * src, Stream * stream)
+{
+  guint i;
+
+  for (i = 0; i < stream->buffers->len; i++) {
+    gst_app_src_push_buffer (GST_APP_SRC (src),
+        gst_buffer_ref (g_ptr_array_index (stream->buffers, i)));
+  }
+  gst_app_src_end_of_stream (GST_APP_SRC (src));
+}
+
+static void
+mux_streams (Stream * video, Stream * audio)
+{
+  GstElement *pipeline, *vsrc, *asrc, *mux, *sink;
+  GstMessage *msg;
+  GstBus *bus;
+
+  pipeline = gst_pipeline_new (NULL);
+  vsrc = gst_element_factory_make ("appsrc", NULL);
+  asrc = gst_element_factory_make ("appsrc", NULL);
+  mux = gst_element_factory_make ("oggmux", NULL);
+  sink = gst_element_factory_make ("fakesink", NULL);
+
+  g_object_set (vsrc, "caps", video->caps, "format", GST_FORMAT_TIME, NULL);
+  g_object_set (asrc, "caps", audio->caps, "format", GST_FORMAT_TIME, NULL);
+
+  gst_bin_add_many (GST_BIN (pipeline), vsrc, asrc, mux, sink, NULL);
+  gst_element_link_many (vsrc, mux, sink, NULL);
+  gst_element_link (asrc, mux);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  push_stream (vsrc, video);
+  push_stream (asrc, audio);
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ERROR)
+    gst_printerrn ("Error while muxing");
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+}
+
+int
+main (int argc, char **argv)
+{
+  Stream video, audio;
+  GTimer *timer;
+  gdouble elapsed;
+  gint i, iterations = DEFAULT_ITERATIONS;
+
+  gst_init (&argc, &argv);
+
+  if (argc > 1)
+    iterations = MAX (1, atoi (argv[1]));
+
+  if (!have_element ("theoraenc") || !have_element ("opusenc")
+      || !have_element ("oggmux"))
+    return 0;
+
+  if (!encode_streams (&video, &audio))
+    return 1;
+
+  gst_println ("muxing %u video and %u audio packets, %d iterations",
+      video.buffers->len, audio.buffers->len, iterations);
+
+  timer = g_timer_new ();
+  for (i = 0; i < iterations; i++)
+    mux_streams (&video, &audio);
+  elapsed = g_timer_elapsed (timer, NULL);
+  g_timer_destroy (timer);
+
+  gst_println ("%8.1f packets/sec (%.3f sec per iteration)",
+      (video.buffers->len + audio.buffers->len) * iterations / elapsed,
+      elapsed / iterations);
+
+  gst_caps_unref (video.caps);
+  gst_caps_unref (audio.caps);
+  g_ptr_array_unref (video.buffers);
+  g_ptr_array_unref (audio.buffers);
+
+  return 0;
+}
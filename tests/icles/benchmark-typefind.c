@@ -0,0 +1,107 @@
+/* GStreamer typefinding benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <stdlib.h>
+#include <gst/gst.h>
+#include <gst/base/gsttypefindhelper.h>
+
+/* Typefinds every file in a directory (the test files by default) a number
+ * of times and prints how long it took per file */
+
+#define DEFAULT_ITERATIONS 100
+
+static void
+typefind_file (const gchar * path, gint iterations)
+{
+  GstTypeFindProbability prob = GST_TYPE_FIND_NONE;
+  GstCaps *caps = NULL;
+  GError *err = NULL;
+  GstBuffer *buf;
+  GTimer *timer;
+  gdouble elapsed;
+  gchar *data, *caps_str;
+  gsize len;
+  gint i;
+
+  if (!g_file_get_contents (path, &data, &len, &err)) {
+    gst_printerrn ("Could not read %s: %s", path, err->message);
+    g_clear_error (&err);
+    return;
+  }
+
+  buf = gst_buffer_new_wrapped (data, len);
+  GST_BUFFER_OFFSET (buf) = 0;
+
+  timer = g_timer_new ();
+  for (i = 0; i < iterations; i++) {
+    if (caps)
+      gst_caps_unref (caps);
+    caps = gst_type_find_helper_for_buffer (NULL, buf, &prob);
+  }
+  elapsed = g_timer_elapsed (timer, NULL);
+  g_timer_destroy (timer);
+
+  caps_str = caps ? gst_caps_to_string (caps) : g_strdup ("unknown");
+  gst_println ("%10.1f us  %3u%%  %s: %s", elapsed * G_USEC_PER_SEC /
+      iterations, prob, path, caps_str);
+  g_free (caps_str);
+
+  if (caps)
+    gst_caps_unref (caps);
+  gst_buffer_unref (buf);
+}
+
+int
+main (int argc, char **argv)
+{
+  const gchar *dirname = GST_TEST_FILES_PATH;
+  const gchar *name;
+  GError *err = NULL;
+  gint iterations = DEFAULT_ITERATIONS;
+  GDir *dir;
+
+  gst_init (&argc, &argv);
+
+  if (argc > 1)
+    dirname = argv[1];
+  if (argc > 2)
+    iterations = MAX (1, atoi (argv[2]));
+
+  dir = g_dir_open (dirname, 0, &err);
+  if (dir == NULL) {
+    gst_printerrn ("Could not open %s: %s", dirname, err->message);
+    g_clear_error (&err);
+    return 1;
+  }
+
+  gst_println ("typefinding files in %s, %d iterations", dirname, iterations);
+
+  while ((name = g_dir_read_name (dir))) {
+    gchar *path = g_build_filename (dirname, name, NULL);
+
+    if (g_file_test (path, G_FILE_TEST_IS_REGULAR))
+      typefind_file (path, iterations);
+    g_free (path);
+  }
+  g_dir_close (dir);
+
+  return 0;
+}